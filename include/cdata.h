@@ -38,5 +38,8 @@ Date:2019.4.2
 #include "cdata_list.h"
 #include "cdata_queue.h"
 #include "cdata_priqueue.h"
+#include "cdata_vector.h"
+#include "cdata_parallel.h"
+#include "cdata_typed.h"
 
 #endif
\ No newline at end of file
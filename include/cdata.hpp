@@ -0,0 +1,583 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.6.3
+*/
+
+/*
+ * C++ templates over the cdata engines: cdata::List, cdata::Queue and cdata::PriQueue.
+ * The objects are created by new in the templates and only their pointers are stored in the
+ * reference lists, so the emplace and move functions construct or move T in place, nothing is
+ * memcpy'd through dataLength.The objects are deleted when the nodes are destroyed.
+ *
+ * The functions which don't give out a reference or an iterator lock the list by themselves.
+ * begin, end, front, back and erase are the "NL" functions of the templates, the list must be
+ * locked by the guard returned from lock() while they are used:
+ * @code
+   cdata::List<std::string> names;
+
+   names.emplace_back("Tom");
+   names.push_back(std::string("Jerry"));
+   {
+       cdata::List<std::string>::Lock guard = names.lock();
+       for (auto it = names.begin(); it != names.end(); ++it)
+       {
+           std::cout << *it << std::endl;
+       }
+   }
+ * @endcode
+ * The list lock is not recursive, don't call the locking functions while the guard is held.
+ */
+
+#ifndef _CDATA_HPP_
+#define _CDATA_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include "cdata.h"
+
+namespace cdata
+{
+
+/*=============================================================================*
+ *                        Lock guard
+ *============================================================================*/
+/*
+ * RAII guard of List_Lock/List_UnLock or List_ReadLock/List_ReadUnLock, it can be moved out of
+ * the function which takes the lock, but not copied.
+ */
+template <void (*LockFn)(List_t), void (*UnLockFn)(List_t)>
+class BasicListGuard
+{
+public:
+    explicit BasicListGuard(List_t list) : m_list(list)
+    {
+        LockFn(m_list);
+    }
+
+    BasicListGuard(BasicListGuard&& other) : m_list(other.m_list)
+    {
+        other.m_list = NULL;
+    }
+
+    ~BasicListGuard()
+    {
+        if (m_list != NULL)
+        {
+            UnLockFn(m_list);
+        }
+    }
+
+private:
+    BasicListGuard(const BasicListGuard&);
+    BasicListGuard& operator=(const BasicListGuard&);
+
+    List_t m_list;
+};
+
+typedef BasicListGuard<List_Lock, List_UnLock>         ListLockGuard;
+typedef BasicListGuard<List_ReadLock, List_ReadUnLock> ListReadLockGuard;
+
+/*=============================================================================*
+ *                        List policies
+ *============================================================================*/
+/*The policy chooses the engine and the lock of cdata::List.*/
+struct DoubleLinkPolicy
+{
+    static const ListType_e       type = LIST_TYPE_DOUBLE_LINK;
+    static const ListLockPolicy_e lockPolicy = LIST_LOCK_MUTEX;
+    typedef std::bidirectional_iterator_tag iterator_category;
+};
+
+struct SingleLinkPolicy
+{
+    static const ListType_e       type = LIST_TYPE_SINGLE_LINK;
+    static const ListLockPolicy_e lockPolicy = LIST_LOCK_MUTEX;
+    typedef std::forward_iterator_tag iterator_category;
+};
+
+/*The readers share the lock, lock_shared() gives the read guard.*/
+struct RwLockPolicy
+{
+    static const ListType_e       type = LIST_TYPE_DOUBLE_LINK;
+    static const ListLockPolicy_e lockPolicy = LIST_LOCK_RW;
+    typedef std::bidirectional_iterator_tag iterator_category;
+};
+
+namespace detail
+{
+    template <typename T>
+    void DeleteData(void* p_data)
+    {
+        delete static_cast<T*>(p_data);
+    }
+
+    template <typename T>
+    int MoveData(void* p_queueData, void* p_userData)
+    {
+        *static_cast<T*>(p_userData) = std::move(*static_cast<T*>(p_queueData));
+        return ERR_OK;
+    }
+
+    //The comparator is default constructed in the callback, so a stateless one is inlined into it.
+    template <typename T, typename Compare>
+    CdataBool GreaterPriority(void* p_nodeData, void* p_userData)
+    {
+        return Compare()(*static_cast<T*>(p_nodeData), *static_cast<T*>(p_userData)) ? CDATA_TRUE : CDATA_FALSE;
+    }
+
+    inline List_t CreateRefList(const char* p_name, ListType_e type, const ListAttr_t* p_attr)
+    {
+        ListName_t name;
+        List_t     list = NULL;
+
+        strncpy(name, p_name, sizeof(name) - 1);
+        name[sizeof(name) - 1] = '\0';
+        if (List_CreateRefWithAttr(name, type, p_attr, &list) != ERR_OK)
+        {
+            throw std::bad_alloc();
+        }
+
+        return list;
+    }
+}
+
+/*=============================================================================*
+ *                        List
+ *============================================================================*/
+template <typename T, typename Policy = DoubleLinkPolicy>
+class List
+{
+public:
+    typedef T                 value_type;
+    typedef T&                reference;
+    typedef const T&          const_reference;
+    typedef std::size_t       size_type;
+    typedef std::ptrdiff_t    difference_type;
+    typedef ListLockGuard     Lock;
+    typedef ListReadLockGuard ReadLock;
+
+    template <typename V>
+    class Iterator
+    {
+    public:
+        typedef typename Policy::iterator_category iterator_category;
+        typedef T                                  value_type;
+        typedef std::ptrdiff_t                     difference_type;
+        typedef V*                                 pointer;
+        typedef V&                                 reference;
+
+        Iterator() : m_list(NULL), m_node(NULL) {}
+        Iterator(List_t list, ListNode_t node) : m_list(list), m_node(node) {}
+
+        //iterator converts to const_iterator.
+        operator Iterator<const T>() const { return Iterator<const T>(m_list, m_node); }
+
+        reference operator*() const  { return *static_cast<V*>(List_GetNodeDataNL(m_list, m_node)); }
+        pointer   operator->() const { return static_cast<V*>(List_GetNodeDataNL(m_list, m_node)); }
+
+        Iterator& operator++()
+        {
+            m_node = List_GetNextNodeNL(m_list, m_node);
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator old(*this);
+            ++*this;
+            return old;
+        }
+
+        //end() steps back to the tail.
+        Iterator& operator--()
+        {
+            m_node = (m_node == NULL) ? List_GetTailNL(m_list) : List_GetPreNodeNL(m_list, m_node);
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator old(*this);
+            --*this;
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return m_node == other.m_node; }
+        bool operator!=(const Iterator& other) const { return m_node != other.m_node; }
+
+        ListNode_t node() const { return m_node; }
+
+    private:
+        List_t     m_list;
+        ListNode_t m_node;
+    };
+
+    typedef Iterator<T>       iterator;
+    typedef Iterator<const T> const_iterator;
+
+    List() : m_list(NULL)
+    {
+        ListAttr_t attr;
+
+        List_AttrInit(&attr);
+        attr.lockPolicy = Policy::lockPolicy;
+        m_list = detail::CreateRefList("cdata::List", Policy::type, &attr);
+        List_SetFreeDataFunc(m_list, detail::DeleteData<T>);
+    }
+
+    ~List()
+    {
+        List_Destroy(m_list);
+    }
+
+    Lock     lock()              { return Lock(m_list); }
+    ReadLock lock_shared() const { return ReadLock(m_list); }
+
+    size_type size() const { return (size_type)List_Count(m_list); }
+    bool      empty() const { return List_Count(m_list) == 0; }
+    void      clear()       { List_Clear(m_list); }
+
+    void push_back(const T& data)  { Insert(new T(data), false); }
+    void push_back(T&& data)       { Insert(new T(std::move(data)), false); }
+    void push_front(const T& data) { Insert(new T(data), true); }
+    void push_front(T&& data)      { Insert(new T(std::move(data)), true); }
+
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        Insert(new T(std::forward<Args>(args)...), false);
+    }
+
+    template <typename... Args>
+    void emplace_front(Args&&... args)
+    {
+        Insert(new T(std::forward<Args>(args)...), true);
+    }
+
+    /*Move the head data out to p_data, return false if the list is empty.*/
+    bool pop_front(T* p_data = NULL)
+    {
+        //Checking the count firstly keeps the engine from logging an error for the empty list.
+        T* p_head = (List_Count(m_list) == 0) ? NULL : static_cast<T*>(List_DetachHeadData(m_list));
+        if (p_head == NULL)
+        {
+            return false;
+        }
+
+        if (p_data != NULL)
+        {
+            *p_data = std::move(*p_head);
+        }
+        delete p_head;
+
+        return true;
+    }
+
+    template <typename Pred>
+    bool any_of(Pred pred) const
+    {
+        ReadLock guard(m_list);
+        for (const_iterator it = begin(); it != end(); ++it)
+        {
+            if (pred(*it))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    template <typename Pred>
+    size_type count_if(Pred pred) const
+    {
+        ReadLock  guard(m_list);
+        size_type count = 0;
+
+        for (const_iterator it = begin(); it != end(); ++it)
+        {
+            count += pred(*it) ? 1 : 0;
+        }
+
+        return count;
+    }
+
+    /*The matched nodes are detached by the iterator, so it's O(n) for the single list too.*/
+    template <typename Pred>
+    size_type remove_if(Pred pred)
+    {
+        Lock       guard(m_list);
+        ListIter_t iter;
+        ListNode_t node = NULL;
+        size_type  count = 0;
+
+        List_IterInitNL(m_list, &iter);
+        while ((node = List_IterNextNL(m_list, &iter)) != NULL)
+        {
+            if (pred(*static_cast<T*>(List_GetNodeDataNL(m_list, node))))
+            {
+                List_DestroyNode(m_list, List_IterDetachNL(m_list, &iter));
+                count++;
+            }
+        }
+
+        return count;
+    }
+
+    //The functions below must be called with the list locked.
+    iterator       begin()       { return iterator(m_list, List_GetHeadNL(m_list)); }
+    iterator       end()         { return iterator(m_list, NULL); }
+    const_iterator begin() const { return const_iterator(m_list, List_GetHeadNL(m_list)); }
+    const_iterator end() const   { return const_iterator(m_list, NULL); }
+
+    T&       front()       { return *static_cast<T*>(List_GetHeadDataNL(m_list)); }
+    const T& front() const { return *static_cast<T*>(List_GetHeadDataNL(m_list)); }
+    T&       back()        { return *static_cast<T*>(List_GetTailDataNL(m_list)); }
+    const T& back() const  { return *static_cast<T*>(List_GetTailDataNL(m_list)); }
+
+    /*The time is O(n) if the list is LIST_TYPE_SINGLE_LINK.*/
+    iterator erase(iterator pos)
+    {
+        ListNode_t next = List_GetNextNodeNL(m_list, pos.node());
+
+        List_RmNodeNL(m_list, pos.node());
+        return iterator(m_list, next);
+    }
+
+    List_t native_handle() const { return m_list; }
+
+private:
+    List(const List&);
+    List& operator=(const List&);
+
+    void Insert(T* p_data, bool toHead)
+    {
+        ListNode_t node = toHead ? List_InsertData2Head(m_list, p_data) : List_InsertData(m_list, p_data);
+        if (node == NULL)
+        {
+            delete p_data;
+            throw std::bad_alloc();
+        }
+    }
+
+    List_t m_list;
+};
+
+/*=============================================================================*
+ *                        Queue
+ *============================================================================*/
+/*
+ * The data are moved out to user by pop, the consumers don't see the data in the queue, so all the
+ * functions lock the queue by themselves.
+ */
+template <typename T>
+class Queue
+{
+public:
+    typedef T           value_type;
+    typedef std::size_t size_type;
+
+    Queue() : m_queue(NULL)
+    {
+        QueueName_t name = "cdata::Queue";
+
+        if (Queue_CreateRef(name, detail::MoveData<T>, &m_queue) != ERR_OK)
+        {
+            throw std::bad_alloc();
+        }
+        Queue_SetFreeFunc(m_queue, detail::DeleteData<T>);
+    }
+
+    ~Queue()
+    {
+        Queue_Destroy(m_queue);
+    }
+
+    size_type size() const  { return (size_type)Queue_Count(m_queue); }
+    bool      empty() const { return Queue_Count(m_queue) == 0; }
+    void      clear()       { Queue_Clear(m_queue); }
+
+    void push(const T& data)  { Push(new T(data), false); }
+    void push(T&& data)       { Push(new T(std::move(data)), false); }
+    void push_front(T&& data) { Push(new T(std::move(data)), true); }
+
+    template <typename... Args>
+    void emplace(Args&&... args)
+    {
+        Push(new T(std::forward<Args>(args)...), false);
+    }
+
+    /*Move the head data out to data, return false if the queue is empty.*/
+    bool try_pop(T& data)
+    {
+        return Queue_PopBatch(m_queue, &data, sizeof(T), 1) == 1;
+    }
+
+    /*Wait until there is data in the queue.*/
+    void pop(T& data)
+    {
+        while (!try_pop(data))
+        {
+            Queue_WaitDataReady(m_queue);
+        }
+    }
+
+    /*Return false if there is still no data after timeOutMs.*/
+    bool pop(T& data, CdataTime_t timeOutMs)
+    {
+        while (!try_pop(data))
+        {
+            if (Queue_TimedWaitDataReady(m_queue, timeOutMs) != ERR_OK)
+            {
+                return try_pop(data);
+            }
+        }
+
+        return true;
+    }
+
+    Queue_t native_handle() const { return m_queue; }
+
+private:
+    Queue(const Queue&);
+    Queue& operator=(const Queue&);
+
+    void Push(T* p_data, bool toHead)
+    {
+        int ret = toHead ? Queue_Push2Head(m_queue, p_data) : Queue_Push(m_queue, p_data);
+        if (ret != ERR_OK)
+        {
+            delete p_data;
+            throw std::bad_alloc();
+        }
+    }
+
+    Queue_t m_queue;
+};
+
+/*=============================================================================*
+ *                        PriQueue
+ *============================================================================*/
+/*
+ * The same order as std::priority_queue: the greatest data by Compare is popped first, and the
+ * equal data are first in first out.It's a sorted list, the skip list towers make push O(log n).
+ * Compare is default constructed for each compare, it should be stateless as std::less.
+ */
+template <typename T, typename Compare = std::less<T> >
+class PriQueue
+{
+public:
+    typedef T           value_type;
+    typedef std::size_t size_type;
+
+    PriQueue() : m_list(NULL)
+    {
+        ListAttr_t attr;
+
+        List_AttrInit(&attr);
+        attr.sortOrder = LIST_SORT_ASC;
+        m_list = detail::CreateRefList("cdata::PriQueue", LIST_TYPE_DOUBLE_LINK, &attr);
+        List_SetFreeDataFunc(m_list, detail::DeleteData<T>);
+        List_SetUserLtNodeFunc(m_list, detail::GreaterPriority<T, Compare>);
+    }
+
+    ~PriQueue()
+    {
+        List_Destroy(m_list);
+    }
+
+    size_type size() const  { return (size_type)List_Count(m_list); }
+    bool      empty() const { return List_Count(m_list) == 0; }
+    void      clear()       { List_Clear(m_list); }
+
+    void push(const T& data) { Push(new T(data)); }
+    void push(T&& data)      { Push(new T(std::move(data))); }
+
+    template <typename... Args>
+    void emplace(Args&&... args)
+    {
+        Push(new T(std::forward<Args>(args)...));
+    }
+
+    /*Copy the top data to data, return false if the queue is empty.*/
+    bool top(T& data) const
+    {
+        ListLockGuard guard(m_list);
+        T*            p_top = static_cast<T*>(List_GetHeadDataNL(m_list));
+
+        if (p_top == NULL)
+        {
+            return false;
+        }
+        data = *p_top;
+
+        return true;
+    }
+
+    /*Move the top data out to p_data, return false if the queue is empty.*/
+    bool pop(T* p_data = NULL)
+    {
+        //Checking the count firstly keeps the engine from logging an error for the empty list.
+        T* p_top = (List_Count(m_list) == 0) ? NULL : static_cast<T*>(List_DetachHeadData(m_list));
+        if (p_top == NULL)
+        {
+            return false;
+        }
+
+        if (p_data != NULL)
+        {
+            *p_data = std::move(*p_top);
+        }
+        delete p_top;
+
+        return true;
+    }
+
+    List_t native_handle() const { return m_list; }
+
+private:
+    PriQueue(const PriQueue&);
+    PriQueue& operator=(const PriQueue&);
+
+    void Push(T* p_data)
+    {
+        if (List_InsertDataAsc(m_list, p_data) == NULL)
+        {
+            delete p_data;
+            throw std::bad_alloc();
+        }
+    }
+
+    List_t m_list;
+};
+
+}
+
+#endif //_CDATA_HPP_
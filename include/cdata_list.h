@@ -148,6 +148,7 @@ void Thread2()
 #define _CDATA_LIST_H_
 
 #include <stdio.h>
+#include <stddef.h>
 
 #include "cdata_types.h"
 #include "cdata_os_adapter.h"
@@ -157,9 +158,49 @@ __BEGIN_EXTERN_C_DECL__
 typedef enum
 {
 	LIST_TYPE_DOUBLE_LINK,
-	LIST_TYPE_SINGLE_LINK
+	LIST_TYPE_SINGLE_LINK,
+
+	/*
+	 * The value copy data are stored side by side in blocks, the node handle is the address of the data
+	 * in its block, it never changes while the node is alive. Walking the list touches far fewer cache
+	 * lines than the linked nodes, and inserting at the head or tail is O(1), but the data can only be
+	 * inserted at the two ends, and the functions which link nodes created by user(List_CreateNode,
+	 * List_InsertNode*, List_InsertData{Before|After|Asc|Des|AtPos}), the node chains(List_DetachHeadChain,
+	 * List_DetachHeadBatch, List_DetachAllMatchNodes*), List_Splice, List_Concat, List_SplitAt and List_Sort
+	 * are not supported. It can only be created by List_Create or List_CreateWithAttr without pool,
+	 * positionIndex, sortOrder and LIST_LOCK_RCU, and dataLength must not be greater than 1024.
+	 */
+	LIST_TYPE_UNROLLED
 }ListType_e;
 
+typedef enum
+{
+	LIST_SORT_NONE,
+	LIST_SORT_ASC,
+	LIST_SORT_DES
+}ListSortOrder_e;
+
+typedef enum
+{
+	LIST_LOCK_MUTEX,
+	LIST_LOCK_RW,
+	LIST_LOCK_RCU
+}ListLockPolicy_e;
+
+/*
+ * The kind of the key field in the node data, see List_SetKeyField.
+ * The keyword of LIST_KEY_CSTRING is a '\0' terminated string, the others point to a key of the same kind.
+ */
+typedef enum
+{
+	LIST_KEY_NONE,
+	LIST_KEY_INT32,
+	LIST_KEY_INT64,
+	LIST_KEY_UINT64,
+	LIST_KEY_BYTES,
+	LIST_KEY_CSTRING
+}ListKeyKind_e;
+
 typedef void (*List_FreeData_fn)(void* p_data);
 
 /*
@@ -177,6 +218,11 @@ typedef CdataBool (*List_NodeEqual_fn)(void* p_firstNodeData, void* p_secondNode
  */
 typedef CdataBool (*List_UserLtNode_fn)(void* p_nodeData, void* p_userData);
 
+/*
+ * To calculate the hash value of the node data or the keyword.
+ */
+typedef unsigned long (*List_DataHash_fn)(void* p_data);
+
 /*
  * To check if p_userData and p_nodeData satisfy the condition user sets,
  * return true if satisfies, or else return false
@@ -196,6 +242,117 @@ typedef struct
  */
 typedef void (*List_Traverse_fn)(ListTraverseNodeInfo_t* p_nodeInfo, void* p_userData, CdataBool* p_needStopTraverse);
 
+/*
+ * The link embedded in the user struct of an intrusive list, see List_CreateIntrusive. The same link works
+ * for both LIST_TYPE_DOUBLE_LINK and LIST_TYPE_SINGLE_LINK. Don't change the fields directly.
+ */
+typedef struct _CdataLink_s
+{
+    struct _CdataLink_s* p_next;
+    void*                p_data;
+    struct _CdataLink_s* p_pre;
+} CdataLink_t;
+
+//Get the struct from the pointer of its member, e.g. the data from its CdataLink_t.
+#define CDATA_CONTAINER_OF(_ptr_, _type_, _member_) ((_type_*)((char*)(_ptr_) - offsetof(_type_, _member_)))
+
+/*
+ * A cursor which remembers the node before the current one, so the current node can be detached
+ * in O(1) even for LIST_TYPE_SINGLE_LINK. Don't change the fields directly.
+ */
+typedef struct
+{
+    ListNode_t preNode;
+    ListNode_t node;
+    ListNode_t nextNode;
+} ListIter_t;
+
+/*
+ * A cursor of the chunked traversal, see List_CursorTraverse. The list keeps the open cursors, and
+ * moves a cursor to the next node when the node it stands on is detached, so the traversal can go on
+ * after the list is unlocked and changed. Don't change the fields directly.
+ */
+typedef struct _ListCursor_s
+{
+    List_t                list;
+    ListNode_t            nextNode;
+    CdataIndex_t          index;
+    struct _ListCursor_s* p_pre;
+    struct _ListCursor_s* p_next;
+} ListCursor_t;
+
+/*
+ * A cursor of the positional access, see List_PosCursorGetNodeNL. It remembers the last position and
+ * node, it's not registered to the list and needs no close. Don't change the fields directly.
+ */
+typedef struct
+{
+    List_t       list;
+    ListNode_t   node;
+    CdataIndex_t index;
+    CdataCount_t modCount;
+} ListPosCursor_t;
+
+/*
+ * Optional attributes used when creating a list, call List_AttrInit to get the default value firstly,
+ * then change the attributes you need.
+ */
+typedef struct
+{
+    /*
+     * If it's greater than 0, the list will allocate nodes from its own node pool, each chunk of the pool
+     * holds poolChunkNodes nodes. For the value copy list the node data is stored in the same slot with the
+     * node, so inserting or removing a node will not call malloc/free at all except a new chunk is needed.
+     * The chunks are only freed when the list is destroyed.
+     * 0 means no pool, the nodes are allocated with malloc, it's the default value.
+     */
+    int poolChunkNodes;
+
+    /*
+     * If it's CDATA_TRUE, the list keeps an order-statistics index of its nodes, then List_GetNodeAtPos,
+     * List_InsertDataAtPos, List_DetachDataAtPos and the other *AtPos functions are O(log n) instead of O(n).
+     * The index costs some memory in every node and a little time on every insert and detach.
+     * The default value is CDATA_FALSE.
+     */
+    CdataBool positionIndex;
+
+    /*
+     * If it's LIST_SORT_ASC or LIST_SORT_DES, the list keeps skip list towers over its nodes, then
+     * List_InsertDataAsc(or List_InsertDataDes for LIST_SORT_DES), List_GetLowerBoundNode,
+     * List_GetUpperBoundNode and List_GetFirstOrderedMatchNode are O(log n) instead of O(n).
+     * Inserting in the other order fails. The other insert functions and List_Swap don't know the order,
+     * it's up to user to keep the list sorted when using them.
+     * The default value is LIST_SORT_NONE.
+     */
+    ListSortOrder_e sortOrder;
+
+    /*
+     * LIST_LOCK_RW makes the list use a reader-writer lock, the read functions(List_GetData, List_DataExists,
+     * List_Traverse and so on) take it in shared mode, so they can run at the same time, the functions
+     * which change the list take it in exclusive mode. It suits the list which is read by many threads
+     * and seldom written.
+     * LIST_LOCK_RCU makes the read functions take no lock at all, they walk the links while the writers
+     * change them under the mutex. A removed node is freed only after all the readers which may see it
+     * have finished, so the readers never touch freed memory. It can only be used by LIST_TYPE_DOUBLE_LINK
+     * list without positionIndex and sortOrder, and the hash index can't be set on it. List_Swap changes
+     * the value copy data in place, a reader may see it half done.
+     * The functions which detach the data wait for the readers before returning it, detach many data with
+     * List_DetachHeadBatch to wait only once. The readers see NULL data in the node whose data is detached
+     * by List_DetachNodeData while it's still in the list.
+     * The default value is LIST_LOCK_MUTEX, all the functions take the same mutex.
+     */
+    ListLockPolicy_e lockPolicy;
+} ListAttr_t;
+
+typedef struct
+{
+    CdataCount_t nodeCount;
+
+    //How many nodes have been linked into and unlinked from the list since it was created.
+    CdataCount_t linkedTotal;
+    CdataCount_t unlinkedTotal;
+} ListStats_t;
+
 #define FOR_EACH_IN_LIST(_node_, _list_) for (_node_ = List_GetHeadNL(_list_); _node_ != NULL; _node_ = List_GetNextNodeNL(_list_, _node_))
 #define FOR_EACH_IN_DBLIST_REVERSE(_node_, _list_) for (_node_ = List_GetTailNL(_list_); _node_ != NULL; _node_ = List_GetPreNodeNL(_list_, _node_))
 
@@ -206,7 +363,7 @@ typedef void (*List_Traverse_fn)(ListTraverseNodeInfo_t* p_nodeInfo, void* p_use
 /**
  * @brief Create a new list which will store the data as value copy model.
  * @param name: List name.
- * @param type: List type, can be either LIST_TYPE_DOUBLE_LINK or LIST_TYPE_SINGLE_LINK.
+ * @param type: List type, can be LIST_TYPE_DOUBLE_LINK, LIST_TYPE_SINGLE_LINK or LIST_TYPE_UNROLLED.
  * @param dataLength: The length of data which will be stored into list node. For example,
  *  if you want to store int value in the list, so dataLength will be sizeof(int).
  * @param p_list:Output the new list handle.
@@ -229,9 +386,62 @@ int List_Create(ListName_t name, ListType_e type, int dataLength, List_t* p_list
  */
 int List_CreateRef(ListName_t name, ListType_e type, List_t* p_list);
 
+/**
+ * @brief Set the default value to the list attributes.
+ * @param p_attr: The list attributes.
+ * @return Error code.
+ *   @retval ERR_OK: Success
+ *   @retval ERR_BAD_PARAM:Param p_attr is NULL.
+ */
+int List_AttrInit(ListAttr_t* p_attr);
+
+/**
+ * @brief Create a new list which will store the data as value copy model with the attributes.
+ * @param name: List name.
+ * @param type: List type, can be LIST_TYPE_DOUBLE_LINK, LIST_TYPE_SINGLE_LINK or LIST_TYPE_UNROLLED.
+ * @param dataLength: The length of data which will be stored into list node.
+ * @param p_attr: The list attributes, NULL means using the default attributes, same as List_Create.
+ * @param p_list:Output the new list handle.
+ * @return Error code.
+ *   @retval ERR_OK: Success
+ *   @retval ERR_FAIL: Fail
+ *   @retval ERR_BAD_PARAM:Param p_list is NULL or p_attr is invalid.
+ */
+int List_CreateWithAttr(ListName_t name, ListType_e type, int dataLength, const ListAttr_t* p_attr, List_t* p_list);
+
+/**
+ * @brief Create a new list which will store the data as value reference model with the attributes.
+ * @param name: List name.
+ * @param type: List type, can be either LIST_TYPE_DOUBLE_LINK or LIST_TYPE_SINGLE_LINK.
+ * @param p_attr: The list attributes, NULL means using the default attributes, same as List_CreateRef.
+ * @param p_list:Output the new list handle.
+ * @return Error code.
+ *   @retval ERR_OK: Success
+ *   @retval ERR_FAIL: Fail
+ *   @retval ERR_BAD_PARAM:Param p_list is NULL or p_attr is invalid.
+ */
+int List_CreateRefWithAttr(ListName_t name, ListType_e type, const ListAttr_t* p_attr, List_t* p_list);
+
+/**
+ * @brief Create an intrusive list, the node is the CdataLink_t embedded in the data at linkOffset,
+ * e.g. offsetof(Conn_t, link). Inserting and detaching never allocate or free memory, and the data
+ * inserted is referenced as List_CreateRef does. The data must not be in two intrusive lists by
+ * the same link at the same time.
+ * When the node is destroyed (List_RmNode, List_Clear, List_Destroy and so on) the data is passed
+ * to freeFn if it's set, otherwise the data is left to user.
+ * @param type: List type, can be either LIST_TYPE_DOUBLE_LINK or LIST_TYPE_SINGLE_LINK.
+ * @param p_attr: Only lockPolicy LIST_LOCK_MUTEX or LIST_LOCK_RW is supported, the pool, index and
+ *  sort order need memory in the node.
+ */
+int List_CreateIntrusive(ListName_t name, ListType_e type, size_t linkOffset, List_t* p_list);
+int List_CreateIntrusiveWithAttr(ListName_t name, ListType_e type, size_t linkOffset, const ListAttr_t* p_attr, List_t* p_list);
+
 /**
  * @brief Set a freeFn to a list, freeFn will be used when free the node data. If not set 
  * the list will free data with free function.
+ * For the value copy list without freeFn, the node data is stored behind the node in one allocation.
+ * The data in the node memory(such a node, the node pool list and the unrolled list) is passed to freeFn
+ * where it is, freeFn must only free what the data points to, the data itself is released with the node.
  * @return Error code.
  *   @retval ERR_OK: Success
  *   @retval ERR_BAD_PARAM:Param list is NULL.
@@ -265,9 +475,78 @@ int List_SetNodeEqualFunc(List_t list, List_NodeEqual_fn nodeEqualFn);
  */
 int List_SetUserLtNodeFunc(List_t list, List_UserLtNode_fn userLtNodeFn);
 
+/**
+ * @brief Set the hash functions to a list, then the list keeps a hash index of its nodes, and
+ * List_GetData, List_DataExists, List_GetMachCount, List_GetFirstMatchNode, List_DetachData, List_DetachNodeByKey,
+ * List_RmFirstMatchNode, List_InsertDataUni, List_InsertNodeUni and so on will be expected O(1) instead of O(n).
+ * The hash functions must agree with the equal functions: if equal2KeywordFn(p_nodeData, p_keyword) is true,
+ * nodeHashFn(p_nodeData) must be equal to keywordHashFn(p_keyword); if nodeEqualFn(p_first, p_second) is true,
+ * nodeHashFn(p_first) must be equal to nodeHashFn(p_second).
+ * The node data must not be changed in the way that changes its hash value while the node is in the list.
+ * If several nodes match a keyword, the first one is found by scanning the list, unless the list has the
+ * position index.
+ * @param nodeHashFn: Hash function for the node data, NULL means removing the hash index.
+ * @param keywordHashFn: Hash function for the keyword, NULL means the keyword has the same type with the node
+ * data, nodeHashFn will be used for it.
+ * @return Error code.
+ *   @retval ERR_OK: Success
+ *   @retval ERR_BAD_PARAM:Param list is NULL.
+ *   @retval ERR_OUT_MEM:Not enough memory for the hash index.
+ */
+int List_SetHashFunc(List_t list, List_DataHash_fn nodeHashFn, List_DataHash_fn keywordHashFn);
+
+/**
+ * @brief Describe the key field of the node data, then the list compares and hashes the key field by itself:
+ * the keyword functions match the key field with the keyword, the unique inserts compare the key fields, and
+ * the ordered inserts, the sorted list and List_Sort without ltFn take the smaller key as the less data.
+ * The key field of a sorted list can only be changed when the list is empty.
+ * The integers are compared by value, LIST_KEY_BYTES by memcmp, LIST_KEY_CSTRING by strncmp on at most length
+ * bytes, and the hash index hashes the key field instead of calling the hash functions.
+ * The equal, less than and hash functions are only used when the key field is not set.
+ * @param offset: Offset of the key field in the node data.
+ * @param length: Length of the key field, it must be 4 for LIST_KEY_INT32 and 8 for LIST_KEY_INT64 and LIST_KEY_UINT64.
+ * @param keyKind: LIST_KEY_NONE means removing the key field.
+ * @return Error code.
+ *   @retval ERR_OK: Success
+ *   @retval ERR_BAD_PARAM:Param list is NULL, or the key field doesn't fit the kind or the data.
+ *   @retval ERR_OUT_MEM:Not enough memory to rebuild the hash index.
+ */
+int List_SetKeyField(List_t list, size_t offset, size_t length, ListKeyKind_e keyKind);
+
+/**
+ * @brief Keep the keys of a value-copy list in a column, then List_GetData, List_DataExists, List_GetMachCount,
+ * List_GetFirstMatchNode, List_DetachData, List_DetachNodeByKey and List_RmFirstMatchNode compare the keys with
+ * SIMD instructions instead of calling equal2KeywordFn for every node.
+ * The key is the first keyLength bytes of the node data, it's compared as a 32/64 bits integer, so p_keyword of
+ * these functions must point to a key, and the key of the node data must not be changed while the node is in the list.
+ * equal2KeywordFn must still be set, the other keyword functions use it. The hash index is used first if the list has both.
+ * It can't be used by the reference list, the unrolled list and the LIST_LOCK_RCU list.
+ * @param keyLength: 4 or 8, 0 means removing the key column.
+ * @return Error code.
+ *   @retval ERR_OK: Success
+ *   @retval ERR_BAD_PARAM:Param list is NULL, keyLength is wrong or the list can't use the key column.
+ *   @retval ERR_OUT_MEM:Not enough memory for the key column.
+ */
+int List_SetKeyColumn(List_t list, int keyLength);
+
+/**
+ * @brief A general hash function on the bytes of data(FNV-1a), it can be used in the List_DataHash_fn.
+ */
+unsigned long List_HashBytes(const void* p_data, size_t length);
+
 const char*   List_Name(List_t list);
+
+/**
+ * @brief Get the node count without locking the list, so it can be polled often without blocking the writers.
+ */
 CdataCount_t  List_Count(List_t list);
 
+/**
+ * @brief Get the counters of the list without locking it. Each counter is read atomically, but they may
+ * be taken at slightly different moments if the list is being changed.
+ */
+int List_GetStats(List_t list, ListStats_t* p_stats);
+
 /**
  * @brief If you want to call NL functions in multi-thread, you need lock and unlock the
  * list with List_Lock and List_UnLock manually.
@@ -276,6 +555,18 @@ void List_Lock(List_t list);
 
 void List_UnLock(List_t list);
 
+/**
+ * @brief Lock the list in shared mode if it's created with LIST_LOCK_RW, enter a lock-free read section
+ * if it's created with LIST_LOCK_RCU, or else it's the same as List_Lock.
+ * Only the NL functions which don't change the list can be called before List_ReadUnLock.
+ */
+void List_ReadLock(List_t list);
+
+/**
+ * @brief Release what List_ReadLock has taken. The read locks of different lists must be released in reverse order.
+ */
+void List_ReadUnLock(List_t list);
+
 /**
  * @brief Visit each node and node data of a list, from head to tail. p_userData will be
  * passed to traverseFn as its parameter p_userData.
@@ -326,6 +617,8 @@ ListNode_t List_InsertData2Head(List_t list, void* p_data);
  *  For p_data == p_nodeData, if you want p_data to be inserted after p_nodeData, you 
  *  need make p_data < p_nodeData return true in List_UserLtNode_fn; if you want p_data 
  *  to be inserted before p_nodeData, just make p_data <= p_nodeData return true.
+ *  The place is searched from the tail and the last ordered insert, so nearly sorted data are inserted
+ *  in O(1) each, the list must be kept in order by the ordered inserts only.
  */
 ListNode_t List_InsertDataAsc(List_t list, void* p_data);
 
@@ -378,6 +671,32 @@ ListNode_t List_InsertDataAfterNL(List_t list, void* p_keyword, void *p_data);
  */
 ListNode_t List_InsertDataAtPos(List_t list, void* p_data, CdataIndex_t posIndex);
 
+/**
+ * @brief Insert count data to the list tail in one go, the result is the same as calling List_InsertData
+ * for each of them, but all the nodes are created before the list is locked, and the list is locked only once.
+ * If the list has a node pool, the nodes are taken from one chunk.
+ * @param p_dataArray: For the value copy list, it's an array of count data, each one has dataLength bytes.
+ * For the reference list, it's an array of count data pointers.
+ * @return The number of the inserted data, 0 if the nodes can't be created.
+ */
+CdataCount_t List_InsertDataBatch(List_t list, void* p_dataArray, CdataCount_t count);
+
+/**
+ * @brief Insert the data to the list head one by one as List_InsertData2Head does, so the last one becomes the head.
+ */
+CdataCount_t List_InsertDataBatch2Head(List_t list, void* p_dataArray, CdataCount_t count);
+
+/**
+ * @brief Insert the data as List_InsertDataAsc does.
+ */
+CdataCount_t List_InsertDataBatchAsc(List_t list, void* p_dataArray, CdataCount_t count);
+
+/**
+ * @brief Insert the data as List_InsertDataUni does, the data equal to the one in the list or before it in
+ * p_dataArray are skipped.
+ */
+CdataCount_t List_InsertDataBatchUni(List_t list, void* p_dataArray, CdataCount_t count);
+
 /**
  * @brief Check if there is data equal to p_keyword, needs  List_Equal2Keyword_fn.
  */
@@ -432,6 +751,14 @@ void* List_DetachDataByCond(List_t list, void* p_userData, List_Condition_fn con
 void* List_DetachHeadData(List_t list);
 
 void* List_DetachTailData(List_t list);
+
+/**
+ * @brief Detach up to max data from the head with one lock, and destroy their nodes.
+ * @param p_dataArray: For the value copy list, it's a buffer of max * dataLength bytes, the data are copied
+ * into it. For the reference list, it's an array of max pointers which receives the data, user should free them.
+ * @return The number of the detached data.
+ */
+CdataCount_t List_DetachHeadBatch(List_t list, CdataCount_t max, void* p_dataArray);
 void* List_DetachDataAtPos(List_t list, CdataIndex_t posIndex);
 
 /**
@@ -446,6 +773,11 @@ int List_RmNodeAtPos(List_t list, CdataIndex_t posIndex);
 int List_RmFirstMatchNode(List_t list, void* p_keyword);
 int List_RmFirstMatchNodeByCond(List_t list, void* p_userData, List_Condition_fn conditionFn);
 
+/**
+ * @brief Remove all the matched nodes in one pass, the nodes are unlinked with the list locked and
+ * destroyed after the list is unlocked.
+ * @return The count of removed nodes.
+ */
 CdataCount_t List_RmAllMatchNodes(List_t list, void* p_keyword);
 CdataCount_t List_RmAllMatchNodesByCond(List_t list, void* p_userData, List_Condition_fn conditionFn);
 
@@ -512,7 +844,9 @@ void*      List_GetNodeDataNL(List_t list, ListNode_t node);
 
 /**
  * @brief Detach the data from node, and return the data to user.Then there
- * is nothing in the node.
+ * is nothing in the node.If the data is stored in the same memory with the node(e.g. the list
+ * uses node pool), a copy of the data allocated by malloc is returned, user should free it.
+ * The data of intrusive list can't leave its link, NULL is returned for it.
  */
 void*      List_DetachNodeData(List_t list, ListNode_t node);
 
@@ -551,19 +885,56 @@ ListNode_t List_GetLastMatchNodeByCond(List_t list, void* p_userData, List_Condi
  */
 ListNode_t List_GetPreMatchNodeByCond(List_t list, ListNode_t startNode, void* p_userData, List_Condition_fn conditionFn);
 
+/**
+ * @brief Only for the list created with a sortOrder, see ListAttr_t. p_data is compared with the node data
+ * by List_UserLtNode_fn, so it must be the same type as the node data and List_UserLtNode_fn must be a
+ * strict less than.Visiting from List_GetLowerBoundNode(list, p_low) to List_GetUpperBoundNode(list, p_high)
+ * by List_GetNextNode gives all the nodes in the range [p_low, p_high].
+ * @return The first node which is not before p_data in the list order, NULL if there is no such node.
+ */
+ListNode_t List_GetLowerBoundNode(List_t list, void* p_data);
+
+/**
+ * @brief Only for the list created with a sortOrder.
+ * @return The first node which is after p_data in the list order, NULL if there is no such node.
+ */
+ListNode_t List_GetUpperBoundNode(List_t list, void* p_data);
+
+/**
+ * @brief Only for the list created with a sortOrder.
+ * @return The first node which is equal to p_data in the list order, NULL if there is no such node.
+ */
+ListNode_t List_GetFirstOrderedMatchNode(List_t list, void* p_data);
+
 /**
  * @brief Swap the data between firstNode and secondNode.
+ * @return ERR_BAD_PARAM for intrusive list, its data can't leave the link embedded in it.
  */
 int List_Swap(List_t list, ListNode_t firstNode, ListNode_t secondNode);
 
+/**
+ * @brief Sort the list in ascending order by relinking the nodes, it's a stable merge sort which is
+ * O(nlogn) and allocates nothing.
+ * @param ltFn: The same as List_UserLtNode_fn, NULL means using the one set by List_SetUserLtNodeFunc.
+ * @return ERR_BAD_PARAM if there is no ltFn, or the list is created with sortOrder or LIST_LOCK_RCU.
+ */
+int List_Sort(List_t list, List_UserLtNode_fn ltFn);
+
 /**
  * @brief Detach node from the list, so the node will not belong to the list any longer.
  * The time is O(n) if the list is LIST_TYPE_SINGLE_LINK, for the LIST_TYPE_DOUBLE_LINK
- * it is O(1).
+ * it is O(1). Use List_DetachNextNode or List_IterDetachNL if the pre node is known.
  */
 int List_DetachNode(List_t list, ListNode_t node);
 int List_DetachNodeNL(List_t list, ListNode_t node);
 
+/**
+ * @brief Get the node of the data in an intrusive list, it's the link embedded in the data, so
+ * List_DetachNode(list, List_GetNodeOfData(list, p_data)) detaches the data in O(1) for LIST_TYPE_DOUBLE_LINK.
+ * @return NULL if the list is not intrusive.
+ */
+ListNode_t List_GetNodeOfData(List_t list, void* p_data);
+
 /**
  * @brief Detach the head node from list then return it to user.
  */
@@ -576,6 +947,120 @@ ListNode_t List_DetachNodeAtPos(List_t list, CdataIndex_t posIndex);
 ListNode_t List_DetachNodeByKey(List_t list, void* p_keyword);
 ListNode_t List_DetachNodeByCond(List_t list, void* p_userData, List_Condition_fn conditionFn);
 
+/**
+ * @brief Detach the node after preNode, preNode NULL means detaching the head. The time is O(1)
+ * for both LIST_TYPE_SINGLE_LINK and LIST_TYPE_DOUBLE_LINK.
+ * @return The detached node, NULL if there is no node after preNode.
+ */
+ListNode_t List_DetachNextNode(List_t list, ListNode_t preNode);
+ListNode_t List_DetachNextNodeNL(List_t list, ListNode_t preNode);
+
+/**
+ * @brief Detach all the matched nodes in one pass, the detached nodes are linked as a chain in the list
+ * order.Visit the chain by List_GetNextChainNode, then destroy it by List_DestroyNodeChain, or destroy
+ * the nodes one by one.
+ * @param p_count: Output the count of detached nodes, it can be NULL.
+ * @return The first node of the chain, NULL if nothing matches.
+ */
+ListNode_t List_DetachAllMatchNodes(List_t list, void* p_keyword, CdataCount_t* p_count);
+ListNode_t List_DetachAllMatchNodesByCond(List_t list, void* p_userData, List_Condition_fn conditionFn, CdataCount_t* p_count);
+
+/**
+ * @brief Detach up to max nodes from the head with one lock, they are returned as a chain like
+ * List_DetachAllMatchNodes does.
+ */
+ListNode_t List_DetachHeadChain(List_t list, CdataCount_t max, CdataCount_t* p_count);
+
+/**
+ * @brief Get the next node of a chain returned by List_DetachAllMatchNodes, NULL if it's the last one.
+ */
+ListNode_t List_GetNextChainNode(List_t list, ListNode_t node);
+
+/**
+ * @brief Destroy all the nodes of a chain, it doesn't need the list lock.
+ */
+int        List_DestroyNodeChain(List_t list, ListNode_t chain);
+
+/**
+ * @brief Move the nodes from first to last of src behind pos of dst, pos NULL means the head of dst.
+ * The nodes are relinked, nothing is allocated or copied. Both lists are locked in the address order,
+ * so nodes can be moved in the opposite directions at the same time.
+ * The moved nodes are counted, first and pos are searched from the heads to make sure they are in their lists.
+ * @return ERR_BAD_PARAM if dst is src, the lists have different type or data length, or any of them has node
+ * pool, index or LIST_LOCK_RCU. It's the same for List_Concat and List_SplitAt. ERR_BAD_PARAM is also
+ * returned if first is not in src, last is not behind first or pos is not in dst.
+ */
+int List_Splice(List_t dst, ListNode_t pos, List_t src, ListNode_t first, ListNode_t last);
+
+/**
+ * @brief Move all the nodes of src to the tail of dst in O(1).
+ */
+int List_Concat(List_t dst, List_t src);
+
+/**
+ * @brief Move node and all the nodes behind it to the tail of newList. The nodes before it are visited
+ * to make sure it is in list, ERR_BAD_PARAM is returned if it's not.
+ */
+int List_SplitAt(List_t list, ListNode_t node, List_t newList);
+
+/**
+ * @brief Visit the list with a ListIter_t, the list must be locked by List_Lock during the visit:
+ *
+ *  List_Lock(list);
+ *  List_IterInitNL(list, &iter);
+ *  while ((node = List_IterNextNL(list, &iter)) != NULL)
+ *  {
+ *      if (...) List_IterDetachNL(list, &iter);
+ *  }
+ *  List_UnLock(list);
+ */
+int        List_IterInitNL(List_t list, ListIter_t* p_iter);
+
+/**
+ * @brief Move the iterator to the next node.
+ * @return The new current node, NULL if the tail has been passed.
+ */
+ListNode_t List_IterNextNL(List_t list, ListIter_t* p_iter);
+
+/**
+ * @brief Detach the current node in O(1), List_IterNextNL will go on from the node after it, so
+ * the detached node can be destroyed at once.
+ * @return The detached node, NULL if there is no current node.
+ */
+ListNode_t List_IterDetachNL(List_t list, ListIter_t* p_iter);
+
+/**
+ * @brief Open a cursor at the head of the list. The cursor can't be used by LIST_TYPE_UNROLLED, and
+ * it must be closed before the list is destroyed.
+ */
+int List_CursorOpen(List_t list, ListCursor_t* p_cursor);
+int List_CursorClose(ListCursor_t* p_cursor);
+
+/**
+ * @brief Visit at most maxNodes nodes from the cursor with the list locked, then unlock the list,
+ * the next call goes on from where this one stops. The nodes inserted after the cursor are visited,
+ * the ones inserted before it or after it has passed the tail are not. If the list is sorted or spliced between the calls, the cursor
+ * goes on from its node in the new order.
+ * @return ERR_OK if there are nodes left, ERR_DATA_NOT_EXISTS if the cursor has passed the tail.
+ */
+int List_CursorTraverse(ListCursor_t* p_cursor, CdataCount_t maxNodes, void* p_userData, List_Traverse_fn traverseFn);
+
+/**
+ * @brief The same as List_Traverse, but the list is unlocked after every chunkNodes nodes, so the
+ * writers are blocked for one chunk at most. LIST_TYPE_UNROLLED is traversed in one lock hold.
+ */
+int List_TraverseChunked(List_t list, CdataCount_t chunkNodes, void* p_userData, List_Traverse_fn traverseFn);
+
+int List_PosCursorInit(List_t list, ListPosCursor_t* p_cursor);
+
+/**
+ * @brief The same as List_GetNodeAtPos, but the node is walked to from the last position of the cursor
+ * when it's nearer than the head and the tail, so visiting the positions one by one is O(1) each.
+ * Any insert, detach or sort of the list makes the cursor start over from the head or the tail.
+ */
+ListNode_t List_PosCursorGetNodeNL(ListPosCursor_t* p_cursor, CdataIndex_t posIndex);
+void*      List_PosCursorGetData(ListPosCursor_t* p_cursor, CdataIndex_t posIndex);
+
 /**
  * @brief Detach node from the list and destroy it. If there is pointer in the node data, it needs
  * custom List_FreeData_fn.The time is O(n) if the list is LIST_TYPE_SINGLE_LINK, for the LIST_TYPE_DOUBLE_LINK
@@ -6,6 +6,9 @@
 
 typedef void* OSMutex_t;
 typedef void* OSCond_t;
+typedef void* OSRWLock_t;
+typedef void* OSThreadKey_t;
+typedef void* OSThread_t;
 
 #ifdef __cplusplus
 extern "C" {
@@ -13,18 +16,44 @@ extern "C" {
 
 #ifdef _RELEASE_VERSION_
 void *OS_Malloc(size_t size);
+void *OS_Realloc(void* p_mem, size_t size);
 void  OS_Free(void* p_mem);
 #else
 #define OS_Free free
 #define OS_Malloc malloc
+#define OS_Realloc realloc
 #endif
 
+/*The memory is aligned to alignment which must be a power of 2, it's freed by OS_Free.*/
+void *OS_AlignedMalloc(size_t alignment, size_t size);
+
 OSMutex_t OS_MutexCreate();
 void  OS_MutexDestroy(OSMutex_t mutex);
 
 int OS_MutexLock(OSMutex_t mutex);
 int OS_MutexUnlock(OSMutex_t mutex);
 
+OSRWLock_t OS_RWLockCreate();
+void  OS_RWLockDestroy(OSRWLock_t rwLock);
+
+int OS_RWLockReadLock(OSRWLock_t rwLock);
+int OS_RWLockWriteLock(OSRWLock_t rwLock);
+int OS_RWLockUnlock(OSRWLock_t rwLock);
+
+/*The destructor is called with the thread's value when a thread which has set a value exits.*/
+OSThreadKey_t OS_ThreadKeyCreate(void (*destructor)(void* p_value));
+void  OS_ThreadKeyDestroy(OSThreadKey_t key);
+int OS_ThreadKeySet(OSThreadKey_t key, void* p_value);
+
+void OS_YieldThread();
+
+/*The thread must be joined by OS_ThreadJoin, which frees the handle.*/
+OSThread_t OS_ThreadCreate(void* (*threadFn)(void* p_arg), void* p_arg);
+int OS_ThreadJoin(OSThread_t thread);
+
+/*The number of online CPUs, at least 1.*/
+int OS_GetCpuCount();
+
 
 OSCond_t OS_CondCreate();
 int OS_CondDestroy(OSCond_t cond);
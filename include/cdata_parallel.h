@@ -0,0 +1,91 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.6.10
+*/
+
+/*
+ * Parallel algorithms over a big list. The list is walked once to split it into chunks, then the
+ * chunks are run by a small built-in thread pool, and the results of the chunks are merged.
+ * The callbacks are called on several threads at the same time, so they must be thread safe,
+ * and they must not call the functions of the same list, which is locked during the call.
+ * The lists shorter than a few thousand nodes are run on the calling thread only.
+ */
+
+#ifndef _CDATA_PARALLEL_H_
+#define _CDATA_PARALLEL_H_
+
+#include <stddef.h>
+
+#include "cdata_types.h"
+#include "cdata_list.h"
+
+__BEGIN_EXTERN_C_DECL__
+
+typedef void (*List_ForEach_fn)(void* p_nodeData, void* p_userData);
+
+/*Add p_nodeData into p_partial, the partial result of one chunk.*/
+typedef void (*List_Reduce_fn)(void* p_nodeData, void* p_userData, void* p_partial);
+
+/*Add the partial result of one chunk into p_result, the chunks are merged in the list order.*/
+typedef void (*List_Merge_fn)(void* p_result, const void* p_partial, void* p_userData);
+
+/**
+ * @brief Set how many threads the parallel functions use, including the calling thread.
+ * @param threadCount: 0 means the number of CPUs, which is the default.
+ */
+int List_SetParallelThreads(int threadCount);
+int List_GetParallelThreads();
+
+/**
+ * @brief Call forEachFn for each data. The list is locked by List_ReadLock, the data can be
+ * changed in place, but the list can't.
+ */
+int List_ParallelForEach(List_t list, void* p_userData, List_ForEach_fn forEachFn);
+
+/**
+ * @brief The same as List_GetMachCountByCond.
+ */
+CdataCount_t List_ParallelCountIf(List_t list, void* p_userData, List_Condition_fn conditionFn);
+
+/**
+ * @brief Reduce the list into p_result.
+ * @param p_result: It must hold the identity value on input, e.g. 0 for sum. Each chunk starts its
+ *  partial result with a copy of it, then the partial results are merged into it by mergeFn.
+ * @param resultSize: The size of the result, e.g. sizeof(long).
+ */
+int List_ParallelReduce(List_t list, void* p_userData, List_Reduce_fn reduceFn, List_Merge_fn mergeFn,
+                        void* p_result, size_t resultSize);
+
+/**
+ * @brief The same as List_RmAllMatchNodesByCond, conditionFn is run in parallel with the list locked,
+ * then the matched nodes are detached on the calling thread and destroyed after the list is unlocked.
+ * The unrolled list is removed by List_RmAllMatchNodesByCond.
+ */
+CdataCount_t List_ParallelRemoveIf(List_t list, void* p_userData, List_Condition_fn conditionFn);
+
+__END_EXTERN_C_DECL__
+
+#endif //_CDATA_PARALLEL_H_
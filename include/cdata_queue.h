@@ -102,6 +102,8 @@ CdataCount_t Queue_Count(Queue_t queue);
  * @brief If the data contains pointer, and when destroy the queue data in Queue_Pop, user must
  * provide a QueueFreeData_fn to free the queue data, because Queue cannot know how to free the 
  * pointer in the queue data.
+ * Set it before pushing any data, the data pushed before it is set is stored in the node memory, then
+ * freeFn must only free what the data points to, see List_SetFreeDataFunc.
  * For example:
    @code
    typedef struct bar
@@ -132,6 +134,13 @@ int Queue_Push2Head(Queue_t queue, void *p_data);
 int  Queue_GetHead(Queue_t queue, void* p_headData);
 int  Queue_Pop(Queue_t queue);
 
+/**
+ * @brief Pop up to max data from the head with one lock. Each data is copied by QueueValueCp_fn
+ * to p_dataArray + i * dataSize, then it's freed as Queue_Pop does.
+ * @return The number of the popped data.
+ */
+CdataCount_t Queue_PopBatch(Queue_t queue, void* p_dataArray, size_t dataSize, CdataCount_t max);
+
 /**
  * @brief Wait for the data ready, if queue is empty it will be blocked, until someone
  * push a data.
@@ -149,6 +158,12 @@ int Queue_TimedWaitDataReady(Queue_t queue, CdataTime_t timeOutMs);
 
 int Queue_Traverse(Queue_t queue, void*p_userData, QueueTraverse_fn traverseFn);
 
+/**
+ * @brief The same as Queue_Traverse, but the queue is unlocked after every chunkNodes data, so
+ * Queue_Push and Queue_Pop are not blocked by a long traverse.
+ */
+int Queue_TraverseChunked(Queue_t queue, CdataCount_t chunkNodes, void*p_userData, QueueTraverse_fn traverseFn);
+
 /**
  * @brief Clear all the data in the queue, the queue can be used still.If there is pointer in the
  * queue data, it needs to call Queue_SetFreeFunc to set a custom free function after creating a queue.
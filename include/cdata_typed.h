@@ -0,0 +1,541 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.5.24
+*/
+
+/*
+ * Typed containers: the macros below generate a list, a queue and a priority queue for one data type.
+ * The data is stored in the node or the array as T, copied by assignment and compared by the cmp
+ * expression, all the functions are static inline, so the compiler can inline the compare and the
+ * copy into the loops. There is no lock in them, user must lock them if they are shared by threads.
+ *
+ * cmp(p_first, p_second) gets two const T* and returns less than, equal to, or greater than 0 as memcmp.
+ * For example:
+ * @code
+   typedef struct
+   {
+       int  key;
+       char name[16];
+   }Student_t;
+
+   #define StudentCmp(_first_, _second_) CDATA_CMP_VALUE((_first_)->key, (_second_)->key)
+
+   CDATA_DEFINE_LIST(StudentList, Student_t, StudentCmp)
+
+   StudentList_t list;
+   Student_t     student = {1, "Tom"};
+
+   StudentList_Init(&list);
+   StudentList_InsertDataAsc(&list, student);
+   StudentList_Clear(&list);
+ * @endcode
+ */
+
+#ifndef _CDATA_TYPED_H_
+#define _CDATA_TYPED_H_
+
+#include <stddef.h>
+#include <string.h>
+
+#include "cdata_types.h"
+#include "cdata_os_adapter.h"
+
+//Compare two values of the same arithmetic type without branch.
+#define CDATA_CMP_VALUE(_first_, _second_) (((_first_) > (_second_)) - ((_first_) < (_second_)))
+
+#define CDATA_CMP_NUM(_p_first_, _p_second_) CDATA_CMP_VALUE(*(_p_first_), *(_p_second_))
+
+#define CDATA_TYPED_MIN_CAPACITY 16
+
+/*
+ * List of T: a double link list, the freed nodes are kept for the next inserts until the list is cleared.
+ *   name##_InsertData, name##_InsertData2Head and name##_InsertDataAsc return the new node, NULL if out of memory.
+ *   name##_InsertDataAsc inserts the data behind the equal data.
+ *   name##_GetFirstMatchNode, name##_DataExists and name##_GetMachCount find the data whose cmp with key is 0.
+ *   name##_DetachHeadData copies the head data out and removes the head node.
+ */
+#define CDATA_DEFINE_LIST(name, T, cmp) \
+typedef struct name##Node_s \
+{ \
+    struct name##Node_s* p_next; \
+    struct name##Node_s* p_pre; \
+    T                    data; \
+}name##Node_t; \
+\
+typedef struct \
+{ \
+    name##Node_t* p_head; \
+    name##Node_t* p_tail; \
+    name##Node_t* p_freeNodes; \
+    CdataCount_t  count; \
+}name##_t; \
+\
+static inline void name##_Init(name##_t* p_list) \
+{ \
+    memset(p_list, 0, sizeof(name##_t)); \
+} \
+\
+static inline void name##_Clear(name##_t* p_list) \
+{ \
+    name##Node_t* p_node = NULL; \
+    \
+    while (p_list->p_head != NULL) \
+    { \
+        p_node = p_list->p_head; \
+        p_list->p_head = p_node->p_next; \
+        OS_Free(p_node); \
+    } \
+    while (p_list->p_freeNodes != NULL) \
+    { \
+        p_node = p_list->p_freeNodes; \
+        p_list->p_freeNodes = p_node->p_next; \
+        OS_Free(p_node); \
+    } \
+    memset(p_list, 0, sizeof(name##_t)); \
+} \
+\
+static inline CdataCount_t name##_Count(const name##_t* p_list) \
+{ \
+    return p_list->count; \
+} \
+\
+static inline name##Node_t* name##_GetHead(const name##_t* p_list) \
+{ \
+    return p_list->p_head; \
+} \
+\
+static inline name##Node_t* name##_GetTail(const name##_t* p_list) \
+{ \
+    return p_list->p_tail; \
+} \
+\
+static inline name##Node_t* name##_GetNextNode(const name##Node_t* p_node) \
+{ \
+    return p_node->p_next; \
+} \
+\
+static inline name##Node_t* name##_GetPreNode(const name##Node_t* p_node) \
+{ \
+    return p_node->p_pre; \
+} \
+\
+static inline T* name##_GetNodeData(name##Node_t* p_node) \
+{ \
+    return &p_node->data; \
+} \
+\
+static inline name##Node_t* name##_NewNode(name##_t* p_list, const T* p_data) \
+{ \
+    name##Node_t* p_node = p_list->p_freeNodes; \
+    \
+    if (p_node != NULL) \
+    { \
+        p_list->p_freeNodes = p_node->p_next; \
+    } \
+    else \
+    { \
+        p_node = (name##Node_t*)OS_Malloc(sizeof(name##Node_t)); \
+        if (p_node == NULL) \
+        { \
+            return NULL; \
+        } \
+    } \
+    p_node->data = *p_data; \
+    return p_node; \
+} \
+\
+/*Link p_node before p_next, NULL p_next means the tail.*/ \
+static inline void name##_LinkBefore(name##_t* p_list, name##Node_t* p_node, name##Node_t* p_next) \
+{ \
+    p_node->p_next = p_next; \
+    p_node->p_pre  = (p_next != NULL) ? p_next->p_pre : p_list->p_tail; \
+    if (p_node->p_pre != NULL) \
+    { \
+        p_node->p_pre->p_next = p_node; \
+    } \
+    else \
+    { \
+        p_list->p_head = p_node; \
+    } \
+    if (p_next != NULL) \
+    { \
+        p_next->p_pre = p_node; \
+    } \
+    else \
+    { \
+        p_list->p_tail = p_node; \
+    } \
+    p_list->count++; \
+} \
+\
+static inline name##Node_t* name##_InsertData(name##_t* p_list, T data) \
+{ \
+    name##Node_t* p_node = name##_NewNode(p_list, &data); \
+    \
+    if (p_node != NULL) \
+    { \
+        name##_LinkBefore(p_list, p_node, NULL); \
+    } \
+    return p_node; \
+} \
+\
+static inline name##Node_t* name##_InsertData2Head(name##_t* p_list, T data) \
+{ \
+    name##Node_t* p_node = name##_NewNode(p_list, &data); \
+    \
+    if (p_node != NULL) \
+    { \
+        name##_LinkBefore(p_list, p_node, p_list->p_head); \
+    } \
+    return p_node; \
+} \
+\
+static inline name##Node_t* name##_InsertDataAsc(name##_t* p_list, T data) \
+{ \
+    name##Node_t* p_next = p_list->p_head; \
+    name##Node_t* p_node = NULL; \
+    \
+    while (p_next != NULL && cmp(&p_next->data, &data) <= 0) \
+    { \
+        p_next = p_next->p_next; \
+    } \
+    p_node = name##_NewNode(p_list, &data); \
+    if (p_node != NULL) \
+    { \
+        name##_LinkBefore(p_list, p_node, p_next); \
+    } \
+    return p_node; \
+} \
+\
+static inline void name##_RmNode(name##_t* p_list, name##Node_t* p_node) \
+{ \
+    if (p_node->p_pre != NULL) \
+    { \
+        p_node->p_pre->p_next = p_node->p_next; \
+    } \
+    else \
+    { \
+        p_list->p_head = p_node->p_next; \
+    } \
+    if (p_node->p_next != NULL) \
+    { \
+        p_node->p_next->p_pre = p_node->p_pre; \
+    } \
+    else \
+    { \
+        p_list->p_tail = p_node->p_pre; \
+    } \
+    p_list->count--; \
+    p_node->p_next = p_list->p_freeNodes; \
+    p_list->p_freeNodes = p_node; \
+} \
+\
+static inline int name##_DetachHeadData(name##_t* p_list, T* p_data) \
+{ \
+    if (p_list->p_head == NULL) \
+    { \
+        return ERR_DATA_NOT_EXISTS; \
+    } \
+    *p_data = p_list->p_head->data; \
+    name##_RmNode(p_list, p_list->p_head); \
+    return ERR_OK; \
+} \
+\
+static inline name##Node_t* name##_GetFirstMatchNode(const name##_t* p_list, T key) \
+{ \
+    name##Node_t* p_node = p_list->p_head; \
+    \
+    while (p_node != NULL && cmp(&p_node->data, &key) != 0) \
+    { \
+        p_node = p_node->p_next; \
+    } \
+    return p_node; \
+} \
+\
+static inline CdataBool name##_DataExists(const name##_t* p_list, T key) \
+{ \
+    return name##_GetFirstMatchNode(p_list, key) != NULL; \
+} \
+\
+static inline CdataCount_t name##_GetMachCount(const name##_t* p_list, T key) \
+{ \
+    name##Node_t* p_node = NULL; \
+    CdataCount_t  count  = 0; \
+    \
+    for (p_node = p_list->p_head; p_node != NULL; p_node = p_node->p_next) \
+    { \
+        count += (cmp(&p_node->data, &key) == 0); \
+    } \
+    return count; \
+}
+
+/*
+ * Queue of T: a ring buffer which doubles when it is full.
+ *   name##_Push and name##_Push2Head return ERR_OUT_MEM if the buffer can't grow.
+ *   name##_GetHead copies the head data out, name##_Pop removes the head data and copies it out if p_data is not NULL.
+ */
+#define CDATA_DEFINE_QUEUE(name, T) \
+typedef struct \
+{ \
+    T*           p_array; \
+    CdataCount_t capacity; \
+    CdataCount_t head; \
+    CdataCount_t count; \
+}name##_t; \
+\
+static inline void name##_Init(name##_t* p_queue) \
+{ \
+    memset(p_queue, 0, sizeof(name##_t)); \
+} \
+\
+static inline void name##_Clear(name##_t* p_queue) \
+{ \
+    if (p_queue->p_array != NULL) \
+    { \
+        OS_Free(p_queue->p_array); \
+    } \
+    memset(p_queue, 0, sizeof(name##_t)); \
+} \
+\
+static inline CdataCount_t name##_Count(const name##_t* p_queue) \
+{ \
+    return p_queue->count; \
+} \
+\
+/*The data are moved to the begin of the new buffer, so they are not wrapped.*/ \
+static inline int name##_Grow(name##_t* p_queue) \
+{ \
+    CdataCount_t capacity = (p_queue->capacity == 0) ? CDATA_TYPED_MIN_CAPACITY : p_queue->capacity * 2; \
+    CdataCount_t first    = p_queue->capacity - p_queue->head; \
+    T*           p_array  = (T*)OS_Malloc(sizeof(T) * capacity); \
+    \
+    if (p_array == NULL) \
+    { \
+        return ERR_OUT_MEM; \
+    } \
+    if (p_queue->count > 0) \
+    { \
+        first = (first < p_queue->count) ? first : p_queue->count; \
+        memcpy(p_array, p_queue->p_array + p_queue->head, sizeof(T) * first); \
+        memcpy(p_array + first, p_queue->p_array, sizeof(T) * (p_queue->count - first)); \
+    } \
+    if (p_queue->p_array != NULL) \
+    { \
+        OS_Free(p_queue->p_array); \
+    } \
+    p_queue->p_array  = p_array; \
+    p_queue->capacity = capacity; \
+    p_queue->head     = 0; \
+    return ERR_OK; \
+} \
+\
+static inline int name##_Push(name##_t* p_queue, T data) \
+{ \
+    CdataCount_t tail = 0; \
+    \
+    if (p_queue->count == p_queue->capacity && name##_Grow(p_queue) != ERR_OK) \
+    { \
+        return ERR_OUT_MEM; \
+    } \
+    tail = p_queue->head + p_queue->count; \
+    tail = (tail >= p_queue->capacity) ? tail - p_queue->capacity : tail; \
+    p_queue->p_array[tail] = data; \
+    p_queue->count++; \
+    return ERR_OK; \
+} \
+\
+static inline int name##_Push2Head(name##_t* p_queue, T data) \
+{ \
+    if (p_queue->count == p_queue->capacity && name##_Grow(p_queue) != ERR_OK) \
+    { \
+        return ERR_OUT_MEM; \
+    } \
+    p_queue->head = (p_queue->head == 0) ? p_queue->capacity - 1 : p_queue->head - 1; \
+    p_queue->p_array[p_queue->head] = data; \
+    p_queue->count++; \
+    return ERR_OK; \
+} \
+\
+static inline int name##_GetHead(const name##_t* p_queue, T* p_data) \
+{ \
+    if (p_queue->count == 0) \
+    { \
+        return ERR_DATA_NOT_EXISTS; \
+    } \
+    *p_data = p_queue->p_array[p_queue->head]; \
+    return ERR_OK; \
+} \
+\
+static inline int name##_Pop(name##_t* p_queue, T* p_data) \
+{ \
+    if (p_queue->count == 0) \
+    { \
+        return ERR_DATA_NOT_EXISTS; \
+    } \
+    if (p_data != NULL) \
+    { \
+        *p_data = p_queue->p_array[p_queue->head]; \
+    } \
+    p_queue->head = (p_queue->head + 1 == p_queue->capacity) ? 0 : p_queue->head + 1; \
+    p_queue->count--; \
+    return ERR_OK; \
+}
+
+/*
+ * Priority queue of T: a binary heap in an array, the data which cmp takes as greater is in front,
+ * and the data which are equal are popped in the order they are pushed, the same as PriQueue.
+ *   name##_GetHead copies the head data out, name##_Pop removes the head data and copies it out if p_data is not NULL.
+ */
+#define CDATA_DEFINE_PRIQUEUE(name, T, cmp) \
+typedef struct \
+{ \
+    T            data; \
+    CdataCount_t seq; \
+}name##Entry_t; \
+\
+typedef struct \
+{ \
+    name##Entry_t* p_heap; \
+    CdataCount_t   capacity; \
+    CdataCount_t   count; \
+    CdataCount_t   pushedTotal; \
+}name##_t; \
+\
+static inline void name##_Init(name##_t* p_queue) \
+{ \
+    memset(p_queue, 0, sizeof(name##_t)); \
+} \
+\
+static inline void name##_Clear(name##_t* p_queue) \
+{ \
+    if (p_queue->p_heap != NULL) \
+    { \
+        OS_Free(p_queue->p_heap); \
+    } \
+    memset(p_queue, 0, sizeof(name##_t)); \
+} \
+\
+static inline CdataCount_t name##_Count(const name##_t* p_queue) \
+{ \
+    return p_queue->count; \
+} \
+\
+/*Tell if the first entry goes before the second one.*/ \
+static inline CdataBool name##_IsBefore(const name##Entry_t* p_first, const name##Entry_t* p_second) \
+{ \
+    int result = cmp(&p_first->data, &p_second->data); \
+    \
+    return (result > 0) || (result == 0 && p_first->seq < p_second->seq); \
+} \
+\
+static inline int name##_Push(name##_t* p_queue, T data) \
+{ \
+    name##Entry_t* p_heap   = NULL; \
+    name##Entry_t  entry; \
+    CdataCount_t   capacity = 0; \
+    CdataCount_t   index    = p_queue->count; \
+    CdataCount_t   parent   = 0; \
+    \
+    if (p_queue->count == p_queue->capacity) \
+    { \
+        capacity = (p_queue->capacity == 0) ? CDATA_TYPED_MIN_CAPACITY : p_queue->capacity * 2; \
+        p_heap = (name##Entry_t*)OS_Malloc(sizeof(name##Entry_t) * capacity); \
+        if (p_heap == NULL) \
+        { \
+            return ERR_OUT_MEM; \
+        } \
+        if (p_queue->p_heap != NULL) \
+        { \
+            memcpy(p_heap, p_queue->p_heap, sizeof(name##Entry_t) * p_queue->count); \
+            OS_Free(p_queue->p_heap); \
+        } \
+        p_queue->p_heap   = p_heap; \
+        p_queue->capacity = capacity; \
+    } \
+    \
+    entry.data = data; \
+    entry.seq  = p_queue->pushedTotal++; \
+    while (index > 0) \
+    { \
+        parent = (index - 1) / 2; \
+        if (!name##_IsBefore(&entry, &p_queue->p_heap[parent])) \
+        { \
+            break; \
+        } \
+        p_queue->p_heap[index] = p_queue->p_heap[parent]; \
+        index = parent; \
+    } \
+    p_queue->p_heap[index] = entry; \
+    p_queue->count++; \
+    return ERR_OK; \
+} \
+\
+static inline int name##_GetHead(const name##_t* p_queue, T* p_data) \
+{ \
+    if (p_queue->count == 0) \
+    { \
+        return ERR_DATA_NOT_EXISTS; \
+    } \
+    *p_data = p_queue->p_heap[0].data; \
+    return ERR_OK; \
+} \
+\
+static inline int name##_Pop(name##_t* p_queue, T* p_data) \
+{ \
+    name##Entry_t* p_last = NULL; \
+    CdataCount_t   index  = 0; \
+    CdataCount_t   child  = 0; \
+    \
+    if (p_queue->count == 0) \
+    { \
+        return ERR_DATA_NOT_EXISTS; \
+    } \
+    if (p_data != NULL) \
+    { \
+        *p_data = p_queue->p_heap[0].data; \
+    } \
+    \
+    /*Sift the last entry down from the root.*/ \
+    p_queue->count--; \
+    p_last = &p_queue->p_heap[p_queue->count]; \
+    while ((child = index * 2 + 1) < p_queue->count) \
+    { \
+        if (child + 1 < p_queue->count && name##_IsBefore(&p_queue->p_heap[child + 1], &p_queue->p_heap[child])) \
+        { \
+            child++; \
+        } \
+        if (!name##_IsBefore(&p_queue->p_heap[child], p_last)) \
+        { \
+            break; \
+        } \
+        p_queue->p_heap[index] = p_queue->p_heap[child]; \
+        index = child; \
+    } \
+    p_queue->p_heap[index] = *p_last; \
+    return ERR_OK; \
+}
+
+#endif //_CDATA_TYPED_H_
@@ -61,4 +61,7 @@ typedef char  ListName_t[256];
 typedef void* Queue_t;
 typedef char  QueueName_t[256];
 
+typedef void* Vector_t;
+typedef char  VectorName_t[256];
+
 #endif //_CDATA_TYPES_H_
\ No newline at end of file
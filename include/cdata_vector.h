@@ -0,0 +1,119 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.5.20
+*/
+
+/*
+ * Vector: a container which stores the data in one contiguous array, so getting the data at any
+ * position is O(1), and scanning it goes through memory one element after another.
+ * It suits the data which are mostly appended and scanned, and never need a node handle.
+ * The array grows geometrically, Vector_Reserve can allocate it once for a known count.
+ * It uses the same callback types as cdata_list, so a list which never uses its nodes can be
+ * changed to a vector easily.
+ * Same as cdata_list, all the functions take the vector lock, and the data can be stored as value
+ * copy(Vector_Create) or value reference(Vector_CreateRef).
+ */
+
+#ifndef _CDATA_VECTOR_H_
+#define _CDATA_VECTOR_H_
+
+#include "cdata_types.h"
+#include "cdata_list.h"
+
+__BEGIN_EXTERN_C_DECL__
+
+/**
+ * @brief Create a new vector which will store the data as value copy model.
+ * @param dataLength: The length of each data, for example, sizeof(int) for int data.
+ */
+int          Vector_Create(VectorName_t name, int dataLength, Vector_t* p_vector);
+
+/**
+ * @brief Create a new vector which will store the pointer of the data. The data are freed by
+ * the function set by Vector_SetFreeDataFunc, or by free if there is no such function.
+ */
+int          Vector_CreateRef(VectorName_t name, Vector_t* p_vector);
+
+int          Vector_SetFreeDataFunc(Vector_t vector, List_FreeData_fn freeFn);
+
+/**
+ * @brief Make the vector hold at least capacity data without growing the array again.
+ */
+int          Vector_Reserve(Vector_t vector, CdataCount_t capacity);
+
+const char*  Vector_Name(Vector_t vector);
+CdataCount_t Vector_Count(Vector_t vector);
+CdataCount_t Vector_Capacity(Vector_t vector);
+
+void         Vector_Lock(Vector_t vector);
+void         Vector_UnLock(Vector_t vector);
+
+int          Vector_Push(Vector_t vector, void* p_data);
+
+/**
+ * @brief Take the last data out of the vector.
+ * @param p_data: The value copy data is copied to it, the pointer of the value reference data is
+ *  stored to it as (void*). If it's NULL, the data is freed.
+ * @return ERR_DATA_NOT_EXISTS if the vector is empty.
+ */
+int          Vector_Pop(Vector_t vector, void* p_data);
+
+/**
+ * @brief Insert the data before the data at index, index can be Vector_Count to append it.
+ */
+int          Vector_InsertAt(Vector_t vector, CdataIndex_t index, void* p_data);
+int          Vector_RmAt(Vector_t vector, CdataIndex_t index);
+
+/**
+ * @brief Get the data at index, NULL if index is out of range.
+ * The data of value copy vector lives in the array, the pointer is valid until the vector is changed,
+ * so hold Vector_Lock while using it if other threads may change the vector.
+ */
+void*        Vector_GetAt(Vector_t vector, CdataIndex_t index);
+
+/**
+ * @brief Remove and free all the data which satisfy conditionFn, the others keep their order.
+ * @return The count of the removed data.
+ */
+CdataCount_t Vector_RmByCond(Vector_t vector, void* p_userData, List_Condition_fn conditionFn);
+
+/**
+ * @brief Visit the data from the first one, the node of ListTraverseNodeInfo_t is always NULL.
+ */
+int          Vector_Traverse(Vector_t vector, void* p_userData, List_Traverse_fn traverseFn);
+
+/**
+ * @brief Sort the data in the order ltFn defines with a stable merge sort, the data which are equal
+ * keep their order.
+ */
+int          Vector_Sort(Vector_t vector, List_UserLtNode_fn ltFn);
+
+int          Vector_Clear(Vector_t vector);
+int          Vector_Destroy(Vector_t vector);
+
+__END_EXTERN_C_DECL__
+
+#endif //_CDATA_VECTOR_H_
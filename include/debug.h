@@ -21,34 +21,34 @@
 #define DBG_PosInfo() fprintf(stdout, "\n==>[%s %d %s()]", _SHORT_FILE_NAME_, __LINE__, __FUNCTION__)
 #define DBG_Log_Print(fmt,args...) fprintf(stdout,fmt,##args)
 
-#define LOG_A(fmt,args...) do{DBG_PosInfo();DBG_Log_Print(" "fmt,##args);}while(0)
+#define LOG_A(fmt,args...) do{DBG_PosInfo();DBG_Log_Print(" " fmt,##args);}while(0)
 
 #if _DEBUG_LEVEL_ <= _DEBUG_LEVEL_V_ && !_RELEASE_VERSION_
-#   define LOG_V(fmt,args...) do{DBG_PosInfo();DBG_Log_Print(" V:"fmt, ##args);}while(0)
+#   define LOG_V(fmt,args...) do{DBG_PosInfo();DBG_Log_Print(" V:" fmt, ##args);}while(0)
 #else
 #   define LOG_V(fmt,args...)
 #endif
 
 #if _DEBUG_LEVEL_ <= _DEBUG_LEVEL_D_
-#   define LOG_D(fmt,args...) do{DBG_PosInfo();DBG_Log_Print(" D:"fmt, ##args);}while(0)
+#   define LOG_D(fmt,args...) do{DBG_PosInfo();DBG_Log_Print(" D:" fmt, ##args);}while(0)
 #else
 #   define LOG_D(fmt,args...)
 #endif
 
 #if _DEBUG_LEVEL_ <= _DEBUG_LEVEL_I_
-#   define LOG_I(fmt,args...) do{DBG_PosInfo();DBG_Log_Print(" I:"fmt,##args);}while(0)
+#   define LOG_I(fmt,args...) do{DBG_PosInfo();DBG_Log_Print(" I:" fmt,##args);}while(0)
 #else
 #   define LOG_I(fmt,args...)
 #endif
 
 #if _DEBUG_LEVEL_ <= _DEBUG_LEVEL_W_
-#   define LOG_W(fmt,args...) do{DBG_PosInfo();DBG_Log_Print(" W:"fmt,##args);}while(0)
+#   define LOG_W(fmt,args...) do{DBG_PosInfo();DBG_Log_Print(" W:" fmt,##args);}while(0)
 #else
 #   define LOG_W(fmt,args...)
 #endif
 
 #if _DEBUG_LEVEL_ <= _DEBUG_LEVEL_E_
-#   define LOG_E(fmt,args...) do{DBG_PosInfo();DBG_Log_Print(" E:"fmt,##args);}while(0)
+#   define LOG_E(fmt,args...) do{DBG_PosInfo();DBG_Log_Print(" E:" fmt,##args);}while(0)
 #else
 #   define LOG_E(fmt,args...)
 #endif
@@ -15,6 +15,9 @@
 extern TestcaseSet_t ListTestcaseSet;
 extern TestcaseSet_t QueueTestcaseSet;
 extern TestcaseSet_t PriQueueTestcaseSet;
+extern TestcaseSet_t VectorTestcaseSet;
+extern TestcaseSet_t TypedTestcaseSet;
+extern TestcaseSet_t CppTestcaseSet;
 
 //=============================================================================
 static void ShowRootMenu(List_t rootMenuList);
@@ -38,6 +41,9 @@ int main(int argc, char* argv[])
     List_InsertData(testcaseList, &ListTestcaseSet);
     List_InsertData(testcaseList, &QueueTestcaseSet);
     List_InsertData(testcaseList, &PriQueueTestcaseSet);
+    List_InsertData(testcaseList, &VectorTestcaseSet);
+    List_InsertData(testcaseList, &TypedTestcaseSet);
+    List_InsertData(testcaseList, &CppTestcaseSet);
 
     while (1)
     {
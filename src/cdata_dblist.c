@@ -66,6 +66,7 @@ static void        InsertAfter(List_st *p_list, DBListNode_st *p_listNode, DBLis
 
 static void        InsertFirstNode(List_st *p_list, DBListNode_st *p_node);
 static void        Insert2Tail(List_st *p_list, DBListNode_st *p_node);
+static void        InsertOrdered(List_st *p_list, DBListNode_st *p_newNode, CdataBool isAsc);
 
 /*=============================================================================*
  *                    Outer function implemention
@@ -79,13 +80,60 @@ int DBList_CreateNode(List_t list, void* p_data, ListNode_t *p_node)
     DBListNode_st* p_newNode = NULL;
     List_st*     p_list    = CONVERT_2_LIST(list);
 
-    p_newNode = (DBListNode_st*) OS_Malloc(sizeof(DBListNode_st));
+    //The node of the intrusive list is the link embedded in the data.
+    if (p_list->dataType == LIST_DATA_TYPE_INTRUSIVE)
+    {
+        p_newNode = (DBListNode_st*)LIST_INTRUSIVE_NODE(p_list, p_data);
+        p_newNode->p_next = NULL;
+        p_newNode->p_pre = NULL;
+        p_newNode->p_data = p_data;
+
+        *p_node = p_newNode;
+        return ERR_OK;
+    }
+
+    //The value copy data lives behind the node if possible, so one allocation for both.
+    if (p_list->pool != NULL || (p_list->dataType == LIST_DATA_TYPE_VALUE_COPY && p_list->freeFn == NULL))
+    {
+        if (p_list->pool != NULL)
+        {
+            p_newNode = (DBListNode_st*) NodePool_Alloc(p_list->pool);
+        }
+        else
+        {
+            p_newNode = (DBListNode_st*) OS_Malloc(p_list->dataOffset + p_list->dataLength);
+        }
+
+        if (NULL == p_newNode)
+        {
+            LOG_E("DBList_CreateNode() : Not enough memory 1\n");
+            return ERR_OUT_MEM;
+        }
+        memset(p_newNode, 0x0, p_list->nodeSize);
+        p_newNode->p_pre = NULL;
+        p_newNode->p_next = NULL;
+
+        if (p_list->dataType == LIST_DATA_TYPE_VALUE_COPY)
+        {
+            p_newNode->p_data = LIST_INLINE_DATA(p_list, p_newNode);
+            memcpy(p_newNode->p_data, p_data, p_list->dataLength);
+        }
+        else
+        {
+            p_newNode->p_data = p_data;
+        }
+
+        *p_node = p_newNode;
+        return ERR_OK;
+    }
+
+    p_newNode = (DBListNode_st*) OS_Malloc(p_list->nodeSize);
     if (NULL == p_newNode)
     {
         LOG_E("DBList_CreateNode() : Not enough memory 1\n");
         return ERR_OUT_MEM;
     }
-    memset(p_newNode, 0x0, sizeof(ListNode_t));
+    memset(p_newNode, 0x0, p_list->nodeSize);
 
     p_newNode->p_pre = NULL;
     p_newNode->p_next = NULL;
@@ -124,7 +172,7 @@ int DBList_InsertDataBefore(List_t list, void* p_keyword, ListNode_t newNode)
     
     for (p_head = (DBListNode_st*)p_list->p_head; p_head != NULL; p_head = (DBListNode_st*)p_head->p_next)
     {
-        if (p_list->equal2KeywordFn(p_head->p_data, p_keyword))
+        if (List_MatchKeyword(p_list, p_head->p_data, p_keyword))
         {
             InsertBefore(p_list, p_head, (DBListNode_st*)newNode);
             return ERR_OK;
@@ -144,7 +192,7 @@ int DBList_InsertDataAfter(List_t list, void* p_keyword, ListNode_t newNode)
     
     for (p_head = (DBListNode_st*)p_list->p_head; p_head != NULL; p_head = (DBListNode_st*)p_head->p_next)
     {
-        if (p_list->equal2KeywordFn(p_head->p_data, p_keyword))
+        if (List_MatchKeyword(p_list, p_head->p_data, p_keyword))
         {
             InsertAfter(p_list, p_head, (DBListNode_st*)newNode);
             return ERR_OK;
@@ -184,10 +232,10 @@ int DBList_InsertNode2Head(List_t list, ListNode_t node)
     p_node->p_next = p_list->p_head;
     p_node->p_pre = NULL;
 
-    ((DBListNode_st*)p_list->p_head)->p_pre = p_node;
-    p_list->p_head = p_node;
+    LIST_PUBLISH(((DBListNode_st*)p_list->p_head)->p_pre, p_node);
+    LIST_PUBLISH(p_list->p_head, (void*)p_node);
 
-    p_list->nodeCount++;
+    List_OnNodeLinked(p_list, p_node);
 
     return ERR_OK;
 }
@@ -199,24 +247,14 @@ int   DBList_InsertNodeAsc(List_t list, ListNode_t node)
 
     List_st*        p_list    = CONVERT_2_LIST(list);
     DBListNode_st*  p_newNode = CONVERT_2_DBLIST_NODE(node);
-	DBListNode_st*  p_node    = NULL;
 
-    if (p_list->usrLtNodeFn == NULL)
+    if (!LIST_CAN_COMPARE_ORDER(p_list))
     {
         LOG_E("usrLtNodeFn is NULL.\n");
         return ERR_FAIL;
     }
 
-    for (p_node = p_list->p_head; p_node != NULL; p_node = p_node->p_next)
-    {
-        if (p_list->usrLtNodeFn(p_node->p_data, p_newNode->p_data))
-        {
-            InsertBefore(p_list, p_node, p_newNode);
-            return ERR_OK;
-        }
-    }
-
-    Insert2Tail(p_list, p_newNode);
+    InsertOrdered(p_list, p_newNode, CDATA_TRUE);
 
     return ERR_OK;
 }
@@ -228,24 +266,14 @@ int   DBList_InsertNodeDes(List_t list, ListNode_t node)
 
     List_st*        p_list    = CONVERT_2_LIST(list);
     DBListNode_st*  p_newNode = CONVERT_2_DBLIST_NODE(node);
-	DBListNode_st*  p_node    = NULL;
 
-    if (p_list->usrLtNodeFn == NULL)
+    if (!LIST_CAN_COMPARE_ORDER(p_list))
     {
         LOG_E("usrLtNodeFn is NULL.\n");
         return ERR_FAIL;
     }
 
-    for (p_node = p_list->p_head; p_node != NULL; p_node = p_node->p_next)
-    {
-        if (!p_list->usrLtNodeFn(p_node->p_data, p_newNode->p_data))
-        {
-            InsertBefore(p_list, p_node, p_newNode);
-            return ERR_OK;
-        }
-    }
-
-    Insert2Tail(p_list, p_newNode);
+    InsertOrdered(p_list, p_newNode, CDATA_FALSE);
 
     return ERR_OK;
 }
@@ -300,6 +328,10 @@ int DBList_DetachNode(List_t list, ListNode_t node)
         {
             ((DBListNode_st*)p_list->p_head)->p_pre = NULL;
         }
+        else
+        {
+            p_list->p_tail = NULL;
+        }
     }
     else if (p_node == p_list->p_tail)
     {
@@ -322,7 +354,81 @@ int DBList_DetachNode(List_t list, ListNode_t node)
         }
     }
 
-    p_list->nodeCount--;
+    List_OnNodeUnlinked(p_list, p_node);
+
+    return ERR_OK;
+}
+
+int DBList_UnlinkRun(List_t list, ListNode_t first, ListNode_t last, CdataCount_t count)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(first != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(last != NULL, ERR_BAD_PARAM);
+
+    List_st*       p_list  = CONVERT_2_LIST(list);
+    DBListNode_st* p_first = CONVERT_2_DBLIST_NODE(first);
+    DBListNode_st* p_last  = CONVERT_2_DBLIST_NODE(last);
+    DBListNode_st* p_next  = p_last->p_next;
+
+    if (p_first->p_pre == NULL)
+    {
+        p_list->p_head = p_last->p_next;
+    }
+    else
+    {
+        p_first->p_pre->p_next = p_last->p_next;
+    }
+
+    if (p_last->p_next == NULL)
+    {
+        p_list->p_tail = p_first->p_pre;
+    }
+    else
+    {
+        p_last->p_next->p_pre = p_first->p_pre;
+    }
+
+    p_first->p_pre = NULL;
+    p_last->p_next = NULL;
+
+    List_OnRunUnlinked(p_list, first, last, p_next, count);
+
+    return ERR_OK;
+}
+
+int DBList_LinkRunAfter(List_t list, ListNode_t listNode, ListNode_t first, ListNode_t last, CdataCount_t count)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(first != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(last != NULL, ERR_BAD_PARAM);
+
+    List_st*       p_list     = CONVERT_2_LIST(list);
+    DBListNode_st* p_listNode = CONVERT_2_DBLIST_NODE(listNode);
+    DBListNode_st* p_first    = CONVERT_2_DBLIST_NODE(first);
+    DBListNode_st* p_last     = CONVERT_2_DBLIST_NODE(last);
+
+    p_first->p_pre = p_listNode;
+    p_last->p_next = (p_listNode == NULL) ? (DBListNode_st*)p_list->p_head : p_listNode->p_next;
+
+    if (p_listNode == NULL)
+    {
+        p_list->p_head = p_first;
+    }
+    else
+    {
+        p_listNode->p_next = p_first;
+    }
+
+    if (p_last->p_next == NULL)
+    {
+        p_list->p_tail = p_last;
+    }
+    else
+    {
+        p_last->p_next->p_pre = p_last;
+    }
+
+    List_OnRunLinked(p_list, count);
 
     return ERR_OK;
 }
@@ -336,21 +442,21 @@ static void InsertBefore(List_st* p_list, DBListNode_st* p_listNode, DBListNode_
     ASSERT(p_listNode != NULL);
     ASSERT(p_newNode != NULL);
 
+	//The new node is set up before any link to it is published.
 	p_newNode->p_pre = p_listNode->p_pre;
-
-	p_listNode->p_pre = p_newNode;
 	p_newNode->p_next = p_listNode;
 
+	LIST_PUBLISH(p_listNode->p_pre, p_newNode);
 	if (p_newNode->p_pre == NULL)
 	{
-		p_list->p_head = p_newNode;
+		LIST_PUBLISH(p_list->p_head, (void*)p_newNode);
 	}
 	else
 	{
-		p_newNode->p_pre->p_next = p_newNode;
+		LIST_PUBLISH(p_newNode->p_pre->p_next, p_newNode);
 	}
 
-    p_list->nodeCount++;
+    List_OnNodeLinked(p_list, p_newNode);
 
     return;
 }
@@ -363,18 +469,18 @@ static void InsertAfter(List_st *p_list, DBListNode_st *p_listNode, DBListNode_s
     
 	p_newNode->p_next = p_listNode->p_next;
 	p_newNode->p_pre = p_listNode;
-	p_listNode->p_next = p_newNode;
+	LIST_PUBLISH(p_listNode->p_next, p_newNode);
 
 	if (p_newNode->p_next == NULL)
 	{
-		p_list->p_tail = p_newNode;
+		LIST_PUBLISH(p_list->p_tail, (void*)p_newNode);
 	}
 	else
 	{
-		p_newNode->p_next->p_pre = p_newNode;
+		LIST_PUBLISH(p_newNode->p_next->p_pre, p_newNode);
 	}
 
-    p_list->nodeCount++;
+    List_OnNodeLinked(p_list, p_newNode);
     
     return;
 }
@@ -384,13 +490,13 @@ static void InsertFirstNode(List_st *p_list, DBListNode_st *p_node)
     ASSERT(p_list != NULL);
     ASSERT(p_node != NULL);
 
-    p_list->p_head = p_node;
-    p_list->p_tail = p_node;
-
     p_node->p_next = NULL;
     p_node->p_pre = NULL;
 
-    p_list->nodeCount++;
+    LIST_PUBLISH(p_list->p_head, (void*)p_node);
+    LIST_PUBLISH(p_list->p_tail, (void*)p_node);
+
+    List_OnNodeLinked(p_list, p_node);
 
     return;
 }
@@ -408,14 +514,48 @@ static void Insert2Tail(List_st* p_list, DBListNode_st* p_node)
 
     p_node->p_pre = p_list->p_tail;
     p_node->p_next = NULL;
-    ((DBListNode_st*)p_list->p_tail)->p_next = p_node;
-    p_list->p_tail = p_node;
+    LIST_PUBLISH(((DBListNode_st*)p_list->p_tail)->p_next, p_node);
+    LIST_PUBLISH(p_list->p_tail, (void*)p_node);
 
-    p_list->nodeCount++;
+    List_OnNodeLinked(p_list, p_node);
 
     return;
 }
 
+//The nodes which the new one goes before are all behind the others, the place is searched from the tail
+//or the last ordered insert, so the nearly sorted data are inserted in O(1).
+static void InsertOrdered(List_st* p_list, DBListNode_st* p_newNode, CdataBool isAsc)
+{
+    ASSERT(p_list != NULL);
+    ASSERT(p_newNode != NULL);
+
+    DBListNode_st* p_node = (p_list->p_finger != NULL) ? (DBListNode_st*)p_list->p_finger : (DBListNode_st*)p_list->p_tail;
+
+    if (p_list->nodeCount == 0 || !LIST_GOES_BEFORE(p_list, ((DBListNode_st*)p_list->p_tail)->p_data, p_newNode->p_data, isAsc))
+    {
+        Insert2Tail(p_list, p_newNode);
+    }
+    else if (LIST_GOES_BEFORE(p_list, p_node->p_data, p_newNode->p_data, isAsc))
+    {
+        while (p_node->p_pre != NULL && LIST_GOES_BEFORE(p_list, p_node->p_pre->p_data, p_newNode->p_data, isAsc))
+        {
+            p_node = p_node->p_pre;
+        }
+        InsertBefore(p_list, p_node, p_newNode);
+    }
+    else
+    {
+        //It stops at the tail at last.
+        do
+        {
+            p_node = p_node->p_next;
+        }while (!LIST_GOES_BEFORE(p_list, p_node->p_data, p_newNode->p_data, isAsc));
+        InsertBefore(p_list, p_node, p_newNode);
+    }
+
+    p_list->p_finger = p_newNode;
+}
+
 /*=============================================================================*
  *                                End of file
  *============================================================================*/
@@ -51,6 +51,13 @@ int DBList_InsertNodeAfter(List_t list, ListNode_t listNode, ListNode_t newNode)
 
 int DBList_DetachNode(List_t list, ListNode_t node);
 
+/*
+ * Move a run of count nodes from first to last out of or into the list in O(1), listNode NULL means
+ * linking the run before the head.
+ */
+int DBList_UnlinkRun(List_t list, ListNode_t first, ListNode_t last, CdataCount_t count);
+int DBList_LinkRunAfter(List_t list, ListNode_t listNode, ListNode_t first, ListNode_t last, CdataCount_t count);
+
 __END_EXTERN_C_DECL__
 
 #endif /* _CDATA_DBLIST_H_ */
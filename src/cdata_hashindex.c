@@ -0,0 +1,257 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.4.1
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "cdata_types.h"
+#include "cdata_os_adapter.h"
+#include "cdata_hashindex.h"
+
+#ifndef _DEBUG_LEVEL_
+#define _DEBUG_LEVEL_  _DEBUG_LEVEL_I_
+#endif
+#include "debug.h"
+
+/*=============================================================================*
+ *                        Macro definition
+ *============================================================================*/
+//Fibonacci hashing, it spreads the poor user hash values over the table.
+#define HASH_SLOT(_index_, _hash_) \
+    (size_t)(((unsigned long long)(_hash_) * 11400714819323198485ULL) >> (64 - (_index_)->bits))
+
+#define IS_REMOVED(_node_) ((_node_) == (void*)&g_removedMark)
+
+/*=============================================================================*
+ *                        Const definition
+ *============================================================================*/
+#define HASH_INDEX_MIN_BITS 4
+
+/*=============================================================================*
+ *                    Static variable declaration
+ *============================================================================*/
+//The address marks the slot whose node has been removed.
+static char g_removedMark;
+
+/*=============================================================================*
+ *                    Inner function declaration
+ *============================================================================*/
+static int  Rehash(HashIndex_st* p_index, int bits);
+static void PutEntry(HashIndex_st* p_index, void* p_node, unsigned long hash);
+
+/*=============================================================================*
+ *                    Outer function implemention
+ *============================================================================*/
+int HashIndex_Init(HashIndex_st* p_index)
+{
+    CHECK_PARAM(p_index != NULL, ERR_BAD_PARAM);
+
+    memset(p_index, 0, sizeof(HashIndex_st));
+
+    return Rehash(p_index, HASH_INDEX_MIN_BITS);
+}
+
+void HashIndex_Destroy(HashIndex_st* p_index)
+{
+    if (p_index == NULL)
+    {
+        return;
+    }
+
+    if (p_index->p_entries != NULL)
+    {
+        OS_Free(p_index->p_entries);
+    }
+    memset(p_index, 0, sizeof(HashIndex_st));
+}
+
+void HashIndex_Clear(HashIndex_st* p_index)
+{
+    ASSERT(p_index != NULL);
+
+    memset(p_index->p_entries, 0, sizeof(HashIndexEntry_st) * p_index->capacity);
+    p_index->count = 0;
+    p_index->removedCount = 0;
+}
+
+int HashIndex_Insert(HashIndex_st* p_index, void* p_node, unsigned long hash)
+{
+    ASSERT(p_index != NULL);
+    ASSERT(p_node != NULL);
+
+    int bits = p_index->bits;
+
+    //Keep the load factor under 3/4, the removed slots are counted in, they also make probing long.
+    if ((p_index->count + p_index->removedCount + 1) * 4 > p_index->capacity * 3)
+    {
+        while ((p_index->count + 1) * 2 > ((size_t)1 << bits))
+        {
+            bits++;
+        }
+
+        if (Rehash(p_index, bits) != ERR_OK)
+        {
+            return ERR_OUT_MEM;
+        }
+    }
+
+    PutEntry(p_index, p_node, hash);
+    p_index->count++;
+
+    return ERR_OK;
+}
+
+CdataBool HashIndex_Remove(HashIndex_st* p_index, void* p_node, unsigned long hash)
+{
+    ASSERT(p_index != NULL);
+
+    HashIndexIter_t iter;
+    void*           p_cur = NULL;
+
+    for (p_cur = HashIndex_FindFirst(p_index, hash, &iter); p_cur != NULL; p_cur = HashIndex_FindNext(p_index, &iter))
+    {
+        if (p_cur == p_node)
+        {
+            p_index->p_entries[iter.slot].p_node = (void*)&g_removedMark;
+            p_index->count--;
+            p_index->removedCount++;
+            return CDATA_TRUE;
+        }
+    }
+
+    return CDATA_FALSE;
+}
+
+void* HashIndex_FindFirst(HashIndex_st* p_index, unsigned long hash, HashIndexIter_t* p_iter)
+{
+    ASSERT(p_index != NULL);
+    ASSERT(p_iter != NULL);
+
+    p_iter->hash   = hash;
+    p_iter->slot   = HASH_SLOT(p_index, hash);
+    p_iter->probes = 0;
+
+    //Step back one slot, so FindNext will begin from the home slot.
+    p_iter->slot = (p_iter->slot + p_index->capacity - 1) & (p_index->capacity - 1);
+
+    return HashIndex_FindNext(p_index, p_iter);
+}
+
+void* HashIndex_FindNext(HashIndex_st* p_index, HashIndexIter_t* p_iter)
+{
+    ASSERT(p_index != NULL);
+    ASSERT(p_iter != NULL);
+
+    HashIndexEntry_st* p_entry = NULL;
+    size_t             mask    = p_index->capacity - 1;
+
+    while (p_iter->probes < p_index->capacity)
+    {
+        p_iter->slot = (p_iter->slot + 1) & mask;
+        p_iter->probes++;
+
+        p_entry = &p_index->p_entries[p_iter->slot];
+        if (p_entry->p_node == NULL)
+        {
+            break;
+        }
+
+        if (!IS_REMOVED(p_entry->p_node) && p_entry->hash == p_iter->hash)
+        {
+            return p_entry->p_node;
+        }
+    }
+
+    p_iter->probes = p_index->capacity;
+    return NULL;
+}
+
+/*=============================================================================*
+ *                    Inner function implemention
+ *============================================================================*/
+static int Rehash(HashIndex_st* p_index, int bits)
+{
+    HashIndexEntry_st* p_oldEntries  = p_index->p_entries;
+    size_t             oldCapacity   = p_index->capacity;
+    size_t             capacity      = (size_t)1 << bits;
+    size_t             i             = 0;
+
+    HashIndexEntry_st* p_newEntries = (HashIndexEntry_st*)OS_Malloc(sizeof(HashIndexEntry_st) * capacity);
+    if (p_newEntries == NULL)
+    {
+        LOG_E("Not enough memory for hash index, capacity:%d.\n", (int)capacity);
+        return ERR_OUT_MEM;
+    }
+    memset(p_newEntries, 0, sizeof(HashIndexEntry_st) * capacity);
+
+    p_index->p_entries    = p_newEntries;
+    p_index->capacity     = capacity;
+    p_index->bits         = bits;
+    p_index->removedCount = 0;
+
+    for (i = 0; i < oldCapacity; i++)
+    {
+        if (p_oldEntries[i].p_node != NULL && !IS_REMOVED(p_oldEntries[i].p_node))
+        {
+            PutEntry(p_index, p_oldEntries[i].p_node, p_oldEntries[i].hash);
+        }
+    }
+
+    if (p_oldEntries != NULL)
+    {
+        OS_Free(p_oldEntries);
+    }
+
+    return ERR_OK;
+}
+
+static void PutEntry(HashIndex_st* p_index, void* p_node, unsigned long hash)
+{
+    size_t mask = p_index->capacity - 1;
+    size_t slot = HASH_SLOT(p_index, hash);
+
+    //Insert into an empty slot or a removed slot, they are both free.
+    while (p_index->p_entries[slot].p_node != NULL && !IS_REMOVED(p_index->p_entries[slot].p_node))
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    if (IS_REMOVED(p_index->p_entries[slot].p_node))
+    {
+        p_index->removedCount--;
+    }
+
+    p_index->p_entries[slot].p_node = p_node;
+    p_index->p_entries[slot].hash   = hash;
+}
+
+/*=============================================================================*
+ *                                End of file
+ *============================================================================*/
@@ -0,0 +1,88 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.4.1
+*/
+
+/*
+ * HashIndex: an open-addressing hash table of list nodes.
+ * The table only stores the node and the hash of its data, the caller compares the data itself,
+ * so the same table can be used to look up by keyword and by node data.
+ * All the functions must be called with the list locked.
+ */
+
+#ifndef _CDATA_HASHINDEX_H_
+#define _CDATA_HASHINDEX_H_
+
+#include <stddef.h>
+
+#include "cdata_types.h"
+
+__BEGIN_EXTERN_C_DECL__
+
+typedef struct
+{
+    void*         p_node;
+    unsigned long hash;
+}HashIndexEntry_st;
+
+typedef struct
+{
+    HashIndexEntry_st* p_entries;
+    size_t             capacity;
+    int                bits;
+
+    //Count of the nodes, and count of the removed entries which still hold the slots.
+    size_t             count;
+    size_t             removedCount;
+}HashIndex_st;
+
+typedef struct
+{
+    unsigned long hash;
+    size_t        slot;
+    size_t        probes;
+}HashIndexIter_t;
+
+int       HashIndex_Init(HashIndex_st* p_index);
+void      HashIndex_Destroy(HashIndex_st* p_index);
+void      HashIndex_Clear(HashIndex_st* p_index);
+
+int       HashIndex_Insert(HashIndex_st* p_index, void* p_node, unsigned long hash);
+
+/*
+ * Return CDATA_TRUE if the node is found and removed.
+ */
+CdataBool HashIndex_Remove(HashIndex_st* p_index, void* p_node, unsigned long hash);
+
+/*
+ * Visit all the nodes which have the hash, it returns NULL when there is no more node.
+ */
+void*     HashIndex_FindFirst(HashIndex_st* p_index, unsigned long hash, HashIndexIter_t* p_iter);
+void*     HashIndex_FindNext(HashIndex_st* p_index, HashIndexIter_t* p_iter);
+
+__END_EXTERN_C_DECL__
+
+#endif //_CDATA_HASHINDEX_H_
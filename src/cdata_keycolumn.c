@@ -0,0 +1,411 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.5.22
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "cdata_types.h"
+#include "cdata_os_adapter.h"
+#include "cdata_keycolumn.h"
+
+#ifndef _DEBUG_LEVEL_
+#define _DEBUG_LEVEL_  _DEBUG_LEVEL_I_
+#endif
+#include "debug.h"
+
+/*=============================================================================*
+ *                        Macro definition
+ *============================================================================*/
+#define KEY32(_column_) ((uint32_t*)(_column_)->p_keys)
+#define KEY64(_column_) ((uint64_t*)(_column_)->p_keys)
+
+#define KEY_ADDR(_column_, _index_) ((char*)(_column_)->p_keys + (_index_) * (_column_)->keyLength)
+
+/*=============================================================================*
+ *                        Const definition
+ *============================================================================*/
+#define KEY_COLUMN_MIN_CAPACITY 16
+
+/*=============================================================================*
+ *                    Inner function declaration
+ *============================================================================*/
+static int    Relayout(KeyColumn_st* p_column);
+static size_t IndexOfNode(KeyColumn_st* p_column, void* p_node);
+static void   MoveEntries(KeyColumn_st* p_column, size_t to, size_t from, size_t count);
+static size_t ScanKey32(const uint32_t* p_keys, size_t index, size_t end, uint32_t key);
+static size_t ScanKey64(const uint64_t* p_keys, size_t index, size_t end, uint64_t key);
+
+/*=============================================================================*
+ *                    Outer function implemention
+ *============================================================================*/
+void KeyColumn_Init(KeyColumn_st* p_column, int keyLength)
+{
+    ASSERT(p_column != NULL);
+    ASSERT(keyLength == 0 || keyLength == 4 || keyLength == 8);
+
+    memset(p_column, 0, sizeof(KeyColumn_st));
+    p_column->keyLength = keyLength;
+}
+
+void KeyColumn_Destroy(KeyColumn_st* p_column)
+{
+    ASSERT(p_column != NULL);
+
+    if (p_column->p_keys != NULL)
+    {
+        OS_Free(p_column->p_keys);
+    }
+
+    if (p_column->p_nodes != NULL)
+    {
+        OS_Free(p_column->p_nodes);
+    }
+
+    memset(p_column, 0, sizeof(KeyColumn_st));
+}
+
+void KeyColumn_Clear(KeyColumn_st* p_column)
+{
+    ASSERT(p_column != NULL);
+
+    p_column->begin = p_column->capacity / 2;
+    p_column->end   = p_column->begin;
+}
+
+int KeyColumn_InsertBefore(KeyColumn_st* p_column, void* p_node, const void* p_key, void* nextNode)
+{
+    ASSERT(p_column != NULL);
+    ASSERT(p_node != NULL);
+    ASSERT(p_key != NULL);
+
+    size_t    count   = p_column->end - p_column->begin;
+    size_t    offset  = count;
+    CdataBool atFront = CDATA_FALSE;
+    int       ret     = ERR_OK;
+
+    if (nextNode != NULL)
+    {
+        offset = IndexOfNode(p_column, nextNode) - p_column->begin;
+        if (offset == count)
+        {
+            LOG_E("The next node is not in the key column.\n");
+            return ERR_BAD_PARAM;
+        }
+    }
+
+    //Move the shorter side to make room for the key.
+    atFront = (offset * 2 < count);
+    if ((atFront && p_column->begin == 0) || (!atFront && p_column->end == p_column->capacity))
+    {
+        ret = Relayout(p_column);
+        if (ret != ERR_OK)
+        {
+            return ret;
+        }
+    }
+
+    if (atFront)
+    {
+        MoveEntries(p_column, p_column->begin - 1, p_column->begin, offset);
+        p_column->begin--;
+    }
+    else
+    {
+        MoveEntries(p_column, p_column->begin + offset + 1, p_column->begin + offset, count - offset);
+        p_column->end++;
+    }
+
+    memcpy(KEY_ADDR(p_column, p_column->begin + offset), p_key, p_column->keyLength);
+    p_column->p_nodes[p_column->begin + offset] = p_node;
+
+    return ERR_OK;
+}
+
+CdataBool KeyColumn_Remove(KeyColumn_st* p_column, void* p_node)
+{
+    ASSERT(p_column != NULL);
+
+    size_t count  = p_column->end - p_column->begin;
+    size_t offset = IndexOfNode(p_column, p_node) - p_column->begin;
+
+    if (offset == count)
+    {
+        return CDATA_FALSE;
+    }
+
+    if (offset * 2 < count)
+    {
+        MoveEntries(p_column, p_column->begin + 1, p_column->begin, offset);
+        p_column->begin++;
+    }
+    else
+    {
+        MoveEntries(p_column, p_column->begin + offset, p_column->begin + offset + 1, count - offset - 1);
+        p_column->end--;
+    }
+
+    return CDATA_TRUE;
+}
+
+void KeyColumn_SetKey(KeyColumn_st* p_column, void* p_node, const void* p_key)
+{
+    ASSERT(p_column != NULL);
+    ASSERT(p_key != NULL);
+
+    size_t index = IndexOfNode(p_column, p_node);
+
+    if (index != p_column->end)
+    {
+        memcpy(KEY_ADDR(p_column, index), p_key, p_column->keyLength);
+    }
+}
+
+void* KeyColumn_FindFirst(KeyColumn_st* p_column, const void* p_key, KeyColumnIter_t* p_iter)
+{
+    ASSERT(p_column != NULL);
+    ASSERT(p_iter != NULL);
+
+    p_iter->index = p_column->begin;
+
+    return KeyColumn_FindNext(p_column, p_key, p_iter);
+}
+
+void* KeyColumn_FindNext(KeyColumn_st* p_column, const void* p_key, KeyColumnIter_t* p_iter)
+{
+    ASSERT(p_column != NULL);
+    ASSERT(p_key != NULL);
+    ASSERT(p_iter != NULL);
+
+    uint32_t key32 = 0;
+    uint64_t key64 = 0;
+    size_t   index = 0;
+
+    if (p_column->keyLength == 4)
+    {
+        memcpy(&key32, p_key, sizeof(key32));
+        index = ScanKey32(KEY32(p_column), p_iter->index, p_column->end, key32);
+    }
+    else
+    {
+        memcpy(&key64, p_key, sizeof(key64));
+        index = ScanKey64(KEY64(p_column), p_iter->index, p_column->end, key64);
+    }
+
+    if (index >= p_column->end)
+    {
+        p_iter->index = p_column->end;
+        return NULL;
+    }
+
+    p_iter->index = index + 1;
+
+    return p_column->p_nodes[index];
+}
+
+/*=============================================================================*
+ *                    Inner function implemention
+ *============================================================================*/
+//Center the entries, the column grows if it is more than half full.
+static int Relayout(KeyColumn_st* p_column)
+{
+    size_t count    = p_column->end - p_column->begin;
+    size_t capacity = p_column->capacity;
+    size_t begin    = 0;
+    void*  p_keys   = p_column->p_keys;
+    void** p_nodes  = p_column->p_nodes;
+
+    if (count * 2 >= capacity)
+    {
+        capacity = (count * 2 + 2 > KEY_COLUMN_MIN_CAPACITY) ? count * 2 + 2 : KEY_COLUMN_MIN_CAPACITY;
+        p_keys   = OS_Malloc(capacity * p_column->keyLength);
+        p_nodes  = (void**)OS_Malloc(capacity * sizeof(void*));
+        if (p_keys == NULL || p_nodes == NULL)
+        {
+            LOG_E("Not enough memory for key column, capacity:%d.\n", (int)capacity);
+            if (p_keys != NULL)
+            {
+                OS_Free(p_keys);
+            }
+            if (p_nodes != NULL)
+            {
+                OS_Free(p_nodes);
+            }
+            return ERR_OUT_MEM;
+        }
+    }
+
+    begin = (capacity - count) / 2;
+    if (count > 0)
+    {
+        memmove((char*)p_keys + begin * p_column->keyLength, KEY_ADDR(p_column, p_column->begin), count * p_column->keyLength);
+        memmove(p_nodes + begin, p_column->p_nodes + p_column->begin, count * sizeof(void*));
+    }
+
+    if (p_keys != p_column->p_keys)
+    {
+        if (p_column->p_keys != NULL)
+        {
+            OS_Free(p_column->p_keys);
+            OS_Free(p_column->p_nodes);
+        }
+        p_column->p_keys   = p_keys;
+        p_column->p_nodes  = p_nodes;
+        p_column->capacity = capacity;
+    }
+
+    p_column->begin = begin;
+    p_column->end   = begin + count;
+
+    return ERR_OK;
+}
+
+//Return end if the node is not in the column, the tail is checked first and then from the head.
+static size_t IndexOfNode(KeyColumn_st* p_column, void* p_node)
+{
+    size_t index = 0;
+
+    if (p_column->begin == p_column->end)
+    {
+        return p_column->end;
+    }
+
+    if (p_column->p_nodes[p_column->end - 1] == p_node)
+    {
+        return p_column->end - 1;
+    }
+
+    for (index = p_column->begin; index < p_column->end && p_column->p_nodes[index] != p_node; index++);
+
+    return index;
+}
+
+static void MoveEntries(KeyColumn_st* p_column, size_t to, size_t from, size_t count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    memmove(KEY_ADDR(p_column, to), KEY_ADDR(p_column, from), count * p_column->keyLength);
+    memmove(p_column->p_nodes + to, p_column->p_nodes + from, count * sizeof(void*));
+}
+
+/*
+ * The vector loop only finds the block which has the key, the scalar loop finds the key in the block
+ * and compares the rest keys. The AVX2 version is used if the library is built with -mavx2.
+ */
+static size_t ScanKey32(const uint32_t* p_keys, size_t index, size_t end, uint32_t key)
+{
+#if defined(__AVX2__)
+    __m256i needle = _mm256_set1_epi32((int)key);
+    __m256i first;
+    __m256i second;
+
+    for (; index + 16 <= end; index += 16)
+    {
+        first  = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(p_keys + index)), needle);
+        second = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(p_keys + index + 8)), needle);
+        if (_mm256_movemask_epi8(_mm256_or_si256(first, second)) != 0)
+        {
+            break;
+        }
+    }
+#elif defined(__SSE2__)
+    __m128i needle = _mm_set1_epi32((int)key);
+    __m128i first;
+    __m128i second;
+
+    for (; index + 8 <= end; index += 8)
+    {
+        first  = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(p_keys + index)), needle);
+        second = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(p_keys + index + 4)), needle);
+        if (_mm_movemask_epi8(_mm_or_si128(first, second)) != 0)
+        {
+            break;
+        }
+    }
+#endif
+
+    for (; index < end && p_keys[index] != key; index++);
+
+    return index;
+}
+
+static size_t ScanKey64(const uint64_t* p_keys, size_t index, size_t end, uint64_t key)
+{
+#if defined(__AVX2__)
+    __m256i needle = _mm256_set1_epi64x((long long)key);
+    __m256i first;
+    __m256i second;
+
+    for (; index + 8 <= end; index += 8)
+    {
+        first  = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(p_keys + index)), needle);
+        second = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(p_keys + index + 4)), needle);
+        if (_mm256_movemask_epi8(_mm256_or_si256(first, second)) != 0)
+        {
+            break;
+        }
+    }
+#elif defined(__SSE2__)
+    //SSE2 has no 64 bits compare, both 32 bits halves must be equal.
+    __m128i needle = _mm_set1_epi64x((long long)key);
+    __m128i hits;
+    int     i = 0;
+
+    for (; index + 8 <= end; index += 8)
+    {
+        hits = _mm_setzero_si128();
+        for (i = 0; i < 8; i += 2)
+        {
+            __m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(p_keys + index + i)), needle);
+            hits = _mm_or_si128(hits, _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1))));
+        }
+        if (_mm_movemask_epi8(hits) != 0)
+        {
+            break;
+        }
+    }
+#endif
+
+    for (; index < end && p_keys[index] != key; index++);
+
+    return index;
+}
+
+/*=============================================================================*
+ *                                End of file
+ *============================================================================*/
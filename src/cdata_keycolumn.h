@@ -0,0 +1,93 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.5.22
+*/
+
+/*
+ * KeyColumn: the fixed-width integer keys of the list nodes kept in one array in the list order.
+ * A keyword lookup compares the array with SIMD instructions instead of calling equal2KeywordFn
+ * for every node, and the node is found by the index of the key.
+ * The array has room at both ends, so the changes at the head and the tail are cheap, a change in
+ * the middle moves the shorter side of the array.
+ * All the functions must be called with the list locked.
+ */
+
+#ifndef _CDATA_KEYCOLUMN_H_
+#define _CDATA_KEYCOLUMN_H_
+
+#include <stddef.h>
+
+#include "cdata_types.h"
+
+__BEGIN_EXTERN_C_DECL__
+
+typedef struct
+{
+    //The keys are 4 or 8 bytes, 0 means the column is not used.
+    int     keyLength;
+
+    void*   p_keys;
+    void**  p_nodes;
+
+    //The keys are stored in [begin, end).
+    size_t  begin;
+    size_t  end;
+    size_t  capacity;
+}KeyColumn_st;
+
+typedef struct
+{
+    size_t  index;
+}KeyColumnIter_t;
+
+void      KeyColumn_Init(KeyColumn_st* p_column, int keyLength);
+void      KeyColumn_Destroy(KeyColumn_st* p_column);
+void      KeyColumn_Clear(KeyColumn_st* p_column);
+
+/*
+ * Insert the key of p_node before the key of nextNode, if nextNode is NULL, append it.
+ */
+int       KeyColumn_InsertBefore(KeyColumn_st* p_column, void* p_node, const void* p_key, void* nextNode);
+
+/*
+ * Return CDATA_TRUE if the node is found and removed.
+ */
+CdataBool KeyColumn_Remove(KeyColumn_st* p_column, void* p_node);
+
+/*
+ * Change the key of a node which is already in the column.
+ */
+void      KeyColumn_SetKey(KeyColumn_st* p_column, void* p_node, const void* p_key);
+
+/*
+ * Visit the nodes which have the key in the list order, it returns NULL when there is no more node.
+ */
+void*     KeyColumn_FindFirst(KeyColumn_st* p_column, const void* p_key, KeyColumnIter_t* p_iter);
+void*     KeyColumn_FindNext(KeyColumn_st* p_column, const void* p_key, KeyColumnIter_t* p_iter);
+
+__END_EXTERN_C_DECL__
+
+#endif //_CDATA_KEYCOLUMN_H_
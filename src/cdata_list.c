@@ -31,6 +31,7 @@ Date:2019.4.2
 #include "list_internal.h"
 #include "cdata_dblist.h"
 #include "cdata_sglist.h"
+#include "cdata_ulist.h"
 
 #ifndef _DEBUG_LEVEL_
 #define _DEBUG_LEVEL_  _DEBUG_LEVEL_I_
@@ -41,23 +42,113 @@ Date:2019.4.2
 /*=============================================================================*
  *                        Macro definition
  *============================================================================*/
+//The data pointer of a node, _offset_ is where p_data is in the single or double list node.
+#define NODE_DATA_AT(_node_, _offset_) (*(void**)((char*)(_node_) + (_offset_)))
+
+//The linked nodes can be walked directly, the lock-free readers must go through List_GetNextNodeNL.
+#define CAN_SCAN_KEY_FIELD(_list_) \
+	(LIST_HAS_KEY_FIELD(_list_) && (_list_)->type != LIST_TYPE_UNROLLED && (_list_)->retireList == NULL)
 
 /*=============================================================================*
  *                        Const definition
  *============================================================================*/
+//The nodes detached from a LIST_LOCK_RCU list wait for the readers in batches before they are chained.
+#define LIST_RCU_CHAIN_BATCH 64
+
+//Bin i of List_Sort holds a sorted run of 2^i nodes, 64 bins are enough for any node count.
+#define LIST_SORT_BINS 64
+
+//A position cursor walks this far at most before an indexed list is asked for the node.
+#define POS_CURSOR_WALK_LIMIT 32
 
 /*=============================================================================*
  *                    New type or enum declaration
  *============================================================================*/
+typedef struct
+{
+	List_st* p_list;
+	void*    p_data;
+}SortedSeekArg_t;
 
+//CdataLink_t is used as the node of the intrusive list, it fails to compile if the layouts differ.
+typedef char LinkLayoutCheck_t[(sizeof(CdataLink_t) == sizeof(DBListNode_st)
+	&& offsetof(CdataLink_t, p_data) == offsetof(DBListNode_st, p_data)
+	&& offsetof(CdataLink_t, p_data) == offsetof(SGListNode_st, p_data)
+	&& offsetof(CdataLink_t, p_pre) == offsetof(DBListNode_st, p_pre)) ? 1 : -1];
+
+typedef enum
+{
+	BATCH_INSERT_TAIL,
+	BATCH_INSERT_HEAD,
+	BATCH_INSERT_ASC,
+	BATCH_INSERT_UNI
+}BatchInsert_e;
 
 /*=============================================================================*
  *                    Inner function declaration
  *============================================================================*/
-static List_t      CreateList(ListName_t name, ListType_e type, List_DataType_e dataType, int dataLength);
+static List_t      CreateList(ListName_t name, ListType_e type, List_DataType_e dataType, int dataLength, const ListAttr_t* p_attr);
 static OSMutex_t   CreateGuard();
 static void        DeleteGuard(OSMutex_t guard);
 static CdataBool   HasDuplicateNode(List_t list, ListNode_t node);
+static CdataBool   HasDuplicateNodeNL(List_st* p_list, ListNode_t node);
+static CdataBool   HasDuplicateDataNL(List_st* p_list, void* p_userData, ListNode_t exceptNode);
+static void        FreeNodeData(List_st* p_list, ListNode_t node, void* p_data);
+static void        ReclaimNode(void* p_node, void* p_arg);
+static CdataBool   IsRcuCapable(ListType_e type, const ListAttr_t* p_attr);
+static int         CheckTypeAttr(ListType_e type, List_DataType_e dataType, const ListAttr_t* p_attr);
+static ListNode_t  GetNodeAtPosNL(List_st* p_list, CdataIndex_t posIndex);
+
+static int         BuildHashIndex(List_st* p_list);
+static void        DropHashIndex(List_st* p_list);
+static CdataBool   AddToHashIndex(List_st* p_list, void* p_node);
+static CdataBool   RemoveFromHashIndex(List_st* p_list, void* p_node);
+static unsigned long HashKey(List_st* p_list, const void* p_key);
+static unsigned long HashNodeData(List_st* p_list, void* p_data);
+static unsigned long HashKeyword(List_st* p_list, void* p_keyword);
+static ListNode_t  ScanKeyFieldNL(List_st* p_list, void* p_keyword, CdataCount_t* p_count);
+static CdataBool   MatchCondition(List_st* p_list, List_Condition_fn conditionFn, void* p_data, void* p_userData);
+static int         BuildKeyColumn(List_st* p_list, int keyLength);
+static CdataBool   AddToKeyColumn(List_st* p_list, void* p_node, void* nextNode);
+static void        UpdateKeyColumn(List_st* p_list, void* p_node);
+static ListNode_t  FindFirstMatchNodeNL(List_st* p_list, void* p_keyword);
+static CdataCount_t CountMatchNodesNL(List_st* p_list, void* p_keyword);
+static int         SwapDataContent(List_st* p_list, void* p_firstData, void* p_secondData);
+static void        DestroyFailedNode(List_t list, ListNode_t node);
+static ListNode_t  InsertIntrusiveDataUni(List_t list, void* p_data, CdataBool toHead);
+static int         InsertBatchNodeNL(List_st* p_list, ListNode_t node, BatchInsert_e mode);
+static void*       DetachNodeData(List_t list, ListNode_t node);
+static void*       DetachNodeDataNL(List_st* p_list, ListNode_t node);
+static ListNode_t  DetachFirstMatchNodeNL(List_st* p_list, void* p_keyword);
+static ListNode_t  DetachHeadRunNL(List_st* p_list, CdataCount_t max, ListNode_t* p_last, CdataCount_t* p_count);
+static void*       TakeNodeData(List_st* p_list, ListNode_t node);
+static ListNode_t  DetachMatchChainNL(List_st* p_list, void* p_userData, List_Condition_fn conditionFn, const unsigned char* p_marks, CdataCount_t* p_count);
+static void        AppendToChain(void** pp_chain, void** pp_last, void** pp_nodes, int count);
+static ListNode_t  WalkFromNodeNL(List_st* p_list, ListNode_t node, CdataIndex_t from, CdataIndex_t to);
+static void        MoveCursorsOffRun(List_st* p_list, void* p_first, void* p_last, void* p_nextNode);
+static int         CursorTraverseNL(ListCursor_t* p_cursor, CdataCount_t maxNodes, void* p_userData, List_Traverse_fn traverseFn, CdataBool* p_needStop);
+static int         CheckRunMovable(List_st* p_dst, List_st* p_src);
+static void        LockListPair(List_t firstList, List_t secondList);
+static void        UnLockListPair(List_t firstList, List_t secondList);
+static ListNode_t  FindPreNodeNL(List_st* p_list, ListNode_t node, CdataCount_t* p_index);
+static ListNode_t  MergeRuns(List_st* p_list, List_UserLtNode_fn ltFn, ListNode_t left, ListNode_t right);
+static void        RelinkSortedNL(List_st* p_list, ListNode_t head);
+static void        MoveRunNL(List_st* p_dst, ListNode_t pos, List_st* p_src, ListNode_t preNode, ListNode_t first, ListNode_t last, CdataCount_t count);
+
+static CdataBool   IsBefore(List_st* p_list, void* p_firstData, void* p_secondData);
+static CdataBool   InsertAdvance(void* p_node, void* p_arg);
+static CdataBool   LowerBoundAdvance(void* p_node, void* p_arg);
+static CdataBool   UpperBoundAdvance(void* p_node, void* p_arg);
+static int         InsertNodeSortedNL(List_st* p_list, ListNode_t node, ListSortOrder_e order);
+
+static int         InsertNodeNL(List_st* p_list, ListNode_t node);
+static int         InsertNode2HeadNL(List_st* p_list, ListNode_t node);
+static int         InsertNodeAscNL(List_st* p_list, ListNode_t node);
+static CdataCount_t InsertDataBatch(List_t list, void* p_dataArray, CdataCount_t count, BatchInsert_e mode);
+static ListNode_t  InsertUnrolledData(List_t list, void* p_data, CdataBool toHead, CdataBool unique);
+static ListNode_t  InsertUnrolledDataNL(List_st* p_list, void* p_data, CdataBool toHead, CdataBool unique);
+static CdataCount_t RmUnrolledMatchNodes(List_t list, void* p_userData, List_Condition_fn conditionFn);
+static ListNode_t  SeekSortedNL(List_st* p_list, void* p_data, SkipIndex_Advance_fn advanceFn);
  /*=============================================================================*
  *                    Outer function implemention
  *============================================================================*/
@@ -71,7 +162,12 @@ int List_Create(ListName_t name, ListType_e type, int dataLength, List_t* p_list
 
 	List_t list = NULL;
 
-	list = CreateList(name, type, LIST_DATA_TYPE_VALUE_COPY, dataLength);
+	if (CheckTypeAttr(type, LIST_DATA_TYPE_VALUE_COPY, NULL) != ERR_OK)
+	{
+		return ERR_BAD_PARAM;
+	}
+
+	list = CreateList(name, type, LIST_DATA_TYPE_VALUE_COPY, dataLength, NULL);
 	if (list == NULL)
 	{
 		LOG_E("Fail to create list:'%s'.\n", name);
@@ -91,7 +187,80 @@ int List_CreateRef(ListName_t name, ListType_e type, List_t* p_list)
 
 	List_t list = NULL;
 
-	list = CreateList(name, type, LIST_DATA_TYPE_VALUE_REFERENCE, 0);
+	if (CheckTypeAttr(type, LIST_DATA_TYPE_VALUE_REFERENCE, NULL) != ERR_OK)
+	{
+		return ERR_BAD_PARAM;
+	}
+
+	list = CreateList(name, type, LIST_DATA_TYPE_VALUE_REFERENCE, 0, NULL);
+	if (list == NULL)
+	{
+		LOG_E("Fail to create list:'%s'.\n", name);
+		return ERR_FAIL;
+	}
+
+	*p_list = list;
+
+    LOG_I("Success to create list:'%s'.\n", name);
+
+    return ERR_OK;
+}
+
+int List_AttrInit(ListAttr_t* p_attr)
+{
+    CHECK_PARAM(p_attr != NULL, ERR_BAD_PARAM);
+
+    memset(p_attr, 0x0, sizeof(ListAttr_t));
+    p_attr->poolChunkNodes = 0;
+    p_attr->sortOrder      = LIST_SORT_NONE;
+    p_attr->lockPolicy     = LIST_LOCK_MUTEX;
+
+    return ERR_OK;
+}
+
+int List_CreateWithAttr(ListName_t name, ListType_e type, int dataLength, const ListAttr_t* p_attr, List_t* p_list)
+{
+    CHECK_PARAM(p_list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(p_attr == NULL || p_attr->poolChunkNodes >= 0, ERR_BAD_PARAM);
+    CHECK_PARAM(p_attr == NULL || (unsigned int)p_attr->sortOrder <= LIST_SORT_DES, ERR_BAD_PARAM);
+    CHECK_PARAM(p_attr == NULL || (unsigned int)p_attr->lockPolicy <= LIST_LOCK_RCU, ERR_BAD_PARAM);
+
+	List_t list = NULL;
+
+	if (CheckTypeAttr(type, LIST_DATA_TYPE_VALUE_COPY, p_attr) != ERR_OK)
+	{
+		return ERR_BAD_PARAM;
+	}
+
+	list = CreateList(name, type, LIST_DATA_TYPE_VALUE_COPY, dataLength, p_attr);
+	if (list == NULL)
+	{
+		LOG_E("Fail to create list:'%s'.\n", name);
+		return ERR_FAIL;
+	}
+
+	*p_list = list;
+
+    LOG_I("Success to create:'%s'.\n", name);
+
+    return ERR_OK;
+}
+
+int List_CreateRefWithAttr(ListName_t name, ListType_e type, const ListAttr_t* p_attr, List_t* p_list)
+{
+    CHECK_PARAM(p_list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(p_attr == NULL || p_attr->poolChunkNodes >= 0, ERR_BAD_PARAM);
+    CHECK_PARAM(p_attr == NULL || (unsigned int)p_attr->sortOrder <= LIST_SORT_DES, ERR_BAD_PARAM);
+    CHECK_PARAM(p_attr == NULL || (unsigned int)p_attr->lockPolicy <= LIST_LOCK_RCU, ERR_BAD_PARAM);
+
+	List_t list = NULL;
+
+	if (CheckTypeAttr(type, LIST_DATA_TYPE_VALUE_REFERENCE, p_attr) != ERR_OK)
+	{
+		return ERR_BAD_PARAM;
+	}
+
+	list = CreateList(name, type, LIST_DATA_TYPE_VALUE_REFERENCE, 0, p_attr);
 	if (list == NULL)
 	{
 		LOG_E("Fail to create list:'%s'.\n", name);
@@ -105,6 +274,38 @@ int List_CreateRef(ListName_t name, ListType_e type, List_t* p_list)
     return ERR_OK;
 }
 
+int List_CreateIntrusive(ListName_t name, ListType_e type, size_t linkOffset, List_t* p_list)
+{
+	return List_CreateIntrusiveWithAttr(name, type, linkOffset, NULL, p_list);
+}
+
+int List_CreateIntrusiveWithAttr(ListName_t name, ListType_e type, size_t linkOffset, const ListAttr_t* p_attr, List_t* p_list)
+{
+    CHECK_PARAM(p_list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(p_attr == NULL || (unsigned int)p_attr->lockPolicy <= LIST_LOCK_RCU, ERR_BAD_PARAM);
+
+	List_t list = NULL;
+
+	if (CheckTypeAttr(type, LIST_DATA_TYPE_INTRUSIVE, p_attr) != ERR_OK)
+	{
+		return ERR_BAD_PARAM;
+	}
+
+	list = CreateList(name, type, LIST_DATA_TYPE_INTRUSIVE, 0, p_attr);
+	if (list == NULL)
+	{
+		LOG_E("Fail to create list:'%s'.\n", name);
+		return ERR_FAIL;
+	}
+	(CONVERT_2_LIST(list))->linkOffset = linkOffset;
+
+	*p_list = list;
+
+    LOG_I("Success to create intrusive list:'%s'.\n", name);
+
+    return ERR_OK;
+}
+
 int List_SetFreeDataFunc(List_t list, List_FreeData_fn freeFn)
 {
 	CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
@@ -145,6 +346,117 @@ int List_SetUserLtNodeFunc(List_t list, List_UserLtNode_fn userLtNodeFn)
 	return ERR_OK;
 }
 
+int List_SetHashFunc(List_t list, List_DataHash_fn nodeHashFn, List_DataHash_fn keywordHashFn)
+{
+	CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+
+	int      ret    = ERR_OK;
+	List_st* p_list = CONVERT_2_LIST(list);
+
+	//The hash table is rebuilt under the writer lock, the lock-free readers can't follow it.
+	if (p_list->retireList != NULL && nodeHashFn != NULL)
+	{
+		LOG_E("Hash index can't be used by LIST_LOCK_RCU list:'%s'.\n", p_list->name);
+		return ERR_BAD_PARAM;
+	}
+
+	List_Lock(list);
+	DropHashIndex(p_list);
+
+	p_list->nodeHashFn    = nodeHashFn;
+	p_list->keywordHashFn = keywordHashFn;
+	if (nodeHashFn != NULL)
+	{
+		ret = BuildHashIndex(p_list);
+	}
+	List_UnLock(list);
+
+	return ret;
+}
+
+int List_SetKeyField(List_t list, size_t offset, size_t length, ListKeyKind_e keyKind)
+{
+	CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+	CHECK_PARAM(keyKind >= LIST_KEY_NONE && keyKind <= LIST_KEY_CSTRING, ERR_BAD_PARAM);
+
+	int      ret    = ERR_OK;
+	List_st* p_list = CONVERT_2_LIST(list);
+
+	if ((keyKind == LIST_KEY_INT32 && length != sizeof(int32_t))
+		|| ((keyKind == LIST_KEY_INT64 || keyKind == LIST_KEY_UINT64) && length != sizeof(int64_t))
+		|| (keyKind != LIST_KEY_NONE && length == 0)
+		|| (keyKind != LIST_KEY_NONE && p_list->dataType == LIST_DATA_TYPE_VALUE_COPY && offset + length > (size_t)p_list->dataLength))
+	{
+		LOG_E("Wrong key field, offset:%d, length:%d, kind:%d.\n", (int)offset, (int)length, keyKind);
+		return ERR_BAD_PARAM;
+	}
+
+	List_Lock(list);
+	//The sorted nodes would be out of order with the new key.
+	if (LIST_IS_SORTED(p_list) && p_list->nodeCount != 0)
+	{
+		LOG_E("Can't change the key field of sorted list:'%s', it's not empty.\n", p_list->name);
+		List_UnLock(list);
+		return ERR_BAD_PARAM;
+	}
+
+	p_list->keyField.kind   = keyKind;
+	p_list->keyField.offset = (keyKind == LIST_KEY_NONE) ? 0 : offset;
+	p_list->keyField.length = (keyKind == LIST_KEY_NONE) ? 0 : length;
+
+	//The hash values of the nodes are changed.
+	if (p_list->p_hashIndex != NULL)
+	{
+		DropHashIndex(p_list);
+		ret = BuildHashIndex(p_list);
+	}
+	List_UnLock(list);
+
+	return ret;
+}
+
+int List_SetKeyColumn(List_t list, int keyLength)
+{
+	CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+	CHECK_PARAM(keyLength == 0 || keyLength == 4 || keyLength == 8, ERR_BAD_PARAM);
+
+	int      ret    = ERR_OK;
+	List_st* p_list = CONVERT_2_LIST(list);
+
+	//The keys are read from the data stored with the node, and the column is changed under the writer lock.
+	if (keyLength != 0 && (p_list->dataType != LIST_DATA_TYPE_VALUE_COPY || p_list->dataLength < keyLength
+		|| p_list->type == LIST_TYPE_UNROLLED || p_list->retireList != NULL))
+	{
+		LOG_E("Key column can't be used by list:'%s'.\n", p_list->name);
+		return ERR_BAD_PARAM;
+	}
+
+	List_Lock(list);
+	KeyColumn_Destroy(&p_list->keyColumn);
+	if (keyLength != 0)
+	{
+		ret = BuildKeyColumn(p_list, keyLength);
+	}
+	List_UnLock(list);
+
+	return ret;
+}
+
+unsigned long List_HashBytes(const void* p_data, size_t length)
+{
+	const unsigned char* p_byte = (const unsigned char*)p_data;
+	unsigned long        hash   = 2166136261UL;
+	size_t               i      = 0;
+
+	for (i = 0; i < length; i++)
+	{
+		hash ^= p_byte[i];
+		hash *= 16777619UL;
+	}
+
+	return hash;
+}
+
 const char* List_Name(List_t list)
 {
 	CHECK_PARAM(list != NULL, NULL);
@@ -158,13 +470,22 @@ CdataCount_t  List_Count(List_t list)
     CHECK_PARAM(list != NULL, 0);
 
 	List_st* p_list = CONVERT_2_LIST(list);
-    CdataCount_t count = 0;
 
-    List_Lock(list);
-    count = p_list->nodeCount;
-    List_UnLock(list);
+    return LIST_COUNTER_GET(p_list->nodeCount);
+}
+
+int List_GetStats(List_t list, ListStats_t* p_stats)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(p_stats != NULL, ERR_BAD_PARAM);
 
-    return count;
+	List_st* p_list = CONVERT_2_LIST(list);
+
+    p_stats->nodeCount     = LIST_COUNTER_GET(p_list->nodeCount);
+    p_stats->linkedTotal   = LIST_COUNTER_GET(p_list->linkedTotal);
+    p_stats->unlinkedTotal = LIST_COUNTER_GET(p_list->unlinkedTotal);
+
+    return ERR_OK;
 }
 
 void List_Lock(List_t list)
@@ -176,6 +497,15 @@ void List_Lock(List_t list)
     }
 
     List_st* p_list = CONVERT_2_LIST(list);
+    if (p_list->rwGuard != NULL)
+    {
+        if (OS_RWLockWriteLock(p_list->rwGuard) != 0)
+        {
+            LOG_E("Fail to lock dblist:'%s'.\n", p_list->name);
+        }
+        return;
+    }
+
     if (OS_MutexLock(p_list->guard) != 0)
     {
         LOG_E("Fail to lock dblist:'%s'.\n", p_list->name);
@@ -193,6 +523,15 @@ void List_UnLock(List_t list)
     }
 
     List_st* p_list = CONVERT_2_LIST(list);
+    if (p_list->rwGuard != NULL)
+    {
+        if (OS_RWLockUnlock(p_list->rwGuard) != 0)
+        {
+            LOG_E("Fail to unlock dblist:'%s'.\n", p_list->name);
+        }
+        return;
+    }
+
     if (OS_MutexUnlock(p_list->guard) != 0)
     {
         LOG_E("Fail to unlock dblist:'%s'.\n", p_list->name);
@@ -201,6 +540,56 @@ void List_UnLock(List_t list)
 	return;
 }
 
+void List_ReadLock(List_t list)
+{
+    if (list == NULL)
+    {
+        LOG_E("list is NULL.\n");
+        return;
+    }
+
+    List_st* p_list = CONVERT_2_LIST(list);
+    if (p_list->retireList != NULL)
+    {
+        //Fall back to the writer lock if this thread can't get a reader slot.
+        if (!Rcu_ReadLock())
+        {
+            List_Lock(list);
+        }
+        return;
+    }
+
+    if (p_list->rwGuard == NULL)
+    {
+        List_Lock(list);
+        return;
+    }
+
+    if (OS_RWLockReadLock(p_list->rwGuard) != 0)
+    {
+        LOG_E("Fail to read lock dblist:'%s'.\n", p_list->name);
+    }
+
+	return;
+}
+
+void List_ReadUnLock(List_t list)
+{
+    if (list == NULL)
+    {
+        LOG_E("list is NULL.\n");
+        return;
+    }
+
+    List_st* p_list = CONVERT_2_LIST(list);
+    if (p_list->retireList != NULL && Rcu_ReadUnlock())
+    {
+        return;
+    }
+
+    List_UnLock(list);
+}
+
 int List_Traverse(List_t list, void *p_userData, List_Traverse_fn traverseFn)
 {
     CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
@@ -212,7 +601,16 @@ int List_Traverse(List_t list, void *p_userData, List_Traverse_fn traverseFn)
 	CdataBool  				needStop = CDATA_FALSE;
 	ListTraverseNodeInfo_t 	info;
 
-	List_Lock(list);
+	List_ReadLock(list);
+	//The slots are visited in the blocks, not found one by one from the node before.
+	if (p_list->type == LIST_TYPE_UNROLLED)
+	{
+		UList_Traverse(list, p_userData, traverseFn);
+		List_ReadUnLock(list);
+
+		return ERR_OK;
+	}
+
 	for (p_head = p_list->p_head; p_head != NULL; p_head = List_GetNextNodeNL(list, p_head), pos++)
 	{
 		info.index = pos;
@@ -224,7 +622,7 @@ int List_Traverse(List_t list, void *p_userData, List_Traverse_fn traverseFn)
 			break;
 		}
 	}
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
     return ERR_OK;
 }
@@ -235,7 +633,7 @@ int List_TraverseReversely(List_t list, void *p_userData, List_Traverse_fn trave
     CHECK_PARAM(traverseFn != NULL, ERR_BAD_PARAM);
 
     CdataIndex_t    pos    = 0;
-    DBListNode_st*  p_tail = NULL;
+    void*           p_tail = NULL;
     List_st*        p_list = CONVERT_2_LIST(list);
 
     ListTraverseNodeInfo_t info;
@@ -247,12 +645,12 @@ int List_TraverseReversely(List_t list, void *p_userData, List_Traverse_fn trave
 		return ERR_BAD_PARAM;
 	}
 
-    List_Lock(list);
-    for (p_tail = p_list->p_tail, pos = p_list->nodeCount - 1; p_tail != NULL; p_tail = p_tail->p_pre, pos--)
+    List_ReadLock(list);
+    for (p_tail = p_list->p_tail, pos = LIST_COUNTER_GET(p_list->nodeCount) - 1; p_tail != NULL; p_tail = List_GetPreNodeNL(list, p_tail), pos--)
     {
         info.index = pos;
         info.node = (ListNode_t)p_tail;
-        info.p_data = p_tail->p_data;
+        info.p_data = List_GetNodeDataNL(list, p_tail);
 
         traverseFn(&info, p_userData, &needStop);
         if (needStop)
@@ -260,7 +658,7 @@ int List_TraverseReversely(List_t list, void *p_userData, List_Traverse_fn trave
             break;
         }
     }
-    List_UnLock(list);
+    List_ReadUnLock(list);
 
     return ERR_OK;
 }
@@ -269,22 +667,58 @@ int List_Clear(List_t list)
 {
     CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
 
-	List_st*  	p_list = CONVERT_2_LIST(list);
-	void* 		p_head = p_list->p_head;
-	void* 		p_next = NULL;
+	List_st*  		p_list = CONVERT_2_LIST(list);
+	void* 			p_head = NULL;
+	void* 			p_next = NULL;
+	ListCursor_t*	p_cursor = NULL;
 
-	LOG_I("Clear '%s', nodeCount:%llu.\n", p_list->name, p_list->nodeCount);
+	LOG_I("Clear '%s', nodeCount:%llu.\n", p_list->name, LIST_COUNTER_GET(p_list->nodeCount));
 
 	List_Lock(list);
+	//The slots are given back one by one, a block is freed with its last slot.
+	if (p_list->type == LIST_TYPE_UNROLLED)
+	{
+		while ((p_head = p_list->p_head) != NULL)
+		{
+			UList_DetachNode(list, p_head);
+			List_DestroyNode(list, p_head);
+		}
+		List_UnLock(list);
+
+		return ERR_OK;
+	}
+
+	//The towers are reached through the nodes, free them before the nodes.
+	if (LIST_IS_SORTED(p_list))
+	{
+		SkipIndex_Clear(&p_list->skipIndex);
+	}
+
+	//Unlink all the nodes before they are destroyed, so the lock-free readers can't find them any more.
+	p_head = p_list->p_head;
+	LIST_COUNTER_ADD(p_list->unlinkedTotal, p_list->nodeCount);
+	LIST_COUNTER_SET(p_list->nodeCount, 0);
+	p_list->p_head = NULL;
+	p_list->p_tail = NULL;
 	while (p_head != NULL)
 	{
 		p_next = List_GetNextNodeNL(list, p_head);
 		List_DestroyNode(p_list, p_head);
 		p_head = p_next;
 	}
-	p_list->nodeCount = 0;
-	p_list->p_head = NULL;
-	p_list->p_tail = NULL;
+	PosIndex_Clear(&p_list->posIndex);
+	if (p_list->p_hashIndex != NULL)
+	{
+		HashIndex_Clear(p_list->p_hashIndex);
+	}
+	KeyColumn_Clear(&p_list->keyColumn);
+
+	for (p_cursor = p_list->p_cursors; p_cursor != NULL; p_cursor = p_cursor->p_next)
+	{
+		p_cursor->nextNode = NULL;
+	}
+	p_list->modCount++;
+	p_list->p_finger = NULL;
 
 	List_UnLock(list);
 
@@ -300,7 +734,20 @@ int List_Destroy(List_t list)
     LOG_I("Destroy '%s'.\n", p_list->name);
 
     List_Clear(list);
+    if (p_list->type == LIST_TYPE_UNROLLED)
+    {
+        UList_Fini(&p_list->blocks);
+    }
+    DropHashIndex(p_list);
+    KeyColumn_Destroy(&p_list->keyColumn);
+    //No reader can be in the list when it's destroyed, free the retired nodes before their pool.
+    Rcu_DestroyRetireList(p_list->retireList);
     DeleteGuard(p_list->guard);
+    OS_RWLockDestroy(p_list->rwGuard);
+    if (p_list->pool != NULL)
+    {
+        NodePool_Destroy(p_list->pool);
+    }
     OS_Free(p_list);
 
     return ERR_OK;
@@ -316,6 +763,11 @@ ListNode_t List_InsertData(List_t list, void* p_data)
 	int        ret  = ERR_OK;
 	ListNode_t node = NULL;
 
+	if ((CONVERT_2_LIST(list))->type == LIST_TYPE_UNROLLED)
+	{
+		return InsertUnrolledData(list, p_data, CDATA_FALSE, CDATA_FALSE);
+	}
+
 	ret = List_CreateNode(list, p_data, &node);
 	if (ret != ERR_OK)
 	{
@@ -330,8 +782,7 @@ ListNode_t List_InsertData(List_t list, void* p_data)
 		
 		/*If insert failed, we cannot free the user's raw data, we only can destroy the new created node,
 		 *so we should detach node data first.*/
-		List_DetachNodeData(list, node);
-		List_DestroyNode(list, node);
+		DestroyFailedNode(list, node);
 		return NULL;
 	}
 
@@ -346,6 +797,11 @@ ListNode_t List_InsertData2Head(List_t list, void* p_data)
 	int      ret    = ERR_OK;
 	ListNode_t node = NULL;
 
+	if ((CONVERT_2_LIST(list))->type == LIST_TYPE_UNROLLED)
+	{
+		return InsertUnrolledData(list, p_data, CDATA_TRUE, CDATA_FALSE);
+	}
+
 	ret = List_CreateNode(list, p_data, &node);
 	if (ret != ERR_OK)
 	{
@@ -358,8 +814,7 @@ ListNode_t List_InsertData2Head(List_t list, void* p_data)
 	{
 		LOG_E("Fail to insert node.\n");
 		
-		List_DetachNodeData(list, node);
-		List_DestroyNode(list, node);
+		DestroyFailedNode(list, node);
 		return NULL;
 	}
 
@@ -386,8 +841,7 @@ ListNode_t List_InsertDataAsc(List_t list, void* p_data)
 	{
 		LOG_E("Fail to insert node.\n");
 		
-		List_DetachNodeData(list, node);
-		List_DestroyNode(list, node);
+		DestroyFailedNode(list, node);
 		return NULL;
 	}
 
@@ -414,8 +868,7 @@ ListNode_t List_InsertDataDes(List_t list, void* p_data)
 	{
 		LOG_E("Fail to insert node.\n");
 		
-		List_DetachNodeData(list, node);
-		List_DestroyNode(list, node);
+		DestroyFailedNode(list, node);
 		return NULL;
 	}
 
@@ -430,6 +883,16 @@ ListNode_t List_InsertDataUni(List_t list, void* p_data)
 	int        ret  = ERR_OK;
 	ListNode_t node = NULL;
 
+	if ((CONVERT_2_LIST(list))->type == LIST_TYPE_UNROLLED)
+	{
+		return InsertUnrolledData(list, p_data, CDATA_FALSE, CDATA_TRUE);
+	}
+
+	if ((CONVERT_2_LIST(list))->dataType == LIST_DATA_TYPE_INTRUSIVE)
+	{
+		return InsertIntrusiveDataUni(list, p_data, CDATA_FALSE);
+	}
+
 	ret = List_CreateNode(list, p_data, &node);
 	if (ret != ERR_OK)
 	{
@@ -442,8 +905,7 @@ ListNode_t List_InsertDataUni(List_t list, void* p_data)
 	{
 		LOG_E("Fail to insert node.\n");
 
-        List_DetachNodeData(list, node);
-		List_DestroyNode(list, node);
+		DestroyFailedNode(list, node);
 		return NULL;
 	}
 
@@ -458,6 +920,16 @@ ListNode_t List_InsertData2HeadUni(List_t list, void* p_data)
 	int      ret    = ERR_OK;
 	ListNode_t node = NULL;
 
+	if ((CONVERT_2_LIST(list))->type == LIST_TYPE_UNROLLED)
+	{
+		return InsertUnrolledData(list, p_data, CDATA_TRUE, CDATA_TRUE);
+	}
+
+	if ((CONVERT_2_LIST(list))->dataType == LIST_DATA_TYPE_INTRUSIVE)
+	{
+		return InsertIntrusiveDataUni(list, p_data, CDATA_TRUE);
+	}
+
 	ret = List_CreateNode(list, p_data, &node);
 	if (ret != ERR_OK)
 	{
@@ -470,8 +942,7 @@ ListNode_t List_InsertData2HeadUni(List_t list, void* p_data)
 	{
 		LOG_E("Fail to insert node.\n");
 
-        List_DetachNodeData(list, node);
-		List_DestroyNode(list, node);
+		DestroyFailedNode(list, node);
 		return NULL;
 	}
 
@@ -502,7 +973,7 @@ ListNode_t List_InsertDataBeforeNL(List_t list, void* p_keyword, void *p_data)
 	ListNode_t newNode = NULL;
     List_st*  p_list = CONVERT_2_LIST(list);
     
-	if (p_list->equal2KeywordFn == NULL)
+	if (!LIST_CAN_MATCH_KEYWORD(p_list))
 	{
 		LOG_E("equal2KeywordFn is NULL, pls set a valid function first.\n");
 		return NULL;
@@ -531,8 +1002,7 @@ ListNode_t List_InsertDataBeforeNL(List_t list, void* p_keyword, void *p_data)
     
     if (ret != ERR_OK)
     {        
-        List_DetachNodeData(list, newNode);
-		List_DestroyNode(list, newNode);
+		DestroyFailedNode(list, newNode);
 		return NULL;    
     }
 
@@ -562,7 +1032,7 @@ ListNode_t List_InsertDataAfterNL(List_t list, void* p_keyword, void *p_data)
 	ListNode_t newNode = NULL;
     List_st*  p_list = CONVERT_2_LIST(list);
     
-	if (p_list->equal2KeywordFn == NULL)
+	if (!LIST_CAN_MATCH_KEYWORD(p_list))
 	{
 		LOG_E("equal2KeywordFn is NULL, pls set a valid function first.\n");
 		return NULL;
@@ -591,8 +1061,7 @@ ListNode_t List_InsertDataAfterNL(List_t list, void* p_keyword, void *p_data)
     
     if (ret != ERR_OK)
     {        
-        List_DetachNodeData(list, newNode);
-		List_DestroyNode(list, newNode);
+		DestroyFailedNode(list, newNode);
 		return NULL;    
     }
 
@@ -619,14 +1088,33 @@ ListNode_t List_InsertDataAtPos(List_t list, void* p_data, CdataIndex_t posIndex
 	{
 		LOG_E("Fail to insert node.\n");
 		
-		List_DetachNodeData(list, node);
-		List_DestroyNode(list, node);
+		DestroyFailedNode(list, node);
 		return NULL;
 	}
 
 	return node;
 }
 
+CdataCount_t List_InsertDataBatch(List_t list, void* p_dataArray, CdataCount_t count)
+{
+	return InsertDataBatch(list, p_dataArray, count, BATCH_INSERT_TAIL);
+}
+
+CdataCount_t List_InsertDataBatch2Head(List_t list, void* p_dataArray, CdataCount_t count)
+{
+	return InsertDataBatch(list, p_dataArray, count, BATCH_INSERT_HEAD);
+}
+
+CdataCount_t List_InsertDataBatchAsc(List_t list, void* p_dataArray, CdataCount_t count)
+{
+	return InsertDataBatch(list, p_dataArray, count, BATCH_INSERT_ASC);
+}
+
+CdataCount_t List_InsertDataBatchUni(List_t list, void* p_dataArray, CdataCount_t count)
+{
+	return InsertDataBatch(list, p_dataArray, count, BATCH_INSERT_UNI);
+}
+
 CdataBool List_DataExists(List_t list, void* p_keyword)
 {
 	CHECK_PARAM(list != NULL, CDATA_FALSE);
@@ -636,23 +1124,16 @@ CdataBool List_DataExists(List_t list, void* p_keyword)
 	List_st*  p_list = CONVERT_2_LIST(list);
 	void*     p_head = NULL;
 
-	if (p_list->equal2KeywordFn == NULL)
+	if (!LIST_CAN_MATCH_KEYWORD(p_list))
 	{
 		LOG_E("equal2KeywordFn is NULL, pls set a valid function first.\n");
 		return CDATA_FALSE;
 	}
 
-	List_Lock(list);
-	for (p_head = p_list->p_head; p_head != NULL; p_head = List_GetNextNodeNL(list, p_head))
-	{
-		void *p_data = List_GetNodeDataNL(list, p_head);
-		if (p_list->equal2KeywordFn(p_data, p_keyword))
-		{
-			ret = CDATA_TRUE;
-			break;
-		}
-	}
-	List_UnLock(list);
+	List_ReadLock(list);
+	p_head = FindFirstMatchNodeNL(p_list, p_keyword);
+	ret = (p_head != NULL);
+	List_ReadUnLock(list);
 
 	return ret;
 }
@@ -666,7 +1147,7 @@ CdataBool List_DataExistsByCond(List_t list, void* p_userData, List_Condition_fn
 	List_st*  p_list = CONVERT_2_LIST(list);
 	void*     p_head = NULL;
 
-	List_Lock(list);
+	List_ReadLock(list);
 	for (p_head = p_list->p_head; p_head != NULL; p_head = List_GetNextNodeNL(list, p_head))
 	{
 		void *p_data = List_GetNodeDataNL(list, p_head);
@@ -676,7 +1157,7 @@ CdataBool List_DataExistsByCond(List_t list, void* p_userData, List_Condition_fn
 			break;
 		}
 	}
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
 	return ret;
 }
@@ -687,9 +1168,9 @@ void* List_GetHeadData(List_t list)
 
 	void* p_data = NULL;
 
-	List_Lock(list);
+	List_ReadLock(list);
 	p_data = List_GetHeadDataNL(list);
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
 	return p_data;
 }
@@ -700,7 +1181,7 @@ void* List_GetHeadDataNL(List_t list)
 	List_st* p_list = CONVERT_2_LIST(list);
 	void *   p_data = NULL;
 
-    if (p_list->nodeCount == 0)
+    if (LIST_COUNTER_GET(p_list->nodeCount) == 0)
     {
         return NULL;
     }
@@ -715,6 +1196,10 @@ void* List_GetHeadDataNL(List_t list)
 		SGListNode_st* p_node = (SGListNode_st*)p_list->p_head;
 		p_data = p_node->p_data;
 	}
+	else if (p_list->type == LIST_TYPE_UNROLLED)
+	{
+		p_data = UList_GetNodeData(list, p_list->p_head);
+	}
 	else
 	{
 		LOG_E("Invalid list type:%d.\n", p_list->type);
@@ -729,9 +1214,9 @@ void* List_GetTailData(List_t list)
 
 	void* p_data = NULL;
 
-	List_Lock(list);
+	List_ReadLock(list);
 	p_data = List_GetTailDataNL(list);
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
 	return p_data;
 }
@@ -742,7 +1227,7 @@ void* List_GetTailDataNL(List_t list)
 	List_st* p_list = CONVERT_2_LIST(list);
 	void *   p_data = NULL;
 
-    if (p_list->nodeCount == 0)
+    if (LIST_COUNTER_GET(p_list->nodeCount) == 0)
     {
         return NULL;
     }
@@ -757,6 +1242,10 @@ void* List_GetTailDataNL(List_t list)
 		SGListNode_st* p_node = (SGListNode_st*)p_list->p_tail;
 		p_data = p_node->p_data;
 	}
+	else if (p_list->type == LIST_TYPE_UNROLLED)
+	{
+		p_data = UList_GetNodeData(list, p_list->p_tail);
+	}
 	else
 	{
 		LOG_E("Invalid list type:%d.\n", p_list->type);
@@ -771,26 +1260,17 @@ CdataCount_t List_GetMachCount(List_t list, void* p_keyword)
     CHECK_PARAM(p_keyword != NULL, 0);
 
 	List_st* 	 p_list = CONVERT_2_LIST(list);
-	void *	 	 p_head = NULL;
-	void *		 p_data = NULL;
 	CdataCount_t count  = 0;
 
-	if (p_list->equal2KeywordFn == NULL)
+	if (!LIST_CAN_MATCH_KEYWORD(p_list))
 	{
 		LOG_E("equal2KeywordFn is NULL, pls set a valid equal2KeywordFn first.\n");
 		return 0;
 	}
 
-	List_Lock(list);
-	for (p_head = p_list->p_head; p_head != NULL; p_head = List_GetNextNodeNL(list, p_head))
-	{
-		p_data = List_GetNodeDataNL(list, p_head);
-		if (p_list->equal2KeywordFn(p_data, p_keyword))
-		{
-			count++;
-		}
-	}
-	List_UnLock(list);
+	List_ReadLock(list);
+	count = CountMatchNodesNL(p_list, p_keyword);
+	List_ReadUnLock(list);
 
 	return count;
 }
@@ -805,7 +1285,7 @@ CdataCount_t List_GetMachCountByCond(List_t list, void* p_userData, List_Conditi
 	void *		 p_data = NULL;
 	CdataCount_t count  = 0;
 
-	List_Lock(list);
+	List_ReadLock(list);
 	for (p_head = p_list->p_head; p_head != NULL; p_head = List_GetNextNodeNL(list, p_head))
 	{
 		p_data = List_GetNodeDataNL(list, p_head);
@@ -814,7 +1294,7 @@ CdataCount_t List_GetMachCountByCond(List_t list, void* p_userData, List_Conditi
 			count++;
 		}
 	}
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
 	return count;
 }
@@ -828,22 +1308,19 @@ void* List_GetData(List_t list, void* p_keyword)
 	void *	 	 p_head = NULL;
 	void *		 p_data = NULL;
 
-	if (p_list->equal2KeywordFn == NULL)
+	if (!LIST_CAN_MATCH_KEYWORD(p_list))
 	{
 		LOG_E("equal2KeywordFn is NULL, pls set a valid equal2KeywordFn first.\n");
 		return NULL;
 	}
 
-	List_Lock(list);
-	for (p_head = p_list->p_head; p_head != NULL; p_head = List_GetNextNodeNL(list, p_head))
+	List_ReadLock(list);
+	p_head = FindFirstMatchNodeNL(p_list, p_keyword);
+	if (p_head != NULL)
 	{
 		p_data = List_GetNodeDataNL(list, p_head);
-		if (p_list->equal2KeywordFn(p_data, p_keyword))
-		{
-			break;
-		}
 	}
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
 	return p_data;
 }
@@ -856,7 +1333,7 @@ void* List_GetDataByCond(List_t list, void* p_userData, List_Condition_fn condit
 	void *	 	 p_head = NULL;
 	void *		 p_data = NULL;
 
-	List_Lock(list);
+	List_ReadLock(list);
 	for (p_head = p_list->p_head; p_head != NULL; p_head = List_GetNextNodeNL(list, p_head))
 	{
 		p_data = List_GetNodeDataNL(list, p_head);
@@ -865,7 +1342,7 @@ void* List_GetDataByCond(List_t list, void* p_userData, List_Condition_fn condit
 			break;
 		}
 	}
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
 	return p_data;
 }
@@ -875,20 +1352,16 @@ void* List_GetDataAtPos(List_t list, CdataIndex_t posIndex)
 	CHECK_PARAM(list != NULL, NULL);
 
 	List_st*     p_list = CONVERT_2_LIST(list);
-	void *	 	 p_head = NULL;
+	void *	 	 p_node = NULL;
 	void *		 p_data = NULL;
-	CdataIndex_t pos    = 0;
 
-	List_Lock(list);
-	for (p_head = p_list->p_head, pos = 0; p_head != NULL; p_head = List_GetNextNodeNL(list, p_head), pos++)
+	List_ReadLock(list);
+	p_node = GetNodeAtPosNL(p_list, posIndex);
+	if (p_node != NULL)
 	{
-		if (pos == posIndex)
-		{
-			p_data = List_GetNodeDataNL(list, p_head);
-			break;
-		}
+		p_data = List_GetNodeDataNL(list, p_node);
 	}
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
 	return p_data;
 }
@@ -908,7 +1381,7 @@ void* List_DetachData(List_t list, void* p_keyword)
 		LOG_E("Node is NULL.\n");
 		return NULL;
 	}
-	p_data = List_DetachNodeData(list, node);
+	p_data = DetachNodeData(list, node);
 
 	ret = List_DestroyNode(list, node);
 	if (ret != ERR_OK)
@@ -933,7 +1406,7 @@ void* List_DetachDataByCond(List_t list, void* p_userData, List_Condition_fn con
 		LOG_E("Node is NULL.\n");
 		return NULL;
 	}
-	p_data = List_DetachNodeData(list, node);
+	p_data = DetachNodeData(list, node);
 
 	ret = List_DestroyNode(list, node);
 	if (ret != ERR_OK)
@@ -958,7 +1431,7 @@ void* List_DetachHeadData(List_t list)
 		LOG_E("Fail to detach head node.\n");
 		return NULL;
 	}
-	p_data = List_DetachNodeData(list, p_head);
+	p_data = DetachNodeData(list, p_head);
 
 	ret = List_DestroyNode(list, p_head);
 	if (ret != ERR_OK)
@@ -983,7 +1456,7 @@ void* List_DetachTailData(List_t list)
 		LOG_E("Fail to detach tail node.\n");
 		return NULL;
 	}
-	p_data = List_DetachNodeData(list, p_tail);
+	p_data = DetachNodeData(list, p_tail);
 
 	ret = List_DestroyNode(list, p_tail);
 	if (ret != ERR_OK)
@@ -1008,7 +1481,7 @@ void* List_DetachDataAtPos(List_t list, CdataIndex_t posIndex)
 		LOG_E("Fail to detach node at pos:%llu.\n", posIndex);
 		return NULL;
 	}
-	p_data = List_DetachNodeData(list, node);
+	p_data = DetachNodeData(list, node);
 
 	ret = List_DestroyNode(list, node);
 	if (ret != ERR_OK)
@@ -1037,6 +1510,11 @@ int List_CreateNode(List_t list, void* p_data, ListNode_t* p_node)
 	{
 		return SGList_CreateNode(list, p_data, p_node);
 	}
+	else if (p_list->type == LIST_TYPE_UNROLLED)
+	{
+		LOG_E("The node of unrolled list can't be created alone, pls insert the data instead.\n");
+		return ERR_BAD_PARAM;
+	}
 	else
 	{
 		LOG_E("Invalid list type:%d.\n", p_list->type);
@@ -1045,6 +1523,22 @@ int List_CreateNode(List_t list, void* p_data, ListNode_t* p_node)
 	return ERR_FAIL;
 }
 
+ListNode_t List_GetNodeOfData(List_t list, void* p_data)
+{
+	CHECK_PARAM(list != NULL, NULL);
+	CHECK_PARAM(p_data != NULL, NULL);
+
+	List_st* p_list = CONVERT_2_LIST(list);
+
+	if (p_list->dataType != LIST_DATA_TYPE_INTRUSIVE)
+	{
+		LOG_E("List:'%s' is not intrusive.\n", p_list->name);
+		return NULL;
+	}
+
+	return LIST_INTRUSIVE_NODE(p_list, p_data);
+}
+
 int List_DestroyNode(List_t list, ListNode_t node)
 {
 	CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
@@ -1053,6 +1547,23 @@ int List_DestroyNode(List_t list, ListNode_t node)
 	List_st* p_list = CONVERT_2_LIST(list);
 	void *   p_data = NULL;
 
+	//The lock-free readers may still be walking through the node.
+	if (p_list->retireList != NULL)
+	{
+		return Rcu_Retire(p_list->retireList, node);
+	}
+
+	//The intrusive node is a part of the data, nothing else to free.
+	if (p_list->dataType == LIST_DATA_TYPE_INTRUSIVE)
+	{
+		p_data = ((SGListNode_st*)node)->p_data;
+		if (p_data != NULL && p_list->freeFn != NULL)
+		{
+			p_list->freeFn(p_data);
+		}
+		return ERR_OK;
+	}
+
 	if (p_list->type == LIST_TYPE_DOUBLE_LINK)
 	{
 		DBListNode_st *p_node = (DBListNode_st*)node;
@@ -1063,25 +1574,28 @@ int List_DestroyNode(List_t list, ListNode_t node)
 		SGListNode_st *p_node = (SGListNode_st*)node;
 		p_data = p_node->p_data;
 	}
+	else if (p_list->type == LIST_TYPE_UNROLLED)
+	{
+		//The slot belongs to the block, it's given back after the data is freed.
+		FreeNodeData(p_list, node, UList_GetNodeData(list, node));
+		return UList_DestroyNode(list, node);
+	}
 	else
 	{
 		LOG_E("Invalid list type:%d.\n", p_list->type);
 		return ERR_BAD_PARAM;
 	}
 
-	OS_Free(node);
-	if (p_data == NULL)
-	{
-		return ERR_OK;
-	}
+	//The data may be stored in the node memory, so free it before the node.
+	FreeNodeData(p_list, node, p_data);
 
-	if (p_list->freeFn != NULL)
+	if (p_list->pool != NULL)
 	{
-		p_list->freeFn(p_data);
+		NodePool_Free(p_list->pool, node);
 	}
 	else
 	{
-		OS_Free(p_data);
+		OS_Free(node);
 	}
 
 	return ERR_OK;
@@ -1096,19 +1610,7 @@ int List_InsertNode(List_t list, ListNode_t node)
 	List_st* p_list = CONVERT_2_LIST(list);
 
 	List_Lock(list);
-	if (p_list->type == LIST_TYPE_DOUBLE_LINK)
-	{
-		ret = DBList_InsertNode(list, node);
-	}
-	else if (p_list->type == LIST_TYPE_SINGLE_LINK)
-	{
-		ret = SGList_InsertNode(list, node);
-	}
-	else
-	{
-		LOG_E("Invalid list type:%d.\n", p_list->type);
-		ret = ERR_BAD_PARAM;
-	}
+	ret = InsertNodeNL(p_list, node);
 	List_UnLock(list);
 
 	return ret;
@@ -1123,19 +1625,7 @@ int List_InsertNode2Head(List_t list, ListNode_t node)
 	List_st* p_list = CONVERT_2_LIST(list);
 
 	List_Lock(list);
-	if (p_list->type == LIST_TYPE_DOUBLE_LINK)
-	{
-		ret = DBList_InsertNode2Head(list, node);
-	}
-	else if (p_list->type == LIST_TYPE_SINGLE_LINK)
-	{
-		ret = SGList_InsertNode2Head(list, node);
-	}
-	else
-	{
-		LOG_E("Invalid list type:%d.\n", p_list->type);
-		ret = ERR_BAD_PARAM;
-	}
+	ret = InsertNode2HeadNL(p_list, node);
 	List_UnLock(list);
 
 	return ret;
@@ -1150,19 +1640,7 @@ int List_InsertNodeAsc(List_t list, ListNode_t node)
 	List_st* p_list = CONVERT_2_LIST(list);
 
 	List_Lock(list);
-	if (p_list->type == LIST_TYPE_DOUBLE_LINK)
-	{
-		ret = DBList_InsertNodeAsc(list, node);
-	}
-	else if (p_list->type == LIST_TYPE_SINGLE_LINK)
-	{
-		ret = SGList_InsertNodeAsc(list, node);
-	}
-	else
-	{
-		LOG_E("Invalid list type:%d.\n", p_list->type);
-		ret = ERR_BAD_PARAM;
-	}
+	ret = InsertNodeAscNL(p_list, node);
 	List_UnLock(list);
 
 	return ret;
@@ -1177,7 +1655,11 @@ int List_InsertNodeDes(List_t list, ListNode_t node)
 	List_st* p_list = CONVERT_2_LIST(list);
 
 	List_Lock(list);
-	if (p_list->type == LIST_TYPE_DOUBLE_LINK)
+	if (LIST_IS_SORTED(p_list))
+	{
+		ret = InsertNodeSortedNL(p_list, node, LIST_SORT_DES);
+	}
+	else if (p_list->type == LIST_TYPE_DOUBLE_LINK)
 	{
 		ret = DBList_InsertNodeDes(list, node);
 	}
@@ -1203,7 +1685,7 @@ int List_InsertNodeUni(List_t list, ListNode_t node)
 	int ret          = ERR_OK;
 	List_st* p_list  = CONVERT_2_LIST(list);
 
-	if (p_list->nodeEqualFn == NULL)
+	if (!LIST_CAN_COMPARE_EQUAL(p_list))
 	{
 		LOG_E("nodeEqualFn is NULL, pls set a valid function first.\n");
 		return ERR_BAD_PARAM;
@@ -1231,7 +1713,7 @@ int List_InsertNode2HeadUni(List_t list, ListNode_t node)
 	int ret          = ERR_OK;
 	List_st* p_list  = CONVERT_2_LIST(list);
 
-	if (p_list->nodeEqualFn == NULL)
+	if (!LIST_CAN_COMPARE_EQUAL(p_list))
 	{
 		LOG_E("nodeEqualFn is NULL, pls set a valid function first.\n");
 		return ERR_BAD_PARAM;
@@ -1334,8 +1816,7 @@ int List_InsertNodeAtPos(List_t list, ListNode_t node, CdataIndex_t posIndex)
 
 	int ret         = ERR_OK;
 	List_st* p_list = CONVERT_2_LIST(list);
-	void*    p_head = NULL;
-	CdataIndex_t i  = 0;
+	void*    p_pre  = NULL;
 
 	if (posIndex <= 0)
 	{
@@ -1360,13 +1841,15 @@ int List_InsertNodeAtPos(List_t list, ListNode_t node, CdataIndex_t posIndex)
 	}
 
 	List_Lock(list);
-	for (p_head = p_list->p_head, i = 0; p_head != NULL; p_head = List_GetNextNodeNL(list, p_head), i++)
+	p_pre = GetNodeAtPosNL(p_list, posIndex - 1);
+	if (p_pre != NULL)
 	{
-		if (i == (posIndex - 1))
-		{
-			ret = List_InsertNodeAfterNL(list, p_head, node);
-			break;
-		}
+		ret = List_InsertNodeAfterNL(list, p_pre, node);
+	}
+	else
+	{
+		LOG_E("Not find node at pos:%llu.\n", posIndex - 1);
+		ret = ERR_DATA_NOT_EXISTS;
 	}
 	List_UnLock(list);
 
@@ -1379,17 +1862,10 @@ ListNode_t List_GetNodeAtPos(List_t list, CdataIndex_t posIndex)
 
 	List_st* p_list = CONVERT_2_LIST(list);
 	ListNode_t node = NULL;
-	CdataIndex_t pos = 0;
 
-	List_Lock(list);
-	for (node = p_list->p_head, pos = 0; node != NULL; node = List_GetNextNodeNL(list, node), pos++)
-	{
-		if (pos == posIndex)
-		{
-			break;
-		}
-	}
-	List_UnLock(list);
+	List_ReadLock(list);
+	node = GetNodeAtPosNL(p_list, posIndex);
+	List_ReadUnLock(list);
 
 	return node;
 }
@@ -1400,9 +1876,9 @@ ListNode_t List_GetHead(List_t list)
 
 	ListNode_t node = NULL;
 
-	List_Lock(list);
+	List_ReadLock(list);
 	node = List_GetHeadNL(list);
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
 	return node;
 }
@@ -1420,9 +1896,9 @@ ListNode_t List_GetTail(List_t list)
 
 	ListNode_t node = NULL;
 
-	List_Lock(list);
+	List_ReadLock(list);
 	node = List_GetTailNL(list);
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
 	return node;
 }
@@ -1441,9 +1917,9 @@ ListNode_t List_GetPreNode(List_t list,ListNode_t node)
 
 	ListNode_t preNode = NULL;
 
-	List_Lock(list);
+	List_ReadLock(list);
 	preNode = List_GetPreNodeNL(list, node);
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
 	return preNode;
 }
@@ -1459,6 +1935,10 @@ ListNode_t List_GetPreNodeNL(List_t list,ListNode_t node)
 		LOG_E("Hasn't pre node on a single list node.\n");
 		return NULL;
 	}
+	else if (p_list->type == LIST_TYPE_UNROLLED)
+	{
+		return UList_GetPreNode(list, node);
+	}
 
 	DBListNode_st *p_node = (DBListNode_st*)node;
 	return p_node->p_pre;
@@ -1471,9 +1951,9 @@ ListNode_t List_GetNextNode(List_t list, ListNode_t node)
 
 	ListNode_t nextNode = NULL;
 
-	List_Lock(list);
+	List_ReadLock(list);
 	nextNode = List_GetNextNodeNL(list, node);
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
 	return nextNode;
 }
@@ -1495,6 +1975,10 @@ ListNode_t List_GetNextNodeNL(List_t list, ListNode_t node)
 		SGListNode_st *p_listNode = (SGListNode_st*)node;
 		nextNode = p_listNode->p_next;
 	}
+	else if (p_list->type == LIST_TYPE_UNROLLED)
+	{
+		nextNode = UList_GetNextNode(list, node);
+	}
 	else
 	{
 		LOG_E("Invalid list type:%d.\n", p_list->type);
@@ -1510,9 +1994,9 @@ void*  List_GetNodeData(List_t list, ListNode_t node)
 
 	void *p_data = NULL;
 
-	List_Lock(list);
+	List_ReadLock(list);
 	p_data = List_GetNodeDataNL(list, node);
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
 	return p_data;
 }
@@ -1534,6 +2018,10 @@ void*  List_GetNodeDataNL(List_t list, ListNode_t node)
 		SGListNode_st *p_listNode = (SGListNode_st*)node;
 		p_data = p_listNode->p_data;
 	}
+	else if (p_list->type == LIST_TYPE_UNROLLED)
+	{
+		p_data = UList_GetNodeData(list, node);
+	}
 	else
 	{
 		LOG_E("Invalid list type:%d.\n", p_list->type);
@@ -1547,6 +2035,13 @@ void*  List_DetachNodeData(List_t list, ListNode_t node)
 	CHECK_PARAM(list != NULL, NULL);
     CHECK_PARAM(node != NULL, NULL);
 
+	//The node of the intrusive list is a part of the data, they can't be separated.
+	if ((CONVERT_2_LIST(list))->dataType == LIST_DATA_TYPE_INTRUSIVE)
+	{
+		LOG_E("The data of intrusive list:'%s' can't be detached from its node.\n", (CONVERT_2_LIST(list))->name);
+		return NULL;
+	}
+
 	void *p_data = NULL;
 
 	List_Lock(list);
@@ -1560,24 +2055,70 @@ void*  List_DetachNodeDataNL(List_t list, ListNode_t node)
     CHECK_PARAM(list != NULL, NULL);
     CHECK_PARAM(node != NULL, NULL);
 
-	void*    p_data = NULL;
-	List_st* p_list = CONVERT_2_LIST(list);
+	if ((CONVERT_2_LIST(list))->dataType == LIST_DATA_TYPE_INTRUSIVE)
+	{
+		LOG_E("The data of intrusive list:'%s' can't be detached from its node.\n", (CONVERT_2_LIST(list))->name);
+		return NULL;
+	}
 
-	if (p_list->type == LIST_TYPE_DOUBLE_LINK)
+	void* p_data = DetachNodeDataNL(CONVERT_2_LIST(list), node);
+
+	//The node may be still linked, the lock-free readers which have got the data must leave it before user frees it.
+	if (p_data != NULL && (CONVERT_2_LIST(list))->retireList != NULL)
 	{
-		DBListNode_st *p_listNode = (DBListNode_st*)node;
-		p_data = p_listNode->p_data;
-		p_listNode->p_data = NULL;
+		Rcu_Synchronize();
 	}
-	else if (p_list->type == LIST_TYPE_SINGLE_LINK)
+
+	return p_data;
+}
+
+//Only for the node which has been unlinked.
+static void* DetachNodeData(List_t list, ListNode_t node)
+{
+	void *p_data = NULL;
+
+	//The lock-free readers may still stand on the node, they leave it before the data is taken, so they never see it NULL.
+	if ((CONVERT_2_LIST(list))->retireList != NULL)
 	{
-		SGListNode_st *p_listNode = (SGListNode_st*)node;
-		p_data = p_listNode->p_data;
-		p_listNode->p_data = NULL;
+		Rcu_Synchronize();
 	}
-	else
+
+	List_Lock(list);
+	p_data = DetachNodeDataNL(CONVERT_2_LIST(list), node);
+	List_UnLock(list);
+
+	return p_data;
+}
+
+static void* DetachNodeDataNL(List_st* p_list, ListNode_t node)
+{
+	void* p_data = NULL;
+	void* p_copy = NULL;
+
+	//The data lives in the node memory, user will get a copy of it. The copy is allocated first,
+	//so the data stays in the node if there is no memory.
+	p_data = List_GetNodeDataNL(p_list, node);
+	if (LIST_IS_INLINE_DATA(p_list, node, p_data))
 	{
-		LOG_E("Invalid list type:%d.\n", p_list->type);
+		p_copy = OS_Malloc(p_list->dataLength);
+		if (p_copy == NULL)
+		{
+			LOG_E("Not enough memory to detach node data.\n");
+			return NULL;
+		}
+	}
+
+	//The node without data cannot be found by keyword any longer.
+	if (p_list->p_hashIndex != NULL)
+	{
+		RemoveFromHashIndex(p_list, node);
+	}
+
+	p_data = TakeNodeData(p_list, node);
+	if (p_copy != NULL)
+	{
+		memcpy(p_copy, p_data, p_list->dataLength);
+		p_data = p_copy;
 	}
 
 	return p_data;
@@ -1589,26 +2130,18 @@ ListNode_t List_GetFirstMatchNode(List_t list, void* p_userData)
     CHECK_PARAM(p_userData != NULL, NULL);
 
 	void* 	p_node = NULL;
-	void *	p_data = NULL;
 
 	List_st* p_list = CONVERT_2_LIST(list);
 
-	if (p_list->equal2KeywordFn == NULL)
+	if (!LIST_CAN_MATCH_KEYWORD(p_list))
 	{
 		LOG_E("equal2KeywordFn is NULL, pls set a valid equal2KeywordFn first.\n");
 		return NULL;
 	}
 
-	List_Lock(list);
-	for (p_node = List_GetHeadNL(list); p_node != NULL; p_node = List_GetNextNodeNL(list, p_node))
-	{
-		p_data = List_GetNodeDataNL(list, p_node);
-		if (p_list->equal2KeywordFn(p_data, p_userData))
-		{
-			break;
-		}
-	}
-	List_UnLock(list);
+	List_ReadLock(list);
+	p_node = FindFirstMatchNodeNL(p_list, p_userData);
+	List_ReadUnLock(list);
 
 	return p_node;
 }
@@ -1623,22 +2156,22 @@ ListNode_t List_GetNextMatchNode(List_t list, ListNode_t startNode, void* p_user
 	List_st* p_list = CONVERT_2_LIST(list);
 
 
-	if (p_list->equal2KeywordFn == NULL)
+	if (!LIST_CAN_MATCH_KEYWORD(p_list))
 	{
 		LOG_E("equal2KeywordFn is NULL, pls set a valid equal2KeywordFn first.\n");
 		return NULL;
 	}
 
-	List_Lock(list);
+	List_ReadLock(list);
 	for (p_node = startNode; p_node != NULL; p_node = List_GetNextNodeNL(list, p_node))
 	{
 		p_data = List_GetNodeDataNL(list, p_node);
-		if (p_list->equal2KeywordFn(p_data, p_userData))
+		if (List_MatchKeyword(p_list, p_data, p_userData))
 		{
 			break;
 		}
 	}
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
 	return p_node;
 }
@@ -1658,22 +2191,22 @@ ListNode_t List_GetLastMatchNode(List_t list, void* p_userData)
 		return NULL;
 	}
 
-	if (p_list->equal2KeywordFn == NULL)
+	if (!LIST_CAN_MATCH_KEYWORD(p_list))
 	{
 		LOG_E("equal2KeywordFn is NULL, pls set a valid equal2KeywordFn first.\n");
 		return NULL;
 	}
 
-	List_Lock(list);
+	List_ReadLock(list);
 	for (p_node = List_GetTailNL(list); p_node != NULL; p_node = List_GetPreNodeNL(list, p_node))
 	{
 		p_data = List_GetNodeDataNL(list, p_node);
-		if (p_list->equal2KeywordFn(p_data, p_userData))
+		if (List_MatchKeyword(p_list, p_data, p_userData))
 		{
 			break;
 		}
 	}
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
 	return p_node;
 }
@@ -1693,22 +2226,22 @@ ListNode_t List_GetPreMatchNode(List_t list, ListNode_t startNode, void* p_userD
 		return NULL;
 	}
 
-	if (p_list->equal2KeywordFn == NULL)
+	if (!LIST_CAN_MATCH_KEYWORD(p_list))
 	{
 		LOG_E("equal2KeywordFn is NULL, pls set a valid equal2KeywordFn first.\n");
 		return NULL;
 	}
 
-	List_Lock(list);
+	List_ReadLock(list);
 	for (p_node = startNode; p_node != NULL; p_node = List_GetPreNodeNL(list, p_node))
 	{
 		p_data = List_GetNodeDataNL(list, p_node);
-		if (p_list->equal2KeywordFn(p_data, p_userData))
+		if (List_MatchKeyword(p_list, p_data, p_userData))
 		{
 			break;
 		}
 	}
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
 	return p_node;
 }
@@ -1721,7 +2254,7 @@ ListNode_t List_GetFirstMatchNodeByCond(List_t list, void* p_userData, List_Cond
 	void* 	p_node = NULL;
 	void *	p_data = NULL;
 
-	List_Lock(list);
+	List_ReadLock(list);
 	for (p_node = List_GetHeadNL(list); p_node != NULL; p_node = List_GetNextNodeNL(list, p_node))
 	{
 		p_data = List_GetNodeDataNL(list, p_node);
@@ -1730,7 +2263,7 @@ ListNode_t List_GetFirstMatchNodeByCond(List_t list, void* p_userData, List_Cond
 			break;
 		}
 	}
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
 	return p_node;
 }
@@ -1743,7 +2276,7 @@ ListNode_t List_GetNextMatchNodeByCond(List_t list, ListNode_t startNode, void*
 	void* 	p_node = NULL;
 	void *	p_data = NULL;
 
-	List_Lock(list);
+	List_ReadLock(list);
 	for (p_node = startNode; p_node != NULL; p_node = List_GetNextNodeNL(list, p_node))
 	{
 		p_data = List_GetNodeDataNL(list, p_node);
@@ -1752,7 +2285,7 @@ ListNode_t List_GetNextMatchNodeByCond(List_t list, ListNode_t startNode, void*
 			break;
 		}
 	}
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
 	return p_node;
 }
@@ -1772,7 +2305,7 @@ ListNode_t List_GetLastMatchNodeByCond(List_t list, void* p_userData, List_Condi
 		return NULL;
 	}
 
-	List_Lock(list);
+	List_ReadLock(list);
 	for (p_node = List_GetTailNL(list); p_node != NULL; p_node = List_GetPreNodeNL(list, p_node))
 	{
 		p_data = List_GetNodeDataNL(list, p_node);
@@ -1781,7 +2314,7 @@ ListNode_t List_GetLastMatchNodeByCond(List_t list, void* p_userData, List_Condi
 			break;
 		}
 	}
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
 	return p_node;
 }
@@ -1801,7 +2334,7 @@ ListNode_t List_GetPreMatchNodeByCond(List_t list, ListNode_t startNode, void* p
 		return NULL;
 	}
 
-	List_Lock(list);
+	List_ReadLock(list);
 	for (p_node = startNode; p_node != NULL; p_node = List_GetPreNodeNL(list, p_node))
 	{
 		p_data = List_GetNodeDataNL(list, p_node);
@@ -1810,26 +2343,101 @@ ListNode_t List_GetPreMatchNodeByCond(List_t list, ListNode_t startNode, void* p
 			break;
 		}
 	}
-	List_UnLock(list);
+	List_ReadUnLock(list);
 
 	return p_node;
 }
 
-int List_Swap(List_t list, ListNode_t firstNode, ListNode_t secondNode)
+ListNode_t List_GetLowerBoundNode(List_t list, void* p_data)
 {
-    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
-	CHECK_PARAM(firstNode != NULL, ERR_BAD_PARAM);
-    CHECK_PARAM(secondNode != NULL, ERR_BAD_PARAM);
+	CHECK_PARAM(list != NULL, NULL);
+	CHECK_PARAM(p_data != NULL, NULL);
 
-	List_st* p_list = CONVERT_2_LIST(list);
-	int      ret    = ERR_OK;
+	ListNode_t node = NULL;
+	List_st*   p_list = CONVERT_2_LIST(list);
 
-	List_Lock(list);
-	if (p_list->type == LIST_TYPE_SINGLE_LINK)
-	{
-        SGListNode_st* p_firstNode = (SGListNode_st*)firstNode;
-        SGListNode_st* p_secondNode = (SGListNode_st*)secondNode;
-        void *p_data = NULL;
+	List_ReadLock(list);
+	node = SeekSortedNL(p_list, p_data, LowerBoundAdvance);
+	List_ReadUnLock(list);
+
+	return node;
+}
+
+ListNode_t List_GetUpperBoundNode(List_t list, void* p_data)
+{
+	CHECK_PARAM(list != NULL, NULL);
+	CHECK_PARAM(p_data != NULL, NULL);
+
+	ListNode_t node = NULL;
+	List_st*   p_list = CONVERT_2_LIST(list);
+
+	List_ReadLock(list);
+	node = SeekSortedNL(p_list, p_data, UpperBoundAdvance);
+	List_ReadUnLock(list);
+
+	return node;
+}
+
+ListNode_t List_GetFirstOrderedMatchNode(List_t list, void* p_data)
+{
+	CHECK_PARAM(list != NULL, NULL);
+	CHECK_PARAM(p_data != NULL, NULL);
+
+	ListNode_t node = NULL;
+	List_st*   p_list = CONVERT_2_LIST(list);
+
+	List_ReadLock(list);
+	node = SeekSortedNL(p_list, p_data, LowerBoundAdvance);
+	if (node != NULL && IsBefore(p_list, p_data, List_GetNodeDataNL(list, node)))
+	{
+		node = NULL;
+	}
+	List_ReadUnLock(list);
+
+	return node;
+}
+
+int List_Swap(List_t list, ListNode_t firstNode, ListNode_t secondNode)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+	CHECK_PARAM(firstNode != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(secondNode != NULL, ERR_BAD_PARAM);
+
+	List_st*  p_list = CONVERT_2_LIST(list);
+	int       ret    = ERR_OK;
+	void*     p_firstData  = NULL;
+	void*     p_secondData = NULL;
+	CdataBool firstIndexed  = CDATA_FALSE;
+	CdataBool secondIndexed = CDATA_FALSE;
+
+	//The data of intrusive list can't leave the link embedded in it.
+	if (p_list->dataType == LIST_DATA_TYPE_INTRUSIVE)
+	{
+		LOG_E("The data of intrusive list:'%s' can't be swapped.\n", p_list->name);
+		return ERR_BAD_PARAM;
+	}
+
+	List_Lock(list);
+	//The hash of the node data will be changed.
+	if (p_list->p_hashIndex != NULL)
+	{
+		firstIndexed  = RemoveFromHashIndex(p_list, firstNode);
+		secondIndexed = RemoveFromHashIndex(p_list, secondNode);
+	}
+
+	p_firstData  = List_GetNodeDataNL(list, firstNode);
+	p_secondData = List_GetNodeDataNL(list, secondNode);
+
+	//The data stored in node memory cannot leave its node, so swap the content.
+	if (LIST_IS_INLINE_DATA(p_list, firstNode, p_firstData) || LIST_IS_INLINE_DATA(p_list, secondNode, p_secondData))
+	{
+		ret = SwapDataContent(p_list, p_firstData, p_secondData);
+	}
+	else if (p_list->type == LIST_TYPE_SINGLE_LINK)
+	{
+        SGListNode_st* p_firstNode = (SGListNode_st*)firstNode;
+        SGListNode_st* p_secondNode = (SGListNode_st*)secondNode;
+        void *p_data = NULL;
 
         p_data = p_secondNode->p_data;
         p_secondNode->p_data = p_firstNode->p_data;
@@ -1850,11 +2458,91 @@ int List_Swap(List_t list, ListNode_t firstNode, ListNode_t secondNode)
         LOG_E("Wrong list type:%d.\n", p_list->type);
         ret = ERR_BAD_PARAM;
     }
+
+	if (firstIndexed && p_list->p_hashIndex != NULL)
+	{
+		AddToHashIndex(p_list, firstNode);
+	}
+	if (secondIndexed && p_list->p_hashIndex != NULL)
+	{
+		AddToHashIndex(p_list, secondNode);
+	}
+	if (LIST_HAS_KEY_COLUMN(p_list))
+	{
+		UpdateKeyColumn(p_list, firstNode);
+		UpdateKeyColumn(p_list, secondNode);
+	}
 	List_UnLock(list);
 
 	return ret;
 }
 
+int List_Sort(List_t list, List_UserLtNode_fn ltFn)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+
+	List_st*   p_list = CONVERT_2_LIST(list);
+	ListNode_t bins[LIST_SORT_BINS];
+	ListNode_t node   = NULL;
+	ListNode_t next   = NULL;
+	ListNode_t run    = NULL;
+	int        i      = 0;
+
+	//NULL ltFn makes MergeRuns compare the key field.
+	if (ltFn == NULL && !LIST_HAS_KEY_FIELD(p_list))
+	{
+		ltFn = p_list->usrLtNodeFn;
+	}
+
+	if (ltFn == NULL && !LIST_HAS_KEY_FIELD(p_list))
+	{
+		LOG_E("List:'%s' has no List_UserLtNode_fn to sort.\n", p_list->name);
+		return ERR_BAD_PARAM;
+	}
+
+	if (LIST_IS_SORTED(p_list) || p_list->retireList != NULL || p_list->type == LIST_TYPE_UNROLLED)
+	{
+		LOG_E("Can't sort list:'%s', it keeps its own order, has lock-free readers or is unrolled.\n", p_list->name);
+		return ERR_BAD_PARAM;
+	}
+
+	memset(bins, 0, sizeof(bins));
+
+	List_Lock(list);
+	/*
+	 * Bottom-up merge: every node is merged into the bins like adding 1 to a binary counter, so the runs
+	 * are merged while they are still hot in the cache, and no memory is needed besides the bins.
+	 */
+	for (node = p_list->p_head; node != NULL; node = next)
+	{
+		next = LIST_CHAIN_NEXT(node);
+		LIST_CHAIN_NEXT(node) = NULL;
+
+		run = node;
+		for (i = 0; i < LIST_SORT_BINS - 1 && bins[i] != NULL; i++)
+		{
+			//The runs in the bins are always before the new one in the list order, it keeps the sort stable.
+			run = MergeRuns(p_list, ltFn, bins[i], run);
+			bins[i] = NULL;
+		}
+		bins[i] = (bins[i] == NULL) ? run : MergeRuns(p_list, ltFn, bins[i], run);
+	}
+
+	run = NULL;
+	for (i = 0; i < LIST_SORT_BINS; i++)
+	{
+		if (bins[i] != NULL)
+		{
+			run = (run == NULL) ? bins[i] : MergeRuns(p_list, ltFn, bins[i], run);
+		}
+	}
+
+	RelinkSortedNL(p_list, run);
+	List_UnLock(list);
+
+	return ERR_OK;
+}
+
 int List_DetachNode(List_t list, ListNode_t node)
 {
     CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
@@ -1883,6 +2571,10 @@ int List_DetachNodeNL(List_t list, ListNode_t node)
 	{
 		return SGList_DetachNode(list, node);
 	}
+	else if (p_list->type == LIST_TYPE_UNROLLED)
+	{
+		return UList_DetachNode(list, node);
+	}
 	else
 	{
 		LOG_E("Invalid list type:%d.\n", p_list->type);
@@ -1943,15 +2635,21 @@ ListNode_t List_DetachNodeAtPos(List_t list, CdataIndex_t posIndex)
 
 	List_st* p_list = CONVERT_2_LIST(list);
 	void*    p_node = NULL;
-	CdataIndex_t i = 0;
+	void*    p_pre  = NULL;
 
 	List_Lock(list);
-	for (p_node = p_list->p_head, i = 0; p_node != NULL; p_node = List_GetNextNodeNL(list, p_node), i++)
+	if (p_list->type == LIST_TYPE_SINGLE_LINK && posIndex > 0)
+	{
+		//Find the pre node, so the single list need not search the node again when detaching.
+		p_pre = GetNodeAtPosNL(p_list, posIndex - 1);
+		p_node = (p_pre != NULL) ? List_DetachNextNodeNL(list, p_pre) : NULL;
+	}
+	else
 	{
-		if (i == posIndex)
+		p_node = GetNodeAtPosNL(p_list, posIndex);
+		if (p_node != NULL)
 		{
 			List_DetachNodeNL(list, p_node);
-			break;
 		}
 	}
 	List_UnLock(list);
@@ -1966,29 +2664,15 @@ ListNode_t List_DetachNodeByKey(List_t list, void* p_keyword)
 
 	List_st* p_list = CONVERT_2_LIST(list);
 	void*    p_node = NULL;
-	void*	 p_data = NULL;
 
-	if (p_list->equal2KeywordFn == NULL)
+	if (!LIST_CAN_MATCH_KEYWORD(p_list))
 	{
 		LOG_E("equal2KeywordFn is NULL, pls set a valid equal2KeywordFn first.\n");
 		return NULL;
 	}
 
 	List_Lock(list);
-	for (p_node = p_list->p_head; p_node != NULL; p_node = List_GetNextNodeNL(list, p_node))
-	{
-		p_data = List_GetNodeDataNL(list, p_node);
-		if (p_data == NULL)
-		{
-			continue;
-		}
-
-		if (p_list->equal2KeywordFn(p_data, p_keyword))
-		{
-			List_DetachNodeNL(list, p_node);
-			break;
-		}
-	}
+	p_node = DetachFirstMatchNodeNL(p_list, p_keyword);
 	List_UnLock(list);
 
 	return p_node;
@@ -1998,12 +2682,13 @@ ListNode_t List_DetachNodeByCond(List_t list, void* p_userData, List_Condition_f
     CHECK_PARAM(list != NULL, NULL);
 	CHECK_PARAM(conditionFn != NULL, NULL);
 
-	List_st* p_list = CONVERT_2_LIST(list);
-	void*    p_node = NULL;
-	void*	 p_data = NULL;
+	ListIter_t iter;
+	void*      p_node = NULL;
+	void*	   p_data = NULL;
 
 	List_Lock(list);
-	for (p_node = p_list->p_head; p_node != NULL; p_node = List_GetNextNodeNL(list, p_node))
+	List_IterInitNL(list, &iter);
+	while ((p_node = List_IterNextNL(list, &iter)) != NULL)
 	{
 		p_data = List_GetNodeDataNL(list, p_node);
 		if (p_data == NULL)
@@ -2013,7 +2698,7 @@ ListNode_t List_DetachNodeByCond(List_t list, void* p_userData, List_Condition_f
 
 		if (conditionFn(p_data, p_userData))
 		{
-			List_DetachNodeNL(list, p_node);
+			List_IterDetachNL(list, &iter);
 			break;
 		}
 	}
@@ -2022,414 +2707,2533 @@ ListNode_t List_DetachNodeByCond(List_t list, void* p_userData, List_Condition_f
 	return p_node;
 }
 
-int List_RmNode(List_t list, ListNode_t node)
+ListNode_t List_DetachNextNode(List_t list, ListNode_t preNode)
 {
-    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
-	CHECK_PARAM(node != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(list != NULL, NULL);
 
-	int ret = ERR_OK;
+	ListNode_t node = NULL;
 
 	List_Lock(list);
-	ret = List_RmNodeNL(list, node);
+	node = List_DetachNextNodeNL(list, preNode);
 	List_UnLock(list);
 
-	return ret;
+	return node;
 }
-int List_RmNodeNL(List_t list, ListNode_t node)
+
+ListNode_t List_DetachNextNodeNL(List_t list, ListNode_t preNode)
 {
-    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
-    CHECK_PARAM(node != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(list != NULL, NULL);
 
-	int ret = ERR_OK;
+	List_st*   p_list = CONVERT_2_LIST(list);
+	ListNode_t node   = NULL;
+	int        ret    = ERR_OK;
 
-	ret = List_DetachNodeNL(list, node);
-	if (ret != ERR_OK)
+	node = (preNode == NULL) ? p_list->p_head : List_GetNextNodeNL(list, preNode);
+	if (node == NULL)
 	{
-		LOG_E("Fail to detach node.\n");
-		return ERR_FAIL;
+		return NULL;
 	}
 
-	ret = List_DestroyNode(list, node);
-	if (ret != ERR_OK)
+	//The head of single list and any node of double list are detached in O(1) already.
+	if (p_list->type == LIST_TYPE_SINGLE_LINK && preNode != NULL)
 	{
-		LOG_E("Fail to destroy node.\n");
-		return ERR_FAIL;
+		ret = SGList_DetachNextNode(list, preNode);
 	}
-
-	return ERR_OK;
-}
-
-int List_RmHead(List_t list)
-{
-    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
-
-	int ret = ERR_OK;
-	ListNode_t node = NULL;
-
-
-	node = List_DetachHead(list);
-	if (node == NULL)
+	else
 	{
-		LOG_E("Fail to detach head.\n");
-		return ERR_FAIL;
+		ret = List_DetachNodeNL(list, node);
 	}
 
-	ret = List_DestroyNode(list, node);
 	if (ret != ERR_OK)
 	{
-		LOG_E("Fail to destroy node.\n");
-		ret = ERR_FAIL;
+		LOG_E("Fail to detach node.\n");
+		return NULL;
 	}
 
-	return ret;
+	return node;
 }
 
-int List_RmTail(List_t list)
+ListNode_t List_DetachHeadChain(List_t list, CdataCount_t max, CdataCount_t* p_count)
 {
-    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(list != NULL, NULL);
 
-	int ret = ERR_OK;
-	ListNode_t node = NULL;
+	List_st*     p_list = CONVERT_2_LIST(list);
+	ListNode_t   chain  = NULL;
+	ListNode_t   last   = NULL;
+	CdataCount_t count  = 0;
 
-	node = List_DetachTail(list);
-	if (node == NULL)
+	List_Lock(list);
+	chain = DetachHeadRunNL(p_list, max, &last, &count);
+	List_UnLock(list);
+
+	if (last != NULL)
 	{
-		LOG_E("Fail to detach tail.\n");
-		return ERR_FAIL;
+		//The last node still points to the list, unless the lock-free readers have left it, they need it to go on.
+		if (p_list->retireList != NULL)
+		{
+			Rcu_Synchronize();
+		}
+		LIST_CHAIN_NEXT(last) = NULL;
 	}
 
-	ret = List_DestroyNode(list, node);
-	if (ret != ERR_OK)
+	if (p_count != NULL)
 	{
-		LOG_E("Fail to destroy node.\n");
-		ret = ERR_FAIL;
+		*p_count = count;
 	}
 
-	return ret;
+	return chain;
 }
 
-int List_RmNodeAtPos(List_t list, CdataIndex_t posIndex)
+CdataCount_t List_DetachHeadBatch(List_t list, CdataCount_t max, void* p_dataArray)
 {
-    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(list != NULL, 0);
+    CHECK_PARAM(p_dataArray != NULL, 0);
 
-	int ret = ERR_OK;
-	ListNode_t node = NULL;
+	List_st*     p_list = CONVERT_2_LIST(list);
+	ListNode_t   node   = NULL;
+	ListNode_t   next   = NULL;
+	ListNode_t   last   = NULL;
+	void*        p_data = NULL;
+	CdataCount_t count  = 0;
+	CdataCount_t i      = 0;
 
-	node = List_DetachNodeAtPos(list, posIndex);
-	if (node == NULL)
+	List_Lock(list);
+	node = DetachHeadRunNL(p_list, max, &last, &count);
+	List_UnLock(list);
+
+	//The data is taken out of the nodes, no lock-free reader may still be looking at it.
+	if (count > 0 && p_list->retireList != NULL)
 	{
-		LOG_E("Fail to detach node.\n");
-		return ERR_FAIL;
+		Rcu_Synchronize();
 	}
 
-	ret = List_DestroyNode(list, node);
-	if (ret != ERR_OK)
+	for (i = 0; i < count; i++, node = next)
 	{
-		LOG_E("Fail to destroy node.\n");
-		ret = ERR_FAIL;
+		next   = LIST_CHAIN_NEXT(node);
+		p_data = TakeNodeData(p_list, node);
+		if (p_list->dataType == LIST_DATA_TYPE_VALUE_COPY && p_data == NULL)
+		{
+			memset((char*)p_dataArray + i * p_list->dataLength, 0, p_list->dataLength);
+		}
+		else if (p_list->dataType == LIST_DATA_TYPE_VALUE_COPY)
+		{
+			//The data is copied to user as raw bytes, so it's freed without freeFn.
+			memcpy((char*)p_dataArray + i * p_list->dataLength, p_data, p_list->dataLength);
+			if (!LIST_IS_INLINE_DATA(p_list, node, p_data))
+			{
+				OS_Free(p_data);
+			}
+		}
+		else
+		{
+			((void**)p_dataArray)[i] = p_data;
+		}
+		List_DestroyNode(list, node);
 	}
 
-	return ret;
+	return count;
 }
 
-int List_RmFirstMatchNode(List_t list, void* p_userData)
+ListNode_t List_DetachAllMatchNodes(List_t list, void* p_keyword, CdataCount_t* p_count)
 {
-	CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
-	CHECK_PARAM(p_userData != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(list != NULL, NULL);
+	CHECK_PARAM(p_keyword != NULL, NULL);
 
-	List_st* p_list = CONVERT_2_LIST(list);
-	void*    p_node = NULL;
-	void*    p_data = NULL;
-	CdataBool found = CDATA_FALSE;
+	List_st*     p_list = CONVERT_2_LIST(list);
+	ListNode_t   chain  = NULL;
+	CdataCount_t count  = 0;
 
-	if (p_list->equal2KeywordFn == NULL)
+	if (!LIST_CAN_MATCH_KEYWORD(p_list))
 	{
 		LOG_E("equal2KeywordFn is NULL, pls set a valid equal2KeywordFn first.\n");
-		return ERR_BAD_PARAM;
+		return NULL;
 	}
 
 	List_Lock(list);
-	for (p_node = p_list->p_head; p_node != NULL; p_node = List_GetNextNodeNL(list, p_node))
-	{
-		p_data = List_GetNodeDataNL(list, p_node);
-		if (p_list->equal2KeywordFn(p_data, p_userData))
-		{
-			found = CDATA_TRUE;
-			break;
-		}
-	}
+	chain = DetachMatchChainNL(p_list, p_keyword, NULL, NULL, &count);
 	List_UnLock(list);
 
-	if (found)
+	if (p_count != NULL)
 	{
-		if (List_DetachNode(list, p_node) != ERR_OK)
-		{
-			LOG_E("Fail to detach node.\n");
-			return ERR_FAIL;
-		}
-
-		if (List_DestroyNode(list, p_node) != ERR_OK)
-		{
-			LOG_E("Fail to destroy node.\n");
-			return ERR_FAIL;
-		}
+		*p_count = count;
 	}
 
-	return ERR_OK;
+	return chain;
 }
-int List_RmFirstMatchNodeByCond(List_t list, void* p_userData, List_Condition_fn conditionFn)
+
+ListNode_t List_DetachAllMatchNodesByCond(List_t list, void* p_userData, List_Condition_fn conditionFn, CdataCount_t* p_count)
 {
-	CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
-	CHECK_PARAM(conditionFn != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(list != NULL, NULL);
+	CHECK_PARAM(conditionFn != NULL, NULL);
 
-	List_st* p_list = CONVERT_2_LIST(list);
-	void*    p_node = NULL;
-	void*    p_data = NULL;
-	CdataBool found = CDATA_FALSE;
+	ListNode_t   chain = NULL;
+	CdataCount_t count = 0;
 
 	List_Lock(list);
-	for (p_node = p_list->p_head; p_node != NULL; p_node = List_GetNextNodeNL(list, p_node))
+	chain = DetachMatchChainNL(CONVERT_2_LIST(list), p_userData, conditionFn, NULL, &count);
+	List_UnLock(list);
+
+	if (p_count != NULL)
 	{
-		p_data = List_GetNodeDataNL(list, p_node);
-		if (conditionFn(p_data, p_userData))
-		{
-			found = CDATA_TRUE;
+		*p_count = count;
+	}
+
+	return chain;
+}
+
+ListNode_t List_GetNextChainNode(List_t list, ListNode_t node)
+{
+    CHECK_PARAM(list != NULL, NULL);
+	CHECK_PARAM(node != NULL, NULL);
+
+	return LIST_CHAIN_NEXT(node);
+}
+
+int List_DestroyNodeChain(List_t list, ListNode_t chain)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+
+	ListNode_t node = chain;
+	ListNode_t next = NULL;
+	int        ret  = ERR_OK;
+
+	while (node != NULL)
+	{
+		next = LIST_CHAIN_NEXT(node);
+		if (List_DestroyNode(list, node) != ERR_OK)
+		{
+			LOG_E("Fail to destroy node.\n");
+			ret = ERR_FAIL;
+		}
+		node = next;
+	}
+
+	return ret;
+}
+
+int List_Splice(List_t dst, ListNode_t pos, List_t src, ListNode_t first, ListNode_t last)
+{
+    CHECK_PARAM(dst != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(src != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(first != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(last != NULL, ERR_BAD_PARAM);
+
+	List_st*     p_dst   = CONVERT_2_LIST(dst);
+	List_st*     p_src   = CONVERT_2_LIST(src);
+	ListNode_t   preNode = NULL;
+	ListNode_t   node    = NULL;
+	CdataCount_t count   = 0;
+	int          ret     = ERR_OK;
+
+	ret = CheckRunMovable(p_dst, p_src);
+	if (ret != ERR_OK)
+	{
+		return ret;
+	}
+
+	LockListPair(dst, src);
+
+	//The nodes out of the lists would break both of them. dst is not src, so pos in dst is not one of the moved nodes.
+	if (p_src->nodeCount == 0 || (first != p_src->p_head && (preNode = FindPreNodeNL(p_src, first, NULL)) == NULL))
+	{
+		LOG_E("The first node is not in list:'%s'.\n", p_src->name);
+		ret = ERR_BAD_PARAM;
+		goto EXIT;
+	}
+
+	if (pos != NULL && (p_dst->nodeCount == 0 || (pos != p_dst->p_head && FindPreNodeNL(p_dst, pos, NULL) == NULL)))
+	{
+		LOG_E("The pos node is not in list:'%s'.\n", p_dst->name);
+		ret = ERR_BAD_PARAM;
+		goto EXIT;
+	}
+
+	for (node = first, count = 1; node != last; node = LIST_CHAIN_NEXT(node), count++)
+	{
+		if (LIST_CHAIN_NEXT(node) == NULL)
+		{
+			LOG_E("The last node is not behind the first one in list:'%s'.\n", p_src->name);
+			ret = ERR_BAD_PARAM;
+			goto EXIT;
+		}
+	}
+
+	MoveRunNL(p_dst, pos, p_src, preNode, first, last, count);
+
+	EXIT:
+	UnLockListPair(dst, src);
+
+	return ret;
+}
+
+int List_Concat(List_t dst, List_t src)
+{
+    CHECK_PARAM(dst != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(src != NULL, ERR_BAD_PARAM);
+
+	List_st* p_dst = CONVERT_2_LIST(dst);
+	List_st* p_src = CONVERT_2_LIST(src);
+	int      ret   = ERR_OK;
+
+	ret = CheckRunMovable(p_dst, p_src);
+	if (ret != ERR_OK)
+	{
+		return ret;
+	}
+
+	LockListPair(dst, src);
+	if (p_src->nodeCount > 0)
+	{
+		//p_tail is not reliable in an emptied list.
+		MoveRunNL(p_dst, (p_dst->nodeCount == 0) ? NULL : p_dst->p_tail, p_src, NULL, p_src->p_head, p_src->p_tail, p_src->nodeCount);
+	}
+	UnLockListPair(dst, src);
+
+	return ERR_OK;
+}
+
+int List_SplitAt(List_t list, ListNode_t node, List_t newList)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(node != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(newList != NULL, ERR_BAD_PARAM);
+
+	List_st*     p_list    = CONVERT_2_LIST(list);
+	List_st*     p_newList = CONVERT_2_LIST(newList);
+	ListNode_t   preNode   = NULL;
+	CdataCount_t index     = 0;
+	CdataCount_t count     = 0;
+	int          ret       = ERR_OK;
+
+	ret = CheckRunMovable(p_newList, p_list);
+	if (ret != ERR_OK)
+	{
+		return ret;
+	}
+
+	LockListPair(newList, list);
+
+	//The node of another list would take the links of that list with it, so it's searched from the head.
+	//The single list needs the pre node too, and the count of the rest comes with it.
+	if (p_list->nodeCount == 0 || (node != p_list->p_head && (preNode = FindPreNodeNL(p_list, node, &index)) == NULL))
+	{
+		LOG_E("The node is not in list:'%s'.\n", p_list->name);
+		ret = ERR_BAD_PARAM;
+		goto EXIT;
+	}
+	count = p_list->nodeCount - index;
+
+	MoveRunNL(p_newList, (p_newList->nodeCount == 0) ? NULL : p_newList->p_tail, p_list, preNode, node, p_list->p_tail, count);
+
+	EXIT:
+	UnLockListPair(newList, list);
+
+	return ret;
+}
+
+int List_IterInitNL(List_t list, ListIter_t* p_iter)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(p_iter != NULL, ERR_BAD_PARAM);
+
+	List_st* p_list = CONVERT_2_LIST(list);
+
+	p_iter->preNode  = NULL;
+	p_iter->node     = NULL;
+	p_iter->nextNode = p_list->p_head;
+
+	return ERR_OK;
+}
+
+ListNode_t List_IterNextNL(List_t list, ListIter_t* p_iter)
+{
+    CHECK_PARAM(list != NULL, NULL);
+    CHECK_PARAM(p_iter != NULL, NULL);
+
+	//The current node is NULL after it's detached, then the pre node is still the pre one of the next node.
+	if (p_iter->node != NULL)
+	{
+		p_iter->preNode = p_iter->node;
+	}
+
+	p_iter->node     = p_iter->nextNode;
+	p_iter->nextNode = (p_iter->node != NULL) ? List_GetNextNodeNL(list, p_iter->node) : NULL;
+
+	return p_iter->node;
+}
+
+ListNode_t List_IterDetachNL(List_t list, ListIter_t* p_iter)
+{
+    CHECK_PARAM(list != NULL, NULL);
+    CHECK_PARAM(p_iter != NULL, NULL);
+
+	ListNode_t node = NULL;
+
+	if (p_iter->node == NULL)
+	{
+		return NULL;
+	}
+
+	node = List_DetachNextNodeNL(list, p_iter->preNode);
+	ASSERT(node == p_iter->node);
+	p_iter->node = NULL;
+
+	return node;
+}
+
+int List_CursorOpen(List_t list, ListCursor_t* p_cursor)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(p_cursor != NULL, ERR_BAD_PARAM);
+
+	List_st* p_list = CONVERT_2_LIST(list);
+
+	//An unlinked slot can't tell which slot was after it.
+	if (p_list->type == LIST_TYPE_UNROLLED)
+	{
+		LOG_E("Unrolled list:'%s' can't open cursor.\n", p_list->name);
+		return ERR_BAD_PARAM;
+	}
+
+	List_Lock(list);
+	p_cursor->list     = list;
+	p_cursor->nextNode = p_list->p_head;
+	p_cursor->index    = 0;
+	p_cursor->p_pre    = NULL;
+	p_cursor->p_next   = p_list->p_cursors;
+	if (p_list->p_cursors != NULL)
+	{
+		p_list->p_cursors->p_pre = p_cursor;
+	}
+	p_list->p_cursors = p_cursor;
+	List_UnLock(list);
+
+	return ERR_OK;
+}
+
+int List_CursorClose(ListCursor_t* p_cursor)
+{
+    CHECK_PARAM(p_cursor != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(p_cursor->list != NULL, ERR_BAD_PARAM);
+
+	List_st* p_list = CONVERT_2_LIST(p_cursor->list);
+
+	List_Lock(p_cursor->list);
+	if (p_cursor->p_pre == NULL)
+	{
+		p_list->p_cursors = p_cursor->p_next;
+	}
+	else
+	{
+		p_cursor->p_pre->p_next = p_cursor->p_next;
+	}
+
+	if (p_cursor->p_next != NULL)
+	{
+		p_cursor->p_next->p_pre = p_cursor->p_pre;
+	}
+	List_UnLock(p_cursor->list);
+
+	p_cursor->list     = NULL;
+	p_cursor->nextNode = NULL;
+	p_cursor->p_pre    = NULL;
+	p_cursor->p_next   = NULL;
+
+	return ERR_OK;
+}
+
+int List_CursorTraverse(ListCursor_t* p_cursor, CdataCount_t maxNodes, void* p_userData, List_Traverse_fn traverseFn)
+{
+    CHECK_PARAM(p_cursor != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(p_cursor->list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(traverseFn != NULL, ERR_BAD_PARAM);
+
+	CdataBool needStop = CDATA_FALSE;
+	int       ret = ERR_OK;
+
+	//The writers move the cursor, so they are kept out while the cursor is used.
+	List_SharedLock(p_cursor->list);
+	ret = CursorTraverseNL(p_cursor, maxNodes, p_userData, traverseFn, &needStop);
+	List_SharedUnLock(p_cursor->list);
+
+	return ret;
+}
+
+int List_TraverseChunked(List_t list, CdataCount_t chunkNodes, void* p_userData, List_Traverse_fn traverseFn)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(chunkNodes > 0, ERR_BAD_PARAM);
+    CHECK_PARAM(traverseFn != NULL, ERR_BAD_PARAM);
+
+	ListCursor_t cursor;
+	CdataBool    needStop = CDATA_FALSE;
+	int          ret = ERR_OK;
+
+	//The unrolled list can't keep a cursor, it's traversed in one go.
+	if ((CONVERT_2_LIST(list))->type == LIST_TYPE_UNROLLED)
+	{
+		return List_Traverse(list, p_userData, traverseFn);
+	}
+
+	if (List_CursorOpen(list, &cursor) != ERR_OK)
+	{
+		LOG_E("Fail to open cursor of list:'%s'.\n", (CONVERT_2_LIST(list))->name);
+		return ERR_FAIL;
+	}
+
+	do
+	{
+		List_SharedLock(list);
+		ret = CursorTraverseNL(&cursor, chunkNodes, p_userData, traverseFn, &needStop);
+		List_SharedUnLock(list);
+
+		//Let the blocked writers go before the next chunk.
+		OS_YieldThread();
+	}while (ret == ERR_OK && !needStop);
+
+	List_CursorClose(&cursor);
+
+	return ERR_OK;
+}
+
+int List_PosCursorInit(List_t list, ListPosCursor_t* p_cursor)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(p_cursor != NULL, ERR_BAD_PARAM);
+
+	p_cursor->list     = list;
+	p_cursor->node     = NULL;
+	p_cursor->index    = 0;
+	p_cursor->modCount = 0;
+
+	return ERR_OK;
+}
+
+ListNode_t List_PosCursorGetNodeNL(ListPosCursor_t* p_cursor, CdataIndex_t posIndex)
+{
+    CHECK_PARAM(p_cursor != NULL, NULL);
+    CHECK_PARAM(p_cursor->list != NULL, NULL);
+
+	List_st*     p_list = CONVERT_2_LIST(p_cursor->list);
+	CdataCount_t count  = LIST_COUNTER_GET(p_list->nodeCount);
+	CdataCount_t cost   = 0;
+	ListNode_t   node   = NULL;
+	CdataBool    canWalkBack = (p_list->type != LIST_TYPE_SINGLE_LINK);
+	CdataBool    canWalk = CDATA_FALSE;
+
+	if (posIndex >= count)
+	{
+		return NULL;
+	}
+
+	//The cost of walking from the cursor, the single list can't walk back.
+	if (p_cursor->node != NULL && p_cursor->modCount == p_list->modCount)
+	{
+		if (posIndex >= p_cursor->index)
+		{
+			canWalk = CDATA_TRUE;
+			cost = posIndex - p_cursor->index;
+		}
+		else if (canWalkBack)
+		{
+			canWalk = CDATA_TRUE;
+			cost = p_cursor->index - posIndex;
+		}
+	}
+
+	//The indexed and unrolled list find the node without walking, the others walk from the nearer end.
+	if (canWalk && (cost <= POS_CURSOR_WALK_LIMIT
+		|| (!LIST_HAS_POS_INDEX(p_list) && p_list->type != LIST_TYPE_UNROLLED
+			&& cost < posIndex && (!canWalkBack || cost < count - 1 - posIndex))))
+	{
+		node = WalkFromNodeNL(p_list, p_cursor->node, p_cursor->index, posIndex);
+	}
+	else
+	{
+		node = GetNodeAtPosNL(p_list, posIndex);
+	}
+
+	p_cursor->node     = node;
+	p_cursor->index    = posIndex;
+	p_cursor->modCount = p_list->modCount;
+
+	return node;
+}
+
+void* List_PosCursorGetData(ListPosCursor_t* p_cursor, CdataIndex_t posIndex)
+{
+    CHECK_PARAM(p_cursor != NULL, NULL);
+    CHECK_PARAM(p_cursor->list != NULL, NULL);
+
+	ListNode_t node   = NULL;
+	void*      p_data = NULL;
+
+	List_SharedLock(p_cursor->list);
+	node = List_PosCursorGetNodeNL(p_cursor, posIndex);
+	if (node != NULL)
+	{
+		p_data = List_GetNodeDataNL(p_cursor->list, node);
+	}
+	List_SharedUnLock(p_cursor->list);
+
+	return p_data;
+}
+
+int List_RmNode(List_t list, ListNode_t node)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+	CHECK_PARAM(node != NULL, ERR_BAD_PARAM);
+
+	int ret = ERR_OK;
+
+	List_Lock(list);
+	ret = List_RmNodeNL(list, node);
+	List_UnLock(list);
+
+	return ret;
+}
+int List_RmNodeNL(List_t list, ListNode_t node)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(node != NULL, ERR_BAD_PARAM);
+
+	int ret = ERR_OK;
+
+	ret = List_DetachNodeNL(list, node);
+	if (ret != ERR_OK)
+	{
+		LOG_E("Fail to detach node.\n");
+		return ERR_FAIL;
+	}
+
+	ret = List_DestroyNode(list, node);
+	if (ret != ERR_OK)
+	{
+		LOG_E("Fail to destroy node.\n");
+		return ERR_FAIL;
+	}
+
+	return ERR_OK;
+}
+
+int List_RmHead(List_t list)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+
+	int ret = ERR_OK;
+	ListNode_t node = NULL;
+
+
+	node = List_DetachHead(list);
+	if (node == NULL)
+	{
+		LOG_E("Fail to detach head.\n");
+		return ERR_FAIL;
+	}
+
+	ret = List_DestroyNode(list, node);
+	if (ret != ERR_OK)
+	{
+		LOG_E("Fail to destroy node.\n");
+		ret = ERR_FAIL;
+	}
+
+	return ret;
+}
+
+int List_RmTail(List_t list)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+
+	int ret = ERR_OK;
+	ListNode_t node = NULL;
+
+	node = List_DetachTail(list);
+	if (node == NULL)
+	{
+		LOG_E("Fail to detach tail.\n");
+		return ERR_FAIL;
+	}
+
+	ret = List_DestroyNode(list, node);
+	if (ret != ERR_OK)
+	{
+		LOG_E("Fail to destroy node.\n");
+		ret = ERR_FAIL;
+	}
+
+	return ret;
+}
+
+int List_RmNodeAtPos(List_t list, CdataIndex_t posIndex)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+
+	int ret = ERR_OK;
+	ListNode_t node = NULL;
+
+	node = List_DetachNodeAtPos(list, posIndex);
+	if (node == NULL)
+	{
+		LOG_E("Fail to detach node.\n");
+		return ERR_FAIL;
+	}
+
+	ret = List_DestroyNode(list, node);
+	if (ret != ERR_OK)
+	{
+		LOG_E("Fail to destroy node.\n");
+		ret = ERR_FAIL;
+	}
+
+	return ret;
+}
+
+int List_RmFirstMatchNode(List_t list, void* p_userData)
+{
+	CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+	CHECK_PARAM(p_userData != NULL, ERR_BAD_PARAM);
+
+	List_st* p_list = CONVERT_2_LIST(list);
+	void*    p_node = NULL;
+
+	if (!LIST_CAN_MATCH_KEYWORD(p_list))
+	{
+		LOG_E("equal2KeywordFn is NULL, pls set a valid equal2KeywordFn first.\n");
+		return ERR_BAD_PARAM;
+	}
+
+	List_Lock(list);
+	p_node = DetachFirstMatchNodeNL(p_list, p_userData);
+	List_UnLock(list);
+
+	if (p_node != NULL)
+	{
+		if (List_DestroyNode(list, p_node) != ERR_OK)
+		{
+			LOG_E("Fail to destroy node.\n");
+			return ERR_FAIL;
+		}
+	}
+
+	return ERR_OK;
+}
+int List_RmFirstMatchNodeByCond(List_t list, void* p_userData, List_Condition_fn conditionFn)
+{
+	CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+	CHECK_PARAM(conditionFn != NULL, ERR_BAD_PARAM);
+
+	ListIter_t iter;
+	void*      p_node = NULL;
+	void*      p_data = NULL;
+
+	List_Lock(list);
+	List_IterInitNL(list, &iter);
+	while ((p_node = List_IterNextNL(list, &iter)) != NULL)
+	{
+		p_data = List_GetNodeDataNL(list, p_node);
+		if (conditionFn(p_data, p_userData))
+		{
+			List_IterDetachNL(list, &iter);
+			break;
+		}
+	}
+	List_UnLock(list);
+
+	if (p_node != NULL)
+	{
+		if (List_DestroyNode(list, p_node) != ERR_OK)
+		{
+			LOG_E("Fail to destroy node.\n");
+			return ERR_FAIL;
+		}
+	}
+
+	return ERR_OK;
+}
+
+CdataCount_t List_RmAllMatchNodes(List_t list, void* p_userData)
+{
+	CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+	CHECK_PARAM(p_userData != NULL, ERR_BAD_PARAM);
+
+	List_st*     p_list = CONVERT_2_LIST(list);
+	ListNode_t   chain  = NULL;
+	CdataCount_t count  = 0;
+
+	if (!LIST_CAN_MATCH_KEYWORD(p_list))
+	{
+		LOG_E("equal2KeywordFn is NULL, pls set a valid equal2KeywordFn first.\n");
+		return ERR_BAD_PARAM;
+	}
+
+	if (p_list->type == LIST_TYPE_UNROLLED)
+	{
+		return RmUnrolledMatchNodes(list, p_userData, NULL);
+	}
+
+	List_Lock(list);
+	chain = DetachMatchChainNL(p_list, p_userData, NULL, NULL, &count);
+	List_UnLock(list);
+
+	List_DestroyNodeChain(list, chain);
+
+	return count;
+}
+CdataCount_t List_RmAllMatchNodesByCond(List_t list, void* p_userData, List_Condition_fn conditionFn)
+{
+	CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+	CHECK_PARAM(conditionFn != NULL, ERR_BAD_PARAM);
+
+	ListNode_t   chain = NULL;
+	CdataCount_t count = 0;
+
+	if ((CONVERT_2_LIST(list))->type == LIST_TYPE_UNROLLED)
+	{
+		return RmUnrolledMatchNodes(list, p_userData, conditionFn);
+	}
+
+	List_Lock(list);
+	chain = DetachMatchChainNL(CONVERT_2_LIST(list), p_userData, conditionFn, NULL, &count);
+	List_UnLock(list);
+
+	List_DestroyNodeChain(list, chain);
+
+	return count;
+}
+
+
+//=========================================================
+//          Functions shared by single and double list
+//=========================================================
+ListNode_t List_DetachMarkedChainNL(List_st* p_list, const unsigned char* p_marks, CdataCount_t* p_count)
+{
+	ASSERT(p_list != NULL);
+	ASSERT(p_marks != NULL);
+	ASSERT(p_count != NULL);
+
+	return DetachMatchChainNL(p_list, NULL, NULL, p_marks, p_count);
+}
+
+void List_OnNodeLinked(List_st* p_list, void* p_node)
+{
+	ASSERT(p_list != NULL);
+	ASSERT(p_node != NULL);
+
+	p_list->modCount++;
+
+	LIST_COUNTER_ADD(p_list->nodeCount, 1);
+	LIST_COUNTER_ADD(p_list->linkedTotal, 1);
+
+	if (LIST_HAS_POS_INDEX(p_list))
+	{
+		//Both single and double list node begin with p_next.
+		PosIndex_InsertBefore(&p_list->posIndex, p_node, ((SGListNode_st*)p_node)->p_next);
+	}
+
+	if (LIST_IS_SORTED(p_list))
+	{
+		//InsertNodeSortedNL builds the tower after the node is linked.
+		SkipIndex_InsertFlat(&p_list->skipIndex, p_node);
+	}
+
+	if (p_list->p_hashIndex != NULL)
+	{
+		AddToHashIndex(p_list, p_node);
+	}
+
+	if (LIST_HAS_KEY_COLUMN(p_list))
+	{
+		//The node is linked already, its next node is in the column.
+		AddToKeyColumn(p_list, p_node, LIST_CHAIN_NEXT(p_node));
+	}
+}
+
+void List_OnRunLinked(List_st* p_list, CdataCount_t count)
+{
+	ASSERT(p_list != NULL);
+
+	p_list->modCount++;
+
+	LIST_COUNTER_ADD(p_list->nodeCount, count);
+	LIST_COUNTER_ADD(p_list->linkedTotal, count);
+}
+
+void List_OnRunUnlinked(List_st* p_list, ListNode_t first, ListNode_t last, ListNode_t nextNode, CdataCount_t count)
+{
+	ASSERT(p_list != NULL);
+
+	p_list->modCount++;
+
+	LIST_COUNTER_ADD(p_list->nodeCount, -count);
+	LIST_COUNTER_ADD(p_list->unlinkedTotal, count);
+	p_list->p_finger = NULL;
+
+	if (p_list->p_cursors != NULL)
+	{
+		MoveCursorsOffRun(p_list, first, last, nextNode);
+	}
+}
+
+void List_OnNodeUnlinked(List_st* p_list, void* p_node)
+{
+	ASSERT(p_list != NULL);
+	ASSERT(p_node != NULL);
+
+	p_list->modCount++;
+
+	LIST_COUNTER_ADD(p_list->nodeCount, -1);
+	LIST_COUNTER_ADD(p_list->unlinkedTotal, 1);
+
+	if (p_node == p_list->p_finger)
+	{
+		p_list->p_finger = NULL;
+	}
+
+	if (LIST_HAS_POS_INDEX(p_list))
+	{
+		PosIndex_Remove(&p_list->posIndex, p_node);
+	}
+
+	if (LIST_IS_SORTED(p_list))
+	{
+		SortedSeekArg_t arg = {p_list, List_GetNodeDataNL(p_list, p_node)};
+		SkipIndex_Remove(&p_list->skipIndex, p_node, UpperBoundAdvance, &arg);
+	}
+
+	if (p_list->p_hashIndex != NULL)
+	{
+		RemoveFromHashIndex(p_list, p_node);
+	}
+
+	if (LIST_HAS_KEY_COLUMN(p_list))
+	{
+		KeyColumn_Remove(&p_list->keyColumn, p_node);
+	}
+
+	//Both single and double list node begin with p_next, and it's kept after the node is unlinked.
+	if (p_list->p_cursors != NULL)
+	{
+		MoveCursorsOffRun(p_list, p_node, p_node, LIST_CHAIN_NEXT(p_node));
+	}
+}
+
+/*=============================================================================*
+ *                    Inner function implemention
+ *============================================================================*/
+List_t  CreateList(ListName_t name, ListType_e type, List_DataType_e dataType, int dataLength, const ListAttr_t* p_attr)
+{
+    OSMutex_t* guard = NULL;
+    List_st* p_newList = NULL;
+
+    size_t minNameLen = 0;
+    size_t nameLen = 0;
+    size_t maxLen = 0;
+    size_t nodeSize = 0;
+    size_t slotSize = 0;
+
+    guard = CreateGuard();
+    if (guard == NULL)
+    {
+        LOG_E("Fail to create list guard.\n");
+        return NULL;
+    }
+
+    p_newList = (List_st*) OS_Malloc(sizeof(List_st));
+    if (NULL == p_newList)
+    {
+        LOG_E("Have no enough memory.\n");
+
+        DeleteGuard(guard);
+        return NULL;
+    }
+    memset(p_newList, 0x0, sizeof(List_st));
+
+    if (type == LIST_TYPE_UNROLLED && UList_Init(&p_newList->blocks, dataLength) != ERR_OK)
+    {
+        LOG_E("Fail to init blocks of unrolled list:'%s'.\n", name);
+
+        DeleteGuard(guard);
+        OS_Free(p_newList);
+        return NULL;
+    }
+
+	p_newList->type    = type;
+    p_newList->p_head  = NULL;
+    p_newList->p_tail  = NULL;
+
+    p_newList->name[0] = '\0';
+    nameLen = strlen(name);
+    maxLen = sizeof(ListName_t) - 1;
+    minNameLen = nameLen < maxLen ? nameLen : maxLen;
+    memcpy(p_newList->name, name, minNameLen);
+    p_newList->name[minNameLen] = '\0';
+
+    p_newList->dataType    = dataType;
+    p_newList->dataLength  = dataLength;
+
+    p_newList->nodeCount     = 0;
+    p_newList->linkedTotal   = 0;
+    p_newList->unlinkedTotal = 0;
+    p_newList->guard  = guard;
+    p_newList->rwGuard = NULL;
+
+	p_newList->p_cursors = NULL;
+	p_newList->modCount = 0;
+	p_newList->p_finger = NULL;
+
+	p_newList->freeFn = NULL;
+	p_newList->equal2KeywordFn = NULL;
+	p_newList->usrLtNodeFn = NULL;
+	p_newList->nodeEqualFn = NULL;
+	p_newList->keyField.kind   = LIST_KEY_NONE;
+	p_newList->keyField.offset = 0;
+	p_newList->keyField.length = 0;
+
+    p_newList->pool       = NULL;
+    p_newList->dataOffset = 0;
+    p_newList->linkOffset = 0;
+
+    p_newList->p_hashIndex   = NULL;
+    p_newList->nodeHashFn    = NULL;
+    p_newList->keywordHashFn = NULL;
+    KeyColumn_Init(&p_newList->keyColumn, 0);
+
+    //The extension fields are stored behind the link fields.
+    nodeSize = (type == LIST_TYPE_DOUBLE_LINK) ? sizeof(DBListNode_st) : sizeof(SGListNode_st);
+    PosIndex_Init(&p_newList->posIndex, 0);
+    if (p_attr != NULL && p_attr->positionIndex)
+    {
+        PosIndex_Init(&p_newList->posIndex, nodeSize);
+        nodeSize += sizeof(PosIndexNode_st);
+    }
+    p_newList->sortOrder = LIST_SORT_NONE;
+    SkipIndex_Init(&p_newList->skipIndex, 0);
+    if (p_attr != NULL && p_attr->sortOrder != LIST_SORT_NONE)
+    {
+        p_newList->sortOrder = p_attr->sortOrder;
+        SkipIndex_Init(&p_newList->skipIndex, nodeSize);
+        nodeSize += sizeof(SkipIndexNode_st);
+    }
+    p_newList->nodeSize = nodeSize;
+
+    //The value copy data can be stored behind the node.
+    slotSize = nodeSize;
+    if (dataType == LIST_DATA_TYPE_VALUE_COPY && type != LIST_TYPE_UNROLLED)
+    {
+        p_newList->dataOffset = ((nodeSize + LIST_NODE_DATA_ALIGN - 1) / LIST_NODE_DATA_ALIGN) * LIST_NODE_DATA_ALIGN;
+        slotSize = p_newList->dataOffset + dataLength;
+    }
+
+    if (p_attr != NULL && p_attr->lockPolicy == LIST_LOCK_RW)
+    {
+        p_newList->rwGuard = OS_RWLockCreate();
+        if (p_newList->rwGuard == NULL)
+        {
+            LOG_E("Fail to create rwlock for list:'%s'.\n", p_newList->name);
+
+            if (type == LIST_TYPE_UNROLLED)
+            {
+                UList_Fini(&p_newList->blocks);
+            }
+            DeleteGuard(guard);
+            OS_Free(p_newList);
+            return NULL;
+        }
+    }
+
+    if (p_attr != NULL && p_attr->poolChunkNodes > 0)
+    {
+        p_newList->pool = NodePool_Create(slotSize, p_attr->poolChunkNodes);
+        if (p_newList->pool == NULL)
+        {
+            LOG_E("Fail to create node pool for list:'%s'.\n", p_newList->name);
+
+            OS_RWLockDestroy(p_newList->rwGuard);
+            DeleteGuard(guard);
+            OS_Free(p_newList);
+            return NULL;
+        }
+    }
+
+    p_newList->retireList = NULL;
+    if (p_attr != NULL && p_attr->lockPolicy == LIST_LOCK_RCU)
+    {
+        p_newList->retireList = Rcu_CreateRetireList(ReclaimNode, p_newList);
+        if (p_newList->retireList == NULL)
+        {
+            LOG_E("Fail to create retire list for list:'%s'.\n", p_newList->name);
+
+            NodePool_Destroy(p_newList->pool);
+            DeleteGuard(guard);
+            OS_Free(p_newList);
+            return NULL;
+        }
+    }
+
+    return p_newList;
+}
+
+static OSMutex_t  CreateGuard()
+{
+    OSMutex_t mutex = OS_MutexCreate();
+    if(mutex == NULL)
+    {
+        LOG_E("Fail to create a mutex!\n");
+        return NULL;
+    }
+
+    return mutex;
+}
+
+static void DeleteGuard(OSMutex_t guard)
+{
+    ASSERT(guard != NULL);
+
+    OS_MutexDestroy(guard);
+}
+
+static CdataBool   HasDuplicateNode(List_t list, ListNode_t node)
+{
+	ASSERT(list != NULL);
+	ASSERT(node != NULL);
+
+	CdataBool isDuplicate = CDATA_FALSE;
+	List_st* p_list  = CONVERT_2_LIST(list);
+
+	List_ReadLock(list);
+	isDuplicate = HasDuplicateNodeNL(p_list, node);
+	List_ReadUnLock(list);
+
+	return isDuplicate;
+}
+
+static CdataBool HasDuplicateNodeNL(List_st* p_list, ListNode_t node)
+{
+	return HasDuplicateDataNL(p_list, List_GetNodeDataNL(p_list, node), node);
+}
+
+//exceptNode holds p_userData itself, it's NULL if the data isn't in any node yet.
+static CdataBool HasDuplicateDataNL(List_st* p_list, void* p_userData, ListNode_t exceptNode)
+{
+	void *p_node = NULL;
+	HashIndexIter_t iter;
+
+	if (p_list->p_hashIndex != NULL)
+	{
+		for (p_node = HashIndex_FindFirst(p_list->p_hashIndex, HashNodeData(p_list, p_userData), &iter); p_node != NULL; p_node = HashIndex_FindNext(p_list->p_hashIndex, &iter))
+		{
+			if (p_node != exceptNode && List_IsDataEqual(p_list, List_GetNodeDataNL(p_list, p_node), p_userData))
+			{
+				return CDATA_TRUE;
+			}
+		}
+
+		return CDATA_FALSE;
+	}
+
+	for (p_node = p_list->p_head; p_node != NULL; p_node = List_GetNextNodeNL(p_list, p_node))
+	{
+		if (List_IsDataEqual(p_list, List_GetNodeDataNL(p_list, p_node), p_userData))
+		{
+			return CDATA_TRUE;
+		}
+	}
+
+	return CDATA_FALSE;
+}
+
+static void ReclaimNode(void* p_node, void* p_arg)
+{
+	List_st* p_list = (List_st*)p_arg;
+	void*    p_data = ((DBListNode_st*)p_node)->p_data;
+
+	FreeNodeData(p_list, p_node, p_data);
+	if (p_list->pool != NULL)
+	{
+		NodePool_Free(p_list->pool, p_node);
+	}
+	else
+	{
+		OS_Free(p_node);
+	}
+}
+
+static CdataBool IsRcuCapable(ListType_e type, const ListAttr_t* p_attr)
+{
+	//The readers only follow the links, the indexes are changed in place under the writer lock.
+	return type == LIST_TYPE_DOUBLE_LINK && !p_attr->positionIndex && p_attr->sortOrder == LIST_SORT_NONE;
+}
+
+static int CheckTypeAttr(ListType_e type, List_DataType_e dataType, const ListAttr_t* p_attr)
+{
+	if ((unsigned int)type > LIST_TYPE_UNROLLED)
+	{
+		LOG_E("Invalid list type:%d.\n", type);
+		return ERR_BAD_PARAM;
+	}
+
+	if (p_attr != NULL && p_attr->lockPolicy == LIST_LOCK_RCU && !IsRcuCapable(type, p_attr))
+	{
+		LOG_E("LIST_LOCK_RCU only supports double list without position index and sort order.\n");
+		return ERR_BAD_PARAM;
+	}
+
+	//The link embedded in the data has no room for the pool, the index and the deferred free.
+	if (dataType == LIST_DATA_TYPE_INTRUSIVE && (type == LIST_TYPE_UNROLLED || (p_attr != NULL
+		&& (p_attr->poolChunkNodes > 0 || p_attr->positionIndex || p_attr->sortOrder != LIST_SORT_NONE || p_attr->lockPolicy == LIST_LOCK_RCU))))
+	{
+		LOG_E("Intrusive list can't be unrolled or created with pool, position index, sort order or LIST_LOCK_RCU.\n");
+		return ERR_BAD_PARAM;
+	}
+
+	if (type != LIST_TYPE_UNROLLED)
+	{
+		return ERR_OK;
+	}
+
+	//The node of the unrolled list is the slot of the data, there is nothing else to keep the extension fields.
+	if (dataType != LIST_DATA_TYPE_VALUE_COPY)
+	{
+		LOG_E("Unrolled list can only store value copy data.\n");
+		return ERR_BAD_PARAM;
+	}
+
+	if (p_attr != NULL && (p_attr->poolChunkNodes > 0 || p_attr->positionIndex || p_attr->sortOrder != LIST_SORT_NONE))
+	{
+		LOG_E("Unrolled list can't be created with pool, position index or sort order.\n");
+		return ERR_BAD_PARAM;
+	}
+
+	return ERR_OK;
+}
+
+static void FreeNodeData(List_st* p_list, ListNode_t node, void* p_data)
+{
+	ASSERT(p_list != NULL);
+	ASSERT(node != NULL);
+
+	if (p_data == NULL)
+	{
+		return;
+	}
+
+	if (!LIST_IS_INLINE_DATA(p_list, node, p_data))
+	{
+		if (p_list->freeFn != NULL)
+		{
+			p_list->freeFn(p_data);
+		}
+		else
+		{
+			OS_Free(p_data);
+		}
+		return;
+	}
+
+	//The data lives in the node memory which is released with the node, freeFn only frees what it points to.
+	if (p_list->freeFn != NULL)
+	{
+		p_list->freeFn(p_data);
+	}
+}
+
+static ListNode_t GetNodeAtPosNL(List_st* p_list, CdataIndex_t posIndex)
+{
+	ASSERT(p_list != NULL);
+
+	void*        p_node = NULL;
+	CdataIndex_t pos    = 0;
+	CdataCount_t count  = LIST_COUNTER_GET(p_list->nodeCount);
+
+	if (posIndex >= count)
+	{
+		return NULL;
+	}
+
+	if (LIST_HAS_POS_INDEX(p_list))
+	{
+		return PosIndex_Select(&p_list->posIndex, posIndex);
+	}
+
+	if (p_list->type == LIST_TYPE_UNROLLED)
+	{
+		return UList_GetNodeAtPos(p_list, posIndex);
+	}
+
+	//The double list walks from the nearer end.
+	if (p_list->type == LIST_TYPE_DOUBLE_LINK && posIndex > count / 2)
+	{
+		for (p_node = p_list->p_tail, pos = count - 1; p_node != NULL && pos > posIndex; p_node = ((DBListNode_st*)p_node)->p_pre, pos--);
+		return p_node;
+	}
+
+	for (p_node = p_list->p_head, pos = 0; p_node != NULL && pos < posIndex; p_node = List_GetNextNodeNL(p_list, p_node), pos++);
+
+	return p_node;
+}
+
+static int BuildHashIndex(List_st* p_list)
+{
+	ASSERT(p_list != NULL);
+
+	void* p_node = NULL;
+
+	p_list->p_hashIndex = (HashIndex_st*)OS_Malloc(sizeof(HashIndex_st));
+	if (p_list->p_hashIndex == NULL || HashIndex_Init(p_list->p_hashIndex) != ERR_OK)
+	{
+		LOG_E("Not enough memory for hash index of list:'%s'.\n", p_list->name);
+		DropHashIndex(p_list);
+		return ERR_OUT_MEM;
+	}
+
+	for (p_node = p_list->p_head; p_node != NULL; p_node = List_GetNextNodeNL(p_list, p_node))
+	{
+		if (!AddToHashIndex(p_list, p_node))
+		{
+			return ERR_OUT_MEM;
+		}
+	}
+
+	return ERR_OK;
+}
+
+static void DropHashIndex(List_st* p_list)
+{
+	ASSERT(p_list != NULL);
+
+	if (p_list->p_hashIndex != NULL)
+	{
+		HashIndex_Destroy(p_list->p_hashIndex);
+		OS_Free(p_list->p_hashIndex);
+		p_list->p_hashIndex = NULL;
+	}
+}
+
+static CdataBool AddToHashIndex(List_st* p_list, void* p_node)
+{
+	void* p_data = List_GetNodeDataNL(p_list, p_node);
+
+	if (p_data == NULL)
+	{
+		return CDATA_TRUE;
+	}
+
+	if (HashIndex_Insert(p_list->p_hashIndex, p_node, HashNodeData(p_list, p_data)) != ERR_OK)
+	{
+		//The list still works well without the index, only slower.
+		LOG_E("Fail to add node to hash index, drop the hash index of list:'%s'.\n", p_list->name);
+		DropHashIndex(p_list);
+		return CDATA_FALSE;
+	}
+
+	return CDATA_TRUE;
+}
+
+static CdataBool RemoveFromHashIndex(List_st* p_list, void* p_node)
+{
+	void* p_data = List_GetNodeDataNL(p_list, p_node);
+
+	if (p_data == NULL)
+	{
+		return CDATA_FALSE;
+	}
+
+	return HashIndex_Remove(p_list->p_hashIndex, p_node, HashNodeData(p_list, p_data));
+}
+
+static unsigned long HashKey(List_st* p_list, const void* p_key)
+{
+	uint32_t key32 = 0;
+	uint64_t key64 = 0;
+
+	switch (p_list->keyField.kind)
+	{
+		//The hash index spreads the integer itself over the table.
+		case LIST_KEY_INT32:
+			memcpy(&key32, p_key, sizeof(key32));
+			return (unsigned long)key32;
+
+		case LIST_KEY_INT64:
+		case LIST_KEY_UINT64:
+			memcpy(&key64, p_key, sizeof(key64));
+			return (unsigned long)(key64 ^ (key64 >> 32));
+
+		case LIST_KEY_BYTES:
+			return List_HashBytes(p_key, p_list->keyField.length);
+
+		default:
+			return List_HashBytes(p_key, strnlen((const char*)p_key, p_list->keyField.length));
+	}
+}
+
+static unsigned long HashNodeData(List_st* p_list, void* p_data)
+{
+	if (LIST_HAS_KEY_FIELD(p_list))
+	{
+		return HashKey(p_list, LIST_KEY_OF(p_list, p_data));
+	}
+
+	return p_list->nodeHashFn(p_data);
+}
+
+static unsigned long HashKeyword(List_st* p_list, void* p_keyword)
+{
+	if (LIST_HAS_KEY_FIELD(p_list))
+	{
+		return HashKey(p_list, p_keyword);
+	}
+
+	return (p_list->keywordHashFn != NULL) ? p_list->keywordHashFn(p_keyword) : p_list->nodeHashFn(p_keyword);
+}
+
+/*
+ * Walk the nodes without calling any function, the integer keys are compared directly.
+ * Return the first match node if p_count is NULL, otherwise count all the match nodes.
+ */
+static ListNode_t ScanKeyFieldNL(List_st* p_list, void* p_keyword, CdataCount_t* p_count)
+{
+	size_t   dataOffset = (p_list->type == LIST_TYPE_DOUBLE_LINK) ? offsetof(DBListNode_st, p_data) : offsetof(SGListNode_st, p_data);
+	void*    p_node = NULL;
+	void*    p_data = NULL;
+	int32_t  key32 = 0;
+	int32_t  value32 = 0;
+	uint64_t key64 = 0;
+	uint64_t value64 = 0;
+
+	if (p_list->keyField.kind == LIST_KEY_INT32)
+	{
+		memcpy(&key32, p_keyword, sizeof(key32));
+		for (p_node = p_list->p_head; p_node != NULL; p_node = LIST_CHAIN_NEXT(p_node))
+		{
+			p_data = NODE_DATA_AT(p_node, dataOffset);
+			if (p_data == NULL)
+			{
+				continue;
+			}
+
+			memcpy(&value32, LIST_KEY_OF(p_list, p_data), sizeof(value32));
+			if (value32 == key32)
+			{
+				if (p_count == NULL)
+				{
+					return p_node;
+				}
+				(*p_count)++;
+			}
+		}
+
+		return NULL;
+	}
+
+	//The signed and unsigned 64 bits keys are equal if their bits are equal.
+	if (p_list->keyField.kind == LIST_KEY_INT64 || p_list->keyField.kind == LIST_KEY_UINT64)
+	{
+		memcpy(&key64, p_keyword, sizeof(key64));
+		for (p_node = p_list->p_head; p_node != NULL; p_node = LIST_CHAIN_NEXT(p_node))
+		{
+			p_data = NODE_DATA_AT(p_node, dataOffset);
+			if (p_data == NULL)
+			{
+				continue;
+			}
+
+			memcpy(&value64, LIST_KEY_OF(p_list, p_data), sizeof(value64));
+			if (value64 == key64)
+			{
+				if (p_count == NULL)
+				{
+					return p_node;
+				}
+				(*p_count)++;
+			}
+		}
+
+		return NULL;
+	}
+
+	for (p_node = p_list->p_head; p_node != NULL; p_node = LIST_CHAIN_NEXT(p_node))
+	{
+		p_data = NODE_DATA_AT(p_node, dataOffset);
+		if (p_data != NULL && List_CompareKeys(p_list, LIST_KEY_OF(p_list, p_data), p_keyword) == 0)
+		{
+			if (p_count == NULL)
+			{
+				return p_node;
+			}
+			(*p_count)++;
+		}
+	}
+
+	return NULL;
+}
+
+//NULL conditionFn means matching the data with the keyword.
+static CdataBool MatchCondition(List_st* p_list, List_Condition_fn conditionFn, void* p_data, void* p_userData)
+{
+	return (conditionFn != NULL) ? conditionFn(p_data, p_userData) : List_MatchKeyword(p_list, p_data, p_userData);
+}
+
+static int BuildKeyColumn(List_st* p_list, int keyLength)
+{
+	ASSERT(p_list != NULL);
+
+	void* p_node = NULL;
+
+	KeyColumn_Init(&p_list->keyColumn, keyLength);
+	for (p_node = p_list->p_head; p_node != NULL; p_node = List_GetNextNodeNL(p_list, p_node))
+	{
+		if (!AddToKeyColumn(p_list, p_node, NULL))
+		{
+			return ERR_OUT_MEM;
+		}
+	}
+
+	return ERR_OK;
+}
+
+//The key is put before the key of nextNode, NULL means appending it.
+static CdataBool AddToKeyColumn(List_st* p_list, void* p_node, void* nextNode)
+{
+	void*              p_data = List_GetNodeDataNL(p_list, p_node);
+	unsigned long long key = 0;
+
+	if (p_data != NULL)
+	{
+		memcpy(&key, p_data, p_list->keyColumn.keyLength);
+	}
+
+	if (KeyColumn_InsertBefore(&p_list->keyColumn, p_node, &key, nextNode) != ERR_OK)
+	{
+		//The list still works well without the column, only slower.
+		LOG_E("Fail to add node to key column, drop the key column of list:'%s'.\n", p_list->name);
+		KeyColumn_Destroy(&p_list->keyColumn);
+		return CDATA_FALSE;
+	}
+
+	return CDATA_TRUE;
+}
+
+static void UpdateKeyColumn(List_st* p_list, void* p_node)
+{
+	void* p_data = List_GetNodeDataNL(p_list, p_node);
+
+	if (p_data != NULL)
+	{
+		KeyColumn_SetKey(&p_list->keyColumn, p_node, p_data);
+	}
+}
+
+static ListNode_t FindFirstMatchNodeNL(List_st* p_list, void* p_keyword)
+{
+	ASSERT(p_list != NULL);
+
+	HashIndexIter_t  iter;
+	KeyColumnIter_t  keyIter;
+	void*            p_node    = NULL;
+	void*            p_data    = NULL;
+	void*            p_first   = NULL;
+	CdataIndex_t     firstPos  = 0;
+	CdataIndex_t     pos       = 0;
+
+	if (p_list->p_hashIndex != NULL)
+	{
+		for (p_node = HashIndex_FindFirst(p_list->p_hashIndex, HashKeyword(p_list, p_keyword), &iter); p_node != NULL; p_node = HashIndex_FindNext(p_list->p_hashIndex, &iter))
+		{
+			p_data = List_GetNodeDataNL(p_list, p_node);
+			if (!List_MatchKeyword(p_list, p_data, p_keyword))
+			{
+				continue;
+			}
+
+			if (p_first == NULL)
+			{
+				p_first = p_node;
+				firstPos = LIST_HAS_POS_INDEX(p_list) ? PosIndex_Rank(&p_list->posIndex, p_node) : 0;
+				continue;
+			}
+
+			//Several nodes match the keyword, find out which one is the first.
+			if (!LIST_HAS_POS_INDEX(p_list))
+			{
+				goto SCAN;
+			}
+
+			pos = PosIndex_Rank(&p_list->posIndex, p_node);
+			if (pos < firstPos)
+			{
+				p_first = p_node;
+				firstPos = pos;
+			}
+		}
+
+		return p_first;
+	}
+
+	//The nodes whose data has been detached still have their keys in the column.
+	if (LIST_HAS_KEY_COLUMN(p_list))
+	{
+		for (p_node = KeyColumn_FindFirst(&p_list->keyColumn, p_keyword, &keyIter); p_node != NULL; p_node = KeyColumn_FindNext(&p_list->keyColumn, p_keyword, &keyIter))
+		{
+			if (List_GetNodeDataNL(p_list, p_node) != NULL)
+			{
+				break;
+			}
+		}
+
+		return p_node;
+	}
+
+	SCAN:
+	if (CAN_SCAN_KEY_FIELD(p_list))
+	{
+		return ScanKeyFieldNL(p_list, p_keyword, NULL);
+	}
+
+	for (p_node = p_list->p_head; p_node != NULL; p_node = List_GetNextNodeNL(p_list, p_node))
+	{
+		p_data = List_GetNodeDataNL(p_list, p_node);
+		if (p_data != NULL && List_MatchKeyword(p_list, p_data, p_keyword))
+		{
 			break;
 		}
 	}
-	List_UnLock(list);
 
-	if (found)
+	return p_node;
+}
+
+static CdataCount_t CountMatchNodesNL(List_st* p_list, void* p_keyword)
+{
+	ASSERT(p_list != NULL);
+
+	HashIndexIter_t  iter;
+	KeyColumnIter_t  keyIter;
+	void*            p_node = NULL;
+	void*            p_data = NULL;
+	CdataCount_t     count  = 0;
+
+	if (p_list->p_hashIndex != NULL)
+	{
+		for (p_node = HashIndex_FindFirst(p_list->p_hashIndex, HashKeyword(p_list, p_keyword), &iter); p_node != NULL; p_node = HashIndex_FindNext(p_list->p_hashIndex, &iter))
+		{
+			if (List_MatchKeyword(p_list, List_GetNodeDataNL(p_list, p_node), p_keyword))
+			{
+				count++;
+			}
+		}
+
+		return count;
+	}
+
+	if (LIST_HAS_KEY_COLUMN(p_list))
+	{
+		for (p_node = KeyColumn_FindFirst(&p_list->keyColumn, p_keyword, &keyIter); p_node != NULL; p_node = KeyColumn_FindNext(&p_list->keyColumn, p_keyword, &keyIter))
+		{
+			if (List_GetNodeDataNL(p_list, p_node) != NULL)
+			{
+				count++;
+			}
+		}
+
+		return count;
+	}
+
+	if (CAN_SCAN_KEY_FIELD(p_list))
+	{
+		ScanKeyFieldNL(p_list, p_keyword, &count);
+		return count;
+	}
+
+	for (p_node = p_list->p_head; p_node != NULL; p_node = List_GetNextNodeNL(p_list, p_node))
+	{
+		p_data = List_GetNodeDataNL(p_list, p_node);
+		if (p_data != NULL && List_MatchKeyword(p_list, p_data, p_keyword))
+		{
+			count++;
+		}
+	}
+
+	return count;
+}
+
+static int SwapDataContent(List_st* p_list, void* p_firstData, void* p_secondData)
+{
+	ASSERT(p_list != NULL);
+
+	unsigned char* p_first  = (unsigned char*)p_firstData;
+	unsigned char* p_second = (unsigned char*)p_secondData;
+	unsigned char  tmp      = 0;
+	int            i        = 0;
+
+	if (p_first == NULL || p_second == NULL)
+	{
+		LOG_E("Cannot swap the node without data.\n");
+		return ERR_BAD_PARAM;
+	}
+
+	for (i = 0; i < p_list->dataLength; i++)
+	{
+		tmp = p_first[i];
+		p_first[i] = p_second[i];
+		p_second[i] = tmp;
+	}
+
+	return ERR_OK;
+}
+
+static void DestroyFailedNode(List_t list, ListNode_t node)
+{
+	List_st* p_list = CONVERT_2_LIST(list);
+	void*    p_data = NULL;
+
+	//The link embedded in the user data may still be linked, it is left as it is.
+	if (p_list->dataType == LIST_DATA_TYPE_INTRUSIVE)
+	{
+		return;
+	}
+
+	//The data belongs to user, freeFn must not be called for it, only the copy made by the list is freed.
+	p_data = DetachNodeData(list, node);
+	if (p_list->dataType == LIST_DATA_TYPE_VALUE_COPY && p_data != NULL)
+	{
+		OS_Free(p_data);
+	}
+	List_DestroyNode(list, node);
+}
+
+/*
+ * The link embedded in the data is only written after the data is known to be absent,
+ * re-inserting a linked data would break the list it is in.
+ */
+static ListNode_t InsertIntrusiveDataUni(List_t list, void* p_data, CdataBool toHead)
+{
+	List_st*   p_list = CONVERT_2_LIST(list);
+	ListNode_t node   = NULL;
+	int        ret    = ERR_OK;
+
+	if (!LIST_CAN_COMPARE_EQUAL(p_list))
+	{
+		LOG_E("nodeEqualFn is NULL, pls set a valid function first.\n");
+		return NULL;
+	}
+
+	List_Lock(list);
+	if (HasDuplicateDataNL(p_list, p_data, NULL))
+	{
+		List_UnLock(list);
+		return NULL;
+	}
+
+	ret = List_CreateNode(list, p_data, &node);
+	if (ret == ERR_OK)
+	{
+		ret = toHead ? InsertNode2HeadNL(p_list, node) : InsertNodeNL(p_list, node);
+	}
+	List_UnLock(list);
+
+	if (ret != ERR_OK)
+	{
+		LOG_E("Fail to insert node.\n");
+		return NULL;
+	}
+
+	return node;
+}
+
+static int InsertBatchNodeNL(List_st* p_list, ListNode_t node, BatchInsert_e mode)
+{
+	switch (mode)
+	{
+		case BATCH_INSERT_HEAD:
+			return InsertNode2HeadNL(p_list, node);
+		case BATCH_INSERT_ASC:
+			return InsertNodeAscNL(p_list, node);
+		case BATCH_INSERT_UNI:
+			return HasDuplicateNodeNL(p_list, node) ? ERR_DATA_EXISTS : InsertNodeNL(p_list, node);
+		default:
+			return InsertNodeNL(p_list, node);
+	}
+}
+
+static CdataBool IsBefore(List_st* p_list, void* p_firstData, void* p_secondData)
+{
+	//usrLtNodeFn(p_nodeData, p_userData) tells if p_userData < p_nodeData.
+	if (p_list->sortOrder == LIST_SORT_ASC)
+	{
+		return List_IsUserLtNode(p_list, p_secondData, p_firstData);
+	}
+
+	return List_IsUserLtNode(p_list, p_firstData, p_secondData);
+}
+
+static CdataBool InsertAdvance(void* p_node, void* p_arg)
+{
+	SortedSeekArg_t* p_seekArg  = (SortedSeekArg_t*)p_arg;
+	void*            p_nodeData = List_GetNodeDataNL(p_seekArg->p_list, p_node);
+	CdataBool        isLess     = CDATA_FALSE;
+
+	//The data may have been detached from the node by List_DetachNodeData.
+	if (p_nodeData == NULL)
+	{
+		return CDATA_FALSE;
+	}
+	isLess = List_IsUserLtNode(p_seekArg->p_list, p_nodeData, p_seekArg->p_data);
+
+	//Same as the linear insert: ascending stops at the first node the data is less than, descending at the first one it isn't.
+	return (p_seekArg->p_list->sortOrder == LIST_SORT_ASC) ? !isLess : isLess;
+}
+
+static CdataBool LowerBoundAdvance(void* p_node, void* p_arg)
+{
+	SortedSeekArg_t* p_seekArg  = (SortedSeekArg_t*)p_arg;
+	void*            p_nodeData = List_GetNodeDataNL(p_seekArg->p_list, p_node);
+
+	return p_nodeData != NULL && IsBefore(p_seekArg->p_list, p_nodeData, p_seekArg->p_data);
+}
+
+static CdataBool UpperBoundAdvance(void* p_node, void* p_arg)
+{
+	SortedSeekArg_t* p_seekArg  = (SortedSeekArg_t*)p_arg;
+	void*            p_nodeData = List_GetNodeDataNL(p_seekArg->p_list, p_node);
+
+	if (p_nodeData == NULL || p_seekArg->p_data == NULL)
+	{
+		return CDATA_FALSE;
+	}
+
+	return !IsBefore(p_seekArg->p_list, p_seekArg->p_data, p_nodeData);
+}
+
+static int InsertNodeSortedNL(List_st* p_list, ListNode_t node, ListSortOrder_e order)
+{
+	void*           pp_preds[SKIP_INDEX_MAX_LEVEL];
+	void*           p_pre = NULL;
+	int             ret = ERR_OK;
+	SortedSeekArg_t arg;
+
+	if (!LIST_CAN_COMPARE_ORDER(p_list))
+	{
+		LOG_E("usrLtNodeFn is NULL.\n");
+		return ERR_FAIL;
+	}
+
+	if (order != p_list->sortOrder)
+	{
+		LOG_E("'%s' is sorted in the other order.\n", p_list->name);
+		return ERR_FAIL;
+	}
+
+	arg.p_list = p_list;
+	arg.p_data = List_GetNodeDataNL(p_list, node);
+	p_pre = SkipIndex_Seek(&p_list->skipIndex, p_list->p_head, InsertAdvance, &arg, pp_preds);
+
+	if (p_list->type == LIST_TYPE_DOUBLE_LINK)
+	{
+		ret = (p_pre == NULL) ? DBList_InsertNode2Head(p_list, node) : DBList_InsertNodeAfter(p_list, p_pre, node);
+	}
+	else
+	{
+		ret = (p_pre == NULL) ? SGList_InsertNode2Head(p_list, node) : SGList_InsertNodeAfter(p_list, p_pre, node);
+	}
+
+	if (ret == ERR_OK)
+	{
+		SkipIndex_Insert(&p_list->skipIndex, node, pp_preds);
+	}
+
+	return ret;
+}
+
+static ListNode_t SeekSortedNL(List_st* p_list, void* p_data, SkipIndex_Advance_fn advanceFn)
+{
+	void*           p_pre = NULL;
+	SortedSeekArg_t arg;
+
+	if (!LIST_IS_SORTED(p_list) || !LIST_CAN_COMPARE_ORDER(p_list))
+	{
+		LOG_E("'%s' is not a sorted list or usrLtNodeFn is NULL.\n", p_list->name);
+		return NULL;
+	}
+
+	arg.p_list = p_list;
+	arg.p_data = p_data;
+	p_pre = SkipIndex_Seek(&p_list->skipIndex, p_list->p_head, advanceFn, &arg, NULL);
+
+	//Both single and double list node begin with p_next.
+	return (p_pre == NULL) ? p_list->p_head : ((SGListNode_st*)p_pre)->p_next;
+}
+
+static ListNode_t DetachFirstMatchNodeNL(List_st* p_list, void* p_keyword)
+{
+	ListIter_t iter;
+	void*      p_node = NULL;
+
+	//The indexes find the node without its pre node, single list has to search the pre node.
+	if (p_list->p_hashIndex != NULL || LIST_HAS_KEY_COLUMN(p_list))
+	{
+		p_node = FindFirstMatchNodeNL(p_list, p_keyword);
+		if (p_node != NULL && List_DetachNodeNL(p_list, p_node) != ERR_OK)
+		{
+			LOG_E("Fail to detach node.\n");
+			return NULL;
+		}
+
+		return p_node;
+	}
+
+	List_IterInitNL(p_list, &iter);
+	while ((p_node = List_IterNextNL(p_list, &iter)) != NULL)
+	{
+		if (List_MatchKeyword(p_list, List_GetNodeDataNL(p_list, p_node), p_keyword))
+		{
+			return List_IterDetachNL(p_list, &iter);
+		}
+	}
+
+	return NULL;
+}
+
+//If p_marks is not NULL, the nodes are matched by their marks in the list order instead of conditionFn.
+static ListNode_t DetachMatchChainNL(List_st* p_list, void* p_userData, List_Condition_fn conditionFn, const unsigned char* p_marks, CdataCount_t* p_count)
+{
+	ListIter_t   iter;
+	void*        p_node  = NULL;
+	void*        p_data  = NULL;
+	void*        p_chain = NULL;
+	void*        p_last  = NULL;
+	void*        p_pending[LIST_RCU_CHAIN_BATCH];
+	int          pendingCount = 0;
+	CdataIndex_t index = 0;
+
+	*p_count = 0;
+	if (p_list->type == LIST_TYPE_UNROLLED)
+	{
+		LOG_E("The slots of unrolled list:'%s' can't be chained.\n", p_list->name);
+		return NULL;
+	}
+
+	List_IterInitNL(p_list, &iter);
+	for (index = 0; (p_node = List_IterNextNL(p_list, &iter)) != NULL; index++)
+	{
+		if (p_marks != NULL)
+		{
+			if (!p_marks[index])
+			{
+				continue;
+			}
+		}
+		else
+		{
+			p_data = List_GetNodeDataNL(p_list, p_node);
+			if (p_data == NULL || !MatchCondition(p_list, conditionFn, p_data, p_userData))
+			{
+				continue;
+			}
+		}
+
+		if (List_IterDetachNL(p_list, &iter) == NULL)
+		{
+			LOG_E("Fail to detach node.\n");
+			continue;
+		}
+
+		(*p_count)++;
+
+		//The iterator has got the next node, so p_next of the detached node is free to use.
+		if (p_list->retireList == NULL)
+		{
+			AppendToChain(&p_chain, &p_last, &p_node, 1);
+			continue;
+		}
+
+		//Unless the lock-free readers are still standing on it, they need p_next to go on.
+		p_pending[pendingCount++] = p_node;
+		if (pendingCount == LIST_RCU_CHAIN_BATCH)
+		{
+			Rcu_Synchronize();
+			AppendToChain(&p_chain, &p_last, p_pending, pendingCount);
+			pendingCount = 0;
+		}
+	}
+
+	if (pendingCount > 0)
+	{
+		Rcu_Synchronize();
+		AppendToChain(&p_chain, &p_last, p_pending, pendingCount);
+	}
+
+	return p_chain;
+}
+
+static void AppendToChain(void** pp_chain, void** pp_last, void** pp_nodes, int count)
+{
+	int i = 0;
+
+	for (i = 0; i < count; i++)
+	{
+		LIST_CHAIN_NEXT(pp_nodes[i]) = NULL;
+		if (*pp_last == NULL)
+		{
+			*pp_chain = pp_nodes[i];
+		}
+		else
+		{
+			LIST_CHAIN_NEXT(*pp_last) = pp_nodes[i];
+		}
+		*pp_last = pp_nodes[i];
+	}
+}
+
+static int InsertNodeNL(List_st* p_list, ListNode_t node)
+{
+	if (p_list->type == LIST_TYPE_DOUBLE_LINK)
+	{
+		return DBList_InsertNode(p_list, node);
+	}
+	else if (p_list->type == LIST_TYPE_SINGLE_LINK)
+	{
+		return SGList_InsertNode(p_list, node);
+	}
+
+	LOG_E("Invalid list type:%d.\n", p_list->type);
+	return ERR_BAD_PARAM;
+}
+
+static int InsertNode2HeadNL(List_st* p_list, ListNode_t node)
+{
+	if (p_list->type == LIST_TYPE_DOUBLE_LINK)
+	{
+		return DBList_InsertNode2Head(p_list, node);
+	}
+	else if (p_list->type == LIST_TYPE_SINGLE_LINK)
+	{
+		return SGList_InsertNode2Head(p_list, node);
+	}
+
+	LOG_E("Invalid list type:%d.\n", p_list->type);
+	return ERR_BAD_PARAM;
+}
+
+static int InsertNodeAscNL(List_st* p_list, ListNode_t node)
+{
+	if (LIST_IS_SORTED(p_list))
+	{
+		return InsertNodeSortedNL(p_list, node, LIST_SORT_ASC);
+	}
+	else if (p_list->type == LIST_TYPE_DOUBLE_LINK)
+	{
+		return DBList_InsertNodeAsc(p_list, node);
+	}
+	else if (p_list->type == LIST_TYPE_SINGLE_LINK)
+	{
+		return SGList_InsertNodeAsc(p_list, node);
+	}
+
+	LOG_E("Invalid list type:%d.\n", p_list->type);
+	return ERR_BAD_PARAM;
+}
+
+static CdataCount_t InsertDataBatch(List_t list, void* p_dataArray, CdataCount_t count, BatchInsert_e mode)
+{
+	CHECK_PARAM(list != NULL, 0);
+	CHECK_PARAM(p_dataArray != NULL, 0);
+
+	List_st*     p_list   = CONVERT_2_LIST(list);
+	void*        p_data   = NULL;
+	ListNode_t   node     = NULL;
+	ListNode_t   next     = NULL;
+	ListNode_t   chain    = NULL;
+	ListNode_t   last     = NULL;
+	ListNode_t   failed   = NULL;
+	CdataCount_t inserted = 0;
+	CdataCount_t i        = 0;
+	int          ret      = ERR_OK;
+
+	if (mode == BATCH_INSERT_UNI && !LIST_CAN_COMPARE_EQUAL(p_list))
+	{
+		LOG_E("nodeEqualFn is NULL, pls set a valid function first.\n");
+		return 0;
+	}
+
+	//The data is copied into the blocks directly, there is no node to create beforehand.
+	if (p_list->type == LIST_TYPE_UNROLLED)
+	{
+		if (mode == BATCH_INSERT_ASC)
+		{
+			LOG_E("Unrolled list can only insert data at the head or tail.\n");
+			return 0;
+		}
+
+		List_Lock(list);
+		for (i = 0; i < count; i++)
+		{
+			p_data = (char*)p_dataArray + i * p_list->dataLength;
+			if (InsertUnrolledDataNL(p_list, p_data, mode == BATCH_INSERT_HEAD, mode == BATCH_INSERT_UNI) != NULL)
+			{
+				inserted++;
+			}
+		}
+		List_UnLock(list);
+
+		return inserted;
+	}
+
+	//The links are embedded in the data, one is written only when its data is going to be inserted.
+	if (p_list->dataType == LIST_DATA_TYPE_INTRUSIVE)
+	{
+		List_Lock(list);
+		for (i = 0; i < count; i++)
+		{
+			p_data = ((void**)p_dataArray)[i];
+			if (mode == BATCH_INSERT_UNI && HasDuplicateDataNL(p_list, p_data, NULL))
+			{
+				continue;
+			}
+
+			if (List_CreateNode(list, p_data, &node) == ERR_OK
+				&& InsertBatchNodeNL(p_list, node, (mode == BATCH_INSERT_UNI) ? BATCH_INSERT_TAIL : mode) == ERR_OK)
+			{
+				inserted++;
+			}
+		}
+		List_UnLock(list);
+
+		return inserted;
+	}
+
+	//One chunk for all the nodes, so the pool doesn't go to malloc in the middle.
+	if (p_list->pool != NULL)
+	{
+		//The pool counts its slots by int, the nodes beyond that are allocated chunk by chunk as usual.
+		if (count > 0x7FFFFFFF)
+		{
+			LOG_W("Only %d of %llu nodes are reserved in the pool.\n", 0x7FFFFFFF, count);
+		}
+
+		if (NodePool_Reserve(p_list->pool, (count > 0x7FFFFFFF) ? 0x7FFFFFFF : (int)count) != ERR_OK)
+		{
+			LOG_E("Fail to reserve %llu nodes.\n", count);
+			return 0;
+		}
+	}
+
+	//The nodes are created before locking the list, they are chained by p_next until they are linked.
+	for (i = 0; i < count; i++)
+	{
+		if (p_list->dataType == LIST_DATA_TYPE_VALUE_COPY)
+		{
+			p_data = (char*)p_dataArray + i * p_list->dataLength;
+		}
+		else
+		{
+			p_data = ((void**)p_dataArray)[i];
+		}
+
+		if (List_CreateNode(list, p_data, &node) != ERR_OK)
+		{
+			LOG_E("Fail to create node %llu of %llu.\n", i, count);
+			for (node = chain; node != NULL; node = next)
+			{
+				next = LIST_CHAIN_NEXT(node);
+				DestroyFailedNode(list, node);
+			}
+			return 0;
+		}
+
+		LIST_CHAIN_NEXT(node) = NULL;
+		if (last == NULL)
+		{
+			chain = node;
+		}
+		else
+		{
+			LIST_CHAIN_NEXT(last) = node;
+		}
+		last = node;
+	}
+
+	List_Lock(list);
+	for (node = chain; node != NULL; node = next)
+	{
+		next = LIST_CHAIN_NEXT(node);
+		ret  = InsertBatchNodeNL(p_list, node, mode);
+		if (ret != ERR_OK)
+		{
+			LIST_CHAIN_NEXT(node) = failed;
+			failed = node;
+			continue;
+		}
+		inserted++;
+	}
+	List_UnLock(list);
+
+	for (node = failed; node != NULL; node = next)
+	{
+		next = LIST_CHAIN_NEXT(node);
+		DestroyFailedNode(list, node);
+	}
+
+	return inserted;
+}
+
+/*
+ * Detach up to max nodes from the head. The detached nodes are still linked by their own p_next,
+ * p_next of the last one is not cut off.
+ */
+static ListNode_t DetachHeadRunNL(List_st* p_list, CdataCount_t max, ListNode_t* p_last, CdataCount_t* p_count)
+{
+	ListNode_t first = NULL;
+	ListNode_t node  = NULL;
+
+	*p_last  = NULL;
+	*p_count = 0;
+	if (p_list->type == LIST_TYPE_UNROLLED)
+	{
+		LOG_E("The slots of unrolled list:'%s' can't be chained.\n", p_list->name);
+		return NULL;
+	}
+
+	while (*p_count < max && (node = List_DetachNextNodeNL(p_list, NULL)) != NULL)
+	{
+		if (first == NULL)
+		{
+			first = node;
+		}
+		*p_last = node;
+		(*p_count)++;
+	}
+
+	return first;
+}
+
+//Take the data pointer out of the node, the node is left without data.
+static void* TakeNodeData(List_st* p_list, ListNode_t node)
+{
+	void* p_data = NULL;
+
+	if (p_list->type == LIST_TYPE_DOUBLE_LINK)
+	{
+		DBListNode_st *p_listNode = (DBListNode_st*)node;
+		p_data = p_listNode->p_data;
+		LIST_PUBLISH(p_listNode->p_data, NULL);
+	}
+	else if (p_list->type == LIST_TYPE_SINGLE_LINK)
+	{
+		SGListNode_st *p_listNode = (SGListNode_st*)node;
+		p_data = p_listNode->p_data;
+		p_listNode->p_data = NULL;
+	}
+	else if (p_list->type == LIST_TYPE_UNROLLED)
+	{
+		p_data = UList_TakeNodeData(p_list, node);
+	}
+	else
+	{
+		LOG_E("Invalid list type:%d.\n", p_list->type);
+	}
+
+	return p_data;
+}
+
+/*
+ * The nodes are relinked as they are, so both lists must have the same node layout, and neither of them
+ * may own the node memory(pool) or keep anything about the nodes besides the links(indexes, RCU readers).
+ */
+static int CheckRunMovable(List_st* p_dst, List_st* p_src)
+{
+	if (p_dst == p_src)
 	{
-		if (List_DetachNode(list, p_node) != ERR_OK)
-		{
-			LOG_E("Fail to detach node.\n");
-			return ERR_FAIL;
-		}
+		LOG_E("Can't move nodes inside list:'%s'.\n", p_dst->name);
+		return ERR_BAD_PARAM;
+	}
 
-		if (List_DestroyNode(list, p_node) != ERR_OK)
-		{
-			LOG_E("Fail to destroy node.\n");
-			return ERR_FAIL;
-		}
+	if (p_dst->type != p_src->type || p_dst->dataType != p_src->dataType || p_dst->dataLength != p_src->dataLength
+		|| p_dst->linkOffset != p_src->linkOffset)
+	{
+		LOG_E("List:'%s' and '%s' have different node types.\n", p_dst->name, p_src->name);
+		return ERR_BAD_PARAM;
+	}
+
+	//The slots of the unrolled list belong to its blocks, just like the pool nodes.
+	if (p_dst->pool != NULL || p_src->pool != NULL || p_dst->type == LIST_TYPE_UNROLLED)
+	{
+		LOG_E("Can't move the pool nodes or unrolled slots between list:'%s' and '%s'.\n", p_dst->name, p_src->name);
+		return ERR_BAD_PARAM;
+	}
+
+	if (LIST_HAS_POS_INDEX(p_dst) || LIST_HAS_POS_INDEX(p_src) || LIST_IS_SORTED(p_dst) || LIST_IS_SORTED(p_src)
+		|| p_dst->p_hashIndex != NULL || p_src->p_hashIndex != NULL || LIST_HAS_KEY_COLUMN(p_dst) || LIST_HAS_KEY_COLUMN(p_src))
+	{
+		LOG_E("Can't move nodes between list:'%s' and '%s', they have indexes.\n", p_dst->name, p_src->name);
+		return ERR_BAD_PARAM;
+	}
 
+	if (p_dst->retireList != NULL || p_src->retireList != NULL)
+	{
+		LOG_E("Can't move nodes between list:'%s' and '%s', they have lock-free readers.\n", p_dst->name, p_src->name);
+		return ERR_BAD_PARAM;
 	}
 
 	return ERR_OK;
 }
 
-CdataCount_t List_RmAllMatchNodes(List_t list, void* p_userData)
+//Two lists are always locked in the address order, so two threads moving nodes in the opposite directions can't deadlock.
+static void LockListPair(List_t firstList, List_t secondList)
 {
-	CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
-	CHECK_PARAM(p_userData != NULL, ERR_BAD_PARAM);
+	if (firstList < secondList)
+	{
+		List_Lock(firstList);
+		List_Lock(secondList);
+	}
+	else
+	{
+		List_Lock(secondList);
+		List_Lock(firstList);
+	}
+}
 
-	List_st* p_list = CONVERT_2_LIST(list);
-	void*    p_node = NULL;
-	void*    p_next = NULL;
-	void*    p_data = NULL;
-	CdataBool found = CDATA_FALSE;
-	CdataCount_t count = 0;
+static void UnLockListPair(List_t firstList, List_t secondList)
+{
+	List_UnLock(firstList);
+	List_UnLock(secondList);
+}
+
+//Find the pre node of node from the head, p_index outputs the position of node if it's not NULL.
+static ListNode_t FindPreNodeNL(List_st* p_list, ListNode_t node, CdataCount_t* p_index)
+{
+	ListNode_t   preNode = NULL;
+	ListNode_t   cur     = p_list->p_head;
+	CdataCount_t index   = 0;
 
-	if (p_list->equal2KeywordFn == NULL)
+	while (cur != NULL && cur != node)
 	{
-		LOG_E("equal2KeywordFn is NULL, pls set a valid equal2KeywordFn first.\n");
-		return ERR_BAD_PARAM;
+		preNode = cur;
+		cur = LIST_CHAIN_NEXT(cur);
+		index++;
 	}
 
-	List_Lock(list);
-	count = 0;
-	p_next = p_list->p_head;
-	while(1)
+	if (cur == NULL)
 	{
-		for (p_node = p_next, found = CDATA_FALSE; p_node != NULL; p_node = List_GetNextNodeNL(list, p_node))
-		{
-			p_data = List_GetNodeDataNL(list, p_node);
-			if (p_list->equal2KeywordFn(p_data, p_userData))
-			{
-				found = CDATA_TRUE;
-				count++;
-				break;
-			}
-		}
+		return NULL;
+	}
 
-		if (found)
-		{
-			p_next = List_GetNextNodeNL(list, p_node);
+	if (p_index != NULL)
+	{
+		*p_index = index;
+	}
 
-			if (List_DetachNodeNL(list, p_node) != ERR_OK)
-			{
-                LOG_E("Fail to detach node.\n");
-                continue;
-            }
-			if (List_DestroyNode(list, p_node) != ERR_OK)
-			{
-                LOG_E("Fail to destroy node.\n");
-            }
+	return preNode;
+}
+
+static void MoveRunNL(List_st* p_dst, ListNode_t pos, List_st* p_src, ListNode_t preNode, ListNode_t first, ListNode_t last, CdataCount_t count)
+{
+	if (p_src->type == LIST_TYPE_DOUBLE_LINK)
+	{
+		DBList_UnlinkRun(p_src, first, last, count);
+		DBList_LinkRunAfter(p_dst, pos, first, last, count);
+	}
+	else
+	{
+		SGList_UnlinkRun(p_src, preNode, last, count);
+		SGList_LinkRunAfter(p_dst, pos, first, last, count);
+	}
+}
+
+//Merge two sorted runs which are chained by p_next, the nodes of left go first if they are equal.
+static ListNode_t MergeRuns(List_st* p_list, List_UserLtNode_fn ltFn, ListNode_t left, ListNode_t right)
+{
+	SGListNode_st  head;
+	SGListNode_st* p_last = &head;
+	size_t         dataOffset = (p_list->type == LIST_TYPE_DOUBLE_LINK) ? offsetof(DBListNode_st, p_data) : offsetof(SGListNode_st, p_data);
+
+	while (left != NULL && right != NULL)
+	{
+		//ltFn(p_nodeData, p_userData) tells if p_userData < p_nodeData.
+		if ((ltFn != NULL) ? ltFn(NODE_DATA_AT(left, dataOffset), NODE_DATA_AT(right, dataOffset))
+			: List_IsUserLtNode(p_list, NODE_DATA_AT(left, dataOffset), NODE_DATA_AT(right, dataOffset)))
+		{
+			p_last->p_next = right;
+			right = LIST_CHAIN_NEXT(right);
 		}
 		else
 		{
-			break;
+			p_last->p_next = left;
+			left = LIST_CHAIN_NEXT(left);
 		}
+		p_last = (SGListNode_st*)p_last->p_next;
 	}
-	List_UnLock(list);
+	p_last->p_next = (left != NULL) ? left : right;
 
-	return count;
+	return head.p_next;
 }
-CdataCount_t List_RmAllMatchNodesByCond(List_t list, void* p_userData, List_Condition_fn conditionFn)
+
+//Set the links which the merge doesn't keep: p_pre of double list, the tail, and the position index.
+static void RelinkSortedNL(List_st* p_list, ListNode_t head)
 {
-	CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
-	CHECK_PARAM(conditionFn != NULL, ERR_BAD_PARAM);
+	ListNode_t node = NULL;
+	ListNode_t pre  = NULL;
 
-	List_st* p_list = CONVERT_2_LIST(list);
-	void*    p_node = NULL;
-	void*    p_next = NULL;
-	void*    p_data = NULL;
-	CdataBool found = CDATA_FALSE;
-	CdataCount_t count = 0;
+	if (LIST_HAS_POS_INDEX(p_list))
+	{
+		PosIndex_Clear(&p_list->posIndex);
+	}
+	KeyColumn_Clear(&p_list->keyColumn);
 
-	List_Lock(list);
-	count = 0;
-	p_next = p_list->p_head;
-	while(1)
+	p_list->modCount++;
+	p_list->p_finger = NULL;
+	p_list->p_head = head;
+	for (node = head; node != NULL; pre = node, node = LIST_CHAIN_NEXT(node))
 	{
-		for (p_node = p_next, found = CDATA_FALSE; p_node != NULL; p_node = List_GetNextNodeNL(list, p_node))
+		if (p_list->type == LIST_TYPE_DOUBLE_LINK)
 		{
-			p_data = List_GetNodeDataNL(list, p_node);
-			if (conditionFn(p_data, p_userData))
-			{
-				found = CDATA_TRUE;
-				count++;
-				break;
-			}
+			((DBListNode_st*)node)->p_pre = (DBListNode_st*)pre;
 		}
 
-		if (found)
-		{
-			p_next = List_GetNextNodeNL(list, p_node);
-
-			if (List_DetachNodeNL(list, p_node) != ERR_OK)
-			{
-                LOG_E("Fail to detach node.\n");
-                continue;
-            }
-			if (List_DestroyNode(list, p_node) != ERR_OK)
-			{
-                LOG_E("Fail to destroy node.\n");
-            }
-
-		}
-		else
+		if (LIST_HAS_POS_INDEX(p_list))
 		{
-			break;
+			PosIndex_InsertBefore(&p_list->posIndex, node, NULL);
 		}
 	}
-	List_UnLock(list);
+	p_list->p_tail = pre;
 
-	return count;
+	//The column is refilled in the new order, every node is appended.
+	for (node = head; node != NULL && LIST_HAS_KEY_COLUMN(p_list); node = LIST_CHAIN_NEXT(node))
+	{
+		AddToKeyColumn(p_list, node, NULL);
+	}
 }
 
-
-/*=============================================================================*
- *                    Inner function implemention
- *============================================================================*/
-List_t  CreateList(ListName_t name, ListType_e type, List_DataType_e dataType, int dataLength)
+static ListNode_t InsertUnrolledData(List_t list, void* p_data, CdataBool toHead, CdataBool unique)
 {
-    OSMutex_t* guard = NULL;
-    List_st* p_newList = NULL;
+	List_st*   p_list = CONVERT_2_LIST(list);
+	ListNode_t node   = NULL;
 
-    size_t minNameLen = 0;
-    size_t nameLen = 0;
-    size_t maxLen = 0;
+	if (unique && !LIST_CAN_COMPARE_EQUAL(p_list))
+	{
+		LOG_E("nodeEqualFn is NULL, pls set a valid function first.\n");
+		return NULL;
+	}
 
-    guard = CreateGuard();
-    if (guard == NULL)
-    {
-        LOG_E("Fail to create list guard.\n");
-        return NULL;
-    }
+	List_Lock(list);
+	node = InsertUnrolledDataNL(p_list, p_data, toHead, unique);
+	List_UnLock(list);
 
-    p_newList = (List_st*) OS_Malloc(sizeof(List_st));
-    if (NULL == p_newList)
-    {
-        LOG_E("Have no enough memory.\n");
+	return node;
+}
 
-        DeleteGuard(guard);
-        return NULL;
-    }
-    memset(p_newList, 0x0, sizeof(List_st));
+//The duplicate check and the insert are done under the same lock.
+static ListNode_t InsertUnrolledDataNL(List_st* p_list, void* p_data, CdataBool toHead, CdataBool unique)
+{
+	ListNode_t node = NULL;
+	int        ret  = ERR_OK;
 
-	p_newList->type    = type;
-    p_newList->p_head  = NULL;
-    p_newList->p_tail  = NULL;
+	if (unique && HasDuplicateDataNL(p_list, p_data, NULL))
+	{
+		return NULL;
+	}
 
-    p_newList->name[0] = '\0';
-    nameLen = strlen(name);
-    maxLen = sizeof(ListName_t) - 1;
-    minNameLen = nameLen < maxLen ? nameLen : maxLen;
-    memcpy(p_newList->name, name, minNameLen);
-    p_newList->name[minNameLen] = '\0';
+	ret = toHead ? UList_InsertData2Head(p_list, p_data, &node) : UList_InsertData(p_list, p_data, &node);
+	if (ret != ERR_OK)
+	{
+		LOG_E("Fail to insert data into unrolled list:'%s'.\n", p_list->name);
+		return NULL;
+	}
 
-    p_newList->dataType    = dataType;
-    p_newList->dataLength  = dataLength;
+	return node;
+}
 
-    p_newList->nodeCount    = 0;
-    p_newList->guard  = guard;
+//The slots can't be chained by p_next, so they are destroyed as soon as they are detached.
+static CdataCount_t RmUnrolledMatchNodes(List_t list, void* p_userData, List_Condition_fn conditionFn)
+{
+	ListIter_t   iter;
+	void*        p_node = NULL;
+	void*        p_data = NULL;
+	CdataCount_t count  = 0;
 
-	p_newList->freeFn = NULL;
-	p_newList->equal2KeywordFn = NULL;
-	p_newList->usrLtNodeFn = NULL;
-	p_newList->nodeEqualFn = NULL;
+	List_Lock(list);
+	List_IterInitNL(list, &iter);
+	while ((p_node = List_IterNextNL(list, &iter)) != NULL)
+	{
+		p_data = List_GetNodeDataNL(list, p_node);
+		if (p_data == NULL || !MatchCondition(CONVERT_2_LIST(list), conditionFn, p_data, p_userData))
+		{
+			continue;
+		}
 
-    return p_newList;
+		if (List_IterDetachNL(list, &iter) == NULL)
+		{
+			LOG_E("Fail to detach node.\n");
+			continue;
+		}
+
+		List_DestroyNode(list, p_node);
+		count++;
+	}
+	List_UnLock(list);
+
+	return count;
 }
 
-static OSMutex_t  CreateGuard()
+static void MoveCursorsOffRun(List_st* p_list, void* p_first, void* p_last, void* p_nextNode)
 {
-    OSMutex_t mutex = OS_MutexCreate();
-    if(mutex == NULL)
-    {
-        LOG_E("Fail to create a mutex!\n");
-        return NULL;
-    }
+	ListCursor_t* p_cursor = NULL;
+	void*         p_node = NULL;
 
-    return mutex;
+	for (p_cursor = p_list->p_cursors; p_cursor != NULL; p_cursor = p_cursor->p_next)
+	{
+		for (p_node = p_first; p_node != NULL; p_node = LIST_CHAIN_NEXT(p_node))
+		{
+			if (p_node == p_cursor->nextNode)
+			{
+				p_cursor->nextNode = p_nextNode;
+				break;
+			}
+
+			if (p_node == p_last)
+			{
+				break;
+			}
+		}
+	}
 }
 
-static void DeleteGuard(OSMutex_t guard)
+static int CursorTraverseNL(ListCursor_t* p_cursor, CdataCount_t maxNodes, void* p_userData, List_Traverse_fn traverseFn, CdataBool* p_needStop)
 {
-    ASSERT(guard != NULL);
+	List_t                 list = p_cursor->list;
+	ListNode_t             node = NULL;
+	CdataCount_t           count = 0;
+	ListTraverseNodeInfo_t info;
 
-    OS_MutexDestroy(guard);
+	*p_needStop = CDATA_FALSE;
+	for (count = 0; count < maxNodes && !*p_needStop && (node = p_cursor->nextNode) != NULL; count++)
+	{
+		//The cursor steps before the callback, so it's never on the node the callback gets.
+		p_cursor->nextNode = List_GetNextNodeNL(list, node);
+
+		info.index  = p_cursor->index++;
+		info.node   = node;
+		info.p_data = List_GetNodeDataNL(list, node);
+		traverseFn(&info, p_userData, p_needStop);
+	}
+
+	return (p_cursor->nextNode == NULL) ? ERR_DATA_NOT_EXISTS : ERR_OK;
 }
 
-static CdataBool   HasDuplicateNode(List_t list, ListNode_t node)
+static ListNode_t WalkFromNodeNL(List_st* p_list, ListNode_t node, CdataIndex_t from, CdataIndex_t to)
 {
-	ASSERT(list != NULL);
-	ASSERT(node != NULL);
-
-	void *p_node     = NULL;
-	void *p_data     = NULL;
-	void *p_userData = NULL;
-	CdataBool isDuplicate = CDATA_FALSE;
-	List_st* p_list  = CONVERT_2_LIST(list);
+	for (; node != NULL && from < to; from++)
+	{
+		node = List_GetNextNodeNL(p_list, node);
+	}
 
-	List_Lock(list);
-	p_userData = List_GetNodeDataNL(list, node);
-	for (p_node = p_list->p_head; p_node != NULL; p_node = List_GetNextNodeNL(list, p_node))
+	for (; node != NULL && from > to; from--)
 	{
-		p_data = List_GetNodeDataNL(list, p_node);
-		if (p_list->nodeEqualFn(p_data, p_userData))
-		{
-			isDuplicate = CDATA_TRUE;
-			break;
-		}
+		node = List_GetPreNodeNL(p_list, node);
 	}
-	List_UnLock(list);
 
-	return isDuplicate;
+	return node;
 }
 
 /*=============================================================================*
  *                                End of file
  *============================================================================*/
-
@@ -4,6 +4,8 @@
 #include <time.h>
 #include <errno.h>
 #include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
 
 #include "cdata_types.h"
 #include "cdata_os_adapter.h"
@@ -19,6 +21,9 @@
  *============================================================================*/
 #define TO_MUTEX(_mutex_)       (pthread_mutex_t*)(_mutex_)
 #define TO_COND(_cond_)         (OSCond_st*)(_cond_)
+#define TO_RWLOCK(_rwLock_)     (pthread_rwlock_t*)(_rwLock_)
+#define TO_THREAD_KEY(_key_)    (pthread_key_t*)(_key_)
+#define TO_THREAD(_thread_)     (pthread_t*)(_thread_)
 
 /*=============================================================================*
  *                        Const definition
@@ -46,6 +51,11 @@ void *OS_Malloc(size_t size)
     return malloc(size);
 }
 
+void *OS_Realloc(void* p_mem, size_t size)
+{
+    return realloc(p_mem, size);
+}
+
 void  OS_Free(void* p_mem)
 {
     if (p_mem != NULL)
@@ -55,6 +65,18 @@ void  OS_Free(void* p_mem)
 }
 #endif
 
+void *OS_AlignedMalloc(size_t alignment, size_t size)
+{
+    void* p_mem = NULL;
+
+    if (posix_memalign(&p_mem, alignment, size) != 0)
+    {
+        return NULL;
+    }
+
+    return p_mem;
+}
+
 
 OSMutex_t OS_MutexCreate()
 {
@@ -113,6 +135,181 @@ int OS_MutexUnlock(OSMutex_t mutex)
     return ERR_OK;
 }
 
+OSRWLock_t OS_RWLockCreate()
+{
+    pthread_rwlock_t *p_rwLock = (pthread_rwlock_t* )OS_Malloc(sizeof(pthread_rwlock_t));
+    if (p_rwLock == NULL)
+    {
+        LOG_E("Fail to malloc rwlock.\n");
+        return NULL;
+    }
+
+    if (pthread_rwlock_init(p_rwLock, NULL) != 0)
+    {
+        LOG_E("Fail to init rwlock.\n");
+
+        OS_Free(p_rwLock);
+        return NULL;
+    }
+
+    return (OSRWLock_t)p_rwLock;
+}
+
+void  OS_RWLockDestroy(OSRWLock_t rwLock)
+{
+    if (rwLock != NULL)
+    {
+        pthread_rwlock_destroy(TO_RWLOCK(rwLock));
+        OS_Free(rwLock);
+    }
+}
+
+int OS_RWLockReadLock(OSRWLock_t rwLock)
+{
+    CHECK_PARAM(rwLock != NULL, ERR_BAD_PARAM);
+
+    int ret = 0;
+
+    ret = pthread_rwlock_rdlock(TO_RWLOCK(rwLock));
+    if (ret != 0)
+    {
+        LOG_E("Fail to read lock rwlock, error:%d, '%s'.\n", ret, strerror(ret));
+        return ERR_FAIL;
+    }
+
+    return ERR_OK;
+}
+
+int OS_RWLockWriteLock(OSRWLock_t rwLock)
+{
+    CHECK_PARAM(rwLock != NULL, ERR_BAD_PARAM);
+
+    int ret = 0;
+
+    ret = pthread_rwlock_wrlock(TO_RWLOCK(rwLock));
+    if (ret != 0)
+    {
+        LOG_E("Fail to write lock rwlock, error:%d, '%s'.\n", ret, strerror(ret));
+        return ERR_FAIL;
+    }
+
+    return ERR_OK;
+}
+
+int OS_RWLockUnlock(OSRWLock_t rwLock)
+{
+    CHECK_PARAM(rwLock != NULL, ERR_BAD_PARAM);
+
+    int ret = 0;
+
+    ret = pthread_rwlock_unlock(TO_RWLOCK(rwLock));
+    if (ret != 0)
+    {
+        LOG_E("Fail to unlock rwlock, error:%d, '%s'.\n", ret, strerror(ret));
+        return ERR_FAIL;
+    }
+
+    return ERR_OK;
+}
+
+OSThreadKey_t OS_ThreadKeyCreate(void (*destructor)(void* p_value))
+{
+    int ret = 0;
+    pthread_key_t *p_key = (pthread_key_t* )OS_Malloc(sizeof(pthread_key_t));
+    if (p_key == NULL)
+    {
+        LOG_E("Fail to malloc thread key.\n");
+        return NULL;
+    }
+
+    ret = pthread_key_create(p_key, destructor);
+    if (ret != 0)
+    {
+        LOG_E("Fail to create thread key, error:%d, '%s'.\n", ret, strerror(ret));
+        OS_Free(p_key);
+        return NULL;
+    }
+
+    return (OSThreadKey_t)p_key;
+}
+
+void  OS_ThreadKeyDestroy(OSThreadKey_t key)
+{
+    if (key != NULL)
+    {
+        pthread_key_delete(*TO_THREAD_KEY(key));
+        OS_Free(key);
+    }
+}
+
+int OS_ThreadKeySet(OSThreadKey_t key, void* p_value)
+{
+    CHECK_PARAM(key != NULL, ERR_BAD_PARAM);
+
+    int ret = 0;
+
+    ret = pthread_setspecific(*TO_THREAD_KEY(key), p_value);
+    if (ret != 0)
+    {
+        LOG_E("Fail to set thread key value, error:%d, '%s'.\n", ret, strerror(ret));
+        return ERR_FAIL;
+    }
+
+    return ERR_OK;
+}
+
+void OS_YieldThread()
+{
+    sched_yield();
+}
+
+OSThread_t OS_ThreadCreate(void* (*threadFn)(void* p_arg), void* p_arg)
+{
+    CHECK_PARAM(threadFn != NULL, NULL);
+
+    int ret = 0;
+    pthread_t *p_thread = (pthread_t*)OS_Malloc(sizeof(pthread_t));
+    if (p_thread == NULL)
+    {
+        LOG_E("Fail to malloc thread.\n");
+        return NULL;
+    }
+
+    ret = pthread_create(p_thread, NULL, threadFn, p_arg);
+    if (ret != 0)
+    {
+        LOG_E("Fail to create thread, error:%d, '%s'.\n", ret, strerror(ret));
+        OS_Free(p_thread);
+        return NULL;
+    }
+
+    return (OSThread_t)p_thread;
+}
+
+int OS_ThreadJoin(OSThread_t thread)
+{
+    CHECK_PARAM(thread != NULL, ERR_BAD_PARAM);
+
+    int ret = 0;
+
+    ret = pthread_join(*TO_THREAD(thread), NULL);
+    OS_Free(thread);
+    if (ret != 0)
+    {
+        LOG_E("Fail to join thread, error:%d, '%s'.\n", ret, strerror(ret));
+        return ERR_FAIL;
+    }
+
+    return ERR_OK;
+}
+
+int OS_GetCpuCount()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return (count > 0) ? (int)count : 1;
+}
+
 OSCond_t OS_CondCreate()
 {
     OSCond_st *p_cond = (OSCond_st*)OS_Malloc(sizeof(OSCond_st));
@@ -0,0 +1,504 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.6.10
+*/
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "cdata_types.h"
+#include "cdata_os_adapter.h"
+#include "cdata_list.h"
+#include "cdata_parallel.h"
+#include "cdata_threadpool.h"
+#include "list_internal.h"
+
+#ifndef _DEBUG_LEVEL_
+#define _DEBUG_LEVEL_  _DEBUG_LEVEL_I_
+#endif
+#include "debug.h"
+
+/*=============================================================================*
+ *                        Macro definition
+ *============================================================================*/
+
+/*=============================================================================*
+ *                        Const definition
+ *============================================================================*/
+/*A chunk shorter than this costs more to hand over than to run.*/
+#define PARALLEL_MIN_CHUNK_NODES   4096
+
+/*More chunks than threads, so a thread which finishes early takes another one.*/
+#define PARALLEL_CHUNKS_PER_THREAD 4
+
+#define PARALLEL_MAX_THREADS       (THREAD_POOL_MAX_THREADS + 1)
+
+/*=============================================================================*
+ *                    New type or enum declaration
+ *============================================================================*/
+typedef enum
+{
+    PARALLEL_JOB_FOR_EACH,
+    PARALLEL_JOB_COUNT_IF,
+    PARALLEL_JOB_REDUCE,
+    PARALLEL_JOB_MARK
+}ParallelJob_e;
+
+typedef struct
+{
+    ListNode_t   first;
+    CdataIndex_t firstIndex;
+    CdataCount_t count;
+    CdataCount_t matchCount;
+}ParallelChunk_st;
+
+typedef struct
+{
+    List_t            list;
+    ParallelJob_e     type;
+    void*             p_userData;
+
+    List_ForEach_fn   forEachFn;
+    List_Condition_fn conditionFn;
+    List_Reduce_fn    reduceFn;
+
+    /*One partial result for each chunk of PARALLEL_JOB_REDUCE.*/
+    char*             p_partials;
+    size_t            resultSize;
+
+    /*One mark for each node of PARALLEL_JOB_MARK.*/
+    unsigned char*    p_marks;
+
+    ParallelChunk_st* p_chunks;
+    int               chunkCount;
+
+    /*The chunks are taken by the threads through it.*/
+    volatile int      nextChunk;
+}ParallelJob_st;
+
+/*=============================================================================*
+ *                    Global variable
+ *============================================================================*/
+static ThreadPool_t g_threadPool   = NULL;
+static volatile int g_threadCount  = 0;
+
+/*=============================================================================*
+ *                    Inner function declaration
+ *============================================================================*/
+static int   SplitChunksNL(List_t list, ParallelChunk_st** pp_chunks);
+static int   RunJob(ParallelJob_st* p_job);
+static void  RunChunks(void* p_arg);
+static void  RunChunk(ParallelJob_st* p_job, ParallelChunk_st* p_chunk, int chunkIndex);
+static ThreadPool_t GetThreadPool();
+
+/*=============================================================================*
+ *                    Outer function implemention
+ *============================================================================*/
+int List_SetParallelThreads(int threadCount)
+{
+    CHECK_PARAM(threadCount >= 0 && threadCount <= PARALLEL_MAX_THREADS, ERR_BAD_PARAM);
+
+    g_threadCount = threadCount;
+
+    return ERR_OK;
+}
+
+int List_GetParallelThreads()
+{
+    int threadCount = g_threadCount;
+
+    if (threadCount == 0)
+    {
+        threadCount = OS_GetCpuCount();
+    }
+
+    return (threadCount > PARALLEL_MAX_THREADS) ? PARALLEL_MAX_THREADS : threadCount;
+}
+
+int List_ParallelForEach(List_t list, void* p_userData, List_ForEach_fn forEachFn)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(forEachFn != NULL, ERR_BAD_PARAM);
+
+    ParallelJob_st job;
+    int            ret = ERR_OK;
+
+    memset(&job, 0, sizeof(job));
+    job.list       = list;
+    job.type       = PARALLEL_JOB_FOR_EACH;
+    job.p_userData = p_userData;
+    job.forEachFn  = forEachFn;
+
+    List_SharedLock(list);
+    ret = RunJob(&job);
+    List_SharedUnLock(list);
+
+    OS_Free(job.p_chunks);
+
+    return ret;
+}
+
+CdataCount_t List_ParallelCountIf(List_t list, void* p_userData, List_Condition_fn conditionFn)
+{
+    CHECK_PARAM(list != NULL, 0);
+    CHECK_PARAM(conditionFn != NULL, 0);
+
+    ParallelJob_st job;
+    CdataCount_t   count = 0;
+    int            i = 0;
+
+    memset(&job, 0, sizeof(job));
+    job.list        = list;
+    job.type        = PARALLEL_JOB_COUNT_IF;
+    job.p_userData  = p_userData;
+    job.conditionFn = conditionFn;
+
+    List_SharedLock(list);
+    if (RunJob(&job) == ERR_OK)
+    {
+        for (i = 0; i < job.chunkCount; i++)
+        {
+            count += job.p_chunks[i].matchCount;
+        }
+    }
+    List_SharedUnLock(list);
+
+    OS_Free(job.p_chunks);
+
+    return count;
+}
+
+int List_ParallelReduce(List_t list, void* p_userData, List_Reduce_fn reduceFn, List_Merge_fn mergeFn,
+                        void* p_result, size_t resultSize)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(reduceFn != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(mergeFn != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(p_result != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(resultSize > 0, ERR_BAD_PARAM);
+
+    ParallelJob_st job;
+    int            ret = ERR_OK;
+    int            i = 0;
+
+    memset(&job, 0, sizeof(job));
+    job.list       = list;
+    job.type       = PARALLEL_JOB_REDUCE;
+    job.p_userData = p_userData;
+    job.reduceFn   = reduceFn;
+    job.resultSize = resultSize;
+
+    List_SharedLock(list);
+    ret = SplitChunksNL(list, &job.p_chunks);
+    if (ret < 0)
+    {
+        goto EXIT;
+    }
+    job.chunkCount = ret;
+
+    job.p_partials = (char*)OS_Malloc(resultSize * (job.chunkCount + 1));
+    if (job.p_partials == NULL)
+    {
+        LOG_E("Not enough memory for %d partial results.\n", job.chunkCount);
+        ret = ERR_OUT_MEM;
+        goto EXIT;
+    }
+    for (i = 0; i < job.chunkCount; i++)
+    {
+        memcpy(job.p_partials + i * resultSize, p_result, resultSize);
+    }
+
+    ret = RunJob(&job);
+    if (ret != ERR_OK)
+    {
+        goto EXIT;
+    }
+
+    for (i = 0; i < job.chunkCount; i++)
+    {
+        mergeFn(p_result, job.p_partials + i * resultSize, p_userData);
+    }
+
+    EXIT:
+    List_SharedUnLock(list);
+
+    OS_Free(job.p_partials);
+    OS_Free(job.p_chunks);
+
+    return (ret < 0) ? ret : ERR_OK;
+}
+
+CdataCount_t List_ParallelRemoveIf(List_t list, void* p_userData, List_Condition_fn conditionFn)
+{
+    CHECK_PARAM(list != NULL, 0);
+    CHECK_PARAM(conditionFn != NULL, 0);
+
+    List_st*       p_list = CONVERT_2_LIST(list);
+    ParallelJob_st job;
+    ListNode_t     chain = NULL;
+    CdataCount_t   matchCount = 0;
+    CdataCount_t   count = 0;
+    int            i = 0;
+
+    //The slots of unrolled list can't be chained.
+    if (p_list->type == LIST_TYPE_UNROLLED)
+    {
+        return List_RmAllMatchNodesByCond(list, p_userData, conditionFn);
+    }
+
+    memset(&job, 0, sizeof(job));
+    job.list        = list;
+    job.type        = PARALLEL_JOB_MARK;
+    job.p_userData  = p_userData;
+    job.conditionFn = conditionFn;
+
+    List_Lock(list);
+    job.p_marks = (unsigned char*)OS_Malloc(List_Count(list) + 1);
+    if (job.p_marks == NULL)
+    {
+        LOG_E("Not enough memory for the marks of list:'%s'.\n", p_list->name);
+        goto EXIT;
+    }
+
+    if (RunJob(&job) != ERR_OK)
+    {
+        goto EXIT;
+    }
+
+    for (i = 0; i < job.chunkCount; i++)
+    {
+        matchCount += job.p_chunks[i].matchCount;
+    }
+
+    if (matchCount > 0)
+    {
+        chain = List_DetachMarkedChainNL(p_list, job.p_marks, &count);
+        ASSERT(count == matchCount);
+    }
+
+    EXIT:
+    List_UnLock(list);
+
+    List_DestroyNodeChain(list, chain);
+    OS_Free(job.p_marks);
+    OS_Free(job.p_chunks);
+
+    return count;
+}
+
+/*=============================================================================*
+ *                    Inner function implemention
+ *============================================================================*/
+/*Return the count of the chunks, or an error code which is less than 0.*/
+static int SplitChunksNL(List_t list, ParallelChunk_st** pp_chunks)
+{
+    ASSERT(list != NULL);
+    ASSERT(pp_chunks != NULL);
+
+    ParallelChunk_st* p_chunks = NULL;
+    CdataCount_t      nodeCount = List_Count(list);
+    CdataCount_t      maxChunks = 0;
+    CdataIndex_t      index = 0;
+    ListNode_t        node = NULL;
+    int               threadCount = 0;
+    int               chunkCount = 0;
+    int               i = 0;
+
+    *pp_chunks = NULL;
+    if (nodeCount == 0)
+    {
+        return 0;
+    }
+
+    //One chunk needs no walk to split the list.
+    threadCount = List_GetParallelThreads();
+    chunkCount  = (threadCount == 1) ? 1 : threadCount * PARALLEL_CHUNKS_PER_THREAD;
+    maxChunks = (nodeCount + PARALLEL_MIN_CHUNK_NODES - 1) / PARALLEL_MIN_CHUNK_NODES;
+    if ((CdataCount_t)chunkCount > maxChunks)
+    {
+        chunkCount = (int)maxChunks;
+    }
+
+    p_chunks = (ParallelChunk_st*)OS_Malloc(sizeof(ParallelChunk_st) * chunkCount);
+    if (p_chunks == NULL)
+    {
+        LOG_E("Not enough memory for %d chunks.\n", chunkCount);
+        return ERR_OUT_MEM;
+    }
+
+    //The list is walked once, the first node of each chunk is kept when it's passed.
+    node = List_GetHeadNL(list);
+    for (i = 0; i < chunkCount; i++)
+    {
+        p_chunks[i].first      = node;
+        p_chunks[i].firstIndex = index;
+        p_chunks[i].count      = nodeCount * (i + 1) / chunkCount - index;
+        p_chunks[i].matchCount = 0;
+
+        if (i == chunkCount - 1)
+        {
+            break;
+        }
+
+        for (; index < nodeCount * (i + 1) / chunkCount; index++)
+        {
+            node = List_GetNextNodeNL(list, node);
+        }
+    }
+
+    *pp_chunks = p_chunks;
+    return chunkCount;
+}
+
+static int RunJob(ParallelJob_st* p_job)
+{
+    ASSERT(p_job != NULL);
+
+    ThreadPool_t pool = NULL;
+    int          threadCount = 0;
+    int          ret = ERR_OK;
+
+    if (p_job->p_chunks == NULL)
+    {
+        ret = SplitChunksNL(p_job->list, &p_job->p_chunks);
+        if (ret < 0)
+        {
+            return ret;
+        }
+        p_job->chunkCount = ret;
+    }
+
+    p_job->nextChunk = 0;
+    threadCount = List_GetParallelThreads();
+    if (threadCount > p_job->chunkCount)
+    {
+        threadCount = p_job->chunkCount;
+    }
+
+    pool = (threadCount > 1) ? GetThreadPool() : NULL;
+    if (pool == NULL)
+    {
+        RunChunks(p_job);
+        return ERR_OK;
+    }
+
+    return ThreadPool_Run(pool, threadCount, RunChunks, p_job);
+}
+
+static void RunChunks(void* p_arg)
+{
+    ParallelJob_st* p_job = (ParallelJob_st*)p_arg;
+    int             i = 0;
+
+    while ((i = __sync_fetch_and_add(&p_job->nextChunk, 1)) < p_job->chunkCount)
+    {
+        RunChunk(p_job, &p_job->p_chunks[i], i);
+    }
+}
+
+static void RunChunk(ParallelJob_st* p_job, ParallelChunk_st* p_chunk, int chunkIndex)
+{
+    List_t       list       = p_job->list;
+    ListNode_t   node       = p_chunk->first;
+    void*        p_data     = NULL;
+    void*        p_partial  = NULL;
+    CdataCount_t matchCount = 0;
+    CdataCount_t i = 0;
+    CdataBool    isMatched = CDATA_FALSE;
+
+    if (p_job->type == PARALLEL_JOB_REDUCE)
+    {
+        p_partial = p_job->p_partials + chunkIndex * p_job->resultSize;
+    }
+
+    for (i = 0; i < p_chunk->count; i++, node = List_GetNextNodeNL(list, node))
+    {
+        p_data = List_GetNodeDataNL(list, node);
+
+        //The data may have been detached from the node by List_DetachNodeData.
+        if (p_data == NULL)
+        {
+            if (p_job->type == PARALLEL_JOB_MARK)
+            {
+                p_job->p_marks[p_chunk->firstIndex + i] = 0;
+            }
+            continue;
+        }
+
+        switch (p_job->type)
+        {
+            case PARALLEL_JOB_FOR_EACH:
+                p_job->forEachFn(p_data, p_job->p_userData);
+                break;
+
+            case PARALLEL_JOB_COUNT_IF:
+                matchCount += p_job->conditionFn(p_data, p_job->p_userData) ? 1 : 0;
+                break;
+
+            case PARALLEL_JOB_REDUCE:
+                p_job->reduceFn(p_data, p_job->p_userData, p_partial);
+                break;
+
+            case PARALLEL_JOB_MARK:
+                isMatched = p_job->conditionFn(p_data, p_job->p_userData) ? CDATA_TRUE : CDATA_FALSE;
+                p_job->p_marks[p_chunk->firstIndex + i] = (unsigned char)isMatched;
+                matchCount += isMatched;
+                break;
+        }
+    }
+
+    p_chunk->matchCount = matchCount;
+}
+
+static ThreadPool_t GetThreadPool()
+{
+    ThreadPool_t pool = g_threadPool;
+
+    if (pool != NULL)
+    {
+        return pool;
+    }
+
+    pool = ThreadPool_Create();
+    if (pool == NULL)
+    {
+        LOG_E("Fail to create thread pool, the jobs are run on the calling thread.\n");
+        return NULL;
+    }
+
+    //Two threads may create the pool at the same time, only one of them is kept.
+    if (!__sync_bool_compare_and_swap(&g_threadPool, NULL, pool))
+    {
+        ThreadPool_Destroy(pool);
+    }
+
+    return g_threadPool;
+}
+
+/*=============================================================================*
+ *                                End of file
+ *============================================================================*/
@@ -0,0 +1,269 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.4.1
+*/
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "cdata_types.h"
+#include "cdata_os_adapter.h"
+#include "cdata_pool.h"
+
+#ifndef _DEBUG_LEVEL_
+#define _DEBUG_LEVEL_  _DEBUG_LEVEL_I_
+#endif
+#include "debug.h"
+
+/*=============================================================================*
+ *                        Macro definition
+ *============================================================================*/
+#define TO_POOL(_pool_) (NodePool_st*)(_pool_)
+
+#define POOL_LOCK(_pool_)   while (__sync_lock_test_and_set(&(_pool_)->guard, 1)) { while ((_pool_)->guard) {} }
+#define POOL_UNLOCK(_pool_) __sync_lock_release(&(_pool_)->guard)
+
+#define ROUND_UP(_size_, _align_) ((((_size_) + (_align_) - 1) / (_align_)) * (_align_))
+
+/*=============================================================================*
+ *                        Const definition
+ *============================================================================*/
+/*The slots are aligned to two pointers, the same as what malloc gives us.*/
+#define SLOT_ALIGN          (2 * sizeof(void*))
+#define CHUNK_HEADER_SIZE   ROUND_UP(sizeof(NodePoolChunk_st), SLOT_ALIGN)
+
+/*=============================================================================*
+ *                    New type or enum declaration
+ *============================================================================*/
+typedef struct _NodePoolChunk_s
+{
+    struct _NodePoolChunk_s* p_next;
+}NodePoolChunk_st;
+
+typedef struct _NodePoolSlot_s
+{
+    struct _NodePoolSlot_s* p_next;
+}NodePoolSlot_st;
+
+typedef struct
+{
+    //The critical section is only a few instructions, a spin lock is cheaper than mutex.
+    volatile int      guard;
+
+    size_t            slotSize;
+    int               slotsPerChunk;
+
+    NodePoolChunk_st* p_chunks;
+
+    /*Slots which have been freed, they will be used firstly.*/
+    NodePoolSlot_st*  p_freeSlots;
+    int               freeCount;
+
+    /*Slots of the newest chunk which have never been used.*/
+    char*             p_carveBegin;
+    char*             p_carveEnd;
+}NodePool_st;
+
+/*=============================================================================*
+ *                    Inner function declaration
+ *============================================================================*/
+static int AddChunk(NodePool_st *p_pool, int slotCount);
+
+/*=============================================================================*
+ *                    Outer function implemention
+ *============================================================================*/
+NodePool_t NodePool_Create(size_t slotSize, int slotsPerChunk)
+{
+    CHECK_PARAM(slotSize > 0, NULL);
+    CHECK_PARAM(slotsPerChunk > 0, NULL);
+
+    NodePool_st *p_pool = (NodePool_st*)OS_Malloc(sizeof(NodePool_st));
+    if (p_pool == NULL)
+    {
+        LOG_E("Fail to allocate node pool.\n");
+        return NULL;
+    }
+    memset(p_pool, 0, sizeof(NodePool_st));
+
+    if (slotSize < sizeof(NodePoolSlot_st))
+    {
+        slotSize = sizeof(NodePoolSlot_st);
+    }
+
+    p_pool->guard         = 0;
+    p_pool->slotSize      = ROUND_UP(slotSize, SLOT_ALIGN);
+    p_pool->slotsPerChunk = slotsPerChunk;
+    p_pool->p_chunks      = NULL;
+    p_pool->p_freeSlots   = NULL;
+    p_pool->freeCount     = 0;
+    p_pool->p_carveBegin  = NULL;
+    p_pool->p_carveEnd    = NULL;
+
+    return (NodePool_t)p_pool;
+}
+
+void NodePool_Destroy(NodePool_t pool)
+{
+    if (pool == NULL)
+    {
+        return;
+    }
+
+    NodePool_st*      p_pool  = TO_POOL(pool);
+    NodePoolChunk_st* p_chunk = p_pool->p_chunks;
+    NodePoolChunk_st* p_next  = NULL;
+
+    while (p_chunk != NULL)
+    {
+        p_next = p_chunk->p_next;
+        OS_Free(p_chunk);
+        p_chunk = p_next;
+    }
+
+    OS_Free(p_pool);
+}
+
+void* NodePool_Alloc(NodePool_t pool)
+{
+    CHECK_PARAM(pool != NULL, NULL);
+
+    NodePool_st* p_pool = TO_POOL(pool);
+    void*        p_slot = NULL;
+
+    POOL_LOCK(p_pool);
+    if (p_pool->p_freeSlots != NULL)
+    {
+        p_slot = p_pool->p_freeSlots;
+        p_pool->p_freeSlots = p_pool->p_freeSlots->p_next;
+        p_pool->freeCount--;
+        goto EXIT;
+    }
+
+    if (p_pool->p_carveBegin == p_pool->p_carveEnd)
+    {
+        if (AddChunk(p_pool, p_pool->slotsPerChunk) != ERR_OK)
+        {
+            LOG_E("Fail to add chunk to node pool.\n");
+            goto EXIT;
+        }
+    }
+
+    p_slot = p_pool->p_carveBegin;
+    p_pool->p_carveBegin += p_pool->slotSize;
+
+    EXIT:
+    POOL_UNLOCK(p_pool);
+
+    return p_slot;
+}
+
+void NodePool_Free(NodePool_t pool, void* p_slot)
+{
+    if (pool == NULL || p_slot == NULL)
+    {
+        return;
+    }
+
+    NodePool_st*     p_pool = TO_POOL(pool);
+    NodePoolSlot_st* p_free = (NodePoolSlot_st*)p_slot;
+
+    POOL_LOCK(p_pool);
+    p_free->p_next = p_pool->p_freeSlots;
+    p_pool->p_freeSlots = p_free;
+    p_pool->freeCount++;
+    POOL_UNLOCK(p_pool);
+}
+
+int NodePool_Reserve(NodePool_t pool, int slotCount)
+{
+    CHECK_PARAM(pool != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(slotCount >= 0, ERR_BAD_PARAM);
+
+    NodePool_st*     p_pool  = TO_POOL(pool);
+    NodePoolSlot_st* p_free  = NULL;
+    int              ret     = ERR_OK;
+    int              carved  = 0;
+
+    POOL_LOCK(p_pool);
+    carved = (int)((p_pool->p_carveEnd - p_pool->p_carveBegin) / p_pool->slotSize);
+    if (p_pool->freeCount + carved >= slotCount)
+    {
+        goto EXIT;
+    }
+
+    //The new chunk takes the place of the carve area, move the rest of the old one to the free list.
+    while (p_pool->p_carveBegin != p_pool->p_carveEnd)
+    {
+        p_free = (NodePoolSlot_st*)p_pool->p_carveBegin;
+        p_free->p_next = p_pool->p_freeSlots;
+        p_pool->p_freeSlots = p_free;
+        p_pool->freeCount++;
+        p_pool->p_carveBegin += p_pool->slotSize;
+    }
+
+    ret = AddChunk(p_pool, slotCount - p_pool->freeCount);
+    if (ret != ERR_OK)
+    {
+        LOG_E("Fail to reserve %d slots in node pool.\n", slotCount);
+    }
+
+    EXIT:
+    POOL_UNLOCK(p_pool);
+
+    return ret;
+}
+
+/*=============================================================================*
+ *                    Inner function implemention
+ *============================================================================*/
+static int AddChunk(NodePool_st *p_pool, int slotCount)
+{
+    ASSERT(p_pool != NULL);
+    ASSERT(slotCount > 0);
+
+    NodePoolChunk_st* p_chunk = NULL;
+    size_t            size    = CHUNK_HEADER_SIZE + p_pool->slotSize * slotCount;
+
+    p_chunk = (NodePoolChunk_st*)OS_Malloc(size);
+    if (p_chunk == NULL)
+    {
+        LOG_E("Not enough memory for pool chunk, size:%d.\n", (int)size);
+        return ERR_OUT_MEM;
+    }
+
+    p_chunk->p_next  = p_pool->p_chunks;
+    p_pool->p_chunks = p_chunk;
+
+    p_pool->p_carveBegin = (char*)p_chunk + CHUNK_HEADER_SIZE;
+    p_pool->p_carveEnd   = p_pool->p_carveBegin + p_pool->slotSize * slotCount;
+
+    return ERR_OK;
+}
+
+/*=============================================================================*
+ *                                End of file
+ *============================================================================*/
@@ -0,0 +1,61 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.4.1
+*/
+
+/*
+ * NodePool: a fixed-size slot allocator.The pool carves slots out of big chunks,
+ * and the freed slots are recycled through a free list, so a list which churns
+ * nodes will not go to malloc/free for every insert and remove.
+ * The chunks are only given back to the system when the pool is destroyed.
+ */
+
+#ifndef _CDATA_POOL_H_
+#define _CDATA_POOL_H_
+
+#include <stddef.h>
+
+#include "cdata_types.h"
+
+__BEGIN_EXTERN_C_DECL__
+
+typedef void* NodePool_t;
+
+NodePool_t NodePool_Create(size_t slotSize, int slotsPerChunk);
+void       NodePool_Destroy(NodePool_t pool);
+
+void*      NodePool_Alloc(NodePool_t pool);
+void       NodePool_Free(NodePool_t pool, void* p_slot);
+
+/*
+ * Make sure the next slotCount allocations are served without going to malloc, the shortfall is
+ * allocated as one chunk.
+ */
+int        NodePool_Reserve(NodePool_t pool, int slotCount);
+
+__END_EXTERN_C_DECL__
+
+#endif //_CDATA_POOL_H_
@@ -0,0 +1,309 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.4.1
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "cdata_types.h"
+#include "cdata_posindex.h"
+
+#ifndef _DEBUG_LEVEL_
+#define _DEBUG_LEVEL_  _DEBUG_LEVEL_I_
+#endif
+#include "debug.h"
+
+/*=============================================================================*
+ *                        Macro definition
+ *============================================================================*/
+#define TREE_NODE(_index_, _node_) ((PosIndexNode_st*)((char*)(_node_) + (_index_)->offset))
+#define TREE_SIZE(_index_, _node_) ((_node_) == NULL ? 0 : TREE_NODE(_index_, _node_)->size)
+
+/*=============================================================================*
+ *                        Const definition
+ *============================================================================*/
+#define POS_INDEX_SEED 0x9E3779B9u
+
+/*=============================================================================*
+ *                    Inner function declaration
+ *============================================================================*/
+static unsigned int NextPriority(PosIndex_st* p_index);
+static void         RotateUp(PosIndex_st* p_index, void* p_node);
+static void         UpdateSize(PosIndex_st* p_index, void* p_node);
+
+/*=============================================================================*
+ *                    Outer function implemention
+ *============================================================================*/
+void PosIndex_Init(PosIndex_st* p_index, size_t offset)
+{
+    ASSERT(p_index != NULL);
+
+    p_index->offset = offset;
+    p_index->p_root = NULL;
+    p_index->seed   = POS_INDEX_SEED;
+}
+
+void PosIndex_Clear(PosIndex_st* p_index)
+{
+    ASSERT(p_index != NULL);
+
+    p_index->p_root = NULL;
+}
+
+void PosIndex_InsertBefore(PosIndex_st* p_index, void* p_node, void* p_nextNode)
+{
+    ASSERT(p_index != NULL);
+    ASSERT(p_node != NULL);
+
+    PosIndexNode_st* p_treeNode = TREE_NODE(p_index, p_node);
+    void*            p_parent   = NULL;
+    void*            p_cur      = NULL;
+
+    p_treeNode->p_left   = NULL;
+    p_treeNode->p_right  = NULL;
+    p_treeNode->size     = 1;
+    p_treeNode->priority = NextPriority(p_index);
+
+    if (p_index->p_root == NULL)
+    {
+        p_treeNode->p_parent = NULL;
+        p_index->p_root = p_node;
+        return;
+    }
+
+    //The new node is the rightmost one of the nodes before nextNode.
+    if (p_nextNode == NULL)
+    {
+        for (p_parent = p_index->p_root; TREE_NODE(p_index, p_parent)->p_right != NULL; p_parent = TREE_NODE(p_index, p_parent)->p_right);
+        TREE_NODE(p_index, p_parent)->p_right = p_node;
+    }
+    else if (TREE_NODE(p_index, p_nextNode)->p_left == NULL)
+    {
+        p_parent = p_nextNode;
+        TREE_NODE(p_index, p_parent)->p_left = p_node;
+    }
+    else
+    {
+        for (p_parent = TREE_NODE(p_index, p_nextNode)->p_left; TREE_NODE(p_index, p_parent)->p_right != NULL; p_parent = TREE_NODE(p_index, p_parent)->p_right);
+        TREE_NODE(p_index, p_parent)->p_right = p_node;
+    }
+    p_treeNode->p_parent = p_parent;
+
+    for (p_cur = p_parent; p_cur != NULL; p_cur = TREE_NODE(p_index, p_cur)->p_parent)
+    {
+        TREE_NODE(p_index, p_cur)->size++;
+    }
+
+    while (p_treeNode->p_parent != NULL && p_treeNode->priority > TREE_NODE(p_index, p_treeNode->p_parent)->priority)
+    {
+        RotateUp(p_index, p_node);
+    }
+}
+
+void PosIndex_Remove(PosIndex_st* p_index, void* p_node)
+{
+    ASSERT(p_index != NULL);
+    ASSERT(p_node != NULL);
+
+    PosIndexNode_st* p_treeNode = TREE_NODE(p_index, p_node);
+    void*            p_child    = NULL;
+    void*            p_parent   = NULL;
+    void*            p_cur      = NULL;
+
+    //Rotate the node down until it's a leaf, then cut it off.
+    while (p_treeNode->p_left != NULL || p_treeNode->p_right != NULL)
+    {
+        if (p_treeNode->p_left == NULL)
+        {
+            p_child = p_treeNode->p_right;
+        }
+        else if (p_treeNode->p_right == NULL)
+        {
+            p_child = p_treeNode->p_left;
+        }
+        else if (TREE_NODE(p_index, p_treeNode->p_left)->priority > TREE_NODE(p_index, p_treeNode->p_right)->priority)
+        {
+            p_child = p_treeNode->p_left;
+        }
+        else
+        {
+            p_child = p_treeNode->p_right;
+        }
+
+        RotateUp(p_index, p_child);
+    }
+
+    p_parent = p_treeNode->p_parent;
+    if (p_parent == NULL)
+    {
+        p_index->p_root = NULL;
+    }
+    else if (TREE_NODE(p_index, p_parent)->p_left == p_node)
+    {
+        TREE_NODE(p_index, p_parent)->p_left = NULL;
+    }
+    else
+    {
+        TREE_NODE(p_index, p_parent)->p_right = NULL;
+    }
+
+    for (p_cur = p_parent; p_cur != NULL; p_cur = TREE_NODE(p_index, p_cur)->p_parent)
+    {
+        TREE_NODE(p_index, p_cur)->size--;
+    }
+
+    p_treeNode->p_parent = NULL;
+    p_treeNode->size     = 0;
+}
+
+void* PosIndex_Select(PosIndex_st* p_index, CdataIndex_t posIndex)
+{
+    ASSERT(p_index != NULL);
+
+    void*        p_cur     = p_index->p_root;
+    CdataCount_t leftCount = 0;
+
+    if (posIndex >= TREE_SIZE(p_index, p_cur))
+    {
+        return NULL;
+    }
+
+    while (p_cur != NULL)
+    {
+        leftCount = TREE_SIZE(p_index, TREE_NODE(p_index, p_cur)->p_left);
+        if (posIndex < leftCount)
+        {
+            p_cur = TREE_NODE(p_index, p_cur)->p_left;
+        }
+        else if (posIndex == leftCount)
+        {
+            break;
+        }
+        else
+        {
+            posIndex -= leftCount + 1;
+            p_cur = TREE_NODE(p_index, p_cur)->p_right;
+        }
+    }
+
+    return p_cur;
+}
+
+CdataIndex_t PosIndex_Rank(PosIndex_st* p_index, void* p_node)
+{
+    ASSERT(p_index != NULL);
+    ASSERT(p_node != NULL);
+
+    CdataIndex_t pos      = TREE_SIZE(p_index, TREE_NODE(p_index, p_node)->p_left);
+    void*        p_cur    = p_node;
+    void*        p_parent = TREE_NODE(p_index, p_node)->p_parent;
+
+    for (; p_parent != NULL; p_cur = p_parent, p_parent = TREE_NODE(p_index, p_parent)->p_parent)
+    {
+        if (TREE_NODE(p_index, p_parent)->p_right == p_cur)
+        {
+            pos += TREE_SIZE(p_index, TREE_NODE(p_index, p_parent)->p_left) + 1;
+        }
+    }
+
+    return pos;
+}
+
+/*=============================================================================*
+ *                    Inner function implemention
+ *============================================================================*/
+static unsigned int NextPriority(PosIndex_st* p_index)
+{
+    //xorshift32, it's good enough to balance the tree.
+    unsigned int x = p_index->seed;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    p_index->seed = x;
+
+    return x;
+}
+
+static void RotateUp(PosIndex_st* p_index, void* p_node)
+{
+    PosIndexNode_st* p_treeNode   = TREE_NODE(p_index, p_node);
+    void*            p_parent     = p_treeNode->p_parent;
+    PosIndexNode_st* p_treeParent = TREE_NODE(p_index, p_parent);
+    void*            p_grand      = p_treeParent->p_parent;
+
+    if (p_treeParent->p_left == p_node)
+    {
+        p_treeParent->p_left = p_treeNode->p_right;
+        if (p_treeNode->p_right != NULL)
+        {
+            TREE_NODE(p_index, p_treeNode->p_right)->p_parent = p_parent;
+        }
+        p_treeNode->p_right = p_parent;
+    }
+    else
+    {
+        p_treeParent->p_right = p_treeNode->p_left;
+        if (p_treeNode->p_left != NULL)
+        {
+            TREE_NODE(p_index, p_treeNode->p_left)->p_parent = p_parent;
+        }
+        p_treeNode->p_left = p_parent;
+    }
+
+    p_treeParent->p_parent = p_node;
+    p_treeNode->p_parent   = p_grand;
+
+    if (p_grand == NULL)
+    {
+        p_index->p_root = p_node;
+    }
+    else if (TREE_NODE(p_index, p_grand)->p_left == p_parent)
+    {
+        TREE_NODE(p_index, p_grand)->p_left = p_node;
+    }
+    else
+    {
+        TREE_NODE(p_index, p_grand)->p_right = p_node;
+    }
+
+    UpdateSize(p_index, p_parent);
+    UpdateSize(p_index, p_node);
+}
+
+static void UpdateSize(PosIndex_st* p_index, void* p_node)
+{
+    PosIndexNode_st* p_treeNode = TREE_NODE(p_index, p_node);
+
+    p_treeNode->size = 1 + TREE_SIZE(p_index, p_treeNode->p_left) + TREE_SIZE(p_index, p_treeNode->p_right);
+}
+
+/*=============================================================================*
+ *                                End of file
+ *============================================================================*/
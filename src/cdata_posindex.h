@@ -0,0 +1,78 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.4.1
+*/
+
+/*
+ * PosIndex: an order-statistics index over the nodes of a list.
+ * It's a treap keyed by the position of the node, every node of the tree is the list node itself,
+ * the tree fields(PosIndexNode_st) live at a fixed offset in the list node memory.
+ * Each tree node counts the nodes of its subtree, so finding the node at a position and
+ * getting the position of a node are both O(log n) in expectation.
+ * All the functions must be called with the list locked.
+ */
+
+#ifndef _CDATA_POSINDEX_H_
+#define _CDATA_POSINDEX_H_
+
+#include <stddef.h>
+
+#include "cdata_types.h"
+
+__BEGIN_EXTERN_C_DECL__
+
+typedef struct
+{
+    void*        p_parent;
+    void*        p_left;
+    void*        p_right;
+    CdataCount_t size;
+    unsigned int priority;
+}PosIndexNode_st;
+
+typedef struct
+{
+    //Offset of PosIndexNode_st in the list node, 0 means the index is not used.
+    size_t       offset;
+    void*        p_root;
+    unsigned int seed;
+}PosIndex_st;
+
+void         PosIndex_Init(PosIndex_st* p_index, size_t offset);
+void         PosIndex_Clear(PosIndex_st* p_index);
+
+/*
+ * The node has been linked into list just before nextNode, nextNode is NULL if the node is the tail.
+ */
+void         PosIndex_InsertBefore(PosIndex_st* p_index, void* p_node, void* p_nextNode);
+void         PosIndex_Remove(PosIndex_st* p_index, void* p_node);
+
+void*        PosIndex_Select(PosIndex_st* p_index, CdataIndex_t posIndex);
+CdataIndex_t PosIndex_Rank(PosIndex_st* p_index, void* p_node);
+
+__END_EXTERN_C_DECL__
+
+#endif //_CDATA_POSINDEX_H_
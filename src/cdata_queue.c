@@ -204,6 +204,36 @@ int Queue_Pop(Queue_t queue)
     return ERR_OK;
 }
 
+CdataCount_t Queue_PopBatch(Queue_t queue, void* p_dataArray, size_t dataSize, CdataCount_t max)
+{
+    CHECK_PARAM(queue != NULL, 0);
+    CHECK_PARAM(p_dataArray != NULL, 0);
+
+    Queue_st *p_queue = TO_QUEUE(queue);
+    ListNode_t node = NULL;
+    ListNode_t next = NULL;
+    CdataCount_t count = 0;
+    CdataCount_t i = 0;
+
+    //The nodes are copied to user after the list is unlocked, the producers are not blocked by the copy.
+    node = List_DetachHeadChain(p_queue->list, max, &count);
+    for (i = 0; i < count; i++, node = next)
+    {
+        next = List_GetNextChainNode(p_queue->list, node);
+        if (p_queue->valueCpFn(List_GetNodeDataNL(p_queue->list, node), (char*)p_dataArray + i * dataSize) != 0)
+        {
+            LOG_E("Fail to copy data %llu to user.\n", i);
+        }
+        List_DestroyNode(p_queue->list, node);
+    }
+
+    OS_CondLock(p_queue->cond);
+    p_queue->empty = (List_Count(p_queue->list) == 0) ? CDATA_TRUE : CDATA_FALSE;
+    OS_CondUnlock(p_queue->cond);
+
+    return count;
+}
+
 int Queue_WaitDataReady(Queue_t queue)
 {
     CHECK_PARAM(queue != NULL, ERR_BAD_PARAM);
@@ -250,6 +280,18 @@ int Queue_Traverse(Queue_t queue, void*p_userData, QueueTraverse_fn traverseFn)
     return List_Traverse(p_queue->list, &userData, QueueTraverseFn);
 }
 
+int Queue_TraverseChunked(Queue_t queue, CdataCount_t chunkNodes, void*p_userData, QueueTraverse_fn traverseFn)
+{
+    CHECK_PARAM(queue != NULL, ERR_BAD_PARAM);
+    Queue_st *p_queue = TO_QUEUE(queue);
+
+    QueueTraverseUserData_t userData;
+
+    userData.p_userData = p_userData;
+    userData.traverseFn = traverseFn;
+    return List_TraverseChunked(p_queue->list, chunkNodes, &userData, QueueTraverseFn);
+}
+
 int Queue_Clear(Queue_t queue)
 {
     CHECK_PARAM(queue != NULL, ERR_BAD_PARAM);
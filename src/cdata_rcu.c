@@ -0,0 +1,356 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.4.1
+*/
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "cdata_types.h"
+#include "cdata_os_adapter.h"
+#include "cdata_rcu.h"
+
+#ifndef _DEBUG_LEVEL_
+#define _DEBUG_LEVEL_  _DEBUG_LEVEL_I_
+#endif
+#include "debug.h"
+
+/*=============================================================================*
+ *                        Macro definition
+ *============================================================================*/
+#define TO_RETIRE_LIST(_list_) (RcuRetireList_st*)(_list_)
+
+/*=============================================================================*
+ *                        Const definition
+ *============================================================================*/
+//Each slot has its own cache line, so the readers don't write the same line.
+#define RCU_CACHE_LINE_SIZE     64
+
+//Slot epoch 0 means the slot owner is not in a read section.
+#define RCU_EPOCH_IDLE          0UL
+
+//The retired items are checked when so many have been queued.
+#define RCU_RECLAIM_BATCH       64
+
+/*=============================================================================*
+ *                    New type or enum declaration
+ *============================================================================*/
+typedef union
+{
+    struct
+    {
+        volatile unsigned long epoch;
+        volatile int           used;
+    }s;
+    char pad[RCU_CACHE_LINE_SIZE];
+}RcuSlot_un;
+
+typedef struct
+{
+    void*         p_item;
+    unsigned long epoch;
+}RcuRetired_st;
+
+typedef struct
+{
+    OSMutex_t      guard;
+
+    Rcu_Reclaim_fn reclaimFn;
+    void*          p_arg;
+
+    RcuRetired_st* p_items;
+    int            count;
+    int            capacity;
+}RcuRetireList_st;
+
+/*=============================================================================*
+ *                    Inner function declaration
+ *============================================================================*/
+static RcuSlot_un*   AcquireSlot(void);
+static void          ReleaseSlot(void* p_slot);
+static unsigned long OldestReaderEpoch(void);
+static void          ReclaimNL(RcuRetireList_st* p_retireList, CdataBool reclaimAll);
+static int           GrowNL(RcuRetireList_st* p_retireList);
+
+/*=============================================================================*
+ *                    Static variable declaration
+ *============================================================================*/
+static RcuSlot_un             g_slots[RCU_MAX_READERS];
+static volatile unsigned long g_epoch   = 1;
+static OSThreadKey_t          g_slotKey = NULL;
+
+static __thread RcuSlot_un*   t_p_slot  = NULL;
+static __thread int           t_nest    = 0;
+
+/*=============================================================================*
+ *                    Outer function implemention
+ *============================================================================*/
+CdataBool Rcu_ReadLock(void)
+{
+    if (t_nest > 0)
+    {
+        t_nest++;
+        return CDATA_TRUE;
+    }
+
+    if (t_p_slot == NULL)
+    {
+        t_p_slot = AcquireSlot();
+        if (t_p_slot == NULL)
+        {
+            return CDATA_FALSE;
+        }
+    }
+
+    t_nest = 1;
+    t_p_slot->s.epoch = __atomic_load_n(&g_epoch, __ATOMIC_RELAXED);
+
+    //The writer must see the slot epoch before this reader loads any link.
+    __sync_synchronize();
+
+    return CDATA_TRUE;
+}
+
+CdataBool Rcu_ReadUnlock(void)
+{
+    if (t_nest == 0)
+    {
+        return CDATA_FALSE;
+    }
+
+    t_nest--;
+    if (t_nest == 0)
+    {
+        __atomic_store_n(&t_p_slot->s.epoch, RCU_EPOCH_IDLE, __ATOMIC_RELEASE);
+    }
+
+    return CDATA_TRUE;
+}
+
+void Rcu_Synchronize(void)
+{
+    unsigned long epoch = __sync_fetch_and_add(&g_epoch, 1);
+
+    while (OldestReaderEpoch() <= epoch)
+    {
+        OS_YieldThread();
+    }
+}
+
+RcuRetireList_t Rcu_CreateRetireList(Rcu_Reclaim_fn reclaimFn, void* p_arg)
+{
+    CHECK_PARAM(reclaimFn != NULL, NULL);
+
+    RcuRetireList_st* p_retireList = (RcuRetireList_st*)OS_Malloc(sizeof(RcuRetireList_st));
+    if (p_retireList == NULL)
+    {
+        LOG_E("Fail to allocate retire list.\n");
+        return NULL;
+    }
+    memset(p_retireList, 0, sizeof(RcuRetireList_st));
+
+    p_retireList->guard = OS_MutexCreate();
+    if (p_retireList->guard == NULL)
+    {
+        LOG_E("Fail to create guard for retire list.\n");
+        OS_Free(p_retireList);
+        return NULL;
+    }
+
+    p_retireList->reclaimFn = reclaimFn;
+    p_retireList->p_arg     = p_arg;
+
+    return (RcuRetireList_t)p_retireList;
+}
+
+void Rcu_DestroyRetireList(RcuRetireList_t retireList)
+{
+    if (retireList == NULL)
+    {
+        return;
+    }
+
+    RcuRetireList_st* p_retireList = TO_RETIRE_LIST(retireList);
+
+    ReclaimNL(p_retireList, CDATA_TRUE);
+    OS_MutexDestroy(p_retireList->guard);
+    if (p_retireList->p_items != NULL)
+    {
+        OS_Free(p_retireList->p_items);
+    }
+    OS_Free(p_retireList);
+}
+
+int Rcu_Retire(RcuRetireList_t retireList, void* p_item)
+{
+    CHECK_PARAM(retireList != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(p_item != NULL, ERR_BAD_PARAM);
+
+    RcuRetireList_st* p_retireList = TO_RETIRE_LIST(retireList);
+
+    OS_MutexLock(p_retireList->guard);
+    if (p_retireList->count == p_retireList->capacity && GrowNL(p_retireList) != ERR_OK)
+    {
+        OS_MutexUnlock(p_retireList->guard);
+
+        //No memory to queue it, wait for the readers here instead.
+        LOG_E("Fail to queue the retired item, reclaim it synchronously.\n");
+        Rcu_Synchronize();
+        p_retireList->reclaimFn(p_item, p_retireList->p_arg);
+        return ERR_OK;
+    }
+
+    //The unlink is ordered before the epoch increment, so a reader which sees the new epoch can't reach the item.
+    p_retireList->p_items[p_retireList->count].p_item = p_item;
+    p_retireList->p_items[p_retireList->count].epoch  = __sync_fetch_and_add(&g_epoch, 1);
+    p_retireList->count++;
+
+    if (p_retireList->count % RCU_RECLAIM_BATCH == 0)
+    {
+        ReclaimNL(p_retireList, CDATA_FALSE);
+    }
+    OS_MutexUnlock(p_retireList->guard);
+
+    return ERR_OK;
+}
+
+/*=============================================================================*
+ *                    Inner function implemention
+ *============================================================================*/
+static RcuSlot_un* AcquireSlot(void)
+{
+    OSThreadKey_t key = __atomic_load_n(&g_slotKey, __ATOMIC_ACQUIRE);
+    int           i   = 0;
+
+    //The key gives the slot back when the thread exits.
+    if (key == NULL)
+    {
+        key = OS_ThreadKeyCreate(ReleaseSlot);
+        if (key == NULL)
+        {
+            LOG_E("Fail to create the reader slot key.\n");
+            return NULL;
+        }
+
+        if (!__sync_bool_compare_and_swap(&g_slotKey, NULL, key))
+        {
+            OS_ThreadKeyDestroy(key);
+            key = g_slotKey;
+        }
+    }
+
+    for (i = 0; i < RCU_MAX_READERS; i++)
+    {
+        if (g_slots[i].s.used == 0 && __sync_bool_compare_and_swap(&g_slots[i].s.used, 0, 1))
+        {
+            if (OS_ThreadKeySet(key, &g_slots[i]) != ERR_OK)
+            {
+                __sync_lock_release(&g_slots[i].s.used);
+                return NULL;
+            }
+            return &g_slots[i];
+        }
+    }
+
+    LOG_W("All %d reader slots are taken.\n", RCU_MAX_READERS);
+    return NULL;
+}
+
+static void ReleaseSlot(void* p_slot)
+{
+    RcuSlot_un* p_rcuSlot = (RcuSlot_un*)p_slot;
+
+    p_rcuSlot->s.epoch = RCU_EPOCH_IDLE;
+    __sync_lock_release(&p_rcuSlot->s.used);
+}
+
+static unsigned long OldestReaderEpoch(void)
+{
+    unsigned long oldest = __atomic_load_n(&g_epoch, __ATOMIC_ACQUIRE);
+    unsigned long epoch  = 0;
+    int           i      = 0;
+
+    //Pairs with the full barrier in Rcu_ReadLock.
+    __sync_synchronize();
+    for (i = 0; i < RCU_MAX_READERS; i++)
+    {
+        epoch = __atomic_load_n(&g_slots[i].s.epoch, __ATOMIC_ACQUIRE);
+        if (epoch != RCU_EPOCH_IDLE && epoch < oldest)
+        {
+            oldest = epoch;
+        }
+    }
+
+    return oldest;
+}
+
+static void ReclaimNL(RcuRetireList_st* p_retireList, CdataBool reclaimAll)
+{
+    unsigned long oldest = reclaimAll ? (unsigned long)-1 : OldestReaderEpoch();
+    int           kept   = 0;
+    int           i      = 0;
+
+    //An item retired at epoch E may be held by the readers which entered at E or before.
+    for (i = 0; i < p_retireList->count; i++)
+    {
+        if (p_retireList->p_items[i].epoch < oldest)
+        {
+            p_retireList->reclaimFn(p_retireList->p_items[i].p_item, p_retireList->p_arg);
+        }
+        else
+        {
+            p_retireList->p_items[kept++] = p_retireList->p_items[i];
+        }
+    }
+    p_retireList->count = kept;
+}
+
+static int GrowNL(RcuRetireList_st* p_retireList)
+{
+    int            capacity = p_retireList->capacity == 0 ? RCU_RECLAIM_BATCH : p_retireList->capacity * 2;
+    RcuRetired_st* p_items  = (RcuRetired_st*)OS_Malloc(capacity * sizeof(RcuRetired_st));
+
+    if (p_items == NULL)
+    {
+        LOG_E("Not enough memory for retire list, capacity:%d.\n", capacity);
+        return ERR_OUT_MEM;
+    }
+
+    if (p_retireList->p_items != NULL)
+    {
+        memcpy(p_items, p_retireList->p_items, p_retireList->count * sizeof(RcuRetired_st));
+        OS_Free(p_retireList->p_items);
+    }
+    p_retireList->p_items  = p_items;
+    p_retireList->capacity = capacity;
+
+    return ERR_OK;
+}
+
+/*=============================================================================*
+ *                                End of file
+ *============================================================================*/
@@ -0,0 +1,83 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.4.1
+*/
+
+/*
+ * Rcu: epoch based reclamation for the lists which are read without lock.
+ * A reader publishes the global epoch in its own slot when it enters a read section and clears
+ * the slot when it leaves, there is no lock and no atomic read-modify-write on the read side.
+ * A writer unlinks an item under its own lock, then retires it, the item is reclaimed once every
+ * reader which was active at the retire time has left its read section.
+ */
+
+#ifndef _CDATA_RCU_H_
+#define _CDATA_RCU_H_
+
+#include "cdata_types.h"
+
+__BEGIN_EXTERN_C_DECL__
+
+//The slots are shared by all the threads of the process, a thread keeps its slot until it exits.
+#define RCU_MAX_READERS 128
+
+typedef void* RcuRetireList_t;
+
+typedef void (*Rcu_Reclaim_fn)(void* p_item, void* p_arg);
+
+/*
+ * Enter a read section, the read sections can be nested.
+ * Return CDATA_FALSE if all the reader slots are taken, the caller must protect the read by a lock.
+ */
+CdataBool Rcu_ReadLock(void);
+
+/*
+ * Leave a read section.
+ * Return CDATA_FALSE if the thread is not in a read section, it means the matching Rcu_ReadLock failed.
+ */
+CdataBool Rcu_ReadUnlock(void);
+
+/*
+ * Wait until every read section which is active now has finished.
+ */
+void Rcu_Synchronize(void);
+
+RcuRetireList_t Rcu_CreateRetireList(Rcu_Reclaim_fn reclaimFn, void* p_arg);
+
+/*
+ * Reclaim all the retired items at once, the caller must make sure no reader can reach them.
+ */
+void Rcu_DestroyRetireList(RcuRetireList_t retireList);
+
+/*
+ * p_item must have been unlinked, so the new readers can't reach it. It's reclaimed later when
+ * the readers which may still hold it have finished.
+ */
+int  Rcu_Retire(RcuRetireList_t retireList, void* p_item);
+
+__END_EXTERN_C_DECL__
+
+#endif //_CDATA_RCU_H_
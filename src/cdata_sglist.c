@@ -61,6 +61,7 @@ Date:2019.4.1
  *============================================================================*/
 static void InsertFirstNode(List_st *p_list, SGListNode_st *p_node);
 static void InsertAfter(List_st *p_list, SGListNode_st *p_listNode, SGListNode_st *p_newNode);
+static int  InsertOrdered(List_st *p_list, SGListNode_st *p_node, CdataBool isAsc);
 /*=============================================================================*
  *                    Outer function implemention
  *============================================================================*/
@@ -73,13 +74,58 @@ int SGList_CreateNode(List_t list, void* p_data, ListNode_t* p_node)
     SGListNode_st* p_newNode = NULL;
     List_st*       p_list    = CONVERT_2_LIST(list);
 
-    p_newNode = (SGListNode_st*) OS_Malloc(sizeof(SGListNode_st));
+    //The node of the intrusive list is the link embedded in the data.
+    if (p_list->dataType == LIST_DATA_TYPE_INTRUSIVE)
+    {
+        p_newNode = (SGListNode_st*)LIST_INTRUSIVE_NODE(p_list, p_data);
+        p_newNode->p_next = NULL;
+        p_newNode->p_data = p_data;
+
+        *p_node = p_newNode;
+        return ERR_OK;
+    }
+
+    //The value copy data lives behind the node if possible, so one allocation for both.
+    if (p_list->pool != NULL || (p_list->dataType == LIST_DATA_TYPE_VALUE_COPY && p_list->freeFn == NULL))
+    {
+        if (p_list->pool != NULL)
+        {
+            p_newNode = (SGListNode_st*) NodePool_Alloc(p_list->pool);
+        }
+        else
+        {
+            p_newNode = (SGListNode_st*) OS_Malloc(p_list->dataOffset + p_list->dataLength);
+        }
+
+        if (NULL == p_newNode)
+        {
+            LOG_E("Not enough memory 1\n");
+            return ERR_OUT_MEM;
+        }
+        memset(p_newNode, 0x0, p_list->nodeSize);
+        p_newNode->p_next = NULL;
+
+        if (p_list->dataType == LIST_DATA_TYPE_VALUE_COPY)
+        {
+            p_newNode->p_data = LIST_INLINE_DATA(p_list, p_newNode);
+            memcpy(p_newNode->p_data, p_data, p_list->dataLength);
+        }
+        else
+        {
+            p_newNode->p_data = p_data;
+        }
+
+        *p_node = p_newNode;
+        return ERR_OK;
+    }
+
+    p_newNode = (SGListNode_st*) OS_Malloc(p_list->nodeSize);
     if (NULL == p_newNode)
     {
         LOG_E("Not enough memory 1\n");
         return ERR_OUT_MEM;
     }
-    memset(p_newNode, 0x0, sizeof(SGListNode_st));
+    memset(p_newNode, 0x0, p_list->nodeSize);
 
     p_newNode->p_next = NULL;
 
@@ -124,14 +170,14 @@ int SGList_InsertDataBefore(List_t list, void* p_keyword, ListNode_t newNode)
     }
     
     p_head = CONVERT_2_SGLIST_NODE(p_list->p_head);
-	if (p_list->equal2KeywordFn(p_head->p_data, p_keyword))
+	if (List_MatchKeyword(p_list, p_head->p_data, p_keyword))
 	{
 		return SGList_InsertNode2Head(list, newNode);
 	}    
 	
 	for (p_pre = p_head, p_cur = (SGListNode_st*)p_pre->p_next; p_cur != NULL; p_pre = p_cur, p_cur = (SGListNode_st*)p_cur->p_next)
 	{
-		if (p_list->equal2KeywordFn(p_cur->p_data, p_keyword))
+		if (List_MatchKeyword(p_list, p_cur->p_data, p_keyword))
 		{
 			return SGList_InsertNodeAfter(list, p_pre, newNode);
 		}
@@ -152,7 +198,7 @@ int SGList_InsertDataAfter(List_t list,  void* p_keyword, ListNode_t newNode)
     
     for (p_head = (SGListNode_st*)p_list->p_head; p_head != NULL; p_head = (SGListNode_st*)p_head->p_next)
     {
-        if (p_list->equal2KeywordFn(p_head->p_data, p_keyword))
+        if (List_MatchKeyword(p_list, p_head->p_data, p_keyword))
         {
             InsertAfter(p_list, p_head, (SGListNode_st*)newNode);
             return ERR_OK;
@@ -180,7 +226,7 @@ int SGList_InsertNode(List_t list, ListNode_t node)
 	p_node->p_next = NULL;
 	p_list->p_tail = p_node;
 
-	p_list->nodeCount++;
+	List_OnNodeLinked(p_list, p_node);
 
 	return ERR_OK;
 }
@@ -201,7 +247,7 @@ int SGList_InsertNode2Head(List_t list, ListNode_t node)
 
 	p_node->p_next = p_list->p_head;
 	p_list->p_head = p_node;
-	p_list->nodeCount++;
+	List_OnNodeLinked(p_list, p_node);
 
 	return ERR_OK;
 }
@@ -213,34 +259,14 @@ int SGList_InsertNodeAsc(List_t list, ListNode_t node)
 
     List_st*       p_list = CONVERT_2_LIST(list);
 	SGListNode_st* p_node = CONVERT_2_SGLIST_NODE(node);
-	void*		   p_userData = NULL;
 
-	SGListNode_st* p_pre = NULL;
-	SGListNode_st* p_cur = NULL;
-
-	if (p_list->usrLtNodeFn == NULL)
+	if (!LIST_CAN_COMPARE_ORDER(p_list))
 	{
 		LOG_E("usrLtNodeFn is NULL.\n");
 		return ERR_FAIL;
 	}
 
-	p_userData = p_node->p_data;
-	for (p_pre = NULL, p_cur = CONVERT_2_SGLIST_NODE(p_list->p_head); p_cur != NULL; p_pre = p_cur, p_cur = CONVERT_2_SGLIST_NODE(p_cur->p_next))
-	{
-		if (p_list->usrLtNodeFn(p_cur->p_data, p_userData))
-		{
-            if (p_pre == NULL)
-            {
-                return SGList_InsertNode2Head(list, node);
-            }
-            else
-            {
-                return SGList_InsertNodeAfter(list, p_pre, node);
-            }
-		}
-	}
-
-	return SGList_InsertNode(list, node);
+	return InsertOrdered(p_list, p_node, CDATA_TRUE);
 }
 
 int SGList_InsertNodeDes(List_t list, ListNode_t node)
@@ -250,34 +276,14 @@ int SGList_InsertNodeDes(List_t list, ListNode_t node)
 
     List_st*       p_list = CONVERT_2_LIST(list);
 	SGListNode_st* p_node = CONVERT_2_SGLIST_NODE(node);
-	void*		   p_userData = NULL;
 
-	SGListNode_st* p_pre = NULL;
-	SGListNode_st* p_cur = NULL;
-
-	if (p_list->usrLtNodeFn == NULL)
+	if (!LIST_CAN_COMPARE_ORDER(p_list))
 	{
 		LOG_E("usrLtNodeFn is NULL.\n");
 		return ERR_FAIL;
 	}
 
-	p_userData = p_node->p_data;
-	for (p_pre = NULL, p_cur = CONVERT_2_SGLIST_NODE(p_list->p_head); p_cur != NULL; p_pre = p_cur, p_cur = CONVERT_2_SGLIST_NODE(p_cur->p_next))
-	{
-		if (!p_list->usrLtNodeFn(p_cur->p_data, p_userData))
-		{
-            if (p_pre == NULL)
-            {
-                return SGList_InsertNode2Head(list, node);
-            }
-            else
-            {
-                return SGList_InsertNodeAfter(list, p_pre, node);
-            }
-		}
-	}
-
-	return SGList_InsertNode(list, node);
+	return InsertOrdered(p_list, p_node, CDATA_FALSE);
 }
 
 int SGList_InsertNodeBefore(List_t list, ListNode_t listNode, ListNode_t newNode)
@@ -353,7 +359,7 @@ int SGList_DetachNode(List_t list, ListNode_t node)
 		{
 			p_list->p_head = NULL;
 			p_list->p_tail = NULL;
-			p_list->nodeCount = 0;
+			List_OnNodeUnlinked(p_list, node);
 
 			return ERR_OK;
 		}
@@ -363,7 +369,7 @@ int SGList_DetachNode(List_t list, ListNode_t node)
 	{
 		p_node = (SGListNode_st*)node;
 		p_list->p_head = p_node->p_next;
-		p_list->nodeCount--;
+		List_OnNodeUnlinked(p_list, node);
 
 		return ERR_OK;
 	}
@@ -378,7 +384,7 @@ int SGList_DetachNode(List_t list, ListNode_t node)
 				p_list->p_tail = p_pre;
 			}
 
-			p_list->nodeCount--;
+			List_OnNodeUnlinked(p_list, p_cur);
 			break;
 		}
 	}
@@ -386,6 +392,93 @@ int SGList_DetachNode(List_t list, ListNode_t node)
 	return ERR_OK;
 }
 
+int SGList_DetachNextNode(List_t list, ListNode_t preNode)
+{
+	CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(preNode != NULL, ERR_BAD_PARAM);
+
+	List_st*       p_list = CONVERT_2_LIST(list);
+	SGListNode_st* p_pre  = CONVERT_2_SGLIST_NODE(preNode);
+	SGListNode_st* p_cur  = CONVERT_2_SGLIST_NODE(p_pre->p_next);
+
+	if (p_cur == NULL)
+	{
+		return ERR_DATA_NOT_EXISTS;
+	}
+
+	p_pre->p_next = p_cur->p_next;
+	if (p_pre->p_next == NULL)
+	{
+		p_list->p_tail = p_pre;
+	}
+
+	List_OnNodeUnlinked(p_list, p_cur);
+
+	return ERR_OK;
+}
+
+int SGList_UnlinkRun(List_t list, ListNode_t preNode, ListNode_t last, CdataCount_t count)
+{
+	CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(last != NULL, ERR_BAD_PARAM);
+
+	List_st*       p_list  = CONVERT_2_LIST(list);
+	SGListNode_st* p_pre   = CONVERT_2_SGLIST_NODE(preNode);
+	SGListNode_st* p_last  = CONVERT_2_SGLIST_NODE(last);
+	SGListNode_st* p_first = (p_pre == NULL) ? CONVERT_2_SGLIST_NODE(p_list->p_head) : CONVERT_2_SGLIST_NODE(p_pre->p_next);
+	SGListNode_st* p_next  = CONVERT_2_SGLIST_NODE(p_last->p_next);
+
+	if (p_pre == NULL)
+	{
+		p_list->p_head = p_last->p_next;
+	}
+	else
+	{
+		p_pre->p_next = p_last->p_next;
+	}
+
+	if (p_last->p_next == NULL)
+	{
+		p_list->p_tail = p_pre;
+	}
+	p_last->p_next = NULL;
+
+	List_OnRunUnlinked(p_list, p_first, last, p_next, count);
+
+	return ERR_OK;
+}
+
+int SGList_LinkRunAfter(List_t list, ListNode_t listNode, ListNode_t first, ListNode_t last, CdataCount_t count)
+{
+	CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(first != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(last != NULL, ERR_BAD_PARAM);
+
+	List_st*       p_list     = CONVERT_2_LIST(list);
+	SGListNode_st* p_listNode = CONVERT_2_SGLIST_NODE(listNode);
+	SGListNode_st* p_last     = CONVERT_2_SGLIST_NODE(last);
+
+	if (p_listNode == NULL)
+	{
+		p_last->p_next = p_list->p_head;
+		p_list->p_head = first;
+	}
+	else
+	{
+		p_last->p_next = p_listNode->p_next;
+		p_listNode->p_next = first;
+	}
+
+	if (p_last->p_next == NULL)
+	{
+		p_list->p_tail = p_last;
+	}
+
+	List_OnRunLinked(p_list, count);
+
+	return ERR_OK;
+}
+
 /*=============================================================================*
  *                    Inner function implemention
  *============================================================================*/
@@ -398,7 +491,7 @@ static void InsertFirstNode(List_st *p_list, SGListNode_st *p_node)
 	p_list->p_tail = p_node;
 	p_node->p_next = NULL;
 
-	p_list->nodeCount++;
+	List_OnNodeLinked(p_list, p_node);
 
 	return;
 }
@@ -417,11 +510,49 @@ static void InsertAfter(List_st *p_list, SGListNode_st *p_listNode, SGListNode_s
 		p_list->p_tail = p_newNode;
 	}
 
-	p_list->nodeCount++;
+	List_OnNodeLinked(p_list, p_newNode);
 	
 	return;	
 }
 
+//The nodes which the new one goes before are all behind the others, so the tail is checked firstly, and
+//the search starts from the last ordered insert if the new node goes behind it.
+static int InsertOrdered(List_st* p_list, SGListNode_st* p_node, CdataBool isAsc)
+{
+	ASSERT(p_list != NULL);
+	ASSERT(p_node != NULL);
+
+	SGListNode_st* p_pre = CONVERT_2_SGLIST_NODE(p_list->p_finger);
+	SGListNode_st* p_cur = NULL;
+	int            ret   = ERR_OK;
+
+	if (p_list->nodeCount == 0 || !LIST_GOES_BEFORE(p_list, (CONVERT_2_SGLIST_NODE(p_list->p_tail))->p_data, p_node->p_data, isAsc))
+	{
+		ret = SGList_InsertNode(p_list, p_node);
+		goto EXIT;
+	}
+
+	if (p_pre != NULL && LIST_GOES_BEFORE(p_list, p_pre->p_data, p_node->p_data, isAsc))
+	{
+		p_pre = NULL;
+	}
+
+	//It stops at the tail at last.
+	for (p_cur = (p_pre == NULL) ? CONVERT_2_SGLIST_NODE(p_list->p_head) : CONVERT_2_SGLIST_NODE(p_pre->p_next);
+		!LIST_GOES_BEFORE(p_list, p_cur->p_data, p_node->p_data, isAsc);
+		p_pre = p_cur, p_cur = CONVERT_2_SGLIST_NODE(p_cur->p_next));
+
+	ret = (p_pre == NULL) ? SGList_InsertNode2Head(p_list, p_node) : SGList_InsertNodeAfter(p_list, p_pre, p_node);
+
+	EXIT:
+	if (ret == ERR_OK)
+	{
+		p_list->p_finger = p_node;
+	}
+
+	return ret;
+}
+
 /*=============================================================================*
  *                                End of file
  *============================================================================*/
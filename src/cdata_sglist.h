@@ -48,6 +48,19 @@ int SGList_InsertNodeAfter(List_t list, ListNode_t listNode, ListNode_t newNode)
 
 int SGList_DetachNode(List_t list, ListNode_t node);
 
+/*
+ * Detach the node after preNode, it's O(1).
+ */
+int SGList_DetachNextNode(List_t list, ListNode_t preNode);
+
+/*
+ * Move a run of count nodes out of or into the list in O(1). The run to unlink begins after preNode
+ * and ends with last, preNode NULL means it begins with the head. listNode NULL means linking the run
+ * before the head.
+ */
+int SGList_UnlinkRun(List_t list, ListNode_t preNode, ListNode_t last, CdataCount_t count);
+int SGList_LinkRunAfter(List_t list, ListNode_t listNode, ListNode_t first, ListNode_t last, CdataCount_t count);
+
 __END_EXTERN_C_DECL__
 
 #endif //_CDATA_SGLIST_H_
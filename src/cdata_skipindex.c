@@ -0,0 +1,276 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.4.1
+*/
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "cdata_types.h"
+#include "cdata_os_adapter.h"
+#include "cdata_skipindex.h"
+
+#ifndef _DEBUG_LEVEL_
+#define _DEBUG_LEVEL_  _DEBUG_LEVEL_I_
+#endif
+#include "debug.h"
+
+/*=============================================================================*
+ *                        Macro definition
+ *============================================================================*/
+#define INDEX_NODE(_index_, _node_) ((SkipIndexNode_st*)((char*)(_node_) + (_index_)->offset))
+#define TOWER(_index_, _node_)      ((SkipTower_st*)INDEX_NODE(_index_, _node_)->p_tower)
+
+//Both single and double list node begin with p_next.
+#define LEVEL0_NEXT(_node_)         (*(void**)(_node_))
+
+/*=============================================================================*
+ *                        Const definition
+ *============================================================================*/
+#define SKIP_INDEX_SEED 0x2545F491u
+
+/*=============================================================================*
+ *                    New type or enum declaration
+ *============================================================================*/
+typedef struct
+{
+    int   height;
+
+    //p_forward[i] is the next node in level i + 1.
+    void* p_forward[];
+}SkipTower_st;
+
+/*=============================================================================*
+ *                    Inner function declaration
+ *============================================================================*/
+static int   RandomHeight(SkipIndex_st* p_index);
+static void* NextAt(SkipIndex_st* p_index, void* p_node, int level);
+static void  SetNextAt(SkipIndex_st* p_index, void* p_node, int level, void* p_next);
+
+/*=============================================================================*
+ *                    Outer function implemention
+ *============================================================================*/
+void SkipIndex_Init(SkipIndex_st* p_index, size_t offset)
+{
+    ASSERT(p_index != NULL);
+
+    memset(p_index, 0, sizeof(SkipIndex_st));
+    p_index->offset = offset;
+    p_index->level  = 1;
+    p_index->seed   = SKIP_INDEX_SEED;
+}
+
+void SkipIndex_Clear(SkipIndex_st* p_index)
+{
+    ASSERT(p_index != NULL);
+
+    void* p_node = p_index->p_heads[1];
+    void* p_next = NULL;
+
+    //Every node which has a tower lives in level 1.
+    while (p_node != NULL)
+    {
+        p_next = TOWER(p_index, p_node)->p_forward[0];
+        OS_Free(INDEX_NODE(p_index, p_node)->p_tower);
+        INDEX_NODE(p_index, p_node)->p_tower = NULL;
+        p_node = p_next;
+    }
+
+    memset(p_index->p_heads, 0, sizeof(p_index->p_heads));
+    p_index->level = 1;
+}
+
+void* SkipIndex_Seek(SkipIndex_st* p_index, void* p_firstNode, SkipIndex_Advance_fn advanceFn, void* p_arg, void* pp_preds[SKIP_INDEX_MAX_LEVEL])
+{
+    ASSERT(p_index != NULL);
+    ASSERT(advanceFn != NULL);
+
+    void* p_pre  = NULL;
+    void* p_next = NULL;
+    int   level  = 0;
+
+    for (level = p_index->level - 1; level >= 1; level--)
+    {
+        for (p_next = NextAt(p_index, p_pre, level); p_next != NULL && advanceFn(p_next, p_arg); p_next = NextAt(p_index, p_next, level))
+        {
+            p_pre = p_next;
+        }
+
+        if (pp_preds != NULL)
+        {
+            pp_preds[level] = p_pre;
+        }
+    }
+
+    if (pp_preds != NULL)
+    {
+        for (level = p_index->level; level < SKIP_INDEX_MAX_LEVEL; level++)
+        {
+            pp_preds[level] = NULL;
+        }
+    }
+
+    for (p_next = (p_pre == NULL) ? p_firstNode : LEVEL0_NEXT(p_pre); p_next != NULL && advanceFn(p_next, p_arg); p_next = LEVEL0_NEXT(p_next))
+    {
+        p_pre = p_next;
+    }
+
+    return p_pre;
+}
+
+void SkipIndex_Insert(SkipIndex_st* p_index, void* p_node, void* pp_preds[SKIP_INDEX_MAX_LEVEL])
+{
+    ASSERT(p_index != NULL);
+    ASSERT(p_node != NULL);
+    ASSERT(pp_preds != NULL);
+
+    SkipTower_st* p_tower = NULL;
+    int           height  = RandomHeight(p_index);
+    int           level   = 0;
+
+    INDEX_NODE(p_index, p_node)->p_tower = NULL;
+    if (height == 1)
+    {
+        return;
+    }
+
+    p_tower = (SkipTower_st*)OS_Malloc(sizeof(SkipTower_st) + (height - 1) * sizeof(void*));
+    if (p_tower == NULL)
+    {
+        LOG_W("No memory for the tower, the node is only in level 0.\n");
+        return;
+    }
+    p_tower->height = height;
+    INDEX_NODE(p_index, p_node)->p_tower = p_tower;
+
+    for (level = 1; level < height; level++)
+    {
+        p_tower->p_forward[level - 1] = NextAt(p_index, pp_preds[level], level);
+        SetNextAt(p_index, pp_preds[level], level, p_node);
+    }
+
+    if (height > p_index->level)
+    {
+        p_index->level = height;
+    }
+}
+
+void SkipIndex_InsertFlat(SkipIndex_st* p_index, void* p_node)
+{
+    ASSERT(p_index != NULL);
+    ASSERT(p_node != NULL);
+
+    INDEX_NODE(p_index, p_node)->p_tower = NULL;
+}
+
+void SkipIndex_Remove(SkipIndex_st* p_index, void* p_node, SkipIndex_Advance_fn advanceFn, void* p_arg)
+{
+    ASSERT(p_index != NULL);
+    ASSERT(p_node != NULL);
+    ASSERT(advanceFn != NULL);
+
+    SkipTower_st* p_tower = TOWER(p_index, p_node);
+    void*         p_pre   = NULL;
+    void*         p_next  = NULL;
+    int           level   = 0;
+
+    if (p_tower == NULL)
+    {
+        return;
+    }
+
+    for (level = p_tower->height - 1; level >= 1; level--)
+    {
+        for (p_next = NextAt(p_index, p_pre, level); p_next != NULL && p_next != p_node && advanceFn(p_next, p_arg); p_next = NextAt(p_index, p_next, level))
+        {
+            p_pre = p_next;
+        }
+
+        //The order has been broken by the caller, look for the node from the head of the level.
+        if (p_next != p_node)
+        {
+            for (p_pre = NULL, p_next = p_index->p_heads[level]; p_next != NULL && p_next != p_node; p_pre = p_next, p_next = NextAt(p_index, p_next, level));
+        }
+
+        if (p_next == p_node)
+        {
+            SetNextAt(p_index, p_pre, level, p_tower->p_forward[level - 1]);
+        }
+    }
+
+    OS_Free(p_tower);
+    INDEX_NODE(p_index, p_node)->p_tower = NULL;
+
+    while (p_index->level > 1 && p_index->p_heads[p_index->level - 1] == NULL)
+    {
+        p_index->level--;
+    }
+}
+
+/*=============================================================================*
+ *                    Inner function implemention
+ *============================================================================*/
+static int RandomHeight(SkipIndex_st* p_index)
+{
+    //xorshift32, every 2 bits give a chance of 1/4 to go up one level.
+    unsigned int x      = p_index->seed;
+    int          height = 1;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    p_index->seed = x;
+
+    while ((x & 0x3) == 0 && height < SKIP_INDEX_MAX_LEVEL)
+    {
+        height++;
+        x >>= 2;
+    }
+
+    return height;
+}
+
+static void* NextAt(SkipIndex_st* p_index, void* p_node, int level)
+{
+    return (p_node == NULL) ? p_index->p_heads[level] : TOWER(p_index, p_node)->p_forward[level - 1];
+}
+
+static void SetNextAt(SkipIndex_st* p_index, void* p_node, int level, void* p_next)
+{
+    if (p_node == NULL)
+    {
+        p_index->p_heads[level] = p_next;
+    }
+    else
+    {
+        TOWER(p_index, p_node)->p_forward[level - 1] = p_next;
+    }
+}
+
+/*=============================================================================*
+ *                                End of file
+ *============================================================================*/
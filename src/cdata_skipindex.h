@@ -0,0 +1,105 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.4.1
+*/
+
+/*
+ * SkipIndex: skip list towers over the nodes of a sorted list.
+ * Level 0 of the skip list is the list itself, so a node only needs a tower when it is promoted
+ * to level 1 or higher, about 1/4 of the nodes. The tower pointer(SkipIndexNode_st) lives at a fixed
+ * offset in the list node memory.
+ * The index doesn't know the order of the data, the caller tells it how far to move on by advanceFn,
+ * so the search, insert and remove are all O(log n) in expectation.
+ * All the functions must be called with the list locked.
+ */
+
+#ifndef _CDATA_SKIPINDEX_H_
+#define _CDATA_SKIPINDEX_H_
+
+#include <stddef.h>
+
+#include "cdata_types.h"
+
+__BEGIN_EXTERN_C_DECL__
+
+#define SKIP_INDEX_MAX_LEVEL 16
+
+/*
+ * Return CDATA_TRUE if the search should move on past p_node.It must be TRUE for a leading part
+ * of the list and FALSE for the rest.
+ */
+typedef CdataBool (*SkipIndex_Advance_fn)(void* p_node, void* p_arg);
+
+typedef struct
+{
+    //NULL if the node only lives in level 0.
+    void* p_tower;
+}SkipIndexNode_st;
+
+typedef struct
+{
+    //Offset of SkipIndexNode_st in the list node, 0 means the index is not used.
+    size_t       offset;
+    int          level;
+    unsigned int seed;
+
+    //The first node of each level, p_heads[0] is not used, level 0 starts from the list head.
+    void*        p_heads[SKIP_INDEX_MAX_LEVEL];
+}SkipIndex_st;
+
+void  SkipIndex_Init(SkipIndex_st* p_index, size_t offset);
+
+/*
+ * Free all the towers, the nodes will only live in level 0.
+ */
+void  SkipIndex_Clear(SkipIndex_st* p_index);
+
+/*
+ * Find the last node for which advanceFn returns TRUE, NULL if there is no such node.
+ * The node of each level after which a new node should be linked is saved in pp_preds
+ * if it's not NULL, NULL means the head of the level.
+ */
+void* SkipIndex_Seek(SkipIndex_st* p_index, void* p_firstNode, SkipIndex_Advance_fn advanceFn, void* p_arg, void* pp_preds[SKIP_INDEX_MAX_LEVEL]);
+
+/*
+ * The node has been linked into the list right after what SkipIndex_Seek returned, build its tower.
+ * The node will only live in level 0 if there is no memory for the tower.
+ */
+void  SkipIndex_Insert(SkipIndex_st* p_index, void* p_node, void* pp_preds[SKIP_INDEX_MAX_LEVEL]);
+
+/*
+ * Called when a node is linked by a function which doesn't know the order, the node only lives in level 0.
+ */
+void  SkipIndex_InsertFlat(SkipIndex_st* p_index, void* p_node);
+
+/*
+ * Unlink the node from all the levels above 0, advanceFn must return TRUE for the nodes before p_node.
+ */
+void  SkipIndex_Remove(SkipIndex_st* p_index, void* p_node, SkipIndex_Advance_fn advanceFn, void* p_arg);
+
+__END_EXTERN_C_DECL__
+
+#endif //_CDATA_SKIPINDEX_H_
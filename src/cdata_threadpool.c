@@ -0,0 +1,257 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.6.10
+*/
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "cdata_types.h"
+#include "cdata_os_adapter.h"
+#include "cdata_threadpool.h"
+
+#ifndef _DEBUG_LEVEL_
+#define _DEBUG_LEVEL_  _DEBUG_LEVEL_I_
+#endif
+#include "debug.h"
+
+/*=============================================================================*
+ *                        Macro definition
+ *============================================================================*/
+#define TO_POOL(_pool_) (ThreadPool_st*)(_pool_)
+
+/*=============================================================================*
+ *                        Const definition
+ *============================================================================*/
+
+/*=============================================================================*
+ *                    New type or enum declaration
+ *============================================================================*/
+typedef struct
+{
+    //Only one job is run at a time.
+    OSMutex_t          runMutex;
+
+    /*Guards taskFn, p_arg, pendingCount and stop, the idle workers wait on it.*/
+    OSCond_t           workCond;
+
+    /*Guards runningCount, the caller of ThreadPool_Run waits on it.*/
+    OSCond_t           doneCond;
+
+    OSThread_t         threads[THREAD_POOL_MAX_THREADS];
+    int                threadCount;
+
+    ThreadPool_Task_fn taskFn;
+    void*              p_arg;
+
+    /*How many workers still need to join the job, and how many haven't returned from it.*/
+    int                pendingCount;
+    int                runningCount;
+
+    CdataBool          stop;
+}ThreadPool_st;
+
+/*=============================================================================*
+ *                    Inner function declaration
+ *============================================================================*/
+static void* WorkerMain(void* p_arg);
+
+/*=============================================================================*
+ *                    Outer function implemention
+ *============================================================================*/
+ThreadPool_t ThreadPool_Create()
+{
+    ThreadPool_st *p_pool = (ThreadPool_st*)OS_Malloc(sizeof(ThreadPool_st));
+    if (p_pool == NULL)
+    {
+        LOG_E("Fail to allocate thread pool.\n");
+        return NULL;
+    }
+    memset(p_pool, 0, sizeof(ThreadPool_st));
+
+    p_pool->runMutex = OS_MutexCreate();
+    p_pool->workCond = OS_CondCreate();
+    p_pool->doneCond = OS_CondCreate();
+    if (p_pool->runMutex == NULL || p_pool->workCond == NULL || p_pool->doneCond == NULL)
+    {
+        LOG_E("Fail to create the locks of thread pool.\n");
+        ThreadPool_Destroy(p_pool);
+        return NULL;
+    }
+
+    p_pool->threadCount  = 0;
+    p_pool->taskFn       = NULL;
+    p_pool->p_arg        = NULL;
+    p_pool->pendingCount = 0;
+    p_pool->runningCount = 0;
+    p_pool->stop         = CDATA_FALSE;
+
+    return (ThreadPool_t)p_pool;
+}
+
+void ThreadPool_Destroy(ThreadPool_t pool)
+{
+    if (pool == NULL)
+    {
+        return;
+    }
+
+    ThreadPool_st* p_pool = TO_POOL(pool);
+    int            i = 0;
+
+    if (p_pool->workCond != NULL)
+    {
+        OS_CondLock(p_pool->workCond);
+        p_pool->stop = CDATA_TRUE;
+        OS_CondBroadcast(p_pool->workCond);
+        OS_CondUnlock(p_pool->workCond);
+    }
+
+    for (i = 0; i < p_pool->threadCount; i++)
+    {
+        OS_ThreadJoin(p_pool->threads[i]);
+    }
+
+    if (p_pool->doneCond != NULL)
+    {
+        OS_CondDestroy(p_pool->doneCond);
+    }
+    if (p_pool->workCond != NULL)
+    {
+        OS_CondDestroy(p_pool->workCond);
+    }
+    if (p_pool->runMutex != NULL)
+    {
+        OS_MutexDestroy(p_pool->runMutex);
+    }
+
+    OS_Free(p_pool);
+}
+
+int ThreadPool_Run(ThreadPool_t pool, int threadCount, ThreadPool_Task_fn taskFn, void* p_arg)
+{
+    CHECK_PARAM(pool != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(threadCount > 0, ERR_BAD_PARAM);
+    CHECK_PARAM(taskFn != NULL, ERR_BAD_PARAM);
+
+    ThreadPool_st* p_pool = TO_POOL(pool);
+    OSThread_t     thread = NULL;
+    int            helperCount = threadCount - 1;
+
+    if (helperCount > THREAD_POOL_MAX_THREADS)
+    {
+        helperCount = THREAD_POOL_MAX_THREADS;
+    }
+
+    OS_MutexLock(p_pool->runMutex);
+    while (p_pool->threadCount < helperCount)
+    {
+        thread = OS_ThreadCreate(WorkerMain, p_pool);
+        if (thread == NULL)
+        {
+            LOG_E("Fail to create worker, the job is run on %d threads.\n", p_pool->threadCount + 1);
+            helperCount = p_pool->threadCount;
+            break;
+        }
+        p_pool->threads[p_pool->threadCount++] = thread;
+    }
+
+    if (helperCount > 0)
+    {
+        //runningCount is set firstly, a worker may return from the task before the caller does.
+        OS_CondLock(p_pool->doneCond);
+        p_pool->runningCount = helperCount;
+        OS_CondUnlock(p_pool->doneCond);
+
+        OS_CondLock(p_pool->workCond);
+        p_pool->taskFn       = taskFn;
+        p_pool->p_arg        = p_arg;
+        p_pool->pendingCount = helperCount;
+        OS_CondBroadcast(p_pool->workCond);
+        OS_CondUnlock(p_pool->workCond);
+    }
+
+    taskFn(p_arg);
+
+    OS_CondLock(p_pool->doneCond);
+    while (p_pool->runningCount > 0)
+    {
+        OS_CondWait(p_pool->doneCond);
+    }
+    OS_CondUnlock(p_pool->doneCond);
+    OS_MutexUnlock(p_pool->runMutex);
+
+    return ERR_OK;
+}
+
+/*=============================================================================*
+ *                    Inner function implemention
+ *============================================================================*/
+static void* WorkerMain(void* p_arg)
+{
+    ThreadPool_st*     p_pool    = (ThreadPool_st*)p_arg;
+    ThreadPool_Task_fn taskFn    = NULL;
+    void*              p_taskArg = NULL;
+
+    OS_CondLock(p_pool->workCond);
+    while (1)
+    {
+        while (!p_pool->stop && p_pool->pendingCount == 0)
+        {
+            OS_CondWait(p_pool->workCond);
+        }
+
+        if (p_pool->stop)
+        {
+            break;
+        }
+
+        p_pool->pendingCount--;
+        taskFn    = p_pool->taskFn;
+        p_taskArg = p_pool->p_arg;
+        OS_CondUnlock(p_pool->workCond);
+
+        taskFn(p_taskArg);
+
+        OS_CondLock(p_pool->doneCond);
+        p_pool->runningCount--;
+        if (p_pool->runningCount == 0)
+        {
+            OS_CondSignal(p_pool->doneCond);
+        }
+        OS_CondUnlock(p_pool->doneCond);
+
+        OS_CondLock(p_pool->workCond);
+    }
+    OS_CondUnlock(p_pool->workCond);
+
+    return NULL;
+}
+
+/*=============================================================================*
+ *                                End of file
+ *============================================================================*/
@@ -0,0 +1,61 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.6.10
+*/
+
+/*
+ * ThreadPool: a few worker threads for the fork-join jobs of cdata_parallel.
+ * A job is one task function which is run on several threads at the same time, the calling
+ * thread is one of them, and ThreadPool_Run returns after all of them have returned, so the
+ * task usually takes its work items from a shared counter until there is nothing left.
+ * The workers are created when a job needs them and live until the pool is destroyed.
+ */
+
+#ifndef _CDATA_THREADPOOL_H_
+#define _CDATA_THREADPOOL_H_
+
+#include "cdata_types.h"
+
+__BEGIN_EXTERN_C_DECL__
+
+#define THREAD_POOL_MAX_THREADS 64
+
+typedef void* ThreadPool_t;
+typedef void (*ThreadPool_Task_fn)(void* p_arg);
+
+ThreadPool_t ThreadPool_Create();
+void         ThreadPool_Destroy(ThreadPool_t pool);
+
+/*
+ * Run taskFn on threadCount threads including the calling one. The jobs of different callers are
+ * run one after another, so taskFn must not call ThreadPool_Run on the same pool.
+ * If some workers can't be created, the job is run on fewer threads.
+ */
+int ThreadPool_Run(ThreadPool_t pool, int threadCount, ThreadPool_Task_fn taskFn, void* p_arg);
+
+__END_EXTERN_C_DECL__
+
+#endif //_CDATA_THREADPOOL_H_
@@ -0,0 +1,634 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.5.7
+*/
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cdata_types.h"
+#include "cdata_os_adapter.h"
+#include "list_internal.h"
+#include "cdata_ulist.h"
+
+#ifndef _DEBUG_LEVEL_
+#define _DEBUG_LEVEL_  _DEBUG_LEVEL_I_
+#endif
+#include "debug.h"
+
+/*=============================================================================*
+ *                        Macro definition
+ *============================================================================*/
+#define ROUND_UP(_size_, _align_) ((((_size_) + (_align_) - 1) / (_align_)) * (_align_))
+
+#define BLOCKS_LOCK(_blocks_)   while (__sync_lock_test_and_set(&(_blocks_)->guard, 1)) { while ((_blocks_)->guard) {} }
+#define BLOCKS_UNLOCK(_blocks_) __sync_lock_release(&(_blocks_)->guard)
+
+#define BLOCK_OF(_blocks_, _node_)            ((UListBlock_st*)((uintptr_t)(_node_) & ~((uintptr_t)(_blocks_)->blockSize - 1)))
+#define SLOT_AT(_blocks_, _block_, _index_)   ((char*)(_block_) + BLOCK_HEADER_SIZE + (size_t)(_index_) * (_blocks_)->slotSize)
+#define SLOT_INDEX(_blocks_, _block_, _node_) ((int)(((char*)(_node_) - SLOT_AT(_blocks_, _block_, 0)) / (_blocks_)->slotSize))
+
+#define MASK_TEST(_mask_, _index_)  (((_mask_)[(_index_) >> 6] >> ((_index_) & 63)) & 1)
+#define MASK_SET(_mask_, _index_)   ((_mask_)[(_index_) >> 6] |= (uint64_t)1 << ((_index_) & 63))
+#define MASK_CLEAR(_mask_, _index_) ((_mask_)[(_index_) >> 6] &= ~((uint64_t)1 << ((_index_) & 63)))
+
+/*=============================================================================*
+ *                        Const definition
+ *============================================================================*/
+#define ULIST_MAX_SLOTS        256
+#define ULIST_MASK_WORDS       (ULIST_MAX_SLOTS / 64)
+
+/*A block holds at least so many slots, it grows from ULIST_MIN_BLOCK_SIZE until it does.*/
+#define ULIST_MIN_SLOTS        32
+#define ULIST_MIN_BLOCK_SIZE   512
+
+/*The unrolled list is for small data, the bigger one is better stored in the node of the double list.*/
+#define ULIST_MAX_DATA_LENGTH  1024
+
+/*The slots begin at the same alignment as malloc gives us.*/
+#define BLOCK_HEADER_SIZE      ROUND_UP(sizeof(UListBlock_st), LIST_NODE_DATA_ALIGN)
+
+/*=============================================================================*
+ *                    New type or enum declaration
+ *============================================================================*/
+typedef struct _UListBlock_s
+{
+    struct _UListBlock_s* p_next;
+    struct _UListBlock_s* p_pre;
+
+    //The slots out of [begin, end) are free, they are taken from the two edges.
+    int       begin;
+    int       end;
+
+    int       linkedCount;
+
+    //The linked slots and the detached slots which haven't been destroyed.
+    int       usedCount;
+
+    //The block leaves the block list when its last slot is detached.
+    CdataBool linked;
+
+    uint64_t  linkedMask[ULIST_MASK_WORDS];
+    uint64_t  usedMask[ULIST_MASK_WORDS];
+
+    //The slot still holds its data, it's cleared when the data is taken out.
+    uint64_t  dataMask[ULIST_MASK_WORDS];
+}UListBlock_st;
+
+/*=============================================================================*
+ *                    Inner function declaration
+ *============================================================================*/
+static UListBlock_st* NewBlock(UListBlocks_st* p_blocks, int start);
+static void           LinkBlock(UListBlocks_st* p_blocks, UListBlock_st* p_pre, UListBlock_st* p_block);
+static void           UnlinkBlock(UListBlocks_st* p_blocks, UListBlock_st* p_block);
+static void*          FillSlot(List_st* p_list, UListBlock_st* p_block, int index, void* p_data);
+static int            FindNextLinked(UListBlock_st* p_block, int from);
+static int            FindPreLinked(UListBlock_st* p_block, int from);
+static int            SelectLinked(UListBlock_st* p_block, int rank);
+
+/*=============================================================================*
+ *                    Outer function implemention
+ *============================================================================*/
+int UList_Init(UListBlocks_st* p_blocks, int dataLength)
+{
+    CHECK_PARAM(p_blocks != NULL, ERR_BAD_PARAM);
+
+    size_t blockSize = ULIST_MIN_BLOCK_SIZE;
+    size_t slots     = 0;
+
+    memset(p_blocks, 0, sizeof(UListBlocks_st));
+    if (dataLength <= 0 || dataLength > ULIST_MAX_DATA_LENGTH)
+    {
+        LOG_E("The data length of unrolled list must be in [1, %d], dataLength:%d.\n", ULIST_MAX_DATA_LENGTH, dataLength);
+        return ERR_BAD_PARAM;
+    }
+
+    while ((blockSize - BLOCK_HEADER_SIZE) / dataLength < ULIST_MIN_SLOTS)
+    {
+        blockSize *= 2;
+    }
+
+    slots = (blockSize - BLOCK_HEADER_SIZE) / dataLength;
+
+    //A struct's size is a multiple of its alignment, so the slots need no padding.
+    p_blocks->guard         = 0;
+    p_blocks->p_headBlock   = NULL;
+    p_blocks->p_tailBlock   = NULL;
+    p_blocks->blockSize     = blockSize;
+    p_blocks->slotSize      = dataLength;
+    p_blocks->slotsPerBlock = (slots < ULIST_MAX_SLOTS) ? (int)slots : ULIST_MAX_SLOTS;
+
+    return ERR_OK;
+}
+
+void UList_Fini(UListBlocks_st* p_blocks)
+{
+    ASSERT(p_blocks != NULL);
+
+    UListBlock_st* p_block = (UListBlock_st*)p_blocks->p_headBlock;
+    UListBlock_st* p_next  = NULL;
+
+    for (; p_block != NULL; p_block = p_next)
+    {
+        p_next = p_block->p_next;
+        OS_Free(p_block);
+    }
+
+    p_blocks->p_headBlock = NULL;
+    p_blocks->p_tailBlock = NULL;
+}
+
+int UList_InsertData(List_t list, void* p_data, ListNode_t* p_node)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(p_data != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(p_node != NULL, ERR_BAD_PARAM);
+
+    List_st*        p_list   = CONVERT_2_LIST(list);
+    UListBlocks_st* p_blocks = &p_list->blocks;
+    UListBlock_st*  p_block  = NULL;
+
+    BLOCKS_LOCK(p_blocks);
+    p_block = (UListBlock_st*)p_blocks->p_tailBlock;
+    if (p_block == NULL || p_block->end == p_blocks->slotsPerBlock)
+    {
+        //The first block starts from the middle, so it can grow to both sides.
+        p_block = NewBlock(p_blocks, (p_block == NULL) ? p_blocks->slotsPerBlock / 2 : 0);
+        if (p_block == NULL)
+        {
+            BLOCKS_UNLOCK(p_blocks);
+            return ERR_OUT_MEM;
+        }
+        LinkBlock(p_blocks, (UListBlock_st*)p_blocks->p_tailBlock, p_block);
+    }
+
+    *p_node = FillSlot(p_list, p_block, p_block->end++, p_data);
+    BLOCKS_UNLOCK(p_blocks);
+
+    if (p_list->p_head == NULL)
+    {
+        p_list->p_head = *p_node;
+    }
+    p_list->p_tail = *p_node;
+
+    List_OnNodeLinked(p_list, *p_node);
+
+    return ERR_OK;
+}
+
+int UList_InsertData2Head(List_t list, void* p_data, ListNode_t* p_node)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(p_data != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(p_node != NULL, ERR_BAD_PARAM);
+
+    List_st*        p_list   = CONVERT_2_LIST(list);
+    UListBlocks_st* p_blocks = &p_list->blocks;
+    UListBlock_st*  p_block  = NULL;
+
+    BLOCKS_LOCK(p_blocks);
+    p_block = (UListBlock_st*)p_blocks->p_headBlock;
+    if (p_block == NULL || p_block->begin == 0)
+    {
+        p_block = NewBlock(p_blocks, (p_block == NULL) ? p_blocks->slotsPerBlock / 2 : p_blocks->slotsPerBlock);
+        if (p_block == NULL)
+        {
+            BLOCKS_UNLOCK(p_blocks);
+            return ERR_OUT_MEM;
+        }
+        LinkBlock(p_blocks, NULL, p_block);
+    }
+
+    *p_node = FillSlot(p_list, p_block, --p_block->begin, p_data);
+    BLOCKS_UNLOCK(p_blocks);
+
+    if (p_list->p_tail == NULL)
+    {
+        p_list->p_tail = *p_node;
+    }
+    p_list->p_head = *p_node;
+
+    List_OnNodeLinked(p_list, *p_node);
+
+    return ERR_OK;
+}
+
+int UList_DetachNode(List_t list, ListNode_t node)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(node != NULL, ERR_BAD_PARAM);
+
+    List_st*        p_list   = CONVERT_2_LIST(list);
+    UListBlocks_st* p_blocks = &p_list->blocks;
+    UListBlock_st*  p_block  = BLOCK_OF(p_blocks, node);
+    int             index    = SLOT_INDEX(p_blocks, p_block, node);
+
+    if (!MASK_TEST(p_block->linkedMask, index))
+    {
+        LOG_E("The node is not in list:'%s'.\n", p_list->name);
+        return ERR_BAD_PARAM;
+    }
+
+    //The neighbours are found before the block may leave the block list.
+    if (p_list->p_head == node)
+    {
+        p_list->p_head = UList_GetNextNode(list, node);
+    }
+    if (p_list->p_tail == node)
+    {
+        p_list->p_tail = UList_GetPreNode(list, node);
+    }
+
+    BLOCKS_LOCK(p_blocks);
+    MASK_CLEAR(p_block->linkedMask, index);
+    p_block->linkedCount--;
+    if (p_block->linkedCount == 0)
+    {
+        UnlinkBlock(p_blocks, p_block);
+    }
+    BLOCKS_UNLOCK(p_blocks);
+
+    List_OnNodeUnlinked(p_list, node);
+
+    return ERR_OK;
+}
+
+int UList_DestroyNode(List_t list, ListNode_t node)
+{
+    CHECK_PARAM(list != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(node != NULL, ERR_BAD_PARAM);
+
+    List_st*        p_list   = CONVERT_2_LIST(list);
+    UListBlocks_st* p_blocks = &p_list->blocks;
+    UListBlock_st*  p_block  = BLOCK_OF(p_blocks, node);
+    int             index    = SLOT_INDEX(p_blocks, p_block, node);
+    CdataBool       needFree = CDATA_FALSE;
+
+    BLOCKS_LOCK(p_blocks);
+    if (MASK_TEST(p_block->linkedMask, index) || !MASK_TEST(p_block->usedMask, index))
+    {
+        BLOCKS_UNLOCK(p_blocks);
+        LOG_E("The node is still in list or has been destroyed, list:'%s'.\n", p_list->name);
+        return ERR_BAD_PARAM;
+    }
+
+    MASK_CLEAR(p_block->usedMask, index);
+    MASK_CLEAR(p_block->dataMask, index);
+    p_block->usedCount--;
+
+    if (!p_block->linked)
+    {
+        needFree = (p_block->usedCount == 0);
+        BLOCKS_UNLOCK(p_blocks);
+        if (needFree)
+        {
+            OS_Free(p_block);
+        }
+        return ERR_OK;
+    }
+
+    //Give the free slots at the edges back, so the head and tail block can reuse them.
+    while (p_block->begin < p_block->end && !MASK_TEST(p_block->usedMask, p_block->begin))
+    {
+        p_block->begin++;
+    }
+    while (p_block->end > p_block->begin && !MASK_TEST(p_block->usedMask, p_block->end - 1))
+    {
+        p_block->end--;
+    }
+    BLOCKS_UNLOCK(p_blocks);
+
+    return ERR_OK;
+}
+
+void* UList_TakeNodeData(List_t list, ListNode_t node)
+{
+    CHECK_PARAM(list != NULL, NULL);
+    CHECK_PARAM(node != NULL, NULL);
+
+    UListBlocks_st* p_blocks = &(CONVERT_2_LIST(list))->blocks;
+    UListBlock_st*  p_block  = BLOCK_OF(p_blocks, node);
+    int             index    = SLOT_INDEX(p_blocks, p_block, node);
+    void*           p_data   = NULL;
+
+    BLOCKS_LOCK(p_blocks);
+    if (MASK_TEST(p_block->dataMask, index))
+    {
+        MASK_CLEAR(p_block->dataMask, index);
+        p_data = node;
+    }
+    BLOCKS_UNLOCK(p_blocks);
+
+    return p_data;
+}
+
+void* UList_GetNodeData(List_t list, ListNode_t node)
+{
+    CHECK_PARAM(list != NULL, NULL);
+    CHECK_PARAM(node != NULL, NULL);
+
+    UListBlocks_st* p_blocks = &(CONVERT_2_LIST(list))->blocks;
+    UListBlock_st*  p_block  = BLOCK_OF(p_blocks, node);
+
+    return MASK_TEST(p_block->dataMask, SLOT_INDEX(p_blocks, p_block, node)) ? node : NULL;
+}
+
+ListNode_t UList_GetNextNode(List_t list, ListNode_t node)
+{
+    CHECK_PARAM(list != NULL, NULL);
+    CHECK_PARAM(node != NULL, NULL);
+
+    UListBlocks_st* p_blocks = &(CONVERT_2_LIST(list))->blocks;
+    UListBlock_st*  p_block  = BLOCK_OF(p_blocks, node);
+    int             index    = FindNextLinked(p_block, SLOT_INDEX(p_blocks, p_block, node) + 1);
+
+    //A block in the block list has one linked slot at least.
+    if (index < 0)
+    {
+        p_block = p_block->p_next;
+        index   = (p_block != NULL) ? FindNextLinked(p_block, p_block->begin) : -1;
+    }
+
+    return (index >= 0) ? SLOT_AT(p_blocks, p_block, index) : NULL;
+}
+
+ListNode_t UList_GetPreNode(List_t list, ListNode_t node)
+{
+    CHECK_PARAM(list != NULL, NULL);
+    CHECK_PARAM(node != NULL, NULL);
+
+    UListBlocks_st* p_blocks = &(CONVERT_2_LIST(list))->blocks;
+    UListBlock_st*  p_block  = BLOCK_OF(p_blocks, node);
+    int             index    = FindPreLinked(p_block, SLOT_INDEX(p_blocks, p_block, node) - 1);
+
+    if (index < 0)
+    {
+        p_block = p_block->p_pre;
+        index   = (p_block != NULL) ? FindPreLinked(p_block, p_block->end - 1) : -1;
+    }
+
+    return (index >= 0) ? SLOT_AT(p_blocks, p_block, index) : NULL;
+}
+
+void UList_Traverse(List_t list, void* p_userData, List_Traverse_fn traverseFn)
+{
+    ASSERT(list != NULL);
+    ASSERT(traverseFn != NULL);
+
+    UListBlocks_st*        p_blocks = &(CONVERT_2_LIST(list))->blocks;
+    UListBlock_st*         p_block  = NULL;
+    CdataBool              needStop = CDATA_FALSE;
+    uint64_t               bits     = 0;
+    int                    word     = 0;
+    int                    index    = 0;
+    ListTraverseNodeInfo_t info;
+
+    info.index = 0;
+    for (p_block = (UListBlock_st*)p_blocks->p_headBlock; p_block != NULL; p_block = p_block->p_next)
+    {
+        for (word = p_block->begin >> 6; word < ULIST_MASK_WORDS; word++)
+        {
+            for (bits = p_block->linkedMask[word]; bits != 0; bits &= bits - 1)
+            {
+                index = (word << 6) + __builtin_ctzll(bits);
+                info.node   = SLOT_AT(p_blocks, p_block, index);
+                info.p_data = MASK_TEST(p_block->dataMask, index) ? info.node : NULL;
+
+                traverseFn(&info, p_userData, &needStop);
+                if (needStop)
+                {
+                    return;
+                }
+                info.index++;
+            }
+        }
+    }
+}
+
+ListNode_t UList_GetNodeAtPos(List_t list, CdataIndex_t posIndex)
+{
+    CHECK_PARAM(list != NULL, NULL);
+
+    List_st*        p_list   = CONVERT_2_LIST(list);
+    UListBlocks_st* p_blocks = &p_list->blocks;
+    UListBlock_st*  p_block  = NULL;
+    CdataCount_t    count    = LIST_COUNTER_GET(p_list->nodeCount);
+    CdataIndex_t    rest     = 0;
+
+    if (posIndex >= count)
+    {
+        return NULL;
+    }
+
+    //Walk from the nearer end.
+    if (posIndex <= count / 2)
+    {
+        for (p_block = (UListBlock_st*)p_blocks->p_headBlock, rest = posIndex; rest >= (CdataIndex_t)p_block->linkedCount; p_block = p_block->p_next)
+        {
+            rest -= p_block->linkedCount;
+        }
+
+        return SLOT_AT(p_blocks, p_block, SelectLinked(p_block, (int)rest));
+    }
+
+    for (p_block = (UListBlock_st*)p_blocks->p_tailBlock, rest = count - 1 - posIndex; rest >= (CdataIndex_t)p_block->linkedCount; p_block = p_block->p_pre)
+    {
+        rest -= p_block->linkedCount;
+    }
+
+    return SLOT_AT(p_blocks, p_block, SelectLinked(p_block, p_block->linkedCount - 1 - (int)rest));
+}
+
+/*=============================================================================*
+ *                    Inner function implemention
+ *============================================================================*/
+static UListBlock_st* NewBlock(UListBlocks_st* p_blocks, int start)
+{
+    UListBlock_st* p_block = (UListBlock_st*)OS_AlignedMalloc(p_blocks->blockSize, p_blocks->blockSize);
+
+    if (p_block == NULL)
+    {
+        LOG_E("Not enough memory for unrolled list block, size:%d.\n", (int)p_blocks->blockSize);
+        return NULL;
+    }
+
+    memset(p_block, 0, BLOCK_HEADER_SIZE);
+    p_block->begin = start;
+    p_block->end   = start;
+
+    return p_block;
+}
+
+//p_pre NULL means linking the block before the head block.
+static void LinkBlock(UListBlocks_st* p_blocks, UListBlock_st* p_pre, UListBlock_st* p_block)
+{
+    UListBlock_st* p_next = (p_pre != NULL) ? p_pre->p_next : (UListBlock_st*)p_blocks->p_headBlock;
+
+    p_block->p_pre  = p_pre;
+    p_block->p_next = p_next;
+    p_block->linked = CDATA_TRUE;
+
+    if (p_pre != NULL)
+    {
+        p_pre->p_next = p_block;
+    }
+    else
+    {
+        p_blocks->p_headBlock = p_block;
+    }
+
+    if (p_next != NULL)
+    {
+        p_next->p_pre = p_block;
+    }
+    else
+    {
+        p_blocks->p_tailBlock = p_block;
+    }
+}
+
+static void UnlinkBlock(UListBlocks_st* p_blocks, UListBlock_st* p_block)
+{
+    if (p_block->p_pre != NULL)
+    {
+        p_block->p_pre->p_next = p_block->p_next;
+    }
+    else
+    {
+        p_blocks->p_headBlock = p_block->p_next;
+    }
+
+    if (p_block->p_next != NULL)
+    {
+        p_block->p_next->p_pre = p_block->p_pre;
+    }
+    else
+    {
+        p_blocks->p_tailBlock = p_block->p_pre;
+    }
+
+    p_block->p_pre  = NULL;
+    p_block->p_next = NULL;
+    p_block->linked = CDATA_FALSE;
+}
+
+static void* FillSlot(List_st* p_list, UListBlock_st* p_block, int index, void* p_data)
+{
+    void* p_slot = SLOT_AT(&p_list->blocks, p_block, index);
+
+    memcpy(p_slot, p_data, p_list->dataLength);
+
+    MASK_SET(p_block->linkedMask, index);
+    MASK_SET(p_block->usedMask, index);
+    MASK_SET(p_block->dataMask, index);
+    p_block->linkedCount++;
+    p_block->usedCount++;
+
+    return p_slot;
+}
+
+//The first linked slot at or after from, -1 if there is none.
+static int FindNextLinked(UListBlock_st* p_block, int from)
+{
+    int      word = 0;
+    uint64_t bits = 0;
+
+    if (from >= ULIST_MAX_SLOTS)
+    {
+        return -1;
+    }
+
+    word = from >> 6;
+    bits = p_block->linkedMask[word] & (~(uint64_t)0 << (from & 63));
+    while (bits == 0)
+    {
+        if (++word == ULIST_MASK_WORDS)
+        {
+            return -1;
+        }
+        bits = p_block->linkedMask[word];
+    }
+
+    return (word << 6) + __builtin_ctzll(bits);
+}
+
+//The last linked slot at or before from, -1 if there is none.
+static int FindPreLinked(UListBlock_st* p_block, int from)
+{
+    int      word = 0;
+    uint64_t bits = 0;
+
+    if (from < 0)
+    {
+        return -1;
+    }
+
+    word = from >> 6;
+    bits = p_block->linkedMask[word] & (~(uint64_t)0 >> (63 - (from & 63)));
+    while (bits == 0)
+    {
+        if (word-- == 0)
+        {
+            return -1;
+        }
+        bits = p_block->linkedMask[word];
+    }
+
+    return (word << 6) + 63 - __builtin_clzll(bits);
+}
+
+//The index of the linked slot which has rank linked slots before it in the block.
+static int SelectLinked(UListBlock_st* p_block, int rank)
+{
+    int      word  = 0;
+    int      count = 0;
+    uint64_t bits  = 0;
+
+    for (word = 0; word < ULIST_MASK_WORDS; word++)
+    {
+        bits  = p_block->linkedMask[word];
+        count = __builtin_popcountll(bits);
+        if (rank < count)
+        {
+            break;
+        }
+        rank -= count;
+    }
+    ASSERT(word < ULIST_MASK_WORDS);
+
+    while (rank-- > 0)
+    {
+        bits &= bits - 1;
+    }
+
+    return (word << 6) + __builtin_ctzll(bits);
+}
+
+/*=============================================================================*
+ *                                End of file
+ *============================================================================*/
@@ -0,0 +1,107 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.5.7
+*/
+
+/*
+ * UList: the storage of LIST_TYPE_UNROLLED. The value copy data are stored in blocks of fixed-size
+ * slots, the blocks are linked in both directions, and a node is just the slot of its data, so a node
+ * never moves while it's alive, and walking the list mostly goes from a slot to the next one of the
+ * same block.
+ * The data can only be linked at the head or the tail, which takes the free slot in front of the head
+ * block or behind the tail block. A detached slot keeps its place until it's destroyed, the slots are
+ * reused only at the two edges of a block, and a block is freed when it has no slot in use.
+ * The blocks are aligned to their size, so the block of a node is found by masking the address.
+ * All the functions must be called with the list locked except UList_DestroyNode, the node is destroyed
+ * out of the list lock like the other list types do, so the slot bookkeeping has its own spin lock.
+ */
+
+#ifndef _CDATA_ULIST_H_
+#define _CDATA_ULIST_H_
+
+#include <stddef.h>
+
+#include "cdata_types.h"
+#include "cdata_list.h"
+
+__BEGIN_EXTERN_C_DECL__
+
+typedef struct
+{
+    //Guards the slot bookkeeping which is changed by UList_DestroyNode out of the list lock.
+    volatile int guard;
+
+    void*  p_headBlock;
+    void*  p_tailBlock;
+
+    //Power of 2, the blocks are aligned to it.
+    size_t blockSize;
+    size_t slotSize;
+    int    slotsPerBlock;
+}UListBlocks_st;
+
+int        UList_Init(UListBlocks_st* p_blocks, int dataLength);
+
+/*
+ * Free the blocks which are still in the block list, the data in them must have been freed.
+ */
+void       UList_Fini(UListBlocks_st* p_blocks);
+
+/*
+ * Copy the data into a new slot at the tail or the head, the slot is the node of the data.
+ */
+int        UList_InsertData(List_t list, void* p_data, ListNode_t* p_node);
+int        UList_InsertData2Head(List_t list, void* p_data, ListNode_t* p_node);
+
+int        UList_DetachNode(List_t list, ListNode_t node);
+
+/*
+ * The slot of a detached node is given back, the data must have been freed or taken by caller.
+ */
+int        UList_DestroyNode(List_t list, ListNode_t node);
+
+/*
+ * The node is left without data, it returns NULL if the data has been taken already.
+ */
+void*      UList_TakeNodeData(List_t list, ListNode_t node);
+void*      UList_GetNodeData(List_t list, ListNode_t node);
+
+ListNode_t UList_GetNextNode(List_t list, ListNode_t node);
+ListNode_t UList_GetPreNode(List_t list, ListNode_t node);
+
+/*
+ * Visit the linked slots block by block, it's what List_Traverse does on the unrolled list.
+ */
+void       UList_Traverse(List_t list, void* p_userData, List_Traverse_fn traverseFn);
+
+/*
+ * The blocks are skipped by their node count, so only one block is searched slot by slot.
+ */
+ListNode_t UList_GetNodeAtPos(List_t list, CdataIndex_t posIndex);
+
+__END_EXTERN_C_DECL__
+
+#endif //_CDATA_ULIST_H_
@@ -0,0 +1,616 @@
+/*
+MIT License
+
+Copyright (c) 2018 DuanBaoshan
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+Author:DuanBaoshan
+E-Mail:duanbaoshan79@163.com
+Date:2019.5.20
+*/
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "cdata_types.h"
+#include "cdata_os_adapter.h"
+#include "cdata_vector.h"
+#include "list_internal.h"
+
+#ifndef _DEBUG_LEVEL_
+#define _DEBUG_LEVEL_  _DEBUG_LEVEL_I_
+#endif
+#include "debug.h"
+
+/*=============================================================================*
+ *                        Macro definition
+ *============================================================================*/
+#define TO_VECTOR(_vector_) (Vector_st*)(_vector_)
+
+#define ELEM_AT(_vector_, _array_, _index_) ((char*)(_array_) + (size_t)(_index_) * (_vector_)->elemSize)
+
+//The reference vector stores the data pointer in the element, the value copy one stores the data itself.
+#define ELEM_DATA(_vector_, _elem_) \
+    ((_vector_)->dataType == LIST_DATA_TYPE_VALUE_REFERENCE ? *(void**)(_elem_) : (void*)(_elem_))
+
+/*=============================================================================*
+ *                        Const definition
+ *============================================================================*/
+#define VECTOR_MIN_CAPACITY 8
+
+/*=============================================================================*
+ *                    New type or enum declaration
+ *============================================================================*/
+typedef struct
+{
+    VectorName_t     name;
+
+    List_DataType_e  dataType;
+    int              dataLength;
+
+    //Size of each element in the array, it's sizeof(void*) for the reference vector.
+    size_t           elemSize;
+
+    char*            p_array;
+    CdataCount_t     count;
+    CdataCount_t     capacity;
+
+    List_FreeData_fn freeFn;
+    OSMutex_t        guard;
+}Vector_st;
+
+/*=============================================================================*
+ *                    Inner function declaration
+ *============================================================================*/
+static Vector_t CreateVector(VectorName_t name, List_DataType_e dataType, int dataLength);
+static int      ReserveNL(Vector_st* p_vector, CdataCount_t capacity);
+static int      InsertAtNL(Vector_st* p_vector, CdataIndex_t index, void* p_data);
+static void     FreeElem(Vector_st* p_vector, void* p_elem);
+static void     MergeRange(Vector_st* p_vector, List_UserLtNode_fn ltFn, char* p_src, char* p_dst, CdataCount_t low, CdataCount_t mid, CdataCount_t high);
+
+/*=============================================================================*
+ *                    Outer function implemention
+ *============================================================================*/
+int Vector_Create(VectorName_t name, int dataLength, Vector_t* p_vector)
+{
+    CHECK_PARAM(p_vector != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(dataLength > 0, ERR_BAD_PARAM);
+
+    Vector_t vector = CreateVector(name, LIST_DATA_TYPE_VALUE_COPY, dataLength);
+    if (vector == NULL)
+    {
+        LOG_E("Fail to create vector:'%s'.\n", name);
+        return ERR_FAIL;
+    }
+
+    *p_vector = vector;
+    return ERR_OK;
+}
+
+int Vector_CreateRef(VectorName_t name, Vector_t* p_vector)
+{
+    CHECK_PARAM(p_vector != NULL, ERR_BAD_PARAM);
+
+    Vector_t vector = CreateVector(name, LIST_DATA_TYPE_VALUE_REFERENCE, 0);
+    if (vector == NULL)
+    {
+        LOG_E("Fail to create vector:'%s'.\n", name);
+        return ERR_FAIL;
+    }
+
+    *p_vector = vector;
+    return ERR_OK;
+}
+
+int Vector_SetFreeDataFunc(Vector_t vector, List_FreeData_fn freeFn)
+{
+    CHECK_PARAM(vector != NULL, ERR_BAD_PARAM);
+
+    Vector_st* p_vector = TO_VECTOR(vector);
+    p_vector->freeFn = freeFn;
+
+    return ERR_OK;
+}
+
+int Vector_Reserve(Vector_t vector, CdataCount_t capacity)
+{
+    CHECK_PARAM(vector != NULL, ERR_BAD_PARAM);
+
+    Vector_st* p_vector = TO_VECTOR(vector);
+    int        ret      = ERR_OK;
+
+    OS_MutexLock(p_vector->guard);
+    ret = ReserveNL(p_vector, capacity);
+    OS_MutexUnlock(p_vector->guard);
+
+    return ret;
+}
+
+const char* Vector_Name(Vector_t vector)
+{
+    CHECK_PARAM(vector != NULL, NULL);
+
+    Vector_st* p_vector = TO_VECTOR(vector);
+    return p_vector->name;
+}
+
+CdataCount_t Vector_Count(Vector_t vector)
+{
+    CHECK_PARAM(vector != NULL, 0);
+
+    Vector_st* p_vector = TO_VECTOR(vector);
+    return LIST_COUNTER_GET(p_vector->count);
+}
+
+CdataCount_t Vector_Capacity(Vector_t vector)
+{
+    CHECK_PARAM(vector != NULL, 0);
+
+    Vector_st* p_vector = TO_VECTOR(vector);
+    return LIST_COUNTER_GET(p_vector->capacity);
+}
+
+void Vector_Lock(Vector_t vector)
+{
+    if (vector == NULL)
+    {
+        LOG_E("vector is NULL.\n");
+        return;
+    }
+
+    Vector_st* p_vector = TO_VECTOR(vector);
+    OS_MutexLock(p_vector->guard);
+}
+
+void Vector_UnLock(Vector_t vector)
+{
+    if (vector == NULL)
+    {
+        LOG_E("vector is NULL.\n");
+        return;
+    }
+
+    Vector_st* p_vector = TO_VECTOR(vector);
+    OS_MutexUnlock(p_vector->guard);
+}
+
+int Vector_Push(Vector_t vector, void* p_data)
+{
+    CHECK_PARAM(vector != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(p_data != NULL, ERR_BAD_PARAM);
+
+    Vector_st* p_vector = TO_VECTOR(vector);
+    int        ret      = ERR_OK;
+
+    OS_MutexLock(p_vector->guard);
+    ret = InsertAtNL(p_vector, p_vector->count, p_data);
+    OS_MutexUnlock(p_vector->guard);
+
+    return ret;
+}
+
+int Vector_Pop(Vector_t vector, void* p_data)
+{
+    CHECK_PARAM(vector != NULL, ERR_BAD_PARAM);
+
+    Vector_st* p_vector = TO_VECTOR(vector);
+    void*      p_elem   = NULL;
+
+    OS_MutexLock(p_vector->guard);
+    if (p_vector->count == 0)
+    {
+        OS_MutexUnlock(p_vector->guard);
+        return ERR_DATA_NOT_EXISTS;
+    }
+
+    p_elem = ELEM_AT(p_vector, p_vector->p_array, p_vector->count - 1);
+    if (p_data != NULL)
+    {
+        memcpy(p_data, p_elem, p_vector->elemSize);
+    }
+    else
+    {
+        FreeElem(p_vector, p_elem);
+    }
+    LIST_COUNTER_ADD(p_vector->count, -1);
+    OS_MutexUnlock(p_vector->guard);
+
+    return ERR_OK;
+}
+
+int Vector_InsertAt(Vector_t vector, CdataIndex_t index, void* p_data)
+{
+    CHECK_PARAM(vector != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(p_data != NULL, ERR_BAD_PARAM);
+
+    Vector_st* p_vector = TO_VECTOR(vector);
+    int        ret      = ERR_OK;
+
+    OS_MutexLock(p_vector->guard);
+    ret = InsertAtNL(p_vector, index, p_data);
+    OS_MutexUnlock(p_vector->guard);
+
+    return ret;
+}
+
+int Vector_RmAt(Vector_t vector, CdataIndex_t index)
+{
+    CHECK_PARAM(vector != NULL, ERR_BAD_PARAM);
+
+    Vector_st* p_vector = TO_VECTOR(vector);
+    char*      p_elem   = NULL;
+
+    OS_MutexLock(p_vector->guard);
+    if (index >= p_vector->count)
+    {
+        OS_MutexUnlock(p_vector->guard);
+        return ERR_DATA_NOT_EXISTS;
+    }
+
+    p_elem = ELEM_AT(p_vector, p_vector->p_array, index);
+    FreeElem(p_vector, p_elem);
+    memmove(p_elem, p_elem + p_vector->elemSize, (p_vector->count - index - 1) * p_vector->elemSize);
+    LIST_COUNTER_ADD(p_vector->count, -1);
+    OS_MutexUnlock(p_vector->guard);
+
+    return ERR_OK;
+}
+
+void* Vector_GetAt(Vector_t vector, CdataIndex_t index)
+{
+    CHECK_PARAM(vector != NULL, NULL);
+
+    Vector_st* p_vector = TO_VECTOR(vector);
+    void*      p_data   = NULL;
+
+    OS_MutexLock(p_vector->guard);
+    if (index < p_vector->count)
+    {
+        p_data = ELEM_DATA(p_vector, ELEM_AT(p_vector, p_vector->p_array, index));
+    }
+    OS_MutexUnlock(p_vector->guard);
+
+    return p_data;
+}
+
+CdataCount_t Vector_RmByCond(Vector_t vector, void* p_userData, List_Condition_fn conditionFn)
+{
+    CHECK_PARAM(vector != NULL, 0);
+    CHECK_PARAM(conditionFn != NULL, 0);
+
+    Vector_st*   p_vector = TO_VECTOR(vector);
+    char*        p_elem   = NULL;
+    char*        p_keep   = NULL;
+    CdataCount_t i        = 0;
+    CdataCount_t kept     = 0;
+    CdataCount_t removed  = 0;
+
+    //The kept data are moved forward over the removed ones in one pass.
+    OS_MutexLock(p_vector->guard);
+    for (i = 0; i < p_vector->count; i++)
+    {
+        p_elem = ELEM_AT(p_vector, p_vector->p_array, i);
+        if (conditionFn(ELEM_DATA(p_vector, p_elem), p_userData))
+        {
+            FreeElem(p_vector, p_elem);
+            continue;
+        }
+
+        p_keep = ELEM_AT(p_vector, p_vector->p_array, kept);
+        if (p_keep != p_elem)
+        {
+            memcpy(p_keep, p_elem, p_vector->elemSize);
+        }
+        kept++;
+    }
+    removed = p_vector->count - kept;
+    LIST_COUNTER_SET(p_vector->count, kept);
+    OS_MutexUnlock(p_vector->guard);
+
+    return removed;
+}
+
+int Vector_Traverse(Vector_t vector, void* p_userData, List_Traverse_fn traverseFn)
+{
+    CHECK_PARAM(vector != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(traverseFn != NULL, ERR_BAD_PARAM);
+
+    Vector_st*             p_vector = TO_VECTOR(vector);
+    CdataBool              needStop = CDATA_FALSE;
+    ListTraverseNodeInfo_t info;
+
+    info.node = NULL;
+
+    OS_MutexLock(p_vector->guard);
+    for (info.index = 0; info.index < p_vector->count; info.index++)
+    {
+        info.p_data = ELEM_DATA(p_vector, ELEM_AT(p_vector, p_vector->p_array, info.index));
+        traverseFn(&info, p_userData, &needStop);
+        if (needStop)
+        {
+            break;
+        }
+    }
+    OS_MutexUnlock(p_vector->guard);
+
+    return ERR_OK;
+}
+
+int Vector_Sort(Vector_t vector, List_UserLtNode_fn ltFn)
+{
+    CHECK_PARAM(vector != NULL, ERR_BAD_PARAM);
+    CHECK_PARAM(ltFn != NULL, ERR_BAD_PARAM);
+
+    Vector_st*   p_vector = TO_VECTOR(vector);
+    char*        p_src    = NULL;
+    char*        p_dst    = NULL;
+    char*        p_swap   = NULL;
+    CdataCount_t width    = 0;
+    CdataCount_t low      = 0;
+    CdataCount_t mid      = 0;
+    CdataCount_t high     = 0;
+    int          ret      = ERR_OK;
+
+    OS_MutexLock(p_vector->guard);
+    if (p_vector->count < 2)
+    {
+        goto EXIT;
+    }
+
+    //The runs are merged back and forth between the array and a buffer of the same capacity.
+    p_dst = (char*)OS_Malloc(p_vector->capacity * p_vector->elemSize);
+    if (p_dst == NULL)
+    {
+        LOG_E("Not enough memory to sort vector:'%s'.\n", p_vector->name);
+        ret = ERR_OUT_MEM;
+        goto EXIT;
+    }
+
+    p_src = p_vector->p_array;
+    for (width = 1; width < p_vector->count; width *= 2)
+    {
+        for (low = 0; low < p_vector->count; low += 2 * width)
+        {
+            mid  = (low + width < p_vector->count) ? low + width : p_vector->count;
+            high = (low + 2 * width < p_vector->count) ? low + 2 * width : p_vector->count;
+            MergeRange(p_vector, ltFn, p_src, p_dst, low, mid, high);
+        }
+
+        p_swap = p_src;
+        p_src  = p_dst;
+        p_dst  = p_swap;
+    }
+
+    p_vector->p_array = p_src;
+    OS_Free(p_dst);
+
+    EXIT:
+    OS_MutexUnlock(p_vector->guard);
+
+    return ret;
+}
+
+int Vector_Clear(Vector_t vector)
+{
+    CHECK_PARAM(vector != NULL, ERR_BAD_PARAM);
+
+    Vector_st*   p_vector = TO_VECTOR(vector);
+    CdataCount_t i        = 0;
+
+    OS_MutexLock(p_vector->guard);
+    for (i = 0; i < p_vector->count; i++)
+    {
+        FreeElem(p_vector, ELEM_AT(p_vector, p_vector->p_array, i));
+    }
+    LIST_COUNTER_SET(p_vector->count, 0);
+    OS_MutexUnlock(p_vector->guard);
+
+    return ERR_OK;
+}
+
+int Vector_Destroy(Vector_t vector)
+{
+    CHECK_PARAM(vector != NULL, ERR_BAD_PARAM);
+
+    Vector_st* p_vector = TO_VECTOR(vector);
+
+    LOG_I("Destroy '%s'.\n", p_vector->name);
+
+    Vector_Clear(vector);
+    OS_MutexDestroy(p_vector->guard);
+    OS_Free(p_vector->p_array);
+    OS_Free(p_vector);
+
+    return ERR_OK;
+}
+
+/*=============================================================================*
+ *                    Inner function implemention
+ *============================================================================*/
+static Vector_t CreateVector(VectorName_t name, List_DataType_e dataType, int dataLength)
+{
+    Vector_st* p_vector = (Vector_st*)OS_Malloc(sizeof(Vector_st));
+    if (p_vector == NULL)
+    {
+        LOG_E("Have no enough memory.\n");
+        return NULL;
+    }
+    memset(p_vector, 0, sizeof(Vector_st));
+
+    p_vector->guard = OS_MutexCreate();
+    if (p_vector->guard == NULL)
+    {
+        LOG_E("Fail to create vector guard.\n");
+        OS_Free(p_vector);
+        return NULL;
+    }
+
+    strncpy(p_vector->name, name, sizeof(VectorName_t) - 1);
+    p_vector->name[sizeof(VectorName_t) - 1] = '\0';
+
+    p_vector->dataType   = dataType;
+    p_vector->dataLength = dataLength;
+    p_vector->elemSize   = (dataType == LIST_DATA_TYPE_VALUE_REFERENCE) ? sizeof(void*) : (size_t)dataLength;
+    p_vector->p_array    = NULL;
+    p_vector->count      = 0;
+    p_vector->capacity   = 0;
+    p_vector->freeFn     = NULL;
+
+    return (Vector_t)p_vector;
+}
+
+static int ReserveNL(Vector_st* p_vector, CdataCount_t capacity)
+{
+    char* p_array = NULL;
+
+    if (capacity <= p_vector->capacity)
+    {
+        return ERR_OK;
+    }
+
+    p_array = (char*)OS_Realloc(p_vector->p_array, capacity * p_vector->elemSize);
+    if (p_array == NULL)
+    {
+        LOG_E("Not enough memory for %llu data of vector:'%s'.\n", capacity, p_vector->name);
+        return ERR_OUT_MEM;
+    }
+
+    p_vector->p_array = p_array;
+    LIST_COUNTER_SET(p_vector->capacity, capacity);
+
+    return ERR_OK;
+}
+
+static int InsertAtNL(Vector_st* p_vector, CdataIndex_t index, void* p_data)
+{
+    char* p_elem = NULL;
+    int   ret    = ERR_OK;
+
+    if (index > p_vector->count)
+    {
+        LOG_E("Index:%llu is out of vector:'%s', count:%llu.\n", index, p_vector->name, p_vector->count);
+        return ERR_BAD_PARAM;
+    }
+
+    if (p_vector->count == p_vector->capacity)
+    {
+        ret = ReserveNL(p_vector, (p_vector->capacity < VECTOR_MIN_CAPACITY) ? VECTOR_MIN_CAPACITY : p_vector->capacity * 2);
+        if (ret != ERR_OK)
+        {
+            return ret;
+        }
+    }
+
+    p_elem = ELEM_AT(p_vector, p_vector->p_array, index);
+    if (index < p_vector->count)
+    {
+        memmove(p_elem + p_vector->elemSize, p_elem, (p_vector->count - index) * p_vector->elemSize);
+    }
+
+    if (p_vector->dataType == LIST_DATA_TYPE_VALUE_REFERENCE)
+    {
+        *(void**)p_elem = p_data;
+    }
+    else
+    {
+        memcpy(p_elem, p_data, p_vector->dataLength);
+    }
+    LIST_COUNTER_ADD(p_vector->count, 1);
+
+    return ERR_OK;
+}
+
+static void FreeElem(Vector_st* p_vector, void* p_elem)
+{
+    void* p_data = ELEM_DATA(p_vector, p_elem);
+
+    if (p_vector->dataType == LIST_DATA_TYPE_VALUE_REFERENCE)
+    {
+        if (p_data == NULL)
+        {
+            return;
+        }
+
+        if (p_vector->freeFn != NULL)
+        {
+            p_vector->freeFn(p_data);
+        }
+        else
+        {
+            OS_Free(p_data);
+        }
+        return;
+    }
+
+    if (p_vector->freeFn == NULL)
+    {
+        return;
+    }
+
+    //freeFn may free the data itself, so give it a copy which is allocated by malloc, same as cdata_list.
+    void* p_copy = OS_Malloc(p_vector->dataLength);
+    if (p_copy == NULL)
+    {
+        LOG_E("Not enough memory to free data of vector:'%s'.\n", p_vector->name);
+        return;
+    }
+    memcpy(p_copy, p_data, p_vector->dataLength);
+    p_vector->freeFn(p_copy);
+}
+
+//Merge [low, mid) and [mid, high) of p_src into p_dst, the right one is taken only if it's less than the left one.
+static void MergeRange(Vector_st* p_vector, List_UserLtNode_fn ltFn, char* p_src, char* p_dst, CdataCount_t low, CdataCount_t mid, CdataCount_t high)
+{
+    CdataCount_t left  = low;
+    CdataCount_t right = mid;
+    CdataCount_t out   = low;
+    char*        p_left  = NULL;
+    char*        p_right = NULL;
+
+    while (left < mid && right < high)
+    {
+        p_left  = ELEM_AT(p_vector, p_src, left);
+        p_right = ELEM_AT(p_vector, p_src, right);
+        if (ltFn(ELEM_DATA(p_vector, p_left), ELEM_DATA(p_vector, p_right)))
+        {
+            memcpy(ELEM_AT(p_vector, p_dst, out++), p_right, p_vector->elemSize);
+            right++;
+        }
+        else
+        {
+            memcpy(ELEM_AT(p_vector, p_dst, out++), p_left, p_vector->elemSize);
+            left++;
+        }
+    }
+
+    if (left < mid)
+    {
+        memcpy(ELEM_AT(p_vector, p_dst, out), ELEM_AT(p_vector, p_src, left), (mid - left) * p_vector->elemSize);
+    }
+    else if (right < high)
+    {
+        memcpy(ELEM_AT(p_vector, p_dst, out), ELEM_AT(p_vector, p_src, right), (high - right) * p_vector->elemSize);
+    }
+}
+
+/*=============================================================================*
+ *                                End of file
+ *============================================================================*/
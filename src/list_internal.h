@@ -1,8 +1,18 @@
 #ifndef _LIST_INTERNAL_H_
 #define _LIST_INTERNAL_H_
 
+#include <stdint.h>
+#include <string.h>
+
 #include "cdata_types.h"
 #include "cdata_list.h"
+#include "cdata_pool.h"
+#include "cdata_posindex.h"
+#include "cdata_hashindex.h"
+#include "cdata_keycolumn.h"
+#include "cdata_skipindex.h"
+#include "cdata_rcu.h"
+#include "cdata_ulist.h"
 
 typedef enum
 {
@@ -11,8 +21,18 @@ typedef enum
 
     //List don't allocate memory for the data of the node.
     LIST_DATA_TYPE_VALUE_REFERENCE,
+
+    //The node is the CdataLink_t embedded in the data, list allocates nothing.
+    LIST_DATA_TYPE_INTRUSIVE,
 } List_DataType_e;
 
+typedef struct
+{
+    ListKeyKind_e kind;
+    size_t        offset;
+    size_t        length;
+}ListKeyField_st;
+
 typedef struct _List_
 {
 	ListType_e	   		    type;
@@ -24,21 +44,73 @@ typedef struct _List_
     int 				    dataLength;
 
     OSMutex_t 			    guard;
+
+    //Not NULL if the list is created with LIST_LOCK_RW, it's used instead of guard.
+    OSRWLock_t              rwGuard;
     List_FreeData_fn 	    freeFn;
 	List_Equal2Keyword_fn   equal2KeywordFn;
 	List_NodeEqual_fn       nodeEqualFn;
 	
 	List_UserLtNode_fn      usrLtNodeFn;
 
+    //The built-in compare and hash of the key field are used instead of the functions above if kind is not LIST_KEY_NONE.
+    ListKeyField_st         keyField;
+
+    //The counters are only changed with the list locked, but they are read without lock, see LIST_COUNTER_*.
     CdataCount_t 		    nodeCount;
+    CdataCount_t            linkedTotal;
+    CdataCount_t            unlinkedTotal;
     ListName_t 		        name;
+
+    //Not NULL if the list allocates nodes from its own pool.
+    NodePool_t              pool;
+
+    //Offset of the data stored in the same memory with the node, 0 means data is not stored with node.
+    size_t                  dataOffset;
+
+    //The offset of CdataLink_t in the data, only used by LIST_DATA_TYPE_INTRUSIVE.
+    size_t                  linkOffset;
+
+    //Memory size of the node, including the extension fields behind the link fields.
+    size_t                  nodeSize;
+
+    //Order-statistics index for the *AtPos functions, posIndex.offset is 0 if not used.
+    PosIndex_st             posIndex;
+
+    //Hash index for the keyword lookups, NULL if not used.
+    HashIndex_st*           p_hashIndex;
+    List_DataHash_fn        nodeHashFn;
+    List_DataHash_fn        keywordHashFn;
+
+    //Integer keys of the nodes in the list order for the keyword lookups, keyColumn.keyLength is 0 if not used.
+    KeyColumn_st            keyColumn;
+
+    //Skip list towers for the ordered inserts and searches, only used if sortOrder is not LIST_SORT_NONE.
+    ListSortOrder_e         sortOrder;
+    SkipIndex_st            skipIndex;
+
+    //Not NULL if the list is created with LIST_LOCK_RCU, the destroyed nodes wait here for the lock-free readers.
+    RcuRetireList_t         retireList;
+
+    //The blocks of slots which hold the data, only used by LIST_TYPE_UNROLLED.
+    UListBlocks_st          blocks;
+
+    //The open cursors, they are moved off the nodes which are unlinked.
+    ListCursor_t*           p_cursors;
+
+    //Bumped when a node is linked, unlinked or the order changes, it makes the position cursors stale.
+    CdataCount_t            modCount;
+
+    //The node of the last ordered insert, the next one searches from it. It's cleared when the node is unlinked.
+    void*                   p_finger;
 }List_st;
 
+//The double list node begins with the single list node, the same as CdataLink_t.
 typedef struct _DBListNode_s
 {
     struct _DBListNode_s* p_next;
-    struct _DBListNode_s* p_pre;
     void* p_data;
+    struct _DBListNode_s* p_pre;
 }DBListNode_st;
 
 typedef struct _SGListNode_s
@@ -47,8 +119,172 @@ typedef struct _SGListNode_s
     void* p_data;
 }SGListNode_st;
 
+//The data stored behind the node is aligned as malloc does.
+#define LIST_NODE_DATA_ALIGN (2 * sizeof(void*))
+
 #define CONVERT_2_LIST(_list_) (List_st*)(_list_)
 #define CONVERT_2_DBLIST_NODE(node) (struct _DBListNode_s*)(node)
 #define CONVERT_2_SGLIST_NODE(node) (struct _SGListNode_s*)(node)
 
+//The detached nodes are chained by p_next, both single and double list node begin with it.
+#define LIST_CHAIN_NEXT(_node_)    (((SGListNode_st*)(_node_))->p_next)
+
+//Store a link which makes a new node reachable, the node must be fully set up before it can be seen.
+#define LIST_PUBLISH(_link_, _node_) __atomic_store_n(&(_link_), (_node_), __ATOMIC_RELEASE)
+
+//The writers are serialized by the list lock, an atomic store is enough, the readers never see a torn value.
+#define LIST_COUNTER_GET(_counter_)          __atomic_load_n(&(_counter_), __ATOMIC_RELAXED)
+#define LIST_COUNTER_SET(_counter_, _value_) __atomic_store_n(&(_counter_), (_value_), __ATOMIC_RELAXED)
+#define LIST_COUNTER_ADD(_counter_, _delta_) LIST_COUNTER_SET(_counter_, (_counter_) + (_delta_))
+
+#define LIST_HAS_POS_INDEX(_list_) ((_list_)->posIndex.offset != 0)
+#define LIST_IS_SORTED(_list_)     ((_list_)->sortOrder != LIST_SORT_NONE)
+#define LIST_HAS_KEY_COLUMN(_list_) ((_list_)->keyColumn.keyLength != 0)
+
+//The node of the intrusive list is the link at linkOffset of the data.
+#define LIST_INTRUSIVE_NODE(_list_, _data_) ((void*)((char*)(_data_) + (_list_)->linkOffset))
+#define LIST_INLINE_DATA(_list_, _node_) ((void*)((char*)(_node_) + (_list_)->dataOffset))
+//The node of the unrolled list is the data itself, its dataOffset is 0.
+#define LIST_IS_INLINE_DATA(_list_, _node_, _data_) \
+    (((_list_)->dataOffset != 0 || (_list_)->type == LIST_TYPE_UNROLLED) && (_data_) != NULL && (_data_) == LIST_INLINE_DATA(_list_, _node_))
+
+#define LIST_HAS_KEY_FIELD(_list_)       ((_list_)->keyField.kind != LIST_KEY_NONE)
+#define LIST_KEY_OF(_list_, _data_)      ((const char*)(_data_) + (_list_)->keyField.offset)
+
+#define LIST_CAN_MATCH_KEYWORD(_list_)   ((_list_)->equal2KeywordFn != NULL || LIST_HAS_KEY_FIELD(_list_))
+#define LIST_CAN_COMPARE_EQUAL(_list_)   ((_list_)->nodeEqualFn != NULL || LIST_HAS_KEY_FIELD(_list_))
+#define LIST_CAN_COMPARE_ORDER(_list_)   ((_list_)->usrLtNodeFn != NULL || LIST_HAS_KEY_FIELD(_list_))
+
+//The new data goes before the node in an ascending(descending) list if it's less(not less) than the node data.
+#define LIST_GOES_BEFORE(_list_, _nodeData_, _newData_, _isAsc_) \
+    (!List_IsUserLtNode((_list_), (_nodeData_), (_newData_)) == !(_isAsc_))
+
+/*
+ * The compare functions are inlined into the loops which search the list, they return like memcmp.
+ * The kind is the same for all the nodes, so the switch is always predicted.
+ * The data of a node is NULL after List_DetachNodeData, it has no key, so it never matches and is never
+ * less than the others, the same as ScanKeyFieldNL skips it.
+ */
+static inline int List_CompareKeys(const List_st* p_list, const void* p_firstKey, const void* p_secondKey)
+{
+    int32_t  first32  = 0;
+    int32_t  second32 = 0;
+    int64_t  first64  = 0;
+    int64_t  second64 = 0;
+    uint64_t firstU64 = 0;
+    uint64_t secondU64 = 0;
+
+    switch (p_list->keyField.kind)
+    {
+        case LIST_KEY_INT32:
+            memcpy(&first32, p_firstKey, sizeof(int32_t));
+            memcpy(&second32, p_secondKey, sizeof(int32_t));
+            return (first32 > second32) - (first32 < second32);
+
+        case LIST_KEY_INT64:
+            memcpy(&first64, p_firstKey, sizeof(int64_t));
+            memcpy(&second64, p_secondKey, sizeof(int64_t));
+            return (first64 > second64) - (first64 < second64);
+
+        case LIST_KEY_UINT64:
+            memcpy(&firstU64, p_firstKey, sizeof(uint64_t));
+            memcpy(&secondU64, p_secondKey, sizeof(uint64_t));
+            return (firstU64 > secondU64) - (firstU64 < secondU64);
+
+        case LIST_KEY_BYTES:
+            return memcmp(p_firstKey, p_secondKey, p_list->keyField.length);
+
+        default:
+            return strncmp((const char*)p_firstKey, (const char*)p_secondKey, p_list->keyField.length);
+    }
+}
+
+static inline CdataBool List_MatchKeyword(const List_st* p_list, void* p_nodeData, void* p_keyword)
+{
+    if (!LIST_HAS_KEY_FIELD(p_list))
+    {
+        return p_list->equal2KeywordFn(p_nodeData, p_keyword);
+    }
+
+    return p_nodeData != NULL && List_CompareKeys(p_list, LIST_KEY_OF(p_list, p_nodeData), p_keyword) == 0;
+}
+
+static inline CdataBool List_IsDataEqual(const List_st* p_list, void* p_firstNodeData, void* p_secondNodeData)
+{
+    if (!LIST_HAS_KEY_FIELD(p_list))
+    {
+        return p_list->nodeEqualFn(p_firstNodeData, p_secondNodeData);
+    }
+
+    if (p_firstNodeData == NULL || p_secondNodeData == NULL)
+    {
+        return CDATA_FALSE;
+    }
+
+    return List_CompareKeys(p_list, LIST_KEY_OF(p_list, p_firstNodeData), LIST_KEY_OF(p_list, p_secondNodeData)) == 0;
+}
+
+//The same as List_UserLtNode_fn: tell if p_userData < p_nodeData.
+static inline CdataBool List_IsUserLtNode(const List_st* p_list, void* p_nodeData, void* p_userData)
+{
+    if (!LIST_HAS_KEY_FIELD(p_list))
+    {
+        return p_list->usrLtNodeFn(p_nodeData, p_userData);
+    }
+
+    if (p_nodeData == NULL || p_userData == NULL)
+    {
+        return CDATA_FALSE;
+    }
+
+    return List_CompareKeys(p_list, LIST_KEY_OF(p_list, p_userData), LIST_KEY_OF(p_list, p_nodeData)) < 0;
+}
+
+/*
+ * Lock the list in shared mode as List_ReadLock does, except LIST_LOCK_RCU whose read section only
+ * covers the calling thread and doesn't keep the writers out, so it takes the writer lock.
+ */
+static inline void List_SharedLock(List_t list)
+{
+    if ((CONVERT_2_LIST(list))->retireList != NULL)
+    {
+        List_Lock(list);
+        return;
+    }
+
+    List_ReadLock(list);
+}
+
+static inline void List_SharedUnLock(List_t list)
+{
+    if ((CONVERT_2_LIST(list))->retireList != NULL)
+    {
+        List_UnLock(list);
+        return;
+    }
+
+    List_ReadUnLock(list);
+}
+
+/*
+ * Called by the single and double list implementation after a node is linked into or unlinked
+ * from the list, so the node count and the indexes of the list can be kept in step.
+ */
+void List_OnNodeLinked(List_st* p_list, void* p_node);
+void List_OnNodeUnlinked(List_st* p_list, void* p_node);
+
+/*
+ * Called instead of the node hooks when a run of count nodes is moved between lists, only the
+ * counters and the cursors are changed, so the lists which have indexes can't move runs.
+ * The unlinked run first..last is still chained, nextNode is the node which was after last.
+ */
+void List_OnRunLinked(List_st* p_list, CdataCount_t count);
+void List_OnRunUnlinked(List_st* p_list, ListNode_t first, ListNode_t last, ListNode_t nextNode, CdataCount_t count);
+
+/*
+ * Detach the nodes whose marks are not 0, p_marks has one mark for each node in the list order.
+ * The detached nodes are chained as List_DetachAllMatchNodes does, the list must be locked.
+ */
+ListNode_t List_DetachMarkedChainNL(List_st* p_list, const unsigned char* p_marks, CdataCount_t* p_count);
+
 #endif //_LIST_INTERNAL_H_
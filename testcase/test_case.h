@@ -3,7 +3,7 @@
 
 typedef struct
 {
-    char *p_name;
+    const char *p_name;
     void (*Init)(void);
     void (*Show)(void);
     void (*Run)(int id);
@@ -15,7 +15,7 @@ typedef int (*TestcaseFn_t)(void);
 
 typedef struct
 {
-    char *p_description;
+    const char *p_description;
     TestcaseFn_t testcaseFn;
 }Testcase_t;
 
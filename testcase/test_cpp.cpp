@@ -0,0 +1,377 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <deque>
+#include <list>
+#include <memory>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cdata.hpp"
+#include "test_case.h"
+
+#ifndef _DEBUG_LEVEL_
+#define _DEBUG_LEVEL_  _DEBUG_LEVEL_I_
+#endif
+#include "debug.h"
+
+
+//=============================================================================
+static void Init(void);
+static void Show(void);
+static void Run(int id);
+static int GetTestcaseCount(void);
+static void Finalize(void);
+
+static int TestCppList();
+static int TestCppQueue();
+static int TestCppBenchmark();
+
+
+//=============================================================================
+extern "C" TestcaseSet_t CppTestcaseSet;
+
+TestcaseSet_t CppTestcaseSet =
+{
+    "Test all C++ template functions.",
+    Init,
+    Show,
+    Run,
+    GetTestcaseCount,
+    Finalize
+};
+
+static Testcase_t g_testcaseArray[] =
+{
+    {"Test C++ list.", TestCppList},
+    {"Test C++ queue and priority queue.", TestCppQueue},
+    {"Benchmark C++ templates with std::list, std::deque and std::priority_queue.", TestCppBenchmark},
+};
+
+//=============================================================================
+static void Init(void)
+{
+    return;
+}
+
+static void Show(void)
+{
+    int i = 0;
+
+    printf("\n==============================================\n");
+    for (i = 0; i < (int)(sizeof(g_testcaseArray) / sizeof(g_testcaseArray[0])); i++)
+    {
+        printf("%d: %s\n", i, g_testcaseArray[i].p_description);
+    }
+    printf("==============================================\n");
+
+}
+static void Run(int id)
+{
+    if (id < 0 || id >= (int)(sizeof(g_testcaseArray) / sizeof(g_testcaseArray[0])))
+    {
+        return;
+    }
+
+    int ret = g_testcaseArray[id].testcaseFn();
+    if (ret == 0)
+    {
+        printf("Testcase %d passed.\n", id);
+    }
+    else
+    {
+        printf("Testcase %d failed.\n", id);
+    }
+
+}
+
+static int GetTestcaseCount(void)
+{
+    return sizeof(g_testcaseArray) / sizeof(g_testcaseArray[0]);
+}
+
+static void Finalize(void)
+{
+    return;
+}
+
+//=============================================================================
+typedef std::pair<int, int> KeySeq_t;
+
+//Only the key is compared, the seq tells the insert order.
+struct KeyLess
+{
+    bool operator()(const KeySeq_t& first, const KeySeq_t& second) const
+    {
+        return first.first < second.first;
+    }
+};
+
+#define CPP_BENCH_COUNT          1000000
+#define CPP_BENCH_PRIQUEUE_COUNT 100000
+#define CPP_BENCH_PRIORITY       16
+
+static double GetNowSeconds()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1000000000.0;
+}
+
+static int TestCppList()
+{
+    cdata::List<std::string> names;
+    std::string              name;
+    std::string              all;
+
+    names.emplace_back(3, 'b');
+    names.push_back(std::string("ccc"));
+    names.emplace_front("aaa");
+    name = "ddd";
+    names.push_back(std::move(name));
+
+    {
+        cdata::List<std::string>::Lock guard = names.lock();
+        for (cdata::List<std::string>::iterator it = names.begin(); it != names.end(); ++it)
+        {
+            all += *it;
+        }
+
+        cdata::List<std::string>::iterator it = names.end();
+        --it;
+        if (all != "aaabbbcccddd" || names.front() != "aaa" || names.back() != "ddd" || *it != "ddd" || it->size() != 3)
+        {
+            LOG_E("Wrong data in list:%s.\n", all.c_str());
+            return -1;
+        }
+
+        it = names.erase(names.begin());
+        if (*it != "bbb")
+        {
+            LOG_E("Wrong data after erasing head:%s.\n", it->c_str());
+            return -1;
+        }
+    }
+
+    if (names.size() != 3 || names.count_if([](const std::string& data) { return data[0] >= 'c'; }) != 2
+        || names.remove_if([](const std::string& data) { return data == "ccc"; }) != 1 || names.any_of([](const std::string& data) { return data == "ccc"; }))
+    {
+        LOG_E("Wrong result of the predicates.\n");
+        return -1;
+    }
+
+    if (!names.pop_front(&name) || name != "bbb" || !names.pop_front() || names.pop_front() || !names.empty())
+    {
+        LOG_E("Wrong result of pop_front.\n");
+        return -1;
+    }
+
+    //The move-only data are moved in and out, they can never go through a memcpy.
+    cdata::List<std::unique_ptr<int>, cdata::SingleLinkPolicy> ptrs;
+    std::unique_ptr<int> p_value;
+    int                  i = 0;
+
+    for (i = 0; i < 100; i++)
+    {
+        ptrs.emplace_back(new int(i));
+    }
+    if (ptrs.remove_if([](const std::unique_ptr<int>& p_data) { return *p_data % 2 == 1; }) != 50)
+    {
+        LOG_E("Wrong count of removed odd data.\n");
+        return -1;
+    }
+    for (i = 0; ptrs.pop_front(&p_value); i += 2)
+    {
+        if (*p_value != i)
+        {
+            LOG_E("Wrong data:%d, expected:%d.\n", *p_value, i);
+            return -1;
+        }
+    }
+
+    return (i == 100) ? 0 : -1;
+}
+
+static int TestCppQueue()
+{
+    cdata::Queue<std::unique_ptr<int> > queue;
+    std::unique_ptr<int>                p_value;
+    cdata::PriQueue<KeySeq_t, KeyLess>  priQueue;
+    KeySeq_t                            item;
+    KeySeq_t                            pre;
+    int                                 i = 0;
+
+    for (i = 1; i < 100; i++)
+    {
+        queue.push(std::unique_ptr<int>(new int(i)));
+    }
+    queue.push_front(std::unique_ptr<int>(new int(0)));
+
+    for (i = 0; i < 100; i++)
+    {
+        if (!queue.try_pop(p_value) || *p_value != i)
+        {
+            LOG_E("Wrong data popped, expected:%d.\n", i);
+            return -1;
+        }
+    }
+    if (queue.try_pop(p_value) || queue.pop(p_value, 10) || !queue.empty())
+    {
+        LOG_E("Queue should be empty.\n");
+        return -1;
+    }
+
+    //The greater key is popped first, the equal keys are first in first out.
+    for (i = 0; i < 1000; i++)
+    {
+        priQueue.emplace((i * 7919) % 10, i);
+    }
+    if (priQueue.size() != 1000 || !priQueue.top(pre) || pre.first != 9)
+    {
+        LOG_E("Wrong top of priority queue.\n");
+        return -1;
+    }
+
+    for (i = 0; priQueue.pop(&item); i++, pre = item)
+    {
+        if (i > 0 && (pre.first < item.first || (pre.first == item.first && pre.second > item.second)))
+        {
+            LOG_E("Wrong order, key:%d, seq:%d.\n", item.first, item.second);
+            return -1;
+        }
+    }
+
+    return (i == 1000) ? 0 : -1;
+}
+
+static int TestCppBenchmark()
+{
+    double begin = 0;
+    double times[2];
+    long   sums[2] = {0, 0};
+    int    value = 0;
+    int    i = 0;
+
+    begin = GetNowSeconds();
+    {
+        cdata::List<int> list;
+        for (i = 0; i < CPP_BENCH_COUNT; i++)
+        {
+            list.push_back(i);
+        }
+        cdata::List<int>::Lock guard = list.lock();
+        for (cdata::List<int>::iterator it = list.begin(); it != list.end(); ++it)
+        {
+            sums[0] += *it;
+        }
+    }
+    times[0] = GetNowSeconds() - begin;
+
+    begin = GetNowSeconds();
+    {
+        std::list<int> list;
+        for (i = 0; i < CPP_BENCH_COUNT; i++)
+        {
+            list.push_back(i);
+        }
+        for (std::list<int>::iterator it = list.begin(); it != list.end(); ++it)
+        {
+            sums[1] += *it;
+        }
+    }
+    times[1] = GetNowSeconds() - begin;
+
+    if (sums[0] != sums[1])
+    {
+        LOG_E("Wrong sum of list:%ld, %ld.\n", sums[0], sums[1]);
+        return -1;
+    }
+    LOG_A("Push and visit %d int, cdata::List:%.3fs, std::list:%.3fs.\n", CPP_BENCH_COUNT, times[0], times[1]);
+
+    sums[0] = sums[1] = 0;
+    begin = GetNowSeconds();
+    {
+        cdata::Queue<int> queue;
+        for (i = 0; i < CPP_BENCH_COUNT; i++)
+        {
+            queue.push(i);
+        }
+        while (queue.try_pop(value))
+        {
+            sums[0] += value;
+        }
+    }
+    times[0] = GetNowSeconds() - begin;
+
+    begin = GetNowSeconds();
+    {
+        std::deque<int> queue;
+        for (i = 0; i < CPP_BENCH_COUNT; i++)
+        {
+            queue.push_back(i);
+        }
+        while (!queue.empty())
+        {
+            sums[1] += queue.front();
+            queue.pop_front();
+        }
+    }
+    times[1] = GetNowSeconds() - begin;
+
+    if (sums[0] != sums[1])
+    {
+        LOG_E("Wrong sum of queue:%ld, %ld.\n", sums[0], sums[1]);
+        return -1;
+    }
+    LOG_A("Push and pop %d int, cdata::Queue:%.3fs, std::deque:%.3fs.\n", CPP_BENCH_COUNT, times[0], times[1]);
+
+    std::vector<int> values(CPP_BENCH_PRIQUEUE_COUNT);
+    for (i = 0; i < CPP_BENCH_PRIQUEUE_COUNT; i++)
+    {
+        values[i] = rand() % CPP_BENCH_PRIORITY;
+    }
+
+    sums[0] = sums[1] = 0;
+    begin = GetNowSeconds();
+    {
+        cdata::PriQueue<int> priQueue;
+        for (i = 0; i < CPP_BENCH_PRIQUEUE_COUNT; i++)
+        {
+            priQueue.push(values[i]);
+        }
+        for (i = 0; priQueue.pop(&value); i++)
+        {
+            sums[0] += (long)value * i;
+        }
+    }
+    times[0] = GetNowSeconds() - begin;
+
+    begin = GetNowSeconds();
+    {
+        std::priority_queue<int> priQueue;
+        for (i = 0; i < CPP_BENCH_PRIQUEUE_COUNT; i++)
+        {
+            priQueue.push(values[i]);
+        }
+        for (i = 0; !priQueue.empty(); i++)
+        {
+            sums[1] += (long)priQueue.top() * i;
+            priQueue.pop();
+        }
+    }
+    times[1] = GetNowSeconds() - begin;
+
+    if (sums[0] != sums[1])
+    {
+        LOG_E("Wrong pop order of priority queue:%ld, %ld.\n", sums[0], sums[1]);
+        return -1;
+    }
+    LOG_A("Push and pop %d data with %d priorities, cdata::PriQueue:%.3fs, std::priority_queue:%.3fs.\n",
+        CPP_BENCH_PRIQUEUE_COUNT, CPP_BENCH_PRIORITY, times[0], times[1]);
+
+    return 0;
+}
@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include <pthread.h>
 #include <unistd.h>
+#include <string.h>
+#include <time.h>
 
 #include "cdata.h"
 #include "test_case.h"
@@ -46,6 +48,7 @@ static int DestroyList();
 static int ChangeListType();
 
 static void FreeStudentData(void* p_data);
+static void FreeStudentName(void* p_data);
 CdataBool SortedByTotalScore(void* p_listNodeData, void* p_userData);
 CdataBool StudentIsEqual(void* p_listNodeData, void* p_userData);
 CdataBool StudentIsDuplicate(void* p_firstNodeData, void* p_secondNodeData);
@@ -69,6 +72,30 @@ static int TestMatchByCond();
 static int TestMultiThread();
 static int TestMultiThreadLock();
 
+static int TestNodePool();
+static int BenchmarkNodePool();
+
+static int TestPositionIndex();
+static int TestHashIndex();
+static int TestSortedList();
+static int TestIterDetach();
+static int TestDetachChain();
+static int TestRWLockList();
+static int TestRcuList();
+static int TestCountPolling();
+static int TestBatchInsert();
+static int TestDetachHeadBatch();
+static int TestSpliceList();
+static int TestListSort();
+static int TestUnrolledList();
+static int TestKeyColumn();
+static int TestKeyField();
+static int TestParallel();
+static int TestChunkedTraverse();
+static int TestPosCursor();
+static int TestFingerInsert();
+static int TestIntrusiveList();
+
 //=========================================================================
 static Testcase_t g_testcaseArray[] =
 {
@@ -84,6 +111,28 @@ static Testcase_t g_testcaseArray[] =
 	{"Test match by condition in list.", TestMatchByCond},
 	{"Test multi thread.", TestMultiThread},
 	{"Test multi thread with List_Lock", TestMultiThreadLock},
+	{"Test list with node pool.", TestNodePool},
+	{"Benchmark list with and without node pool.", BenchmarkNodePool},
+	{"Test position index of list.", TestPositionIndex},
+	{"Test hash index of list.", TestHashIndex},
+	{"Test sorted list with skip index.", TestSortedList},
+	{"Test detaching with iterator and pre node.", TestIterDetach},
+	{"Test detaching matched nodes as a chain.", TestDetachChain},
+	{"Benchmark multi-reader list with mutex and rwlock.", TestRWLockList},
+	{"Test lock-free readers of RCU list.", TestRcuList},
+	{"Benchmark producer with a count polling thread.", TestCountPolling},
+	{"Test and benchmark batch insert.", TestBatchInsert},
+	{"Test and benchmark batch detach from head.", TestDetachHeadBatch},
+	{"Test splice, concat and split of lists.", TestSpliceList},
+	{"Test and benchmark merge sort of list.", TestListSort},
+	{"Test and benchmark unrolled list.", TestUnrolledList},
+	{"Test and benchmark key column lookup.", TestKeyColumn},
+	{"Test and benchmark key field descriptor.", TestKeyField},
+	{"Test and benchmark parallel algorithms.", TestParallel},
+	{"Test and benchmark chunked traverse with cursor.", TestChunkedTraverse},
+	{"Test and benchmark positional access with cursor.", TestPosCursor},
+	{"Test and benchmark ordered insert of nearly sorted data.", TestFingerInsert},
+	{"Test and benchmark intrusive list.", TestIntrusiveList},
 };
 
 static ListType_e g_listType;
@@ -612,6 +661,12 @@ static void FreeStudentData(void* p_data)
 	return ;
 }
 
+//For the data stored in the node memory, only the name belongs to the data.
+static void FreeStudentName(void* p_data)
+{
+	free(((Student_t*)p_data)->p_name);
+}
+
 static void PrintStudent(Student_t *p_student)
 {
 	int total = p_student->chineseScore + p_student->mathScore + p_student->englishScore;
@@ -1349,8 +1404,3048 @@ static int TestMultiThreadLock()
 	return 0;
 }
 
-/*=============================================================================*
- *                                End of file
- *============================================================================*/
+static double GetNowSeconds()
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1000000000.0;
+}
+
+static int TestNodePool()
+{
+	ListAttr_t attr;
+	List_t     list = NULL;
+	ListNode_t node = NULL;
+	Student_t  student;
+	Student_t* p_student = NULL;
+	int*       p_value = NULL;
+	int        value = 0;
+	int        i = 0;
+
+	List_AttrInit(&attr);
+	attr.poolChunkNodes = 4;
+
+	if (List_CreateWithAttr("PoolIntList", g_listType, sizeof(int), &attr, &list) != ERR_OK)
+	{
+		LOG_E("Fail to create pool list.\n");
+		return -1;
+	}
+	List_SetUserLtNodeFunc(list, IntLtListData);
+	List_SetEqual2KeywordFunc(list, IntEqualListData);
+
+	//More nodes than a chunk, and recycle them several times.
+	for (i = 0; i < 3; i++)
+	{
+		for (value = 10; value > 0; value--)
+		{
+			List_InsertDataAsc(list, &value);
+		}
+
+		value = 5;
+		List_RmFirstMatchNode(list, &value);
+		if (List_Count(list) != 9 || *(int*)List_GetHeadData(list) != 1 || *(int*)List_GetTailData(list) != 10)
+		{
+			LOG_E("Wrong data in pool list.\n");
+			List_Destroy(list);
+			return -1;
+		}
+
+		List_Swap(list, List_GetHead(list), List_GetTail(list));
+		if (*(int*)List_GetHeadData(list) != 10 || *(int*)List_GetTailData(list) != 1)
+		{
+			LOG_E("Fail to swap data in pool list.\n");
+			List_Destroy(list);
+			return -1;
+		}
+
+		//The detached data must be a copy which user can free.
+		p_value = (int*)List_DetachHeadData(list);
+		if (p_value == NULL || *p_value != 10)
+		{
+			LOG_E("Fail to detach data from pool list.\n");
+			List_Destroy(list);
+			return -1;
+		}
+		free(p_value);
+
+		List_Clear(list);
+	}
+	ShowIntList(list);
+	List_Destroy(list);
+
+	//The freeFn gets the data in the pool slot, it only frees the name.
+	if (List_CreateWithAttr("PoolStudentList", g_listType, sizeof(Student_t), &attr, &list) != ERR_OK)
+	{
+		LOG_E("Fail to create pool list.\n");
+		return -1;
+	}
+	List_SetFreeDataFunc(list, FreeStudentName);
+
+	for (i = 0; i < 6; i++)
+	{
+		memset(&student, 0, sizeof(Student_t));
+		student.p_name = (char*)malloc(64);
+		sprintf(student.p_name, "Student-%d", i + 1);
+		student.sex = 'M';
+		student.age = 10 + i;
+		List_InsertData(list, &student);
+	}
+
+	List_RmHead(list);
+	node = List_GetHead(list);
+	p_student = (Student_t*)List_GetNodeData(list, node);
+	if (p_student == NULL || strcmp(p_student->p_name, "Student-2") != 0)
+	{
+		LOG_E("Wrong data in pool student list.\n");
+		List_Destroy(list);
+		return -1;
+	}
+	List_Destroy(list);
+
+	//The reference list only puts the nodes into the pool.
+	if (List_CreateRefWithAttr("PoolRefList", g_listType, &attr, &list) != ERR_OK)
+	{
+		LOG_E("Fail to create pool reference list.\n");
+		return -1;
+	}
+	List_SetFreeDataFunc(list, FreeStudentData);
+	p_student = CreateStudent("Student-Ref", 'F', 12, 90, 90, 90);
+	List_InsertData(list, p_student);
+	if (List_GetHeadData(list) != p_student)
+	{
+		LOG_E("Wrong data in pool reference list.\n");
+		List_Destroy(list);
+		return -1;
+	}
+	List_Destroy(list);
+
+	return 0;
+}
+
+#define CHURN_DATA_SIZE 64
+
+static double BenchmarkChurn(List_t list, int rounds, int batch)
+{
+	double begin = 0;
+	char   data[CHURN_DATA_SIZE];
+	int    i = 0;
+	int    j = 0;
+
+	//The list copies CHURN_DATA_SIZE bytes for each insert.
+	memset(data, 0, sizeof(data));
+	begin = GetNowSeconds();
+	for (i = 0; i < rounds; i++)
+	{
+		for (j = 0; j < batch; j++)
+		{
+			memcpy(data, &j, sizeof(j));
+			List_InsertData(list, data);
+		}
+
+		for (j = 0; j < batch; j++)
+		{
+			List_RmHead(list);
+		}
+	}
+
+	return (2.0 * rounds * batch) / (GetNowSeconds() - begin);
+}
+
+static int BenchmarkNodePool()
+{
+	ListAttr_t attr;
+	List_t     list = NULL;
+	double     mallocOps = 0;
+	double     poolOps = 0;
+	int        rounds = 2000;
+	int        batch = 1000;
+
+	List_AttrInit(&attr);
+
+	List_Create("MallocList", g_listType, CHURN_DATA_SIZE, &list);
+	mallocOps = BenchmarkChurn(list, rounds, batch);
+	List_Destroy(list);
+
+	attr.poolChunkNodes = 1024;
+	List_CreateWithAttr("PoolList", g_listType, CHURN_DATA_SIZE, &attr, &list);
+	poolOps = BenchmarkChurn(list, rounds, batch);
+	List_Destroy(list);
+
+	LOG_A("%s list, insert then rm head %d nodes for %d rounds, data size %d bytes:\n",
+		g_listType == LIST_TYPE_DOUBLE_LINK ? "Double link" : "Single link", batch, rounds, CHURN_DATA_SIZE);
+	LOG_A("  malloc:%.0f ops/sec.\n", mallocOps);
+	LOG_A("  pool  :%.0f ops/sec, %.2fx.\n", poolOps, poolOps / mallocOps);
+
+	return 0;
+}
+
+static int CheckIntListContent(List_t list, int* p_array, int count)
+{
+	ListNode_t node = NULL;
+	int        i = 0;
+
+	if (List_Count(list) != count)
+	{
+		LOG_E("Wrong count:%d, should be:%d.\n", (int)List_Count(list), count);
+		return -1;
+	}
+
+	List_Lock(list);
+	for (node = List_GetHeadNL(list), i = 0; node != NULL; node = List_GetNextNodeNL(list, node), i++)
+	{
+		if (*(int*)List_GetNodeDataNL(list, node) != p_array[i])
+		{
+			List_UnLock(list);
+			LOG_E("Wrong data at pos:%d.\n", i);
+			return -1;
+		}
+	}
+	List_UnLock(list);
+
+	return 0;
+}
+
+static int CheckPositionOperations(const ListAttr_t* p_attr)
+{
+	List_t     list = NULL;
+	int*       p_array = NULL;
+	int*       p_value = NULL;
+	int        count = 0;
+	int        value = 0;
+	int        pos = 0;
+	int        i = 0;
+	int        ret = 0;
+
+	if (List_CreateWithAttr("PosIndexList", g_listType, sizeof(int), p_attr, &list) != ERR_OK)
+	{
+		LOG_E("Fail to create list.\n");
+		return -1;
+	}
+
+	p_array = (int*)malloc(sizeof(int) * 4096);
+	srand(1);
+	for (i = 0; i < 20000 && ret == 0; i++)
+	{
+		value = i;
+		pos = (count == 0) ? 0 : rand() % (count + 1);
+		switch (rand() % 6)
+		{
+		case 0:
+		case 1:
+			if (count >= 4096)
+			{
+				break;
+			}
+			List_InsertDataAtPos(list, &value, pos);
+			memmove(&p_array[pos + 1], &p_array[pos], sizeof(int) * (count - pos));
+			p_array[pos] = value;
+			count++;
+			break;
+		case 2:
+			if (count >= 4096)
+			{
+				break;
+			}
+			List_InsertData2Head(list, &value);
+			memmove(&p_array[1], &p_array[0], sizeof(int) * count);
+			p_array[0] = value;
+			count++;
+			break;
+		case 3:
+			if (count == 0)
+			{
+				break;
+			}
+			pos = rand() % count;
+			p_value = (int*)List_DetachDataAtPos(list, pos);
+			if (p_value == NULL || *p_value != p_array[pos])
+			{
+				LOG_E("Wrong data detached at pos:%d.\n", pos);
+				ret = -1;
+			}
+			free(p_value);
+			memmove(&p_array[pos], &p_array[pos + 1], sizeof(int) * (count - pos - 1));
+			count--;
+			break;
+		case 4:
+			if (count == 0)
+			{
+				break;
+			}
+			pos = rand() % count;
+			List_RmNodeAtPos(list, pos);
+			memmove(&p_array[pos], &p_array[pos + 1], sizeof(int) * (count - pos - 1));
+			count--;
+			break;
+		default:
+			if (count == 0)
+			{
+				break;
+			}
+			pos = rand() % count;
+			p_value = (int*)List_GetDataAtPos(list, pos);
+			if (p_value == NULL || *p_value != p_array[pos])
+			{
+				LOG_E("Wrong data at pos:%d.\n", pos);
+				ret = -1;
+			}
+			break;
+		}
+
+		if (ret == 0 && (i % 1000) == 0)
+		{
+			ret = CheckIntListContent(list, p_array, count);
+		}
+	}
+
+	if (ret == 0)
+	{
+		ret = CheckIntListContent(list, p_array, count);
+	}
+	if (ret == 0 && List_GetDataAtPos(list, count) != NULL)
+	{
+		LOG_E("Should get nothing at pos:%d.\n", count);
+		ret = -1;
+	}
+	free(p_array);
+	List_Destroy(list);
+
+	return ret;
+}
+
+static int TestPositionIndex()
+{
+	ListAttr_t attr;
+	List_t     list = NULL;
+	List_t     plainList = NULL;
+	int        pos = 0;
+	int        i = 0;
+	int        ret = 0;
+	int        total = 100000;
+	int        lookups = 2000;
+	double     begin = 0;
+	double     plainTime = 0;
+	double     indexTime = 0;
+
+	List_AttrInit(&attr);
+	attr.positionIndex = CDATA_TRUE;
+
+	//Do the same operations on the list and an array, then compare them.
+	//Test the list without index too, the double list will walk from tail.
+	ret = CheckPositionOperations(&attr);
+	if (ret == 0)
+	{
+		ret = CheckPositionOperations(NULL);
+	}
+
+	if (ret != 0)
+	{
+		return ret;
+	}
+
+	//Compare the random access time with and without the index.
+	List_Create("PlainList", g_listType, sizeof(int), &plainList);
+	List_CreateWithAttr("PosIndexList", g_listType, sizeof(int), &attr, &list);
+	for (i = 0; i < total; i++)
+	{
+		List_InsertData(plainList, &i);
+		List_InsertData(list, &i);
+	}
+
+	srand(2);
+	begin = GetNowSeconds();
+	for (i = 0; i < lookups; i++)
+	{
+		List_GetDataAtPos(plainList, rand() % total);
+	}
+	plainTime = GetNowSeconds() - begin;
+
+	srand(2);
+	begin = GetNowSeconds();
+	for (i = 0; i < lookups; i++)
+	{
+		pos = rand() % total;
+		if (*(int*)List_GetDataAtPos(list, pos) != pos)
+		{
+			LOG_E("Wrong data at pos:%d.\n", pos);
+			ret = -1;
+			break;
+		}
+	}
+	indexTime = GetNowSeconds() - begin;
+
+	LOG_A("%d random List_GetDataAtPos on %d nodes, without index:%.3fs, with index:%.3fs.\n",
+		lookups, total, plainTime, indexTime);
+
+	List_Destroy(plainList);
+	List_Destroy(list);
+
+	return ret;
+}
+
+typedef struct
+{
+	int key;
+	int seq;
+}KeyItem_t;
+
+static CdataBool KeyItemEqual2Keyword(void* p_nodeData, void* p_keyword)
+{
+	return ((KeyItem_t*)p_nodeData)->key == *(int*)p_keyword;
+}
+
+static CdataBool KeyItemIsDuplicate(void* p_firstNodeData, void* p_secondNodeData)
+{
+	return ((KeyItem_t*)p_firstNodeData)->key == ((KeyItem_t*)p_secondNodeData)->key;
+}
+
+static unsigned long KeyItemHash(void* p_data)
+{
+	return List_HashBytes(&((KeyItem_t*)p_data)->key, sizeof(int));
+}
+
+static unsigned long IntKeywordHash(void* p_keyword)
+{
+	return List_HashBytes(p_keyword, sizeof(int));
+}
+
+static double InsertUniquely(List_t list, int total, int* p_inserted)
+{
+	KeyItem_t item;
+	double    begin = GetNowSeconds();
+	int       i = 0;
+
+	*p_inserted = 0;
+	for (i = 0; i < total; i++)
+	{
+		//Every key is inserted twice, only the first one is kept.
+		item.key = i % (total / 2);
+		item.seq = i;
+		if (List_InsertDataUni(list, &item) != NULL)
+		{
+			(*p_inserted)++;
+		}
+	}
+
+	return GetNowSeconds() - begin;
+}
+
+static int TestHashIndex()
+{
+	ListAttr_t attr;
+	List_t     list = NULL;
+	KeyItem_t  item;
+	KeyItem_t* p_item = NULL;
+	int        key = 0;
+	int        inserted = 0;
+	int        total = 20000;
+	int        round = 0;
+	double     plainTime = 0;
+	double     hashTime = 0;
+
+	//Round 0 is the list with hash index only, round 1 has the position index too.
+	for (round = 0; round < 2; round++)
+	{
+		List_AttrInit(&attr);
+		attr.positionIndex = (round == 1);
+		List_CreateWithAttr("HashList", g_listType, sizeof(KeyItem_t), &attr, &list);
+		List_SetEqual2KeywordFunc(list, KeyItemEqual2Keyword);
+		List_SetNodeEqualFunc(list, KeyItemIsDuplicate);
+
+		//Some nodes are inserted before the hash index is set.
+		for (item.seq = 0; item.seq < 30; item.seq++)
+		{
+			item.key = item.seq % 10;
+			List_InsertData(list, &item);
+		}
+		List_SetHashFunc(list, KeyItemHash, IntKeywordHash);
+		for (; item.seq < 60; item.seq++)
+		{
+			item.key = item.seq % 10;
+			List_InsertData2Head(list, &item);
+		}
+
+		//Key 3: seq 53, 43, 33 at head, then 3, 13, 23.
+		key = 3;
+		p_item = (KeyItem_t*)List_GetData(list, &key);
+		if (p_item == NULL || p_item->seq != 53 || List_GetMachCount(list, &key) != 6)
+		{
+			LOG_E("Wrong first match or match count.\n");
+			List_Destroy(list);
+			return -1;
+		}
+
+		List_RmFirstMatchNode(list, &key);
+		p_item = (KeyItem_t*)List_DetachData(list, &key);
+		if (p_item == NULL || p_item->seq != 43)
+		{
+			LOG_E("Wrong data detached.\n");
+			List_Destroy(list);
+			return -1;
+		}
+		free(p_item);
+
+		List_Swap(list, List_GetHead(list), List_GetTail(list));
+		key = 9;
+		p_item = (KeyItem_t*)List_GetNodeData(list, List_GetFirstMatchNode(list, &key));
+		if (p_item == NULL || p_item->seq != 29 || List_GetMachCount(list, &key) != 6)
+		{
+			LOG_E("Wrong data after swap.\n");
+			List_Destroy(list);
+			return -1;
+		}
+
+		List_RmAllMatchNodes(list, &key);
+		key = 100;
+		if (List_DataExists(list, &key) || List_GetData(list, &key) != NULL || List_Count(list) != 52)
+		{
+			LOG_E("Wrong data after rm.\n");
+			List_Destroy(list);
+			return -1;
+		}
+
+		List_Clear(list);
+		List_InsertDataUni(list, &item);
+		if (List_InsertDataUni(list, &item) != NULL || List_Count(list) != 1)
+		{
+			LOG_E("Duplicate data is inserted.\n");
+			List_Destroy(list);
+			return -1;
+		}
+		List_Destroy(list);
+	}
 
+	//Compare the unique insert with and without the hash index.
+	List_Create("PlainList", g_listType, sizeof(KeyItem_t), &list);
+	List_SetNodeEqualFunc(list, KeyItemIsDuplicate);
+	plainTime = InsertUniquely(list, total, &inserted);
+	List_Destroy(list);
+	if (inserted != total / 2)
+	{
+		LOG_E("Wrong count of unique data:%d.\n", inserted);
+		return -1;
+	}
+
+	List_Create("HashList", g_listType, sizeof(KeyItem_t), &list);
+	List_SetNodeEqualFunc(list, KeyItemIsDuplicate);
+	List_SetHashFunc(list, KeyItemHash, NULL);
+	hashTime = InsertUniquely(list, total, &inserted);
+	List_Destroy(list);
+	if (inserted != total / 2)
+	{
+		LOG_E("Wrong count of unique data:%d.\n", inserted);
+		return -1;
+	}
+
+	LOG_A("Insert %d data uniquely, without hash index:%.3fs, with hash index:%.3fs.\n", total, plainTime, hashTime);
+
+	return 0;
+}
+
+#define SORTED_VALUE_RANGE 1000
+
+static int CheckSortedBounds(List_t list, ListSortOrder_e order, int* p_counts)
+{
+	ListNode_t lower = NULL;
+	ListNode_t upper = NULL;
+	ListNode_t node = NULL;
+	int        value = 0;
+	int        expect = 0;
+	int        count = 0;
+
+	for (value = -1; value <= SORTED_VALUE_RANGE; value++)
+	{
+		//The value which lower bound should point to, it's out of range if there is no such node.
+		if (order == LIST_SORT_ASC)
+		{
+			for (expect = (value < 0) ? 0 : value; expect < SORTED_VALUE_RANGE && p_counts[expect] == 0; expect++);
+		}
+		else
+		{
+			for (expect = (value >= SORTED_VALUE_RANGE) ? SORTED_VALUE_RANGE - 1 : value; expect >= 0 && p_counts[expect] == 0; expect--);
+		}
+
+		lower = List_GetLowerBoundNode(list, &value);
+		if ((expect < 0 || expect >= SORTED_VALUE_RANGE) != (lower == NULL)
+			|| (lower != NULL && *(int*)List_GetNodeData(list, lower) != expect))
+		{
+			LOG_E("Wrong lower bound of %d.\n", value);
+			return -1;
+		}
+
+		upper = List_GetUpperBoundNode(list, &value);
+		for (node = lower, count = 0; node != upper; node = List_GetNextNode(list, node), count++);
+		if (count != ((value >= 0 && value < SORTED_VALUE_RANGE) ? p_counts[value] : 0))
+		{
+			LOG_E("Wrong count of %d between the bounds:%d.\n", value, count);
+			return -1;
+		}
+
+		node = List_GetFirstOrderedMatchNode(list, &value);
+		if ((node != NULL) != (count > 0) || (node != NULL && node != lower))
+		{
+			LOG_E("Wrong first ordered match of %d.\n", value);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static int CheckSortedList(ListSortOrder_e order)
+{
+	ListAttr_t attr;
+	List_t     list = NULL;
+	ListNode_t node = NULL;
+	int        counts[SORTED_VALUE_RANGE];
+	int*       p_array = NULL;
+	int        total = 5000;
+	int        value = 0;
+	int        i = 0;
+	int        j = 0;
+	int        ret = 0;
+
+	memset(counts, 0, sizeof(counts));
+	p_array = (int*)malloc(total * sizeof(int));
+
+	List_AttrInit(&attr);
+	attr.sortOrder = order;
+	List_CreateWithAttr("SortedList", g_listType, sizeof(int), &attr, &list);
+	List_SetUserLtNodeFunc(list, IntLtListData);
+
+	srand(5);
+	for (i = 0; i < total; i++)
+	{
+		value = rand() % SORTED_VALUE_RANGE;
+		node = (order == LIST_SORT_ASC) ? List_InsertDataAsc(list, &value) : List_InsertDataDes(list, &value);
+		if (node == NULL)
+		{
+			LOG_E("Fail to insert %d.\n", value);
+			ret = -1;
+			goto EXIT;
+		}
+		counts[value]++;
+	}
+
+	if (((order == LIST_SORT_ASC) ? List_InsertDataDes(list, &value) : List_InsertDataAsc(list, &value)) != NULL)
+	{
+		LOG_E("Insert in the other order should fail.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	//Remove some nodes from the middle and the head, the towers must be kept in step.
+	for (i = 0; i < total / 3; i++)
+	{
+		value = rand() % SORTED_VALUE_RANGE;
+		node = List_GetFirstOrderedMatchNode(list, &value);
+		if (node != NULL)
+		{
+			List_RmNode(list, node);
+			counts[value]--;
+		}
+
+		if (i % 10 == 0)
+		{
+			value = *(int*)List_GetHeadData(list);
+			List_RmHead(list);
+			counts[value]--;
+		}
+	}
+
+	for (i = 0, j = 0; i < SORTED_VALUE_RANGE; i++)
+	{
+		value = (order == LIST_SORT_ASC) ? i : SORTED_VALUE_RANGE - 1 - i;
+		for (total = counts[value]; total > 0; total--)
+		{
+			p_array[j++] = value;
+		}
+	}
 
+	ret = CheckIntListContent(list, p_array, j);
+	if (ret == 0)
+	{
+		ret = CheckSortedBounds(list, order, counts);
+	}
+
+	EXIT:
+	free(p_array);
+	List_Destroy(list);
+
+	return ret;
+}
+
+static int TestSortedList()
+{
+	ListAttr_t attr;
+	List_t     list = NULL;
+	int        total = 20000;
+	int        value = 0;
+	int        i = 0;
+	double     begin = 0;
+	double     plainTime = 0;
+	double     sortedTime = 0;
+
+	if (CheckSortedList(LIST_SORT_ASC) != 0 || CheckSortedList(LIST_SORT_DES) != 0)
+	{
+		return -1;
+	}
+
+	//Compare building a sorted list with and without the skip index.
+	List_Create("PlainList", g_listType, sizeof(int), &list);
+	List_SetUserLtNodeFunc(list, IntLtListData);
+	srand(6);
+	begin = GetNowSeconds();
+	for (i = 0; i < total; i++)
+	{
+		value = rand();
+		List_InsertDataAsc(list, &value);
+	}
+	plainTime = GetNowSeconds() - begin;
+	List_Destroy(list);
+
+	List_AttrInit(&attr);
+	attr.sortOrder = LIST_SORT_ASC;
+	List_CreateWithAttr("SortedList", g_listType, sizeof(int), &attr, &list);
+	List_SetUserLtNodeFunc(list, IntLtListData);
+	srand(6);
+	begin = GetNowSeconds();
+	for (i = 0; i < total; i++)
+	{
+		value = rand();
+		List_InsertDataAsc(list, &value);
+	}
+	sortedTime = GetNowSeconds() - begin;
+	List_Destroy(list);
+
+	LOG_A("Insert %d data ascending, without skip index:%.3fs, with skip index:%.3fs.\n", total, plainTime, sortedTime);
+
+	return 0;
+}
+
+static CdataBool IsMultipleOf(void* p_nodeData, void* p_userData)
+{
+	return (*(int*)p_nodeData % *(int*)p_userData) == 0;
+}
+
+static int TestIterDetach()
+{
+	List_t     list = NULL;
+	ListIter_t iter;
+	ListNode_t node = NULL;
+	int        expect[8] = {1, 3, 5, 7, 9, 11, 13, 15};
+	int        total = 100000;
+	int        divisor = 2;
+	int        i = 0;
+	double     begin = 0;
+	int        ret = 0;
+
+	List_Create("IterList", g_listType, sizeof(int), &list);
+	for (i = 0; i < 16; i++)
+	{
+		List_InsertData(list, &i);
+	}
+
+	//Detach the even data while iterating, the iterator goes on from the next node.
+	List_Lock(list);
+	List_IterInitNL(list, &iter);
+	while ((node = List_IterNextNL(list, &iter)) != NULL)
+	{
+		if (*(int*)List_GetNodeDataNL(list, node) % 2 == 0)
+		{
+			if (List_IterDetachNL(list, &iter) != node)
+			{
+				LOG_E("Wrong node detached.\n");
+				ret = -1;
+			}
+			List_DestroyNode(list, node);
+		}
+	}
+	List_UnLock(list);
+
+	if (ret != 0 || CheckIntListContent(list, expect, 8) != 0)
+	{
+		List_Destroy(list);
+		return -1;
+	}
+
+	//Detach the tail by its pre node, the new tail must be right for appending.
+	node = List_DetachNextNode(list, List_GetNodeAtPos(list, 6));
+	List_DestroyNode(list, node);
+	node = List_DetachNextNode(list, NULL);
+	List_DestroyNode(list, node);
+	expect[7] = 100;
+	List_InsertData(list, &expect[7]);
+	if (List_DetachNextNode(list, List_GetTail(list)) != NULL || CheckIntListContent(list, &expect[1], 7) != 0)
+	{
+		LOG_E("Wrong list after detaching by pre node.\n");
+		List_Destroy(list);
+		return -1;
+	}
+	List_Destroy(list);
+
+	//The remove functions walk the list only once now.
+	List_Create("IterList", g_listType, sizeof(int), &list);
+	for (i = 0; i < total; i++)
+	{
+		List_InsertData(list, &i);
+	}
+
+	begin = GetNowSeconds();
+	if (List_RmAllMatchNodesByCond(list, &divisor, IsMultipleOf) != (CdataCount_t)(total / 2) || List_Count(list) != (CdataCount_t)(total / 2))
+	{
+		LOG_E("Wrong count after remove.\n");
+		ret = -1;
+	}
+	LOG_A("Remove %d matched nodes from %d nodes:%.3fs.\n", total / 2, total, GetNowSeconds() - begin);
+	List_Destroy(list);
+
+	return ret;
+}
+
+static int TestDetachChain()
+{
+	List_t       list = NULL;
+	ListNode_t   chain = NULL;
+	ListNode_t   node = NULL;
+	CdataCount_t count = 0;
+	int          rest[66];
+	int          divisor = 3;
+	int          keyword = 7;
+	int          i = 0;
+	int          j = 0;
+	int          ret = 0;
+
+	List_Create("ChainList", g_listType, sizeof(int), &list);
+	List_SetEqual2KeywordFunc(list, IntEqualListData);
+	for (i = 0; i < 100; i++)
+	{
+		List_InsertData(list, &i);
+		if (i % divisor != 0)
+		{
+			rest[j++] = i;
+		}
+	}
+
+	chain = List_DetachAllMatchNodesByCond(list, &divisor, IsMultipleOf, &count);
+	for (node = chain, i = 0; node != NULL; node = List_GetNextChainNode(list, node), i += divisor)
+	{
+		if (*(int*)List_GetNodeData(list, node) != i)
+		{
+			LOG_E("Wrong data in chain:%d.\n", *(int*)List_GetNodeData(list, node));
+			ret = -1;
+			break;
+		}
+	}
+	List_DestroyNodeChain(list, chain);
+
+	if (ret != 0 || count != 34 || CheckIntListContent(list, rest, j) != 0)
+	{
+		LOG_E("Wrong count:%d or list after detaching.\n", (int)count);
+		List_Destroy(list);
+		return -1;
+	}
+
+	List_InsertData2Head(list, &keyword);
+	chain = List_DetachAllMatchNodes(list, &keyword, &count);
+	if (count != 2 || chain == NULL || List_GetNextChainNode(list, List_GetNextChainNode(list, chain)) != NULL
+		|| List_DataExists(list, &keyword))
+	{
+		LOG_E("Wrong chain of keyword.\n");
+		ret = -1;
+	}
+	List_DestroyNodeChain(list, chain);
+
+	if (List_DetachAllMatchNodes(list, &keyword, &count) != NULL || count != 0)
+	{
+		LOG_E("Nothing should be detached.\n");
+		ret = -1;
+	}
+	List_Destroy(list);
+
+	return ret;
+}
+
+#define RW_READER_COUNT   8
+#define RW_LIST_SIZE      500
+#define RW_READ_TIMES     20000
+
+typedef struct
+{
+	List_t          list;
+	int             readersDone;
+	int             found;
+	pthread_mutex_t countGuard;
+}RWBenchmark_t;
+
+static void* RWReaderThread(void* p_arg)
+{
+	RWBenchmark_t* p_bench = (RWBenchmark_t*)p_arg;
+	unsigned int   seed = (unsigned int)(size_t)pthread_self();
+	int            found = 0;
+	int            key = 0;
+	int            i = 0;
+
+	for (i = 0; i < RW_READ_TIMES; i++)
+	{
+		key = rand_r(&seed) % RW_LIST_SIZE;
+		if (List_DataExists(p_bench->list, &key))
+		{
+			found++;
+		}
+	}
+
+	pthread_mutex_lock(&p_bench->countGuard);
+	p_bench->found += found;
+	p_bench->readersDone++;
+	pthread_mutex_unlock(&p_bench->countGuard);
+
+	return NULL;
+}
+
+static void* RWWriterThread(void* p_arg)
+{
+	RWBenchmark_t* p_bench = (RWBenchmark_t*)p_arg;
+	int            key = 0;
+	int            readersDone = 0;
+
+	//Write now and then, the head is moved to the tail, so the readers always find every key.
+	while (readersDone < RW_READER_COUNT)
+	{
+		List_InsertData(p_bench->list, &key);
+		List_RmHead(p_bench->list);
+		key = (key + 1) % RW_LIST_SIZE;
+		usleep(1000);
+
+		pthread_mutex_lock(&p_bench->countGuard);
+		readersDone = p_bench->readersDone;
+		pthread_mutex_unlock(&p_bench->countGuard);
+	}
+
+	return NULL;
+}
+
+static double RunRWBenchmark(ListType_e type, ListLockPolicy_e lockPolicy, int* p_found)
+{
+	ListAttr_t    attr;
+	RWBenchmark_t bench;
+	pthread_t     readers[RW_READER_COUNT];
+	pthread_t     writer;
+	double        begin = 0;
+	double        cost = 0;
+	int           i = 0;
+
+	List_AttrInit(&attr);
+	attr.lockPolicy = lockPolicy;
+	List_CreateWithAttr("RWList", type, sizeof(int), &attr, &bench.list);
+	List_SetEqual2KeywordFunc(bench.list, IntEqualListData);
+	for (i = 0; i < RW_LIST_SIZE; i++)
+	{
+		List_InsertData(bench.list, &i);
+	}
+
+	bench.readersDone = 0;
+	bench.found = 0;
+	pthread_mutex_init(&bench.countGuard, NULL);
+
+	begin = GetNowSeconds();
+	for (i = 0; i < RW_READER_COUNT; i++)
+	{
+		pthread_create(&readers[i], NULL, RWReaderThread, &bench);
+	}
+	pthread_create(&writer, NULL, RWWriterThread, &bench);
+
+	for (i = 0; i < RW_READER_COUNT; i++)
+	{
+		pthread_join(readers[i], NULL);
+	}
+	cost = GetNowSeconds() - begin;
+	pthread_join(writer, NULL);
+
+	pthread_mutex_destroy(&bench.countGuard);
+	List_Destroy(bench.list);
+
+	*p_found = bench.found;
+
+	return cost;
+}
+
+static int TestRWLockList()
+{
+	double mutexTime = 0;
+	double rwTime = 0;
+	int    found = 0;
+	int    total = RW_READER_COUNT * RW_READ_TIMES;
+
+	mutexTime = RunRWBenchmark(g_listType, LIST_LOCK_MUTEX, &found);
+	if (found != total)
+	{
+		LOG_E("Readers found %d keys, should be %d.\n", found, total);
+		return -1;
+	}
+
+	rwTime = RunRWBenchmark(g_listType, LIST_LOCK_RW, &found);
+	if (found != total)
+	{
+		LOG_E("Readers found %d keys, should be %d.\n", found, total);
+		return -1;
+	}
+
+	LOG_A("%d readers, %d lookups each, mutex:%.3fs, rwlock:%.3fs.\n", RW_READER_COUNT, RW_READ_TIMES, mutexTime, rwTime);
+
+	return 0;
+}
+
+#define RCU_TRAVERSE_TIMES 200
+
+static void* RcuTraverseThread(void* p_arg)
+{
+	RWBenchmark_t* p_bench = (RWBenchmark_t*)p_arg;
+	ListNode_t     node = NULL;
+	int*           p_data = NULL;
+	int            stable = 0;
+	int            broken = 0;
+	int            i = 0;
+
+	//The writer only adds and removes the temporary data, every stable data must be seen in each pass.
+	for (i = 0; i < RCU_TRAVERSE_TIMES; i++)
+	{
+		stable = 0;
+		List_ReadLock(p_bench->list);
+		FOR_EACH_IN_LIST(node, p_bench->list)
+		{
+			p_data = (int*)List_GetNodeDataNL(p_bench->list, node);
+			if (*p_data < RW_LIST_SIZE)
+			{
+				stable++;
+			}
+			else if (*p_data >= 2 * RW_LIST_SIZE)
+			{
+				broken++;
+			}
+		}
+		List_ReadUnLock(p_bench->list);
+
+		if (stable != RW_LIST_SIZE)
+		{
+			broken++;
+		}
+	}
+
+	pthread_mutex_lock(&p_bench->countGuard);
+	p_bench->found += broken;
+	p_bench->readersDone++;
+	pthread_mutex_unlock(&p_bench->countGuard);
+
+	return NULL;
+}
+
+static void* RcuWriterThread(void* p_arg)
+{
+	RWBenchmark_t* p_bench = (RWBenchmark_t*)p_arg;
+	int            key = 0;
+	int            temp = 0;
+	int            readersDone = 0;
+
+	while (readersDone < RW_READER_COUNT)
+	{
+		temp = RW_LIST_SIZE + key;
+		List_InsertDataAtPos(p_bench->list, &temp, key);
+		List_InsertData(p_bench->list, &temp);
+		List_RmAllMatchNodes(p_bench->list, &temp);
+
+		//The readers may still be on the detached node, the data must not be freed under them.
+		List_InsertData(p_bench->list, &temp);
+		free(List_DetachTailData(p_bench->list));
+		key = (key + 1) % RW_LIST_SIZE;
+
+		pthread_mutex_lock(&p_bench->countGuard);
+		readersDone = p_bench->readersDone;
+		pthread_mutex_unlock(&p_bench->countGuard);
+	}
+
+	return NULL;
+}
+
+static int TestRcuList()
+{
+	ListAttr_t    attr;
+	RWBenchmark_t bench;
+	pthread_t     readers[RW_READER_COUNT];
+	pthread_t     writer;
+	List_t        list = NULL;
+	double        mutexTime = 0;
+	double        rcuTime = 0;
+	int           found = 0;
+	int           total = RW_READER_COUNT * RW_READ_TIMES;
+	int           i = 0;
+
+	List_AttrInit(&attr);
+	attr.lockPolicy = LIST_LOCK_RCU;
+	if (List_CreateWithAttr("RcuList", LIST_TYPE_SINGLE_LINK, sizeof(int), &attr, &list) == ERR_OK)
+	{
+		LOG_E("RCU single list should not be created.\n");
+		List_Destroy(list);
+		return -1;
+	}
+
+	List_CreateWithAttr("RcuList", LIST_TYPE_DOUBLE_LINK, sizeof(int), &attr, &bench.list);
+	if (List_SetHashFunc(bench.list, IntKeywordHash, IntKeywordHash) == ERR_OK)
+	{
+		LOG_E("RCU list should not have hash index.\n");
+		List_Destroy(bench.list);
+		return -1;
+	}
+	List_SetEqual2KeywordFunc(bench.list, IntEqualListData);
+	for (i = 0; i < RW_LIST_SIZE; i++)
+	{
+		List_InsertData(bench.list, &i);
+	}
+
+	bench.readersDone = 0;
+	bench.found = 0;
+	pthread_mutex_init(&bench.countGuard, NULL);
+
+	for (i = 0; i < RW_READER_COUNT; i++)
+	{
+		pthread_create(&readers[i], NULL, RcuTraverseThread, &bench);
+	}
+	pthread_create(&writer, NULL, RcuWriterThread, &bench);
+
+	for (i = 0; i < RW_READER_COUNT; i++)
+	{
+		pthread_join(readers[i], NULL);
+	}
+	pthread_join(writer, NULL);
+
+	pthread_mutex_destroy(&bench.countGuard);
+	List_Destroy(bench.list);
+
+	if (bench.found != 0)
+	{
+		LOG_E("Readers have seen %d broken passes.\n", bench.found);
+		return -1;
+	}
+
+	mutexTime = RunRWBenchmark(LIST_TYPE_DOUBLE_LINK, LIST_LOCK_MUTEX, &found);
+	if (found != total)
+	{
+		LOG_E("Readers found %d keys, should be %d.\n", found, total);
+		return -1;
+	}
+
+	rcuTime = RunRWBenchmark(LIST_TYPE_DOUBLE_LINK, LIST_LOCK_RCU, &found);
+	if (found != total)
+	{
+		LOG_E("Readers found %d keys, should be %d.\n", found, total);
+		return -1;
+	}
+
+	LOG_A("%d readers, %d lookups each, mutex:%.3fs, rcu:%.3fs.\n", RW_READER_COUNT, RW_READ_TIMES, mutexTime, rcuTime);
+
+	return 0;
+}
+
+#define POLL_PRODUCE_TIMES 200000
+
+typedef struct
+{
+	List_t       list;
+	volatile int producing;
+	CdataCount_t polls;
+}PollBenchmark_t;
+
+static void* CountPollingThread(void* p_arg)
+{
+	PollBenchmark_t* p_bench = (PollBenchmark_t*)p_arg;
+	ListStats_t      stats;
+
+	while (p_bench->producing)
+	{
+		List_Count(p_bench->list);
+		List_GetStats(p_bench->list, &stats);
+		p_bench->polls++;
+		usleep(100);
+	}
+
+	return NULL;
+}
+
+static double RunProducer(List_t list)
+{
+	double begin = GetNowSeconds();
+	int    i = 0;
+
+	for (i = 0; i < POLL_PRODUCE_TIMES; i++)
+	{
+		List_InsertData(list, &i);
+		List_RmHead(list);
+	}
+
+	return GetNowSeconds() - begin;
+}
+
+static int TestCountPolling()
+{
+	PollBenchmark_t bench;
+	ListStats_t     stats;
+	pthread_t       poller;
+	double          aloneTime = 0;
+	double          polledTime = 0;
+	int             i = 0;
+
+	List_Create("PollList", g_listType, sizeof(int), &bench.list);
+	for (i = 0; i < 10; i++)
+	{
+		List_InsertData(bench.list, &i);
+	}
+
+	aloneTime = RunProducer(bench.list);
+
+	bench.producing = 1;
+	bench.polls = 0;
+	pthread_create(&poller, NULL, CountPollingThread, &bench);
+	polledTime = RunProducer(bench.list);
+	bench.producing = 0;
+	pthread_join(poller, NULL);
+
+	List_GetStats(bench.list, &stats);
+	List_Destroy(bench.list);
+
+	if (stats.nodeCount != 10 || stats.linkedTotal != 10 + 2 * POLL_PRODUCE_TIMES
+		|| stats.linkedTotal - stats.unlinkedTotal != stats.nodeCount)
+	{
+		LOG_E("Wrong stats, nodeCount:%llu, linked:%llu, unlinked:%llu.\n", stats.nodeCount, stats.linkedTotal, stats.unlinkedTotal);
+		return -1;
+	}
+
+	LOG_A("%d inserts and removes, alone:%.3fs, with %llu polls:%.3fs.\n", POLL_PRODUCE_TIMES, aloneTime, bench.polls, polledTime);
+
+	return 0;
+}
+
+#define BATCH_LOAD_COUNT 1000000
+
+static int CheckBatchVariants(const ListAttr_t* p_attr)
+{
+	List_t list = NULL;
+	int    tail[] = {5, 1, 4};
+	int    head[] = {7, 8};
+	int    asc[] = {6, 0, 9};
+	int    uni[] = {2, 4, 2, 3};
+	int    afterTail[] = {5, 1, 4};
+	int    afterHead[] = {8, 7, 5, 1, 4};
+	int    afterAsc[] = {0, 1, 4, 5, 6, 7, 8, 9};
+	int    afterUni[] = {0, 1, 4, 5, 6, 7, 8, 9, 2, 3};
+	int    ret = 0;
+
+	List_CreateWithAttr("BatchList", g_listType, sizeof(int), p_attr, &list);
+	List_SetUserLtNodeFunc(list, IntLtListData);
+	List_SetNodeEqualFunc(list, IntEqualListData);
+
+	if (List_InsertDataBatch(list, tail, 3) != 3 || CheckIntListContent(list, afterTail, 3) != 0)
+	{
+		LOG_E("Wrong batch insert to tail.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	if (List_InsertDataBatch2Head(list, head, 2) != 2 || CheckIntListContent(list, afterHead, 5) != 0)
+	{
+		LOG_E("Wrong batch insert to head.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	//Sort what we have, then the ascending insert keeps the order.
+	List_Clear(list);
+	List_InsertDataBatchAsc(list, afterHead, 5);
+	if (List_InsertDataBatchAsc(list, asc, 3) != 3 || CheckIntListContent(list, afterAsc, 8) != 0)
+	{
+		LOG_E("Wrong batch insert in ascending order.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	//4 is in the list and the second 2 is a duplicate in the batch.
+	if (List_InsertDataBatchUni(list, uni, 4) != 2 || CheckIntListContent(list, afterUni, 10) != 0)
+	{
+		LOG_E("Wrong batch insert uniquely.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	EXIT:
+	List_Destroy(list);
+	return ret;
+}
+
+static int TestBatchInsert()
+{
+	ListAttr_t attr;
+	List_t     list = NULL;
+	int*       p_values = NULL;
+	int*       p_refs[3];
+	double     begin = 0;
+	double     loopTime = 0;
+	double     batchTime = 0;
+	int        i = 0;
+
+	List_AttrInit(&attr);
+	if (CheckBatchVariants(&attr) != 0)
+	{
+		return -1;
+	}
+
+	attr.poolChunkNodes = 64;
+	if (CheckBatchVariants(&attr) != 0)
+	{
+		return -1;
+	}
+
+	//The reference list takes an array of pointers, the data which are not inserted are still the caller's.
+	List_CreateRef("BatchRefList", g_listType, &list);
+	List_SetNodeEqualFunc(list, IntEqualListData);
+	for (i = 0; i < 3; i++)
+	{
+		p_refs[i] = (int*)malloc(sizeof(int));
+		*p_refs[i] = i % 2;
+	}
+	if (List_InsertDataBatchUni(list, p_refs, 3) != 2 || List_GetHeadData(list) != p_refs[0])
+	{
+		LOG_E("Wrong batch insert of reference list.\n");
+		List_Destroy(list);
+		return -1;
+	}
+	free(p_refs[2]);
+	List_Destroy(list);
+
+	p_values = (int*)malloc(BATCH_LOAD_COUNT * sizeof(int));
+
+	for (i = 0; i < BATCH_LOAD_COUNT; i++)
+	{
+		p_values[i] = i;
+	}
+
+	List_CreateWithAttr("LoopList", g_listType, sizeof(int), &attr, &list);
+	begin = GetNowSeconds();
+	for (i = 0; i < BATCH_LOAD_COUNT; i++)
+	{
+		List_InsertData(list, &p_values[i]);
+	}
+	loopTime = GetNowSeconds() - begin;
+	List_Destroy(list);
+
+	List_CreateWithAttr("BatchList", g_listType, sizeof(int), &attr, &list);
+	begin = GetNowSeconds();
+	List_InsertDataBatch(list, p_values, BATCH_LOAD_COUNT);
+	batchTime = GetNowSeconds() - begin;
+	if (CheckIntListContent(list, p_values, BATCH_LOAD_COUNT) != 0)
+	{
+		LOG_E("Wrong batch load.\n");
+		List_Destroy(list);
+		free(p_values);
+		return -1;
+	}
+	List_Destroy(list);
+	free(p_values);
+
+	LOG_A("Load %d data with pool, loop:%.3fs, batch:%.3fs.\n", BATCH_LOAD_COUNT, loopTime, batchTime);
+
+	return 0;
+}
+
+#define DRAIN_COUNT      1000000
+#define DRAIN_BATCH_SIZE 64
+
+static int TestDetachHeadBatch()
+{
+	ListAttr_t   attr;
+	List_t       list = NULL;
+	ListNode_t   chain = NULL;
+	ListNode_t   node = NULL;
+	CdataCount_t count = 0;
+	int          values[5] = {0, 1, 2, 3, 4};
+	int          out[DRAIN_BATCH_SIZE];
+	int*         p_refs[4];
+	int*         p_data = NULL;
+	double       begin = 0;
+	double       loopTime = 0;
+	double       batchTime = 0;
+	int          i = 0;
+	int          ret = 0;
+
+	List_AttrInit(&attr);
+	attr.poolChunkNodes = 64;
+
+	List_CreateWithAttr("DrainList", g_listType, sizeof(int), &attr, &list);
+	List_InsertDataBatch(list, values, 5);
+	if (List_DetachHeadBatch(list, 3, out) != 3 || out[0] != 0 || out[2] != 2 || List_Count(list) != 2)
+	{
+		LOG_E("Wrong batch detach from head.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	//Ask for more than what we have.
+	if (List_DetachHeadBatch(list, DRAIN_BATCH_SIZE, out) != 2 || out[0] != 3 || out[1] != 4 || List_Count(list) != 0)
+	{
+		LOG_E("Wrong batch detach of the rest.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	List_InsertDataBatch(list, values, 5);
+	chain = List_DetachHeadChain(list, 4, &count);
+	for (i = 0, node = chain; node != NULL; i++, node = List_GetNextChainNode(list, node))
+	{
+		if (*(int*)List_GetNodeDataNL(list, node) != i)
+		{
+			break;
+		}
+	}
+	List_DestroyNodeChain(list, chain);
+	if (count != 4 || i != 4 || List_Count(list) != 1 || *(int*)List_GetHeadData(list) != 4)
+	{
+		LOG_E("Wrong head chain, count:%llu, checked:%d.\n", count, i);
+		ret = -1;
+		goto EXIT;
+	}
+	List_Destroy(list);
+
+	//The reference list gives the data back to user.
+	List_CreateRef("DrainRefList", g_listType, &list);
+	for (i = 0; i < 4; i++)
+	{
+		p_refs[i] = (int*)malloc(sizeof(int));
+		*p_refs[i] = i;
+	}
+	List_InsertDataBatch(list, p_refs, 4);
+	if (List_DetachHeadBatch(list, 2, out) != 2 || ((int**)out)[1] != p_refs[1] || List_GetHeadData(list) != p_refs[2])
+	{
+		LOG_E("Wrong batch detach of reference list.\n");
+		ret = -1;
+		goto EXIT;
+	}
+	free(p_refs[0]);
+	free(p_refs[1]);
+	List_Destroy(list);
+
+	List_CreateWithAttr("LoopDrainList", g_listType, sizeof(int), &attr, &list);
+	for (i = 0; i < DRAIN_COUNT; i++)
+	{
+		List_InsertData(list, &i);
+	}
+	begin = GetNowSeconds();
+	while ((p_data = (int*)List_DetachHeadData(list)) != NULL)
+	{
+		free(p_data);
+	}
+	loopTime = GetNowSeconds() - begin;
+
+	for (i = 0; i < DRAIN_COUNT; i++)
+	{
+		List_InsertData(list, &i);
+	}
+	begin = GetNowSeconds();
+	while (List_DetachHeadBatch(list, DRAIN_BATCH_SIZE, out) > 0)
+	{
+	}
+	batchTime = GetNowSeconds() - begin;
+
+	LOG_A("Drain %d data, one by one:%.3fs, by batch of %d:%.3fs.\n", DRAIN_COUNT, loopTime, DRAIN_BATCH_SIZE, batchTime);
+
+	EXIT:
+	List_Destroy(list);
+	return ret;
+}
+
+#define SPLICE_MOVE_TIMES 100000
+
+//Check the content from the head, then check the tail and the links from the tail back.
+static int CheckIntListBothWays(List_t list, int* p_array, int count)
+{
+	ListNode_t node = NULL;
+	int        i = 0;
+
+	if (CheckIntListContent(list, p_array, count) != 0)
+	{
+		return -1;
+	}
+
+	if (count > 0 && *(int*)List_GetTailData(list) != p_array[count - 1])
+	{
+		LOG_E("Wrong tail data.\n");
+		return -1;
+	}
+
+	if (g_listType == LIST_TYPE_SINGLE_LINK)
+	{
+		return 0;
+	}
+
+	List_Lock(list);
+	for (node = List_GetTailNL(list), i = count - 1; node != NULL; node = List_GetPreNodeNL(list, node), i--)
+	{
+		if (i < 0 || *(int*)List_GetNodeDataNL(list, node) != p_array[i])
+		{
+			List_UnLock(list);
+			LOG_E("Wrong data at pos:%d from the tail.\n", i);
+			return -1;
+		}
+	}
+	List_UnLock(list);
+
+	return (i == -1) ? 0 : -1;
+}
+
+static void* ConcatBackThread(void* p_arg)
+{
+	List_t* p_lists = (List_t*)p_arg;
+	int     i = 0;
+
+	for (i = 0; i < SPLICE_MOVE_TIMES; i++)
+	{
+		List_Concat(p_lists[1], p_lists[0]);
+	}
+
+	return NULL;
+}
+
+static int TestSpliceList()
+{
+	ListAttr_t attr;
+	List_t     lists[2] = {NULL, NULL};
+	List_t     poolList = NULL;
+	List_t     emptied = NULL;
+	pthread_t  thread;
+	int        values[] = {0, 1, 2, 3, 4, 5};
+	int        afterSplice[] = {4, 0, 1, 5};
+	int        restSrc[] = {2, 3};
+	int        afterConcat[] = {4, 0, 1, 5, 2, 3};
+	int        afterSplitHead[] = {4, 0};
+	int        afterSplitTail[] = {1, 5, 2, 3};
+	int        afterBadSplice[] = {3, 4, 0};
+	int        afterBadSpliceSrc[] = {1, 5, 2};
+	int        i = 0;
+	int        ret = 0;
+
+	List_Create("SpliceDst", g_listType, sizeof(int), &lists[0]);
+	List_Create("SpliceSrc", g_listType, sizeof(int), &lists[1]);
+	List_InsertDataBatch(lists[0], &values[4], 1);
+	List_InsertDataBatch(lists[1], values, 4);
+	List_InsertDataBatch(lists[0], &values[5], 1);
+
+	//Move 0,1 behind 4, then move 2,3 to the tail by concat.
+	if (List_Splice(lists[0], List_GetHead(lists[0]), lists[1], List_GetHead(lists[1]), List_GetNodeAtPos(lists[1], 1)) != ERR_OK
+		|| CheckIntListBothWays(lists[0], afterSplice, 4) != 0 || CheckIntListBothWays(lists[1], restSrc, 2) != 0)
+	{
+		LOG_E("Wrong splice.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	if (List_Concat(lists[0], lists[1]) != ERR_OK
+		|| CheckIntListBothWays(lists[0], afterConcat, 6) != 0 || CheckIntListBothWays(lists[1], NULL, 0) != 0)
+	{
+		LOG_E("Wrong concat.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	if (List_SplitAt(lists[0], List_GetNodeAtPos(lists[0], 2), lists[1]) != ERR_OK
+		|| CheckIntListBothWays(lists[0], afterSplitHead, 2) != 0 || CheckIntListBothWays(lists[1], afterSplitTail, 4) != 0)
+	{
+		LOG_E("Wrong split.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	//Splice a single node to the head.
+	if (List_Splice(lists[0], NULL, lists[1], List_GetTail(lists[1]), List_GetTail(lists[1])) != ERR_OK
+		|| *(int*)List_GetHeadData(lists[0]) != 3 || *(int*)List_GetTailData(lists[1]) != 2)
+	{
+		LOG_E("Wrong splice to head.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	//The nodes out of their lists are refused, pos in the moved nodes would make a cycle.
+	if (List_Splice(lists[0], NULL, lists[1], List_GetHead(lists[0]), List_GetHead(lists[0])) != ERR_BAD_PARAM
+		|| List_Splice(lists[0], List_GetHead(lists[1]), lists[1], List_GetTail(lists[1]), List_GetTail(lists[1])) != ERR_BAD_PARAM
+		|| List_Splice(lists[1], List_GetNodeAtPos(lists[1], 1), lists[1], List_GetHead(lists[1]), List_GetTail(lists[1])) != ERR_BAD_PARAM
+		|| CheckIntListBothWays(lists[0], afterBadSplice, 3) != 0 || CheckIntListBothWays(lists[1], afterBadSpliceSrc, 3) != 0)
+	{
+		LOG_E("Wrong splice with bad nodes.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	//The tail of the emptied list is gone, and the node of another list can't split it.
+	List_Create("SpliceEmptied", g_listType, sizeof(int), &emptied);
+	List_InsertData(emptied, &values[0]);
+	free(List_DetachHeadData(emptied));
+	if (List_Concat(emptied, lists[1]) != ERR_OK || CheckIntListBothWays(emptied, afterBadSpliceSrc, 3) != 0
+		|| List_SplitAt(emptied, List_GetHead(lists[0]), lists[1]) != ERR_BAD_PARAM
+		|| CheckIntListBothWays(lists[0], afterBadSplice, 3) != 0 || CheckIntListBothWays(lists[1], NULL, 0) != 0)
+	{
+		LOG_E("Wrong concat to emptied list.\n");
+		ret = -1;
+	}
+	List_Concat(lists[1], emptied);
+	List_Destroy(emptied);
+	if (ret != 0)
+	{
+		goto EXIT;
+	}
+
+	//The pool nodes belong to their list.
+	List_AttrInit(&attr);
+	attr.poolChunkNodes = 8;
+	List_CreateWithAttr("SplicePool", g_listType, sizeof(int), &attr, &poolList);
+	List_InsertDataBatch(poolList, values, 2);
+	if (List_Concat(lists[0], poolList) != ERR_BAD_PARAM || List_Count(poolList) != 2)
+	{
+		LOG_E("Pool list should not be concatenated.\n");
+		ret = -1;
+	}
+	List_Destroy(poolList);
+	if (ret != 0)
+	{
+		goto EXIT;
+	}
+
+	//Move all the nodes back and forth in two threads, the lists are locked in the opposite order by the callers.
+	for (i = 0; i < SPLICE_MOVE_TIMES; i++)
+	{
+		List_InsertData(lists[0], &i);
+	}
+	pthread_create(&thread, NULL, ConcatBackThread, lists);
+	for (i = 0; i < SPLICE_MOVE_TIMES; i++)
+	{
+		List_Concat(lists[0], lists[1]);
+	}
+	pthread_join(thread, NULL);
+
+	if (List_Count(lists[0]) + List_Count(lists[1]) != SPLICE_MOVE_TIMES + 6)
+	{
+		LOG_E("Nodes are lost, count:%llu + %llu.\n", List_Count(lists[0]), List_Count(lists[1]));
+		ret = -1;
+	}
+
+	EXIT:
+	List_Destroy(lists[0]);
+	List_Destroy(lists[1]);
+	return ret;
+}
+
+#define SORT_BENCH_COUNT 1000000
+
+static CdataBool KeyItemLtNode(void* p_nodeData, void* p_userData)
+{
+	return ((KeyItem_t*)p_userData)->key < ((KeyItem_t*)p_nodeData)->key;
+}
+
+//The keys are ascending, and the items with the same key keep the order they are inserted.
+static int CheckKeyItemsSorted(List_t list)
+{
+	ListNode_t node = NULL;
+	KeyItem_t* p_item = NULL;
+	KeyItem_t* p_pre = NULL;
+
+	List_Lock(list);
+	for (node = List_GetHeadNL(list); node != NULL; node = List_GetNextNodeNL(list, node), p_pre = p_item)
+	{
+		p_item = (KeyItem_t*)List_GetNodeDataNL(list, node);
+		if (p_pre != NULL && (p_pre->key > p_item->key || (p_pre->key == p_item->key && p_pre->seq > p_item->seq)))
+		{
+			List_UnLock(list);
+			LOG_E("Wrong order at key:%d, seq:%d.\n", p_item->key, p_item->seq);
+			return -1;
+		}
+	}
+	List_UnLock(list);
+
+	if (p_item != List_GetTailData(list))
+	{
+		LOG_E("Wrong tail after sort.\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int TestListSort()
+{
+	ListAttr_t attr;
+	List_t     list = NULL;
+	KeyItem_t  item;
+	KeyItem_t* p_item = NULL;
+	double     begin = 0;
+	double     sortTime = 0;
+	int        i = 0;
+	int        ret = 0;
+
+	//The position index is rebuilt in the new order.
+	List_AttrInit(&attr);
+	attr.positionIndex = CDATA_TRUE;
+	List_CreateWithAttr("SortList", g_listType, sizeof(KeyItem_t), &attr, &list);
+	for (i = 0; i < 1000; i++)
+	{
+		item.key = (i * 7919) % 100;
+		item.seq = i;
+		List_InsertData(list, &item);
+	}
+
+	if (List_Sort(list, KeyItemLtNode) != ERR_OK || CheckKeyItemsSorted(list) != 0)
+	{
+		LOG_E("Wrong sort.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	p_item = (KeyItem_t*)List_GetDataAtPos(list, 10);
+	if (List_Count(list) != 1000 || p_item == NULL || p_item->key != 1)
+	{
+		LOG_E("Wrong position index after sort.\n");
+		ret = -1;
+		goto EXIT;
+	}
+	List_Destroy(list);
+
+	//A list without node sorts with the one set by List_SetUserLtNodeFunc.
+	List_Create("EmptySortList", g_listType, sizeof(KeyItem_t), &list);
+	List_SetUserLtNodeFunc(list, KeyItemLtNode);
+	if (List_Sort(list, NULL) != ERR_OK || List_Count(list) != 0 || List_GetHead(list) != NULL || List_GetTail(list) != NULL)
+	{
+		LOG_E("Wrong sort of empty list.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	srand(1);
+	for (i = 0; i < SORT_BENCH_COUNT; i++)
+	{
+		item.key = rand();
+		item.seq = i;
+		List_InsertData(list, &item);
+	}
+	begin = GetNowSeconds();
+	List_Sort(list, NULL);
+	sortTime = GetNowSeconds() - begin;
+	if (CheckKeyItemsSorted(list) != 0)
+	{
+		ret = -1;
+		goto EXIT;
+	}
+
+	LOG_A("Sort %d random data:%.3fs.\n", SORT_BENCH_COUNT, sortTime);
+
+	EXIT:
+	List_Destroy(list);
+	return ret;
+}
+
+#define UNROLLED_BENCH_COUNT  1000000
+#define UNROLLED_BENCH_ROUNDS 10
+
+typedef struct
+{
+	int       preData;
+	CdataBool isDescending;
+}DescendingCheck_t;
+
+static void CheckDescending(ListTraverseNodeInfo_t *p_info, void *p_userData, CdataBool* p_needStop)
+{
+	DescendingCheck_t* p_check = (DescendingCheck_t*)p_userData;
+	int data = *(int*)p_info->p_data;
+
+	if (data >= p_check->preData)
+	{
+		p_check->isDescending = CDATA_FALSE;
+		*p_needStop = CDATA_TRUE;
+	}
+	p_check->preData = data;
+}
+
+static void SumIntList(ListTraverseNodeInfo_t *p_info, void *p_userData, CdataBool* p_needStop)
+{
+	*(long long*)p_userData += *(int*)p_info->p_data;
+}
+
+static double BenchmarkScan(ListType_e type, long long* p_sum)
+{
+	List_t list = NULL;
+	double begin = 0;
+	int    i = 0;
+
+	List_Create("ScanList", type, sizeof(int), &list);
+	for (i = 0; i < UNROLLED_BENCH_COUNT; i++)
+	{
+		List_InsertData(list, &i);
+	}
+
+	*p_sum = 0;
+	begin = GetNowSeconds();
+	for (i = 0; i < UNROLLED_BENCH_ROUNDS; i++)
+	{
+		List_Traverse(list, p_sum, SumIntList);
+	}
+	begin = GetNowSeconds() - begin;
+
+	List_Destroy(list);
+	return begin;
+}
+
+static int TestUnrolledList()
+{
+	ListAttr_t        attr;
+	List_t            list = NULL;
+	List_t            badList = NULL;
+	ListNode_t        node = NULL;
+	ListNode_t        keep = NULL;
+	DescendingCheck_t check;
+	int*              p_data = NULL;
+	int               values[3] = {7, 8, 7};
+	int               two = 2;
+	int               i = 0;
+	int               j = 0;
+	long long         sums[2];
+	double            times[2];
+	int               ret = 0;
+
+	//The node is the slot of the data, there is no room for the reference or the node extensions.
+	List_AttrInit(&attr);
+	attr.positionIndex = CDATA_TRUE;
+	if (List_CreateRef("BadUnrolled", LIST_TYPE_UNROLLED, &badList) != ERR_BAD_PARAM
+		|| List_CreateWithAttr("BadUnrolled", LIST_TYPE_UNROLLED, sizeof(int), &attr, &badList) != ERR_BAD_PARAM)
+	{
+		LOG_E("Unrolled list should not be created.\n");
+		return -1;
+	}
+
+	List_Create("UnrolledList", LIST_TYPE_UNROLLED, sizeof(int), &list);
+	for (i = 0; i < 1000; i++)
+	{
+		node = List_InsertData(list, &i);
+		if (i == 501)
+		{
+			keep = node;
+		}
+
+		j = -1 - i;
+		List_InsertData2Head(list, &j);
+	}
+
+	if (List_Count(list) != 2000 || *(int*)List_GetHeadData(list) != -1000 || *(int*)List_GetTailData(list) != 999
+		|| *(int*)List_GetDataAtPos(list, 10) != -990 || *(int*)List_GetDataAtPos(list, 1500) != 500)
+	{
+		LOG_E("Wrong data after inserting at both ends.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	List_Lock(list);
+	for (node = List_GetHeadNL(list), i = -1000; node != NULL; node = List_GetNextNodeNL(list, node), i++)
+	{
+		if (*(int*)List_GetNodeDataNL(list, node) != i)
+		{
+			LOG_E("Wrong data:%d, expected:%d.\n", *(int*)List_GetNodeDataNL(list, node), i);
+			ret = -1;
+			break;
+		}
+	}
+	List_UnLock(list);
+	if (ret != 0)
+	{
+		goto EXIT;
+	}
+
+	//The slots don't move when the others are removed, so the handle still points to its data.
+	if (List_RmAllMatchNodesByCond(list, &two, IsMultipleOf) != 1000 || *(int*)List_GetNodeData(list, keep) != 501
+		|| *(int*)List_GetDataAtPos(list, 750) != 501 || List_GetNextNode(list, keep) != List_GetNodeAtPos(list, 751))
+	{
+		LOG_E("Wrong data after removing even data.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	check.preData = 1 << 30;
+	check.isDescending = CDATA_TRUE;
+	List_TraverseReversely(list, &check, CheckDescending);
+	if (!check.isDescending)
+	{
+		LOG_E("Wrong reverse traverse.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	p_data = (int*)List_DetachHeadData(list);
+	if (p_data == NULL || *p_data != -999)
+	{
+		LOG_E("Wrong head data detached.\n");
+		ret = -1;
+		goto EXIT;
+	}
+	free(p_data);
+
+	List_SetNodeEqualFunc(list, IntEqualListData);
+	if (List_InsertDataBatchUni(list, values, 3) != 1 || List_Count(list) != 1000 || *(int*)List_GetTailData(list) != 8)
+	{
+		LOG_E("Wrong unique batch insert.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	if (List_CreateNode(list, &i, &node) == ERR_OK || List_Sort(list, IntLtListData) == ERR_OK)
+	{
+		LOG_E("Node functions should not work on unrolled list.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	List_Clear(list);
+	node = List_InsertData(list, &two);
+	if (List_Count(list) != 1 || List_GetHead(list) != node || List_GetTail(list) != node)
+	{
+		LOG_E("Wrong list after clear.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	times[0] = BenchmarkScan(LIST_TYPE_DOUBLE_LINK, &sums[0]);
+	times[1] = BenchmarkScan(LIST_TYPE_UNROLLED, &sums[1]);
+	if (sums[0] != sums[1])
+	{
+		LOG_E("Wrong sum of unrolled list.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	LOG_A("Scan %d int %d times, double list:%.3fs, unrolled list:%.3fs.\n", UNROLLED_BENCH_COUNT, UNROLLED_BENCH_ROUNDS, times[0], times[1]);
+
+	EXIT:
+	List_Destroy(list);
+	return ret;
+}
+
+#define KEY_COLUMN_BENCH_COUNT   100000
+#define KEY_COLUMN_BENCH_LOOKUPS 200
+
+static double BenchmarkDataExists(CdataBool useKeyColumn, int* p_hits)
+{
+	List_t    list = NULL;
+	KeyItem_t item;
+	int       key = 0;
+	int       i = 0;
+	double    begin = 0;
+	double    cost = 0;
+
+	List_Create("ExistsList", g_listType, sizeof(KeyItem_t), &list);
+	List_SetEqual2KeywordFunc(list, KeyItemEqual2Keyword);
+	if (useKeyColumn)
+	{
+		List_SetKeyColumn(list, sizeof(int));
+	}
+	for (item.seq = 0; item.seq < KEY_COLUMN_BENCH_COUNT; item.seq++)
+	{
+		item.key = item.seq * 2;
+		List_InsertData(list, &item);
+	}
+
+	//Half of the keys are odd, they are not in the list.
+	*p_hits = 0;
+	begin = GetNowSeconds();
+	for (i = 0; i < KEY_COLUMN_BENCH_LOOKUPS; i++)
+	{
+		key = (int)(((long long)i * 7919) % (KEY_COLUMN_BENCH_COUNT * 2));
+		*p_hits += List_DataExists(list, &key) ? 1 : 0;
+	}
+	cost = GetNowSeconds() - begin;
+
+	List_Destroy(list);
+	return cost;
+}
+
+static int TestKeyColumn()
+{
+	ListAttr_t attr;
+	List_t     list = NULL;
+	List_t     refList = NULL;
+	ListNode_t node = NULL;
+	KeyItem_t  item;
+	KeyItem_t* p_item = NULL;
+	int        key = 0;
+	int        round = 0;
+	int        hits[2];
+	double     times[2];
+
+	List_CreateRef("RefList", g_listType, &refList);
+	if (List_SetKeyColumn(refList, sizeof(int)) != ERR_BAD_PARAM)
+	{
+		LOG_E("Reference list should not have key column.\n");
+		List_Destroy(refList);
+		return -1;
+	}
+	List_Destroy(refList);
+
+	//Round 0 is the list with key column only, round 1 has the position index too.
+	for (round = 0; round < 2; round++)
+	{
+		List_AttrInit(&attr);
+		attr.positionIndex = (round == 1);
+		List_CreateWithAttr("KeyColumnList", g_listType, sizeof(KeyItem_t), &attr, &list);
+		List_SetEqual2KeywordFunc(list, KeyItemEqual2Keyword);
+
+		//Some nodes are inserted before the key column is set.
+		for (item.seq = 0; item.seq < 30; item.seq++)
+		{
+			item.key = item.seq % 10;
+			List_InsertData(list, &item);
+		}
+		List_SetKeyColumn(list, sizeof(int));
+		for (; item.seq < 60; item.seq++)
+		{
+			item.key = item.seq % 10;
+			List_InsertData2Head(list, &item);
+		}
+
+		//Key 3: seq 53, 43, 33 at head, then 3, 13, 23, seq 60 is inserted before seq 54.
+		key = 4;
+		item.key = 3;
+		List_InsertDataBefore(list, &key, &item);
+		key = 3;
+		p_item = (KeyItem_t*)List_GetData(list, &key);
+		if (p_item == NULL || p_item->seq != 60 || List_GetMachCount(list, &key) != 7)
+		{
+			LOG_E("Wrong first match or match count.\n");
+			List_Destroy(list);
+			return -1;
+		}
+
+		List_RmFirstMatchNode(list, &key);
+		p_item = (KeyItem_t*)List_DetachData(list, &key);
+		if (p_item == NULL || p_item->seq != 53)
+		{
+			LOG_E("Wrong data detached.\n");
+			List_Destroy(list);
+			return -1;
+		}
+		free(p_item);
+
+		//The node without data can't be found any longer.
+		node = List_GetFirstMatchNode(list, &key);
+		free(List_DetachNodeData(list, node));
+		p_item = (KeyItem_t*)List_GetData(list, &key);
+		if (p_item == NULL || p_item->seq != 33 || List_GetMachCount(list, &key) != 4)
+		{
+			LOG_E("Wrong data after detaching node data.\n");
+			List_Destroy(list);
+			return -1;
+		}
+		List_RmNode(list, node);
+
+		List_Swap(list, List_GetHead(list), List_GetTail(list));
+		key = 9;
+		p_item = (KeyItem_t*)List_GetNodeData(list, List_GetFirstMatchNode(list, &key));
+		if (p_item == NULL || p_item->seq != 29 || List_GetMachCount(list, &key) != 6)
+		{
+			LOG_E("Wrong data after swap.\n");
+			List_Destroy(list);
+			return -1;
+		}
+
+		//The sort is stable, seq 33 is still the first key 3.
+		List_Sort(list, KeyItemLtNode);
+		key = 3;
+		p_item = (KeyItem_t*)List_GetData(list, &key);
+		if (p_item == NULL || p_item->seq != 33 || List_GetMachCount(list, &key) != 4
+			|| ((KeyItem_t*)List_GetNodeData(list, List_GetNextNode(list, List_GetFirstMatchNode(list, &key))))->seq != 3)
+		{
+			LOG_E("Wrong data after sort.\n");
+			List_Destroy(list);
+			return -1;
+		}
+
+		key = 100;
+		if (List_DataExists(list, &key) || List_GetData(list, &key) != NULL)
+		{
+			LOG_E("Data should not exist.\n");
+			List_Destroy(list);
+			return -1;
+		}
+		List_Destroy(list);
+	}
+
+	times[0] = BenchmarkDataExists(CDATA_FALSE, &hits[0]);
+	times[1] = BenchmarkDataExists(CDATA_TRUE, &hits[1]);
+	if (hits[0] != hits[1] || hits[0] != KEY_COLUMN_BENCH_LOOKUPS / 2)
+	{
+		LOG_E("Wrong hits:%d, %d.\n", hits[0], hits[1]);
+		return -1;
+	}
+
+	LOG_A("Check %d keys in %d data, equal2KeywordFn:%.3fs, key column:%.3fs.\n", KEY_COLUMN_BENCH_LOOKUPS, KEY_COLUMN_BENCH_COUNT, times[0], times[1]);
+
+	return 0;
+}
+
+typedef struct
+{
+	int       seq;
+	char      name[12];
+	long long score;
+}Record_t;
+
+#define KEY_FIELD_BENCH_COUNT   100000
+#define KEY_FIELD_BENCH_LOOKUPS 100
+
+static double BenchmarkMatchCount(CdataBool useKeyField, CdataCount_t* p_count)
+{
+	List_t    list = NULL;
+	KeyItem_t item;
+	int       key = 0;
+	int       i = 0;
+	double    begin = 0;
+	double    cost = 0;
+
+	List_Create("MatchList", g_listType, sizeof(KeyItem_t), &list);
+	if (useKeyField)
+	{
+		List_SetKeyField(list, offsetof(KeyItem_t, key), sizeof(int), LIST_KEY_INT32);
+	}
+	else
+	{
+		List_SetEqual2KeywordFunc(list, KeyItemEqual2Keyword);
+	}
+
+	for (item.seq = 0; item.seq < KEY_FIELD_BENCH_COUNT; item.seq++)
+	{
+		item.key = item.seq % 1000;
+		List_InsertData(list, &item);
+	}
+
+	*p_count = 0;
+	begin = GetNowSeconds();
+	for (i = 0; i < KEY_FIELD_BENCH_LOOKUPS; i++)
+	{
+		key = i * 10;
+		*p_count += List_GetMachCount(list, &key);
+	}
+	cost = GetNowSeconds() - begin;
+
+	List_Destroy(list);
+	return cost;
+}
+
+static int TestKeyField()
+{
+	ListAttr_t   attr;
+	List_t       list = NULL;
+	Record_t     record;
+	Record_t*    p_record = NULL;
+	KeyItem_t    item;
+	ListNode_t   node = NULL;
+	ListNode_t   match = NULL;
+	long long    score = 0;
+	int          key = 0;
+	int          i = 0;
+	CdataCount_t counts[2];
+	double       times[2];
+	int          ret = 0;
+
+	//No equal or less than function is set, all the compares are done with the key field.
+	List_Create("RecordList", g_listType, sizeof(Record_t), &list);
+	if (List_SetKeyField(list, offsetof(Record_t, score), sizeof(int), LIST_KEY_INT64) != ERR_BAD_PARAM
+		|| List_SetKeyField(list, offsetof(Record_t, name), sizeof(Record_t), LIST_KEY_BYTES) != ERR_BAD_PARAM)
+	{
+		LOG_E("Wrong key field should not be set.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	List_SetKeyField(list, offsetof(Record_t, name), sizeof(record.name), LIST_KEY_CSTRING);
+	List_SetHashFunc(list, KeyItemHash, NULL);
+	for (i = 0; i < 20; i++)
+	{
+		memset(&record, 0, sizeof(record));
+		record.seq = i;
+		snprintf(record.name, sizeof(record.name), "name%d", i % 5);
+		record.score = (i * 7) % 10;
+		List_InsertDataUni(list, &record);
+	}
+
+	p_record = (Record_t*)List_GetData(list, "name3");
+	if (List_Count(list) != 5 || p_record == NULL || p_record->seq != 3 || List_DataExists(list, "name5"))
+	{
+		LOG_E("Wrong data with string key.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	//Sort the records by score, the records which have the same score keep their order.
+	List_SetHashFunc(list, NULL, NULL);
+	List_SetKeyField(list, offsetof(Record_t, score), sizeof(long long), LIST_KEY_INT64);
+	List_Sort(list, NULL);
+	score = 1;
+	p_record = (Record_t*)List_GetHeadData(list);
+	if (p_record->score != 0 || ((Record_t*)List_GetTailData(list))->score != 8
+		|| ((Record_t*)List_GetData(list, &score))->seq != 3)
+	{
+		LOG_E("Wrong order after sort by score.\n");
+		ret = -1;
+		goto EXIT;
+	}
+	List_Destroy(list);
+
+	//The sorted list orders the data with the key field too.
+	List_AttrInit(&attr);
+	attr.sortOrder = LIST_SORT_DES;
+	List_CreateWithAttr("SortedKeyList", g_listType, sizeof(KeyItem_t), &attr, &list);
+	List_SetKeyField(list, offsetof(KeyItem_t, key), sizeof(int), LIST_KEY_INT32);
+	for (item.seq = 0; item.seq < 100; item.seq++)
+	{
+		item.key = (item.seq * 37) % 50 - 25;
+		List_InsertDataDes(list, &item);
+	}
+
+	key = -25;
+	if (((KeyItem_t*)List_GetHeadData(list))->key != 24 || ((KeyItem_t*)List_GetTailData(list))->key != -25
+		|| List_GetMachCount(list, &key) != 2 || List_SetKeyField(list, 0, 0, LIST_KEY_NONE) != ERR_BAD_PARAM)
+	{
+		LOG_E("Wrong sorted list with key field.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	//The node whose data is detached has no key, it's skipped by the compares.
+	node = List_GetHead(list);
+	free(List_DetachNodeData(list, node));
+	key = 24;
+	item.key = 24;
+	match = List_GetNextMatchNode(list, node, &key);
+	if (match == NULL || ((KeyItem_t*)List_GetNodeData(list, match))->key != 24 || List_DataExists(list, &key) != CDATA_TRUE
+		|| (g_listType == LIST_TYPE_DOUBLE_LINK && (List_GetLastMatchNode(list, &key) != match
+		|| List_GetPreMatchNode(list, List_GetTail(list), &key) != match)) || List_InsertDataDes(list, &item) == NULL)
+	{
+		LOG_E("Wrong match with the detached data.\n");
+		ret = -1;
+		goto EXIT;
+	}
+	List_RmNode(list, node);
+
+	times[0] = BenchmarkMatchCount(CDATA_FALSE, &counts[0]);
+	times[1] = BenchmarkMatchCount(CDATA_TRUE, &counts[1]);
+	if (counts[0] != counts[1] || counts[0] != KEY_FIELD_BENCH_LOOKUPS * (KEY_FIELD_BENCH_COUNT / 1000))
+	{
+		LOG_E("Wrong match count:%d, %d.\n", (int)counts[0], (int)counts[1]);
+		ret = -1;
+		goto EXIT;
+	}
+
+	LOG_A("Count %d keys in %d data, equal2KeywordFn:%.3fs, key field:%.3fs.\n", KEY_FIELD_BENCH_LOOKUPS, KEY_FIELD_BENCH_COUNT, times[0], times[1]);
+
+	EXIT:
+	List_Destroy(list);
+	return ret;
+}
+
+//=============================================================================
+#define PARALLEL_TEST_SIZE    100000
+#define PARALLEL_BENCH_SIZE   2000000
+#define PARALLEL_BENCH_ROUNDS 64
+
+static void AddOne(void* p_nodeData, void* p_userData)
+{
+	(*(int*)p_nodeData)++;
+}
+
+static void SumData(void* p_nodeData, void* p_userData, void* p_partial)
+{
+	*(long long*)p_partial += *(int*)p_nodeData;
+}
+
+static void MergeSum(void* p_result, const void* p_partial, void* p_userData)
+{
+	*(long long*)p_result += *(const long long*)p_partial;
+}
+
+//Mix the data some rounds, as a condition which does real work for each node.
+static CdataBool IsHashMatched(void* p_nodeData, void* p_userData)
+{
+	unsigned int hash = (unsigned int)*(int*)p_nodeData;
+	int          i = 0;
+
+	for (i = 0; i < PARALLEL_BENCH_ROUNDS; i++)
+	{
+		hash = (hash ^ (hash >> 15)) * 2246822519U;
+	}
+
+	return (hash & 7) == 0;
+}
+
+static int CheckParallelList(ListType_e type, int threadCount)
+{
+	List_t     list = NULL;
+	ListNode_t node = NULL;
+	long long  sum = 0;
+	int        divisor = 3;
+	int        i = 0;
+	int        pre = 0;
+	int        ret = 0;
+
+	List_Create("ParallelList", type, sizeof(int), &list);
+	for (i = 0; i < PARALLEL_TEST_SIZE; i++)
+	{
+		List_InsertData(list, &i);
+	}
+
+	//The data are 1 to PARALLEL_TEST_SIZE after adding one.
+	List_SetParallelThreads(threadCount);
+	List_ParallelForEach(list, NULL, AddOne);
+	List_ParallelReduce(list, NULL, SumData, MergeSum, &sum, sizeof(sum));
+	if (sum != (long long)PARALLEL_TEST_SIZE * (PARALLEL_TEST_SIZE + 1) / 2
+		|| List_ParallelCountIf(list, &divisor, IsMultipleOf) != PARALLEL_TEST_SIZE / 3)
+	{
+		LOG_E("Wrong sum:%lld or count with %d threads.\n", sum, threadCount);
+		ret = -1;
+		goto EXIT;
+	}
+
+	if (List_ParallelRemoveIf(list, &divisor, IsMultipleOf) != PARALLEL_TEST_SIZE / 3
+		|| List_Count(list) != PARALLEL_TEST_SIZE - PARALLEL_TEST_SIZE / 3)
+	{
+		LOG_E("Wrong count after removing with %d threads.\n", threadCount);
+		ret = -1;
+		goto EXIT;
+	}
+
+	List_Lock(list);
+	FOR_EACH_IN_LIST(node, list)
+	{
+		i = *(int*)List_GetNodeDataNL(list, node);
+		if (i % 3 == 0 || i <= pre)
+		{
+			LOG_E("Wrong data:%d after %d.\n", i, pre);
+			ret = -1;
+			break;
+		}
+		pre = i;
+	}
+	List_UnLock(list);
+
+	EXIT:
+	List_SetParallelThreads(0);
+	List_Destroy(list);
+	return ret;
+}
+
+static int TestParallel()
+{
+	List_t       list = NULL;
+	CdataCount_t counts[2] = {0, 0};
+	double       begin = 0;
+	double       serialTime = 0;
+	double       parallelTime = 0;
+	int          cpuCount = List_GetParallelThreads();
+	int          maxThreads = 0;
+	int          threadCount = 0;
+	int          i = 0;
+
+	if (CheckParallelList(g_listType, 1) != 0 || CheckParallelList(g_listType, 4) != 0
+		|| CheckParallelList(LIST_TYPE_UNROLLED, 4) != 0)
+	{
+		return -1;
+	}
+
+	List_Create("ParallelBenchList", g_listType, sizeof(int), &list);
+	for (i = 0; i < PARALLEL_BENCH_SIZE; i++)
+	{
+		List_InsertData(list, &i);
+	}
+
+	begin = GetNowSeconds();
+	counts[0] = List_GetMachCountByCond(list, NULL, IsHashMatched);
+	serialTime = GetNowSeconds() - begin;
+	LOG_A("Count by condition in %d data, List_GetMachCountByCond:%.3fs.\n", PARALLEL_BENCH_SIZE, serialTime);
+
+	maxThreads = (cpuCount < 4) ? 4 : cpuCount;
+	for (threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+	{
+		List_SetParallelThreads(threadCount);
+		begin = GetNowSeconds();
+		counts[1] = List_ParallelCountIf(list, NULL, IsHashMatched);
+		parallelTime = GetNowSeconds() - begin;
+		if (counts[1] != counts[0])
+		{
+			LOG_E("Wrong count:%llu, expected:%llu.\n", counts[1], counts[0]);
+			List_SetParallelThreads(0);
+			List_Destroy(list);
+			return -1;
+		}
+		LOG_A("List_ParallelCountIf with %d threads:%.3fs, speedup:%.2f.\n", threadCount, parallelTime, serialTime / parallelTime);
+	}
+	LOG_A("%d CPUs online.\n", cpuCount);
+
+	List_SetParallelThreads(0);
+	List_Destroy(list);
+	return 0;
+}
+
+#define CURSOR_BENCH_SIZE  1000000
+#define CURSOR_CHUNK_NODES 1024
+
+typedef struct
+{
+	int data[16];
+	int count;
+}CursorVisit_t;
+
+typedef struct
+{
+	List_t       list;
+	volatile int traversing;
+	double       maxLatency;
+	CdataCount_t inserts;
+}LatencyBenchmark_t;
+
+static void CollectData(ListTraverseNodeInfo_t* p_nodeInfo, void* p_userData, CdataBool* p_needStopTraverse)
+{
+	CursorVisit_t* p_visit = (CursorVisit_t*)p_userData;
+
+	if (p_visit->count < 16)
+	{
+		p_visit->data[p_visit->count] = *(int*)p_nodeInfo->p_data;
+	}
+	p_visit->count++;
+}
+
+static void SumTraverse(ListTraverseNodeInfo_t* p_nodeInfo, void* p_userData, CdataBool* p_needStopTraverse)
+{
+	*(long long*)p_userData += *(int*)p_nodeInfo->p_data;
+}
+
+static void* LatencyProducerThread(void* p_arg)
+{
+	LatencyBenchmark_t* p_bench = (LatencyBenchmark_t*)p_arg;
+	double              begin = 0;
+	double              latency = 0;
+	int                 data = -1;
+
+	while (p_bench->traversing)
+	{
+		begin = GetNowSeconds();
+		List_InsertData(p_bench->list, &data);
+		latency = GetNowSeconds() - begin;
+		if (latency > p_bench->maxLatency)
+		{
+			p_bench->maxLatency = latency;
+		}
+		p_bench->inserts++;
+		usleep(100);
+	}
+
+	return NULL;
+}
+
+static double MeasureInsertLatency(List_t list, CdataCount_t chunkNodes, long long* p_sum)
+{
+	LatencyBenchmark_t bench;
+	pthread_t          producer;
+
+	bench.list = list;
+	bench.traversing = 1;
+	bench.maxLatency = 0;
+	bench.inserts = 0;
+	pthread_create(&producer, NULL, LatencyProducerThread, &bench);
+
+	//Give the producer a chance to run before the traverse.
+	usleep(1000);
+	*p_sum = 0;
+	if (chunkNodes == 0)
+	{
+		List_Traverse(list, p_sum, SumTraverse);
+	}
+	else
+	{
+		List_TraverseChunked(list, chunkNodes, p_sum, SumTraverse);
+	}
+
+	bench.traversing = 0;
+	pthread_join(producer, NULL);
+
+	return bench.maxLatency;
+}
+
+static int CheckCursor(ListType_e type)
+{
+	List_t        list = NULL;
+	List_t        other = NULL;
+	ListCursor_t  cursor;
+	ListCursor_t  cursor2;
+	CursorVisit_t visit;
+	int           expected[] = {0, 1, 2, 4, 8, 9, 10};
+	int           i = 0;
+	int           ret = 0;
+
+	List_Create("CursorList", type, sizeof(int), &list);
+	List_Create("CursorOther", type, sizeof(int), &other);
+	for (i = 0; i < 10; i++)
+	{
+		List_InsertData(list, &i);
+	}
+
+	memset(&visit, 0, sizeof(visit));
+	List_CursorOpen(list, &cursor);
+	List_CursorOpen(list, &cursor2);
+	if (List_CursorTraverse(&cursor, 3, &visit, CollectData) != ERR_OK)
+	{
+		LOG_E("The cursor stops too early.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	//The cursor stands on 3 now, it's moved to 4 when 3 is removed.
+	List_RmNodeAtPos(list, 3);
+	i = -1;
+	List_InsertData2Head(list, &i);
+	i = 10;
+	List_InsertData(list, &i);
+	List_CursorTraverse(&cursor, 1, &visit, CollectData);
+
+	//Move 5~7 away as a run while the cursor stands on 5.
+	List_Splice(other, NULL, list, List_GetNodeAtPos(list, 5), List_GetNodeAtPos(list, 7));
+	while (List_CursorTraverse(&cursor, 2, &visit, CollectData) == ERR_OK)
+	{
+	}
+
+	if (visit.count != sizeof(expected) / sizeof(expected[0])
+		|| memcmp(visit.data, expected, sizeof(expected)) != 0)
+	{
+		LOG_E("Wrong nodes visited by cursor, count:%d.\n", visit.count);
+		ret = -1;
+		goto EXIT;
+	}
+
+	visit.count = 0;
+	List_Clear(list);
+	if (List_CursorTraverse(&cursor2, 100, &visit, CollectData) != ERR_DATA_NOT_EXISTS || visit.count != 0)
+	{
+		LOG_E("The cursor is not at the end after clear.\n");
+		ret = -1;
+	}
+
+	EXIT:
+	List_CursorClose(&cursor2);
+	List_CursorClose(&cursor);
+	List_Destroy(other);
+	List_Destroy(list);
+	return ret;
+}
+
+static int TestChunkedTraverse()
+{
+	List_t       list = NULL;
+	ListCursor_t cursor;
+	long long    sums[2] = {0, 0};
+	double       latencies[2] = {0, 0};
+	int          i = 0;
+
+	if (CheckCursor(g_listType) != 0)
+	{
+		return -1;
+	}
+
+	List_Create("UnrolledCursorList", LIST_TYPE_UNROLLED, sizeof(int), &list);
+	if (List_CursorOpen(list, &cursor) != ERR_BAD_PARAM)
+	{
+		LOG_E("Unrolled list should not open cursor.\n");
+		List_Destroy(list);
+		return -1;
+	}
+	List_Destroy(list);
+
+	List_Create("ChunkedList", g_listType, sizeof(int), &list);
+	for (i = 0; i < CURSOR_BENCH_SIZE; i++)
+	{
+		List_InsertData(list, &i);
+	}
+
+	latencies[0] = MeasureInsertLatency(list, 0, &sums[0]);
+	List_Clear(list);
+	for (i = 0; i < CURSOR_BENCH_SIZE; i++)
+	{
+		List_InsertData(list, &i);
+	}
+	latencies[1] = MeasureInsertLatency(list, CURSOR_CHUNK_NODES, &sums[1]);
+	List_Destroy(list);
+
+	//The producer inserts -1, the sum can only be less.
+	if (sums[0] > (long long)CURSOR_BENCH_SIZE * (CURSOR_BENCH_SIZE - 1) / 2
+		|| sums[1] > (long long)CURSOR_BENCH_SIZE * (CURSOR_BENCH_SIZE - 1) / 2
+		|| sums[1] < (long long)CURSOR_BENCH_SIZE * (CURSOR_BENCH_SIZE - 1) / 2 - CURSOR_BENCH_SIZE)
+	{
+		LOG_E("Wrong sum, traverse:%lld, chunked:%lld.\n", sums[0], sums[1]);
+		return -1;
+	}
+
+	LOG_A("Max insert latency during traverse of %d nodes, List_Traverse:%.3fms, List_TraverseChunked(%d):%.3fms.\n",
+		CURSOR_BENCH_SIZE, latencies[0] * 1000, CURSOR_CHUNK_NODES, latencies[1] * 1000);
+
+	return 0;
+}
+
+#define POS_CURSOR_TEST_SIZE  1000
+#define POS_CURSOR_BENCH_SIZE 20000
+
+static int CheckPosCursorData(ListPosCursor_t* p_cursor, CdataIndex_t pos, int expected)
+{
+	int* p_data = (int*)List_PosCursorGetData(p_cursor, pos);
+
+	if (p_data == NULL || *p_data != expected)
+	{
+		LOG_E("Wrong data at pos:%llu, expected:%d.\n", (unsigned long long)pos, expected);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int CheckPosCursor(ListType_e type, CdataBool positionIndex)
+{
+	List_t          list = NULL;
+	ListAttr_t      attr;
+	ListPosCursor_t cursor;
+	CdataIndex_t    pos = 0;
+	int             i = 0;
+	int             ret = 0;
+
+	List_AttrInit(&attr);
+	attr.positionIndex = positionIndex;
+	List_CreateWithAttr("PosCursorList", type, sizeof(int), &attr, &list);
+	for (i = 0; i < POS_CURSOR_TEST_SIZE; i++)
+	{
+		List_InsertData(list, &i);
+	}
+
+	List_PosCursorInit(list, &cursor);
+	for (pos = 0; pos < POS_CURSOR_TEST_SIZE && ret == 0; pos++)
+	{
+		ret = CheckPosCursorData(&cursor, pos, (int)pos);
+	}
+
+	//Backward and jumping, the single list starts over from the head.
+	for (i = POS_CURSOR_TEST_SIZE - 1; i >= 0 && ret == 0; i -= 7)
+	{
+		ret = CheckPosCursorData(&cursor, i, i);
+	}
+
+	//The cursor stands on 5, remove 0 and append -1, then the cached position is stale.
+	List_RmHead(list);
+	i = -1;
+	List_InsertData(list, &i);
+	if (ret == 0 && (CheckPosCursorData(&cursor, 6, 7) != 0 || CheckPosCursorData(&cursor, 0, 1) != 0 || CheckPosCursorData(&cursor, 1, 2) != 0
+		|| CheckPosCursorData(&cursor, POS_CURSOR_TEST_SIZE - 2, POS_CURSOR_TEST_SIZE - 1) != 0
+		|| CheckPosCursorData(&cursor, POS_CURSOR_TEST_SIZE - 1, -1) != 0))
+	{
+		ret = -1;
+	}
+
+	if (ret == 0 && List_PosCursorGetData(&cursor, POS_CURSOR_TEST_SIZE) != NULL)
+	{
+		LOG_E("Got data out of the list.\n");
+		ret = -1;
+	}
+
+	List_Destroy(list);
+	return ret;
+}
+
+static int TestPosCursor()
+{
+	List_t          list = NULL;
+	ListPosCursor_t cursor;
+	long long       sums[2] = {0, 0};
+	double          begin = 0;
+	double          times[2] = {0, 0};
+	int             i = 0;
+
+	if (CheckPosCursor(g_listType, CDATA_FALSE) != 0 || CheckPosCursor(g_listType, CDATA_TRUE) != 0
+		|| CheckPosCursor(LIST_TYPE_UNROLLED, CDATA_FALSE) != 0)
+	{
+		return -1;
+	}
+
+	List_Create("PosCursorBenchList", g_listType, sizeof(int), &list);
+	for (i = 0; i < POS_CURSOR_BENCH_SIZE; i++)
+	{
+		List_InsertData(list, &i);
+	}
+
+	begin = GetNowSeconds();
+	for (i = 0; i < POS_CURSOR_BENCH_SIZE; i++)
+	{
+		sums[0] += *(int*)List_GetDataAtPos(list, i);
+	}
+	times[0] = GetNowSeconds() - begin;
+
+	begin = GetNowSeconds();
+	List_PosCursorInit(list, &cursor);
+	for (i = 0; i < POS_CURSOR_BENCH_SIZE; i++)
+	{
+		sums[1] += *(int*)List_PosCursorGetData(&cursor, i);
+	}
+	times[1] = GetNowSeconds() - begin;
+	List_Destroy(list);
+
+	if (sums[0] != sums[1] || sums[0] != (long long)POS_CURSOR_BENCH_SIZE * (POS_CURSOR_BENCH_SIZE - 1) / 2)
+	{
+		LOG_E("Wrong sum, List_GetDataAtPos:%lld, cursor:%lld.\n", sums[0], sums[1]);
+		return -1;
+	}
+
+	LOG_A("Get %d data by position, List_GetDataAtPos:%.3fs, List_PosCursorGetData:%.3fs.\n", POS_CURSOR_BENCH_SIZE, times[0], times[1]);
+
+	return 0;
+}
+
+#define FINGER_TEST_SIZE  3000
+#define FINGER_BENCH_SIZE 200000
+
+typedef struct
+{
+	int key;
+	int seq;
+}KeySeq_t;
+
+static int CheckOrderedInsert(ListType_e type, CdataBool isAsc, CdataBool nearlySorted)
+{
+	List_t     list = NULL;
+	ListNode_t node = NULL;
+	KeySeq_t   data;
+	KeySeq_t   pre;
+	int        i = 0;
+	int        ret = 0;
+
+	List_Create("FingerList", type, sizeof(KeySeq_t), &list);
+	List_SetUserLtNodeFunc(list, IntLtListData);
+
+	for (i = 0; i < FINGER_TEST_SIZE; i++)
+	{
+		data.key = nearlySorted ? (i / 4 + rand() % 8) : rand() % 100;
+		data.seq = i;
+		node = isAsc ? List_InsertDataAsc(list, &data) : List_InsertDataDes(list, &data);
+
+		//Remove the head and the node just inserted sometimes, the last insert place is gone with them.
+		if (i % 7 == 0)
+		{
+			List_RmHead(list);
+		}
+		else if (i % 11 == 0)
+		{
+			List_RmNode(list, node);
+		}
+	}
+
+	//The equal data keep the insert order in an ascending list, and the reversed order in a descending one.
+	List_Lock(list);
+	node = List_GetHeadNL(list);
+	pre = *(KeySeq_t*)List_GetNodeDataNL(list, node);
+	for (node = List_GetNextNodeNL(list, node); node != NULL; node = List_GetNextNodeNL(list, node))
+	{
+		data = *(KeySeq_t*)List_GetNodeDataNL(list, node);
+		if ((isAsc && (data.key < pre.key || (data.key == pre.key && data.seq < pre.seq)))
+			|| (!isAsc && (data.key > pre.key || (data.key == pre.key && data.seq > pre.seq))))
+		{
+			LOG_E("Wrong order, %d(%d) after %d(%d).\n", data.key, data.seq, pre.key, pre.seq);
+			ret = -1;
+			break;
+		}
+		pre = data;
+	}
+	List_UnLock(list);
+
+	List_Destroy(list);
+	return ret;
+}
+
+static int TestFingerInsert()
+{
+	List_t list = NULL;
+	double begin = 0;
+	int    value = 0;
+	int    i = 0;
+
+	for (i = 0; i < 4; i++)
+	{
+		if (CheckOrderedInsert(g_listType, (i & 1) == 0, (i & 2) != 0) != 0)
+		{
+			return -1;
+		}
+	}
+
+	//Timestamps arrive almost in order, the single list can't search back from the tail.
+	List_Create("FingerBenchList", LIST_TYPE_DOUBLE_LINK, sizeof(int), &list);
+	List_SetUserLtNodeFunc(list, IntLtListData);
+	begin = GetNowSeconds();
+	for (i = 0; i < FINGER_BENCH_SIZE; i++)
+	{
+		value = i - rand() % 64;
+		List_InsertDataAsc(list, &value);
+	}
+	LOG_A("Insert %d nearly sorted data ascendingly:%.3fs.\n", FINGER_BENCH_SIZE, GetNowSeconds() - begin);
+	List_Destroy(list);
+
+	return 0;
+}
+
+#define INTRUSIVE_TEST_SIZE   100
+#define INTRUSIVE_BENCH_SIZE  1024
+#define INTRUSIVE_BENCH_TIMES 2000000
+
+typedef struct
+{
+	int         fd;
+	CdataLink_t link;
+	int         state;
+}Conn_t;
+
+static int g_freedConns = 0;
+
+static void FreeConn(void* p_data)
+{
+	g_freedConns++;
+	free(p_data);
+}
+
+static int CheckIntrusiveList(ListType_e type)
+{
+	List_t     list = NULL;
+	List_t     closed = NULL;
+	ListNode_t node = NULL;
+	Conn_t     conns[INTRUSIVE_TEST_SIZE];
+	Conn_t*    p_conn = NULL;
+	int        i = 0;
+	int        ret = 0;
+
+	List_CreateIntrusive("ConnList", type, offsetof(Conn_t, link), &list);
+	List_CreateIntrusive("ClosedList", type, offsetof(Conn_t, link), &closed);
+	List_SetUserLtNodeFunc(list, IntLtListData);
+
+	//The data are on the stack, the list would crash if it freed them.
+	for (i = INTRUSIVE_TEST_SIZE - 1; i >= 0; i--)
+	{
+		conns[i].fd = i;
+		conns[i].state = 0;
+		if (List_InsertDataAsc(list, &conns[i]) != List_GetNodeOfData(list, &conns[i]))
+		{
+			LOG_E("The node is not the link of the data.\n");
+			ret = -1;
+			goto EXIT;
+		}
+	}
+
+	//Move the odd ones to the closed list without searching.
+	for (i = 1; i < INTRUSIVE_TEST_SIZE; i += 2)
+	{
+		List_DetachNode(list, List_GetNodeOfData(list, &conns[i]));
+		List_InsertData(closed, &conns[i]);
+	}
+
+	if (List_Count(list) != INTRUSIVE_TEST_SIZE / 2 || List_Count(closed) != INTRUSIVE_TEST_SIZE / 2)
+	{
+		LOG_E("Wrong count:%llu, closed:%llu.\n", List_Count(list), List_Count(closed));
+		ret = -1;
+		goto EXIT;
+	}
+
+	i = 0;
+	List_Lock(list);
+	FOR_EACH_IN_LIST(node, list)
+	{
+		p_conn = CDATA_CONTAINER_OF(node, Conn_t, link);
+		if (p_conn != List_GetNodeDataNL(list, node) || p_conn != &conns[i])
+		{
+			LOG_E("Wrong data of fd:%d.\n", i);
+			ret = -1;
+			break;
+		}
+		i += 2;
+	}
+	List_UnLock(list);
+
+	if (ret == 0 && (List_DetachHeadData(closed) != &conns[1] || List_DetachTailData(list) != &conns[INTRUSIVE_TEST_SIZE - 2]))
+	{
+		LOG_E("Wrong data detached.\n");
+		ret = -1;
+	}
+
+	EXIT:
+	List_Destroy(closed);
+	List_Destroy(list);
+	return ret;
+}
+
+static int CheckIntrusiveLinks(List_t list, int count)
+{
+	ListNode_t node = NULL;
+	int        i = 0;
+
+	List_Lock(list);
+	FOR_EACH_IN_LIST(node, list)
+	{
+		if (List_GetNodeDataNL(list, node) == NULL || CDATA_CONTAINER_OF(node, Conn_t, link)->fd != i)
+		{
+			break;
+		}
+		i++;
+	}
+	List_UnLock(list);
+
+	if (i != count || List_Count(list) != (CdataCount_t)count)
+	{
+		LOG_E("The links are broken at fd:%d, count:%llu.\n", i, List_Count(list));
+		return -1;
+	}
+
+	return 0;
+}
+
+static int CheckIntrusiveMisuse(ListType_e type)
+{
+	List_t list = NULL;
+	Conn_t conns[4];
+	void*  batch[3] = {&conns[2], &conns[3], &conns[3]};
+	int    i = 0;
+	int    ret = 0;
+
+	List_CreateIntrusive("UniConnList", type, offsetof(Conn_t, link), &list);
+	List_SetNodeEqualFunc(list, IntEqualListData);
+	for (i = 0; i < 4; i++)
+	{
+		conns[i].fd = i;
+	}
+	for (i = 0; i < 3; i++)
+	{
+		List_InsertData(list, &conns[i]);
+	}
+
+	//Re-inserting a linked data must leave its link alone.
+	if (List_InsertDataUni(list, &conns[1]) != NULL || List_InsertData2HeadUni(list, &conns[0]) != NULL
+		|| List_InsertDataBatchUni(list, batch, 3) != 1 || CheckIntrusiveLinks(list, 4) != 0)
+	{
+		LOG_E("The linked data is inserted again.\n");
+		ret = -1;
+		goto EXIT;
+	}
+
+	//The data can't leave its link.
+	if (List_Swap(list, List_GetNodeOfData(list, &conns[0]), List_GetNodeOfData(list, &conns[3])) != ERR_BAD_PARAM
+		|| List_DetachNodeData(list, List_GetNodeOfData(list, &conns[1])) != NULL || CheckIntrusiveLinks(list, 4) != 0)
+	{
+		LOG_E("The data is moved out of its link.\n");
+		ret = -1;
+	}
+
+	EXIT:
+	List_Destroy(list);
+	return ret;
+}
+
+static int CheckIntrusiveFree(ListType_e type)
+{
+	List_t     list = NULL;
+	ListAttr_t attr;
+	Conn_t*    p_conn = NULL;
+	int        i = 0;
+
+	List_AttrInit(&attr);
+	attr.positionIndex = CDATA_TRUE;
+	if (List_CreateIntrusiveWithAttr("BadConnList", type, offsetof(Conn_t, link), &attr, &list) != ERR_BAD_PARAM
+		|| List_CreateIntrusive("BadConnList", LIST_TYPE_UNROLLED, offsetof(Conn_t, link), &list) != ERR_BAD_PARAM)
+	{
+		LOG_E("Intrusive list is created with position index or as unrolled list.\n");
+		return -1;
+	}
+
+	//With freeFn the list frees the data which it destroys.
+	g_freedConns = 0;
+	List_CreateIntrusive("HeapConnList", type, offsetof(Conn_t, link), &list);
+	List_SetFreeDataFunc(list, FreeConn);
+	for (i = 0; i < INTRUSIVE_TEST_SIZE; i++)
+	{
+		p_conn = (Conn_t*)malloc(sizeof(Conn_t));
+		p_conn->fd = i;
+		List_InsertData(list, p_conn);
+	}
+	List_RmHead(list);
+	p_conn = (Conn_t*)List_DetachHeadData(list);
+	List_Destroy(list);
+	free(p_conn);
+
+	if (g_freedConns != INTRUSIVE_TEST_SIZE - 1)
+	{
+		LOG_E("Wrong freed count:%d.\n", g_freedConns);
+		return -1;
+	}
+
+	return 0;
+}
+
+static double RunConnChurn(List_t list, Conn_t* p_conns)
+{
+	double begin = GetNowSeconds();
+	int    i = 0;
+
+	for (i = 0; i < INTRUSIVE_BENCH_SIZE; i++)
+	{
+		List_InsertData(list, &p_conns[i]);
+	}
+
+	for (i = 0; i < INTRUSIVE_BENCH_TIMES; i++)
+	{
+		List_InsertData(list, List_DetachHeadData(list));
+	}
+
+	while (List_Count(list) > 0)
+	{
+		List_DetachHeadData(list);
+	}
+
+	return GetNowSeconds() - begin;
+}
+
+static int TestIntrusiveList()
+{
+	List_t  list = NULL;
+	Conn_t* p_conns = NULL;
+	double  refTime = 0;
+	double  intrusiveTime = 0;
+
+	if (CheckIntrusiveList(g_listType) != 0 || CheckIntrusiveMisuse(g_listType) != 0 || CheckIntrusiveFree(g_listType) != 0)
+	{
+		return -1;
+	}
+
+	p_conns = (Conn_t*)malloc(sizeof(Conn_t) * INTRUSIVE_BENCH_SIZE);
+
+	List_CreateRef("RefConnList", g_listType, &list);
+	refTime = RunConnChurn(list, p_conns);
+	List_Destroy(list);
+
+	List_CreateIntrusive("IntrusiveConnList", g_listType, offsetof(Conn_t, link), &list);
+	intrusiveTime = RunConnChurn(list, p_conns);
+	List_Destroy(list);
+
+	free(p_conns);
+
+	LOG_A("%d detach and insert of %d connections, reference list:%.3fs, intrusive list:%.3fs.\n",
+		INTRUSIVE_BENCH_TIMES, INTRUSIVE_BENCH_SIZE, refTime, intrusiveTime);
+
+	return 0;
+}
+
+/*=============================================================================*
+ *                                End of file
+ *============================================================================*/
@@ -24,6 +24,7 @@ static int TestStructureData();
 static int TestStructureRef();
 static int TestMultiThread();
 static int TestTimedMultiThread();
+static int TestPopBatch();
 
 
 static void InitMsgData(const char* p_msgData, Message_t *p_msg);
@@ -55,6 +56,7 @@ static Testcase_t g_testcaseArray[] =
     {"Test value reference queue.", TestStructureRef},
     {"Test multi thread, writing/reading a same queue.", TestMultiThread},
     {"Test timed wait in multi thread.", TestTimedMultiThread},
+    {"Test pop data by batch.", TestPopBatch},
 };
 
 //=============================================================================
@@ -226,6 +228,56 @@ static int TestStructureRef()
     return 0;
 }
 
+static int TestPopBatch()
+{
+    Queue_t intQueue;
+    Queue_t msgQueue;
+    Message_t msgs[10];
+    int values[8];
+    int value = 0;
+    int ret = 0;
+    CdataCount_t count = 0;
+    CdataCount_t i = 0;
+
+    Queue_Create("IntBatchQueue", sizeof(int), CopyIntValue, &intQueue);
+    for (value = 1; value < 10; value++)
+    {
+        Queue_Push(intQueue, &value);
+    }
+
+    count = Queue_PopBatch(intQueue, values, sizeof(int), 4);
+    if (count != 4 || values[0] != 1 || values[3] != 4 || Queue_Count(intQueue) != 5)
+    {
+        LOG_E("Wrong batch pop, count:%llu.\n", count);
+        ret = -1;
+    }
+
+    count = Queue_PopBatch(intQueue, values, sizeof(int), 8);
+    if (count != 5 || values[0] != 5 || values[4] != 9 || Queue_Count(intQueue) != 0)
+    {
+        LOG_E("Wrong batch pop of the rest, count:%llu.\n", count);
+        ret = -1;
+    }
+    Queue_Destroy(intQueue);
+
+    //Each message is copied out by CpMessage, and the one in queue is freed by FreeMessage.
+    msgQueue = CreateStructureQueue();
+    count = Queue_PopBatch(msgQueue, msgs, sizeof(Message_t), 10);
+    for (i = 0; i < count; i++)
+    {
+        printf("Pop structure by batch:'%s'.\n", msgs[i].p_message);
+        OS_Free(msgs[i].p_message);
+    }
+    if (count != 10 || Queue_Count(msgQueue) != 0)
+    {
+        LOG_E("Wrong batch pop of structure queue, count:%llu.\n", count);
+        ret = -1;
+    }
+    Queue_Destroy(msgQueue);
+
+    return ret;
+}
+
 static int g_writeDataFinished = 0;
 static void* WriteDataThread(void *p_param)
 {
@@ -0,0 +1,377 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "cdata.h"
+#include "test_case.h"
+
+#ifndef _DEBUG_LEVEL_
+#define _DEBUG_LEVEL_  _DEBUG_LEVEL_I_
+#endif
+#include "debug.h"
+
+
+//=============================================================================
+static void Init(void);
+static void Show(void);
+static void Run(int id);
+static int GetTestcaseCount(void);
+static void Finalize(void);
+
+static int TestTypedList();
+static int TestTypedQueue();
+static int TestTypedBenchmark();
+
+
+//=============================================================================
+TestcaseSet_t TypedTestcaseSet =
+{
+    "Test all typed container functions.",
+    Init,
+    Show,
+    Run,
+    GetTestcaseCount,
+    Finalize
+};
+
+static Testcase_t g_testcaseArray[] =
+{
+    {"Test typed list.", TestTypedList},
+    {"Test typed queue and priority queue.", TestTypedQueue},
+    {"Benchmark typed containers with the generic ones.", TestTypedBenchmark},
+};
+
+//=============================================================================
+static void Init(void)
+{
+    return;
+}
+
+static void Show(void)
+{
+    int i = 0;
+
+    printf("\n==============================================\n");
+    for (i = 0; i < sizeof(g_testcaseArray) / sizeof(g_testcaseArray[0]); i++)
+    {
+        printf("%d: %s\n", i, g_testcaseArray[i].p_description);
+    }
+    printf("==============================================\n");
+
+}
+static void Run(int id)
+{
+    if (id < 0 || id >= sizeof(g_testcaseArray) / sizeof(g_testcaseArray[0]))
+    {
+        return;
+    }
+
+    int ret = g_testcaseArray[id].testcaseFn();
+    if (ret == 0)
+    {
+        printf("Testcase %d passed.\n", id);
+    }
+    else
+    {
+        printf("Testcase %d failed.\n", id);
+    }
+
+}
+
+static int GetTestcaseCount(void)
+{
+    return sizeof(g_testcaseArray) / sizeof(g_testcaseArray[0]);
+}
+
+static void Finalize(void)
+{
+    return;
+}
+
+//=============================================================================
+typedef struct
+{
+    int key;
+    int seq;
+}KeyItem_t;
+
+#define KeyItemCmp(_first_, _second_) CDATA_CMP_VALUE((_first_)->key, (_second_)->key)
+
+CDATA_DEFINE_LIST(ItemList, KeyItem_t, KeyItemCmp)
+CDATA_DEFINE_LIST(IntList, int, CDATA_CMP_NUM)
+CDATA_DEFINE_QUEUE(IntQueue, int)
+CDATA_DEFINE_PRIQUEUE(ItemPriQueue, KeyItem_t, KeyItemCmp)
+
+#define TYPED_BENCH_COUNT    1000000
+#define TYPED_BENCH_LOOKUPS  10
+#define TYPED_BENCH_PRIORITY 16
+#define TYPED_BENCH_PRIQUEUE_COUNT 10000
+
+static double GetNowSeconds()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1000000000.0;
+}
+
+static CdataBool IntEqual(void* p_nodeData, void* p_keyword)
+{
+    return *(int*)p_nodeData == *(int*)p_keyword;
+}
+
+static int CopyInt(void *p_queueData, void* p_userData)
+{
+    *(int*)p_userData = *(int*)p_queueData;
+    return 0;
+}
+
+static int TestTypedList()
+{
+    ItemList_t      list;
+    ItemListNode_t* p_node = NULL;
+    KeyItem_t       item;
+    int             i = 0;
+    int             ret = 0;
+
+    ItemList_Init(&list);
+    for (i = 0; i < 20; i++)
+    {
+        item.key = (i * 7) % 10;
+        item.seq = i;
+        ItemList_InsertDataAsc(&list, item);
+    }
+
+    //The equal data keep the order they are inserted.
+    item.key = 3;
+    p_node = ItemList_GetFirstMatchNode(&list, item);
+    if (ItemList_Count(&list) != 20 || p_node == NULL || ItemList_GetNodeData(p_node)->seq != 9
+        || ItemList_GetNodeData(ItemList_GetNextNode(p_node))->seq != 19 || ItemList_GetMachCount(&list, item) != 2)
+    {
+        LOG_E("Wrong data after inserting ascending.\n");
+        ret = -1;
+        goto EXIT;
+    }
+
+    ItemList_RmNode(&list, p_node);
+    item.key = -1;
+    item.seq = 100;
+    ItemList_InsertData2Head(&list, item);
+    item.key = 100;
+    ItemList_InsertData(&list, item);
+    if (ItemList_DetachHeadData(&list, &item) != ERR_OK || item.key != -1 || ItemList_GetNodeData(ItemList_GetTail(&list))->key != 100
+        || ItemList_GetNodeData(ItemList_GetPreNode(ItemList_GetTail(&list)))->key != 9 || ItemList_Count(&list) != 20)
+    {
+        LOG_E("Wrong data at both ends.\n");
+        ret = -1;
+        goto EXIT;
+    }
+
+    item.key = 3;
+    if (ItemList_GetMachCount(&list, item) != 1 || ItemList_DataExists(&list, (KeyItem_t){11, 0}))
+    {
+        LOG_E("Wrong data after removing node.\n");
+        ret = -1;
+        goto EXIT;
+    }
+
+    while (ItemList_DetachHeadData(&list, &item) == ERR_OK);
+    if (ItemList_Count(&list) != 0 || ItemList_GetHead(&list) != NULL || ItemList_GetTail(&list) != NULL)
+    {
+        LOG_E("Wrong list after detaching all data.\n");
+        ret = -1;
+        goto EXIT;
+    }
+
+    EXIT:
+    ItemList_Clear(&list);
+    return ret;
+}
+
+static int TestTypedQueue()
+{
+    IntQueue_t     queue;
+    ItemPriQueue_t priQueue;
+    KeyItem_t      item;
+    KeyItem_t      pre;
+    int            value = 0;
+    int            i = 0;
+    int            ret = 0;
+
+    //Pop some data before push more, so the data are wrapped when the buffer grows.
+    IntQueue_Init(&queue);
+    for (i = 0; i < 10; i++)
+    {
+        IntQueue_Push(&queue, i);
+    }
+    for (i = 0; i < 5; i++)
+    {
+        IntQueue_Pop(&queue, NULL);
+    }
+    for (i = 10; i < 100; i++)
+    {
+        IntQueue_Push(&queue, i);
+    }
+    IntQueue_Push2Head(&queue, 4);
+
+    for (i = 4; i < 100; i++)
+    {
+        if (IntQueue_Pop(&queue, &value) != ERR_OK || value != i)
+        {
+            LOG_E("Wrong data:%d popped, expected:%d.\n", value, i);
+            ret = -1;
+            goto EXIT;
+        }
+    }
+
+    if (IntQueue_Count(&queue) != 0 || IntQueue_GetHead(&queue, &value) != ERR_DATA_NOT_EXISTS)
+    {
+        LOG_E("Queue should be empty.\n");
+        ret = -1;
+        goto EXIT;
+    }
+
+    //The greater key is popped first, the equal keys are first in first out.
+    ItemPriQueue_Init(&priQueue);
+    for (i = 0; i < 1000; i++)
+    {
+        item.key = (i * 7919) % 10;
+        item.seq = i;
+        ItemPriQueue_Push(&priQueue, item);
+    }
+
+    ItemPriQueue_GetHead(&priQueue, &pre);
+    for (i = 0; ItemPriQueue_Pop(&priQueue, &item) == ERR_OK; i++, pre = item)
+    {
+        if (i > 0 && (pre.key < item.key || (pre.key == item.key && pre.seq > item.seq)))
+        {
+            LOG_E("Wrong order, key:%d, seq:%d.\n", item.key, item.seq);
+            ret = -1;
+            break;
+        }
+    }
+    if (ret == 0 && i != 1000)
+    {
+        LOG_E("Wrong count of popped data:%d.\n", i);
+        ret = -1;
+    }
+    ItemPriQueue_Clear(&priQueue);
+
+    EXIT:
+    IntQueue_Clear(&queue);
+    return ret;
+}
+
+static int TestTypedBenchmark()
+{
+    List_t         list;
+    Queue_t        queue;
+    Queue_t        priQueue;
+    IntList_t      typedList;
+    IntQueue_t     typedQueue;
+    ItemPriQueue_t typedPriQueue;
+    KeyItem_t      item;
+    CdataCount_t   counts[2] = {0, 0};
+    double         begin = 0;
+    double         times[2];
+    int            value = 0;
+    int            i = 0;
+
+    begin = GetNowSeconds();
+    List_Create("GenericList", LIST_TYPE_DOUBLE_LINK, sizeof(int), &list);
+    List_SetEqual2KeywordFunc(list, IntEqual);
+    for (i = 0; i < TYPED_BENCH_COUNT; i++)
+    {
+        List_InsertData(list, &i);
+    }
+    for (i = 0; i < TYPED_BENCH_LOOKUPS; i++)
+    {
+        value = i * 1000;
+        counts[0] += List_GetMachCount(list, &value);
+    }
+    List_Destroy(list);
+    times[0] = GetNowSeconds() - begin;
+
+    begin = GetNowSeconds();
+    IntList_Init(&typedList);
+    for (i = 0; i < TYPED_BENCH_COUNT; i++)
+    {
+        IntList_InsertData(&typedList, i);
+    }
+    for (i = 0; i < TYPED_BENCH_LOOKUPS; i++)
+    {
+        counts[1] += IntList_GetMachCount(&typedList, i * 1000);
+    }
+    IntList_Clear(&typedList);
+    times[1] = GetNowSeconds() - begin;
+
+    if (counts[0] != counts[1] || counts[0] != TYPED_BENCH_LOOKUPS)
+    {
+        LOG_E("Wrong match count:%d, %d.\n", (int)counts[0], (int)counts[1]);
+        return -1;
+    }
+    LOG_A("Insert %d int and count %d keys, list:%.3fs, typed list:%.3fs.\n", TYPED_BENCH_COUNT, TYPED_BENCH_LOOKUPS, times[0], times[1]);
+
+    begin = GetNowSeconds();
+    Queue_Create("GenericQueue", sizeof(int), CopyInt, &queue);
+    for (i = 0; i < TYPED_BENCH_COUNT; i++)
+    {
+        Queue_Push(queue, &i);
+    }
+    for (i = 0; i < TYPED_BENCH_COUNT; i++)
+    {
+        Queue_GetHead(queue, &value);
+        Queue_Pop(queue);
+    }
+    Queue_Destroy(queue);
+    times[0] = GetNowSeconds() - begin;
+
+    begin = GetNowSeconds();
+    IntQueue_Init(&typedQueue);
+    for (i = 0; i < TYPED_BENCH_COUNT; i++)
+    {
+        IntQueue_Push(&typedQueue, i);
+    }
+    for (i = 0; i < TYPED_BENCH_COUNT; i++)
+    {
+        IntQueue_Pop(&typedQueue, &value);
+    }
+    IntQueue_Clear(&typedQueue);
+    times[1] = GetNowSeconds() - begin;
+
+    LOG_A("Push and pop %d int, queue:%.3fs, typed queue:%.3fs.\n", TYPED_BENCH_COUNT, times[0], times[1]);
+
+    begin = GetNowSeconds();
+    PriQueue_Create("GenericPriQueue", sizeof(int), CopyInt, &priQueue);
+    for (i = 0; i < TYPED_BENCH_PRIQUEUE_COUNT; i++)
+    {
+        PriQueue_Push(priQueue, &i, i % TYPED_BENCH_PRIORITY);
+    }
+    for (i = 0; i < TYPED_BENCH_PRIQUEUE_COUNT; i++)
+    {
+        PriQueue_GetHead(priQueue, &value, NULL);
+        PriQueue_Pop(priQueue);
+    }
+    PriQueue_Destroy(priQueue);
+    times[0] = GetNowSeconds() - begin;
+
+    begin = GetNowSeconds();
+    ItemPriQueue_Init(&typedPriQueue);
+    for (i = 0; i < TYPED_BENCH_PRIQUEUE_COUNT; i++)
+    {
+        item.key = i % TYPED_BENCH_PRIORITY;
+        item.seq = i;
+        ItemPriQueue_Push(&typedPriQueue, item);
+    }
+    for (i = 0; i < TYPED_BENCH_PRIQUEUE_COUNT; i++)
+    {
+        ItemPriQueue_Pop(&typedPriQueue, &item);
+    }
+    ItemPriQueue_Clear(&typedPriQueue);
+    times[1] = GetNowSeconds() - begin;
+
+    LOG_A("Push and pop %d data with %d priorities, priority queue:%.3fs, typed priority queue:%.3fs.\n",
+        TYPED_BENCH_PRIQUEUE_COUNT, TYPED_BENCH_PRIORITY, times[0], times[1]);
+
+    return 0;
+}
@@ -0,0 +1,306 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "cdata.h"
+#include "test_case.h"
+
+#ifndef _DEBUG_LEVEL_
+#define _DEBUG_LEVEL_  _DEBUG_LEVEL_I_
+#endif
+#include "debug.h"
+
+
+//=============================================================================
+static void Init(void);
+static void Show(void);
+static void Run(int id);
+static int GetTestcaseCount(void);
+static void Finalize(void);
+
+static int TestBasicFunction();
+static int TestReferenceVector();
+static int TestSortAndScan();
+
+
+//=============================================================================
+TestcaseSet_t VectorTestcaseSet =
+{
+    "Test all vector functions.",
+    Init,
+    Show,
+    Run,
+    GetTestcaseCount,
+    Finalize
+};
+
+static Testcase_t g_testcaseArray[] =
+{
+    {"Test all the basic functions of vector.", TestBasicFunction},
+    {"Test value reference vector.", TestReferenceVector},
+    {"Test sort and benchmark scan of vector.", TestSortAndScan},
+};
+
+//=============================================================================
+static void Init(void)
+{
+    return;
+}
+
+static void Show(void)
+{
+    int i = 0;
+
+    printf("\n==============================================\n");
+    for (i = 0; i < sizeof(g_testcaseArray) / sizeof(g_testcaseArray[0]); i++)
+    {
+        printf("%d: %s\n", i, g_testcaseArray[i].p_description);
+    }
+    printf("==============================================\n");
+
+}
+static void Run(int id)
+{
+    if (id < 0 || id >= sizeof(g_testcaseArray) / sizeof(g_testcaseArray[0]))
+    {
+        return;
+    }
+
+    int ret = g_testcaseArray[id].testcaseFn();
+    if (ret == 0)
+    {
+        printf("Testcase %d passed.\n", id);
+    }
+    else
+    {
+        printf("Testcase %d failed.\n", id);
+    }
+
+}
+
+static int GetTestcaseCount(void)
+{
+    return sizeof(g_testcaseArray) / sizeof(g_testcaseArray[0]);
+}
+
+static void Finalize(void)
+{
+    return;
+}
+
+//=============================================================================
+typedef struct
+{
+    int key;
+    int seq;
+}KeyItem_t;
+
+#define SCAN_BENCH_COUNT  1000000
+#define SCAN_BENCH_ROUNDS 10
+
+static int g_freeCount = 0;
+
+static double GetNowSeconds()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1000000000.0;
+}
+
+static CdataBool IsEven(void* p_data, void* p_userData)
+{
+    return (*(int*)p_data % 2) == 0;
+}
+
+static void CountFree(void* p_data)
+{
+    g_freeCount++;
+    free(p_data);
+}
+
+static CdataBool KeyItemLt(void* p_nodeData, void* p_userData)
+{
+    return ((KeyItem_t*)p_userData)->key < ((KeyItem_t*)p_nodeData)->key;
+}
+
+static void SumInt(ListTraverseNodeInfo_t *p_info, void *p_userData, CdataBool* p_needStop)
+{
+    *(long long*)p_userData += *(int*)p_info->p_data;
+}
+
+static int TestBasicFunction()
+{
+    Vector_t vector;
+    int value = 0;
+    int i = 0;
+    int ret = 0;
+
+    Vector_Create("IntVector", sizeof(int), &vector);
+    for (i = 0; i < 100; i++)
+    {
+        Vector_Push(vector, &i);
+    }
+
+    if (Vector_Count(vector) != 100 || Vector_Capacity(vector) < 100 || *(int*)Vector_GetAt(vector, 42) != 42
+        || Vector_GetAt(vector, 100) != NULL)
+    {
+        LOG_E("Wrong data after push.\n");
+        ret = -1;
+        goto EXIT;
+    }
+
+    value = -1;
+    Vector_InsertAt(vector, 0, &value);
+    value = -2;
+    Vector_InsertAt(vector, 50, &value);
+    if (Vector_InsertAt(vector, 103, &value) != ERR_BAD_PARAM || *(int*)Vector_GetAt(vector, 0) != -1
+        || *(int*)Vector_GetAt(vector, 50) != -2 || *(int*)Vector_GetAt(vector, 51) != 49 || Vector_Count(vector) != 102)
+    {
+        LOG_E("Wrong data after insert.\n");
+        ret = -1;
+        goto EXIT;
+    }
+
+    Vector_RmAt(vector, 50);
+    Vector_RmAt(vector, 0);
+    if (Vector_RmAt(vector, 100) != ERR_DATA_NOT_EXISTS || *(int*)Vector_GetAt(vector, 50) != 50)
+    {
+        LOG_E("Wrong data after remove.\n");
+        ret = -1;
+        goto EXIT;
+    }
+
+    if (Vector_Pop(vector, &value) != ERR_OK || value != 99 || Vector_Count(vector) != 99)
+    {
+        LOG_E("Wrong data popped.\n");
+        ret = -1;
+        goto EXIT;
+    }
+
+    Vector_Reserve(vector, 1000);
+    Vector_Clear(vector);
+    if (Vector_Capacity(vector) != 1000 || Vector_Count(vector) != 0 || Vector_Pop(vector, &value) != ERR_DATA_NOT_EXISTS)
+    {
+        LOG_E("Wrong vector after clear.\n");
+        ret = -1;
+        goto EXIT;
+    }
+
+    EXIT:
+    Vector_Destroy(vector);
+    return ret;
+}
+
+static int TestReferenceVector()
+{
+    Vector_t vector;
+    int* p_value = NULL;
+    int i = 0;
+    int ret = 0;
+
+    g_freeCount = 0;
+    Vector_CreateRef("RefVector", &vector);
+    Vector_SetFreeDataFunc(vector, CountFree);
+    for (i = 0; i < 10; i++)
+    {
+        p_value = (int*)malloc(sizeof(int));
+        *p_value = i;
+        Vector_Push(vector, p_value);
+    }
+
+    //The kept data keep their order.
+    if (Vector_RmByCond(vector, NULL, IsEven) != 5 || g_freeCount != 5 || *(int*)Vector_GetAt(vector, 2) != 5)
+    {
+        LOG_E("Wrong data after removing even data.\n");
+        ret = -1;
+        goto EXIT;
+    }
+
+    //The popped data belongs to user.
+    if (Vector_Pop(vector, &p_value) != ERR_OK || *p_value != 9 || g_freeCount != 5)
+    {
+        LOG_E("Wrong data popped.\n");
+        ret = -1;
+        goto EXIT;
+    }
+    free(p_value);
+
+    EXIT:
+    Vector_Destroy(vector);
+    if (ret == 0 && g_freeCount != 9)
+    {
+        LOG_E("Wrong free count:%d.\n", g_freeCount);
+        ret = -1;
+    }
+    return ret;
+}
+
+static int TestSortAndScan()
+{
+    Vector_t vector;
+    List_t list;
+    KeyItem_t item;
+    KeyItem_t* p_pre = NULL;
+    KeyItem_t* p_item = NULL;
+    long long sums[2] = {0, 0};
+    double begin = 0;
+    double times[2];
+    int i = 0;
+    int ret = 0;
+
+    //The items with the same key keep the order they are pushed.
+    Vector_Create("SortVector", sizeof(KeyItem_t), &vector);
+    for (i = 0; i < 1000; i++)
+    {
+        item.key = (i * 7919) % 100;
+        item.seq = i;
+        Vector_Push(vector, &item);
+    }
+    Vector_Sort(vector, KeyItemLt);
+    for (i = 0; i < 1000; i++, p_pre = p_item)
+    {
+        p_item = (KeyItem_t*)Vector_GetAt(vector, i);
+        if (p_pre != NULL && (p_pre->key > p_item->key || (p_pre->key == p_item->key && p_pre->seq > p_item->seq)))
+        {
+            LOG_E("Wrong order at key:%d, seq:%d.\n", p_item->key, p_item->seq);
+            Vector_Destroy(vector);
+            return -1;
+        }
+    }
+    Vector_Destroy(vector);
+
+    Vector_Create("ScanVector", sizeof(int), &vector);
+    List_Create("ScanList", LIST_TYPE_DOUBLE_LINK, sizeof(int), &list);
+    for (i = 0; i < SCAN_BENCH_COUNT; i++)
+    {
+        Vector_Push(vector, &i);
+        List_InsertData(list, &i);
+    }
+
+    begin = GetNowSeconds();
+    for (i = 0; i < SCAN_BENCH_ROUNDS; i++)
+    {
+        List_Traverse(list, &sums[0], SumInt);
+    }
+    times[0] = GetNowSeconds() - begin;
+
+    begin = GetNowSeconds();
+    for (i = 0; i < SCAN_BENCH_ROUNDS; i++)
+    {
+        Vector_Traverse(vector, &sums[1], SumInt);
+    }
+    times[1] = GetNowSeconds() - begin;
+
+    if (sums[0] != sums[1])
+    {
+        LOG_E("Wrong sum of vector.\n");
+        ret = -1;
+    }
+
+    LOG_A("Scan %d int %d times, double list:%.3fs, vector:%.3fs.\n", SCAN_BENCH_COUNT, SCAN_BENCH_ROUNDS, times[0], times[1]);
+
+    List_Destroy(list);
+    Vector_Destroy(vector);
+    return ret;
+}